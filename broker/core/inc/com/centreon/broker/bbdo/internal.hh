@@ -28,6 +28,16 @@
 #define BBDO_VERSION_MINOR 0
 #define BBDO_VERSION_PATCH 0
 constexpr uint32_t BBDO_HEADER_SIZE = 16u;
+/* Extension negotiated by two peers that don't check BBDO header checksums. */
+constexpr const char* BBDO_NO_CHECKSUM_EXTENSION = "NOCRC";
+/* Sent with the COMPRESSION extension, one per codec other than zlib that
+ * the peer can uncompress, e.g. COMPRESSION_ZSTD. */
+constexpr const char* BBDO_COMPRESSION_CODEC_PREFIX = "COMPRESSION_";
+/* Sent with the COMPRESSION extension followed by the id of the zstd
+ * dictionary loaded by the peer. It is only used if both peers have the same
+ * one. */
+constexpr const char* BBDO_COMPRESSION_DICTIONARY_PREFIX =
+    "COMPRESSION_ZSTD_DICT_";
 
 namespace com::centreon::broker::bbdo {
 
@@ -65,7 +65,7 @@ class stream : public io::stream {
     buffer(uint32_t event_id, uint32_t source_id, uint32_t dest_id,
            std::vector<char>&& v)
         : _event_id(event_id), _source_id(source_id), _dest_id(dest_id) {
-      _buf.push_back(v);
+      _buf.push_back(std::move(v));
     }
     buffer(const buffer&) = delete;
     buffer(buffer&& other)
@@ -102,7 +102,7 @@ class stream : public io::stream {
       return retval;
     }
 
-    void push_back(std::vector<char>&& v) { _buf.push_back(v); }
+    void push_back(std::vector<char>&& v) { _buf.push_back(std::move(v)); }
     uint32_t get_event_id() const { return _event_id; }
   };
 
@@ -111,6 +111,9 @@ class stream : public io::stream {
    * to keep in cache all but the first one. It will be read before a call
    * to _read_packet(). */
   std::vector<char> _packet;
+  /* Offset of the first byte of _packet not yet read. Read bytes are not
+   * removed from _packet, events are unserialized directly from it. */
+  size_t _packet_begin;
 
   /* We could get parts of BBDO packets in the wrong order, this deque is useful
    * to paste parts together in the good order. */
@@ -125,6 +128,9 @@ class stream : public io::stream {
   bool _coarse;
   bool _negotiate;
   bool _negotiated;
+  /* false when both peers negotiated the NOCRC extension, header checksums
+   * are then neither computed nor verified. */
+  bool _header_checksum;
   int _timeout;
   uint32_t _acknowledged_events;
   uint32_t _ack_limit;
@@ -171,8 +177,11 @@ class stream : public io::stream {
   void set_coarse(bool coarse);
   void set_negotiate(bool negotiate);
   void set_timeout(int timeout);
+  bool has_pending_input() const;
   void statistics(nlohmann::json& tree) const override;
   int write(std::shared_ptr<io::data> const& d) override;
+  int32_t write(
+      const std::vector<std::shared_ptr<io::data>>& events) override;
   void acknowledge_events(uint32_t events);
   void send_event_acknowledgement();
   std::list<std::string> get_running_config();
@@ -0,0 +1,38 @@
+/**
+ * Copyright 2023 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+#ifndef CCB_COMPRESSION_LZ4_HH
+#define CCB_COMPRESSION_LZ4_HH
+
+namespace com::centreon::broker::compression {
+/**
+ *  @class lz4 lz4.hh "com/centreon/broker/compression/lz4.hh"
+ *  @brief Binding around the lz4 library.
+ *
+ *  Compress and uncompress data. lz4 compresses less than zlib but is much
+ *  faster in both directions.
+ */
+class lz4 {
+ public:
+  static std::vector<char> compress(std::vector<char> const& data,
+                                    int compression_level);
+  static std::vector<char> uncompress(unsigned char const* data,
+                                      unsigned long nbytes);
+};
+}  // namespace com::centreon::broker::compression
+
+#endif  // !CCB_COMPRESSION_LZ4_HH
@@ -19,6 +19,7 @@
 #ifndef CCB_COMPRESSION_OPENER_HH
 #define CCB_COMPRESSION_OPENER_HH
 
+#include "com/centreon/broker/compression/stream.hh"
 #include "com/centreon/broker/io/endpoint.hh"
 
 namespace com::centreon::broker {
@@ -33,11 +34,16 @@ namespace compression {
 class opener : public io::endpoint {
   const int _level;
   const size_t _size;
+  const codec _codec;
+  const std::string _dictionary;
 
   std::shared_ptr<io::stream> _open(std::shared_ptr<io::stream> stream);
 
  public:
-  opener(int32_t level = -1, size_t size = 0);
+  opener(int32_t level = -1,
+         size_t size = 0,
+         codec c = codec::zlib,
+         std::string dictionary = "");
   ~opener() noexcept = default;
   opener(const opener&) = delete;
   opener& operator=(const opener&) = delete;
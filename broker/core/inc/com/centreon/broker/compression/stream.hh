@@ -25,6 +25,18 @@
 namespace com::centreon::broker {
 
 namespace compression {
+class zstd;
+
+/**
+ *  Compression algorithms. The value is stored in the four high bits of the
+ *  size of each compressed chunk, so a stream reads chunks of any codec. zlib
+ *  is 0 to keep the chunks written by older versions readable.
+ */
+enum class codec : uint8_t { zlib = 0, zstd = 1, lz4 = 2 };
+
+bool parse_codec(std::string_view name, codec* c);
+const char* codec_name(codec c);
+
 /**
  *  @class stream stream.hh "com/centreon/broker/compression/stream.hh"
  *  @brief Compression stream.
@@ -33,23 +45,40 @@ namespace compression {
  */
 class stream : public io::stream {
   const int _level;
+  const codec _codec;
+  const std::string _dictionary;
+  std::unique_ptr<zstd> _zstd;
   stack_array _rbuffer;
   bool _shutdown;
   size_t _size;
   std::vector<char> _wbuffer;
 
+  /* Statistics, read by the stats thread. */
+  std::atomic<uint64_t> _uncompressed_bytes;
+  std::atomic<uint64_t> _compressed_bytes;
+  std::atomic<uint64_t> _compress_ns;
+  std::atomic<uint64_t> _uncompress_ns;
+
   void _flush();
   void _get_data(int size, time_t timeout);
+  zstd& _get_zstd();
+  std::vector<char> _uncompress(codec c,
+                                unsigned char const* data,
+                                unsigned long nbytes);
 
  public:
   static size_t const max_data_size;
 
-  stream(int level = -1, size_t size = 0);
+  stream(int level = -1,
+         size_t size = 0,
+         codec c = codec::zlib,
+         const std::string& dictionary = "");
   ~stream() noexcept;
   stream(const stream&) = delete;
   stream& operator=(const stream&) = delete;
   int32_t flush() override;
   int32_t stop() override;
+  int pending_input() const;
   bool read(std::shared_ptr<io::data>& d,
             time_t deadline = (time_t)-1) override;
   void statistics(nlohmann::json& tree) const override;
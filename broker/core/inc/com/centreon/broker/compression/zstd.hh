@@ -0,0 +1,60 @@
+/**
+ * Copyright 2023 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+#ifndef CCB_COMPRESSION_ZSTD_HH
+#define CCB_COMPRESSION_ZSTD_HH
+
+struct ZSTD_CCtx_s;
+struct ZSTD_DCtx_s;
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
+namespace com::centreon::broker::compression {
+/**
+ *  @class zstd zstd.hh "com/centreon/broker/compression/zstd.hh"
+ *  @brief Binding around the zstd library.
+ *
+ *  Compress and uncompress data. Contexts are kept from one call to the
+ *  other, so an object must not be used by several threads at the same time.
+ *
+ *  An optional dictionary (made for example with `zstd --train` on BBDO
+ *  events) improves a lot the ratio of small buffers, the peer must use the
+ *  same one. Peers announce the id of their dictionary during the BBDO
+ *  negotiation and only use it if both have the same.
+ */
+class zstd {
+  const int _level;
+  ZSTD_CCtx_s* _cctx;
+  ZSTD_DCtx_s* _dctx;
+  ZSTD_CDict_s* _cdict;
+  ZSTD_DDict_s* _ddict;
+
+ public:
+  zstd(int level, const std::string& dictionary = "");
+  ~zstd() noexcept;
+  zstd(const zstd&) = delete;
+  zstd& operator=(const zstd&) = delete;
+  std::vector<char> compress(std::vector<char> const& data);
+  std::vector<char> uncompress(unsigned char const* data,
+                               unsigned long nbytes);
+
+  static std::string load_dictionary(const std::string& path);
+  static uint32_t dictionary_id(const std::string& dictionary);
+};
+}  // namespace com::centreon::broker::compression
+
+#endif  // !CCB_COMPRESSION_ZSTD_HH
@@ -47,6 +47,12 @@ class state {
   std::string _command_protocol;
   std::list<endpoint> _endpoints;
   int _event_queue_max_size;
+  uint64_t _event_queue_max_bytes = 0u;
+  uint64_t _event_queues_memory_budget = 0u;
+  std::string _queue_files_compression;
+  std::string _queue_files_engine;
+  uint32_t _queue_files_max_size = 100000000u;
+  uint32_t _queue_files_sync_interval = 0u;
   std::string _module_dir;
   std::list<std::string> _module_list;
   std::map<std::string, std::string> _params;
@@ -129,6 +135,18 @@ class state {
   std::list<endpoint> const& endpoints() const noexcept;
   void event_queue_max_size(int val) noexcept;
   int event_queue_max_size() const noexcept;
+  void event_queue_max_bytes(uint64_t val) noexcept;
+  uint64_t event_queue_max_bytes() const noexcept;
+  void event_queues_memory_budget(uint64_t val) noexcept;
+  uint64_t event_queues_memory_budget() const noexcept;
+  void queue_files_compression(const std::string& codec);
+  const std::string& queue_files_compression() const noexcept;
+  void queue_files_engine(const std::string& engine);
+  const std::string& queue_files_engine() const noexcept;
+  void queue_files_max_size(uint32_t size) noexcept;
+  uint32_t queue_files_max_size() const noexcept;
+  void queue_files_sync_interval(uint32_t interval) noexcept;
+  uint32_t queue_files_sync_interval() const noexcept;
   std::string const& module_directory() const noexcept;
   void module_directory(std::string const& dir);
   std::list<std::string>& module_list() noexcept;
@@ -49,6 +49,9 @@ class disk_accessor {
   void remove(const std::string& name);
   fd fopen(const std::string& name, const char* mode);
   void fclose(fd f);
+  ssize_t pwrite(int fildes, const void* ptr, size_t size, off_t offset);
+  ssize_t pread(int fildes, void* ptr, size_t size, off_t offset);
+  int open(const std::string& name, int flags);
 };
 }  // namespace file
 
@@ -0,0 +1,120 @@
+/**
+ * Copyright 2023 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+#ifndef CCB_FILE_SEGMENT_LOG_HH
+#define CCB_FILE_SEGMENT_LOG_HH
+
+#include "com/centreon/broker/file/splitted_file.hh"
+
+namespace com::centreon::broker::file {
+/**
+ *  @class segment_log segment_log.hh "com/centreon/broker/file/segment_log.hh"
+ *  @brief Queue file made of segments, with a reader and writers that never
+ *  wait for each other.
+ *
+ *  Segments have the same names and format as the splitter parts, so files
+ *  written by one can be read by the other. Segments are accessed with
+ *  pread()/pwrite() and their blocks are preallocated without changing their
+ *  size, so the size of a segment is always the end of its data.
+ *
+ *  Writers are serialized by a mutex the reader never takes. After each
+ *  write, they publish the write segment and its end in one atomic word, the
+ *  reader never reads past it. When the reader has read everything and
+ *  deletes the segment, it marks the word as closed, the next write then
+ *  starts a new segment. This is a compare and swap on the same word, so
+ *  a write racing with it is done again in the next segment.
+ *
+ *  On close, the position of the last consumed byte (see checkpoint()) is
+ *  saved in an index file, so that the next instance resumes reading from
+ *  there instead of the beginning of the first segment. The index is removed
+ *  as soon as it is loaded, after a crash the whole first segment is read
+ *  again.
+ *
+ *  Data can be synced to disk every sync_interval milliseconds at most.
+ */
+class segment_log : public splitted_file {
+  static constexpr uint64_t closed_flag = 1ull << 63;
+  static constexpr uint32_t header_size = 2 * sizeof(uint32_t);
+
+  const bool _auto_delete;
+  const std::string _base_path;
+  const uint32_t _max_file_size;
+  const uint32_t _sync_interval;
+
+  /* Reader side, only used by the reader. */
+  int _rfd;
+  std::atomic<int32_t> _rid;
+  std::atomic<long> _roffset;
+  int32_t _checkpoint_id;
+  long _checkpoint_offset;
+
+  /* Writer side, protected by _write_m. */
+  std::mutex _write_m;
+  int _wfd;
+  std::chrono::steady_clock::time_point _last_sync;
+
+  /* Write segment id in bits 32 to 62, its end in bits 0 to 31, bit 63 is
+   * set when the reader has closed the segment. */
+  std::atomic<uint64_t> _wpos;
+
+  static constexpr uint64_t _pos(int32_t id, uint32_t offset) noexcept {
+    return (static_cast<uint64_t>(id) << 32) | offset;
+  }
+  static constexpr int32_t _id(uint64_t pos) noexcept {
+    return static_cast<int32_t>((pos & ~closed_flag) >> 32);
+  }
+  static constexpr uint32_t _offset(uint64_t pos) noexcept {
+    return static_cast<uint32_t>(pos);
+  }
+
+  std::string _index_path() const;
+  void _load_index();
+  void _save_index();
+  void _open_read_file();
+  void _close_read_file();
+  bool _open_write_file(int32_t id);
+  void _close_write_file();
+  void _sync(bool force);
+
+ public:
+  segment_log(const std::string& path,
+              uint32_t max_file_size = 100000000u,
+              bool auto_delete = false,
+              uint32_t sync_interval = 0u);
+  ~segment_log() noexcept;
+  segment_log(const segment_log&) = delete;
+  segment_log& operator=(const segment_log&) = delete;
+  void close() override final;
+  long read(void* buffer, long max_size) override;
+  void seek(long offset,
+            fs_file::seek_whence whence = fs_file::seek_start) override;
+  long tell() override;
+  long write(void const* buffer, long size) override;
+  void flush() override;
+  void checkpoint(long unread) override;
+
+  void remove_all_files() override;
+  std::string get_file_path(int id = 0) const override;
+  int32_t get_rid() const override;
+  long get_roffset() const override;
+  int32_t get_wid() const override;
+  long get_woffset() const override;
+  size_t max_file_size() const override;
+};
+}  // namespace com::centreon::broker::file
+
+#endif  // !CCB_FILE_SEGMENT_LOG_HH
@@ -20,7 +20,7 @@
 #define CCB_FILE_STREAM_HH
 
 #include "broker.pb.h"
-#include "com/centreon/broker/file/splitter.hh"
+#include "com/centreon/broker/file/splitted_file.hh"
 #include "com/centreon/broker/io/stream.hh"
 
 namespace com::centreon::broker::file {
@@ -31,7 +31,7 @@ namespace com::centreon::broker::file {
  *  Read and write data to a stream.
  */
 class stream : public io::stream {
-  splitter _splitter;
+  std::unique_ptr<splitted_file> _splitter;
   QueueFileStats* _stats;
   std::time_t _last_stats;
   std::time_t _last_stats_perc;
@@ -46,13 +46,15 @@ class stream : public io::stream {
 
  public:
   stream(const std::string& path, QueueFileStats* s,
-         uint32_t max_file_size = 100000000u, bool auto_delete = false);
+         uint32_t max_file_size = 100000000u, bool auto_delete = false,
+         bool segmented = false, uint32_t sync_interval = 0u);
   ~stream() noexcept = default;
   stream(const stream&) = delete;
   stream& operator=(const stream&) = delete;
   std::string peer() const override;
   bool read(std::shared_ptr<io::data>& d, time_t deadline) override;
   void remove_all_files();
+  void checkpoint(long unread);
   void statistics(nlohmann::json& tree) const override;
   int32_t write(std::shared_ptr<io::data> const& d) override;
   int32_t stop() override;
@@ -31,6 +31,11 @@ namespace com::centreon::broker::io {
  */
 class data {
   const uint32_t _type;
+  /* Cache of the estimated size, 0 while not computed. */
+  mutable std::atomic<uint32_t> _estimated_size;
+
+ protected:
+  virtual uint32_t _compute_size() const;
 
  public:
   /**
@@ -65,6 +70,7 @@ class data {
   virtual void dump(std::ostream& s) const;
   virtual void dump_more_detail(std::ostream& s) const;
   virtual void dump_to_json(std::ostream& s) const;
+  uint32_t estimated_size() const;
 
   uint32_t source_id;
   uint32_t destination_id;
@@ -25,6 +25,7 @@
 
 #include "com/centreon/broker/io/data.hh"
 #include "com/centreon/broker/io/event_info.hh"
+#include "com/centreon/broker/misc/shared_perfdata.hh"
 #include "com/centreon/exceptions/msg_fmt.hh"
 
 namespace com::centreon::broker::io {
@@ -48,6 +49,8 @@ namespace com::centreon::broker::io {
  */
 class protobuf_base : public data {
   google::protobuf::Message* _msg;
+  /* Parsed perfdata, only used by events containing service perfdata. */
+  misc::shared_perfdata _perfdata;
 
  protected:
   protobuf_base(uint32_t typ, google::protobuf::Message* msg)
@@ -55,6 +58,16 @@ class protobuf_base : public data {
 
   void set_message(google::protobuf::Message* msg) { _msg = msg; }
 
+  /**
+   * @brief The estimated size of a protobuf event is the size of its
+   * serialized message plus the BBDO header.
+   *
+   * @return A size in bytes.
+   */
+  uint32_t _compute_size() const override {
+    return 16 + _msg->ByteSizeLong();
+  }
+
  public:
   enum attribute {
     always_valid = 0,
@@ -75,6 +88,15 @@ class protobuf_base : public data {
    * @return a google::protobuf::Message* pointer.
    */
   const google::protobuf::Message* msg() const { return _msg; }
+
+  /**
+   * @brief Accessor to the perfdata of this event parsed on demand, only
+   * meaningful with events containing service perfdata (pb_service and
+   * pb_service_status).
+   *
+   * @return a misc::shared_perfdata reference.
+   */
+  const misc::shared_perfdata& parsed_perfdata() const { return _perfdata; }
 };
 
 /**
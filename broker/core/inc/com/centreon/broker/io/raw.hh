@@ -54,6 +54,9 @@ class raw : public data {
     _buffer.insert(_buffer.end(), msg.begin(), msg.end());
   }
 
+ protected:
+  uint32_t _compute_size() const override { return _buffer.size(); }
+
  public:
   std::vector<char> _buffer;
 };
@@ -42,6 +42,8 @@ namespace com::centreon::broker::io {
  *  should return the number of event fully written through (taking into
  *  account any buffering, or underlayer) to the end device. If that
  *  information is not available or meaningful, it should always return '1'.
+ *  Several events can also be given at once to write(), streams able to send
+ *  them in one operation override it.
  *
  *  Behind a stream, we can have threads doing complicated things. Before
  *  destroying a stream, we have to stop all these threads correctly, to flush
@@ -70,6 +72,7 @@ class stream {
   virtual void update();
   bool validate(std::shared_ptr<io::data> const& d, std::string const& error);
   virtual int write(std::shared_ptr<data> const& d) = 0;
+  virtual int32_t write(const std::vector<std::shared_ptr<data>>& events);
   const std::string& get_name() const { return _name; }
 
   virtual bool wait_for_all_events_written(unsigned ms_timeout);
@@ -30,8 +30,9 @@ std::string exec(std::string const& cmd);
 int32_t exec_process(char const** argv, bool wait_for_completion);
 std::vector<char> from_hex(std::string const& str);
 std::string dump_filters(const multiplexing::muxer_filter& filters);
-std::list<perfdata> parse_perfdata(uint32_t host_id, uint32_t service_id,
-                                   const char* str);
+std::vector<perfdata> parse_perfdata(uint32_t host_id,
+                                     uint32_t service_id,
+                                     const char* str);
 #if DEBUG_ROBOT
 void debug(const std::string& content);
 #endif
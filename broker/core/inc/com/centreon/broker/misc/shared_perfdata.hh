@@ -0,0 +1,63 @@
+/**
+ * Copyright 2023 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CCB_MISC_SHARED_PERFDATA_HH
+#define CCB_MISC_SHARED_PERFDATA_HH
+
+#include "com/centreon/broker/misc/perfdata.hh"
+
+namespace com::centreon::broker::misc {
+/**
+ *  @class shared_perfdata shared_perfdata.hh
+ *  "com/centreon/broker/misc/shared_perfdata.hh"
+ *  @brief Perfdata of a service status event, parsed the first time a stream
+ *  asks for them and then shared by all the streams receiving this event.
+ *
+ *  Streams run in different threads, so the parsed perfdata are published
+ *  atomically. If two streams ask for them at the same time, both parse the
+ *  string and only one result is kept.
+ *
+ *  The perfdata string of the event must not be modified once they are
+ *  parsed. A copy of the event parses them again.
+ */
+class shared_perfdata {
+ public:
+  using array = std::vector<perfdata>;
+
+ private:
+  static std::atomic<uint64_t> _parsed;
+  static std::atomic<uint64_t> _reused;
+
+  mutable std::shared_ptr<const array> _perfdata;
+
+ public:
+  shared_perfdata() = default;
+  shared_perfdata(const shared_perfdata&) {}
+  shared_perfdata& operator=(const shared_perfdata& other);
+  ~shared_perfdata() noexcept = default;
+
+  std::shared_ptr<const array> get(uint32_t host_id,
+                                   uint32_t service_id,
+                                   const std::string& str) const;
+
+  static uint64_t parsed_count() noexcept;
+  static uint64_t reused_count() noexcept;
+};
+}  // namespace com::centreon::broker::misc
+
+#endif  // !CCB_MISC_SHARED_PERFDATA_HH
@@ -19,11 +19,16 @@
 #ifndef CCB_PERSISTENT_FILE_HH
 #define CCB_PERSISTENT_FILE_HH
 
+#include "com/centreon/broker/compression/stream.hh"
 #include "com/centreon/broker/file/stream.hh"
 #include "com/centreon/broker/io/stream.hh"
 
 namespace com::centreon::broker {
 
+namespace bbdo {
+class stream;
+}
+
 /**
  *  @class persistent_file persistent_file.hh
  * "com/centreon/broker/persistent_file.hh"
@@ -33,9 +38,20 @@ namespace com::centreon::broker {
  *  It uses BBDO, compression and file streams.
  */
 class persistent_file : public io::stream {
+  static std::atomic<compression::codec> _codec;
+  static std::atomic<bool> _segmented;
+  static std::atomic<uint32_t> _max_file_size;
+  static std::atomic<uint32_t> _sync_interval;
+
   std::shared_ptr<file::stream> _splitter;
+  std::shared_ptr<compression::stream> _compression;
+  std::shared_ptr<bbdo::stream> _bbdo;
 
  public:
+  static void compression_codec(compression::codec c) noexcept;
+  static void file_options(bool segmented,
+                           uint32_t max_file_size,
+                           uint32_t sync_interval) noexcept;
   persistent_file(const std::string& path, QueueFileStats* stats = nullptr);
   ~persistent_file() noexcept = default;
   persistent_file(const persistent_file&) = delete;
@@ -54,6 +54,7 @@ class center {
 
   center();
   ~center();
+  void _update_perfdata_stats();
 
  public:
   static center& instance();
@@ -64,8 +65,12 @@ class center {
   EngineStats* register_engine();
   ConflictManagerStats* register_conflict_manager();
   void unregister_muxer(const std::string& name);
-  void update_muxer(std::string name, std::string queue_file, uint32_t size,
-                    uint32_t unack);
+  void update_muxer(std::string name,
+                    std::string queue_file,
+                    uint32_t size,
+                    uint32_t unack,
+                    uint64_t memory_size,
+                    uint64_t memory_used);
   void init_queue_file(std::string muxer, std::string queue_file,
                        uint32_t max_file_size);
 
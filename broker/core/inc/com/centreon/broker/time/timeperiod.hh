@@ -20,6 +20,7 @@
 #define CCB_CORE_TIME_TIMEPERIOD_HH
 
 #include "com/centreon/broker/time/daterange.hh"
+#include "com/centreon/common/time_segments.hh"
 #include "com/centreon/broker/time/timerange.hh"
 
 namespace com::centreon::broker {
@@ -30,6 +31,10 @@ namespace time {
  *  @brief Timeperiod object.
  *
  *  The object containing a timeperiod.
+ *
+ *  Next valid and invalid times are compiled into time segments over the
+ *  eight days starting at the current day, they are compiled again the next
+ *  day or when the timeperiod changes. Other times are computed directly.
  */
 class timeperiod {
  public:
@@ -117,6 +122,17 @@ class timeperiod {
   std::string _timeperiod_name;
   std::vector<std::list<timerange> > _timeranges;
   std::string _timezone;
+
+  mutable std::mutex _compiled_m;
+  mutable time_t _compiled_next_day;
+  mutable common::time_segments _valid;
+  mutable common::time_segments _invalid;
+
+  time_t _compute_next_valid(time_t preferred_time) const;
+  time_t _compute_next_invalid(time_t preferred_time) const;
+  time_t _lookup(common::time_segments const& segments,
+                 time_t preferred_time) const;
+  void _invalidate();
 };
 }  // namespace time
 
@@ -29,6 +29,10 @@ namespace detail {
 class callback_caller;
 }  // namespace detail
 
+/* A batch of events sent by the engine to its muxers. It is shared by all the
+ * muxers and is never modified once published. */
+using event_segment = std::deque<std::shared_ptr<io::data>>;
+
 /**
  *  @class engine engine.hh "com/centreon/broker/multiplexing/engine.hh"
  *  @brief Multiplexing engine.
@@ -43,6 +47,18 @@ class callback_caller;
  *  The instance initialization/deinitialization are guarded by a mutex
  *  _load_m. It is only used for that purpose.
  *
+ *  Published events are not stored in a single queue protected by a global
+ *  mutex. They are appended to one of the _shards, each producer thread
+ *  always using the same shard. Each event receives a sequence number taken
+ *  while its shard is locked, so every shard is sorted. When events are sent
+ *  to the muxers, all the shards are drained up to the same sequence number
+ *  and merged, so muxers still receive events in the publication order.
+ *
+ *  The merged events form an event_segment shared by all the muxers. Muxers
+ *  don't copy events, they keep references to ranges of segments and their
+ *  read/ack cursors on them. A segment is freed as soon as all the muxers
+ *  have acknowledged its events.
+ *
  *  This class is the root of events dispatching. Events arrive from a stream,
  *  are transfered to a muxer and then to engine (at the root of the tree).
  *  This one then sends events to all its children. Each muxer receives
@@ -68,15 +84,29 @@ class engine {
 
   using send_to_mux_callback_type = std::function<void()>;
 
-  state _state;
+  /* Number of shards used to store published events. */
+  static constexpr size_t shards_count = 16;
+
+  struct shard {
+    std::mutex m;
+    std::deque<std::pair<uint64_t, std::shared_ptr<io::data>>> events;
+  };
+
+  /* _state can be read without lock, but it is only modified with _engine_m
+   * and all the shards locked. */
+  std::atomic<state> _state;
 
   std::unique_ptr<persistent_cache> _cache_file;
 
-  // Mutex to lock _kiew and _state
+  // Mutex to lock _retention, _muxers, _cache_file and _state changes.
   std::mutex _engine_m;
 
-  // Data queue.
-  std::deque<std::shared_ptr<io::data>> _kiew;
+  // Events read from the cache file at start, sent before the shards content.
+  event_segment _retention;
+
+  // Data queues.
+  std::array<shard, shards_count> _shards;
+  std::atomic<uint64_t> _next_seq;
 
   // Subscriber.
   std::vector<std::weak_ptr<muxer>> _muxers;
@@ -84,12 +114,20 @@ class engine {
   // Statistics.
   EngineStats* _stats;
   uint32_t _unprocessed_events;
+  std::atomic<uint64_t> _producer_stalls;
+  uint64_t _batches;
+  uint64_t _batched_events;
+  uint32_t _max_batch_size;
 
   std::atomic_bool _sending_to_subscribers;
 
   engine();
   std::string _cache_file_path() const;
   bool _send_to_subscribers(send_to_mux_callback_type&& callback);
+  shard& _lock_shard(std::unique_lock<std::mutex>& lck);
+  void _set_state(state s);
+  void _pop_queued_events(event_segment& kiew);
+  void _update_batch_stats(size_t batch_size);
 
   friend class detail::callback_caller;
 
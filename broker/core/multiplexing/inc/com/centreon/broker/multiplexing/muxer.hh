@@ -38,7 +38,17 @@ namespace com::centreon::broker::multiplexing {
  *  It works essentially with 3 methods:
  *  * publish(): only called from multiplexing::engine. The event is stored to
  * the muxer queue if it is possible, otherwise, it is written to its retention
- * file.
+ * file. The queue does not contain copies of events but the segments built by
+ * the engine. When some events of a segment are rejected by the write filter
+ * or do not fit in the queue, the kept events are gathered in a segment owned
+ * by the muxer, so that a muxer never keeps alive events it does not use.
+ *
+ *  The memory queue is limited by a number of events and by an amount of
+ * bytes, computed from the estimated serialized size of events. The memory
+ * of a segment is counted until all its events are acknowledged. All the
+ * muxers also share a global memory budget: a muxer can use more than its
+ * fair share (budget / number of muxers) while the budget is not exhausted.
+ * Otherwise, events are written to its retention file.
  *  * write(): it is called from the other side (failover or feeder) to send an
  * event to the muxer. This time, the muxer does not push it to its queue, but
  * calls the engine publisher who will publish this event to all its muxers and
@@ -53,7 +63,20 @@ class muxer : public io::stream {
   using read_handler = std::function<void()>;
 
  private:
+  /* The events of a segment not acknowledged yet, all allowed by the write
+   * filter. bytes is the estimated size of the whole segment. */
+  struct slice {
+    std::shared_ptr<const event_segment> segment;
+    uint32_t begin;
+    uint32_t end;
+    uint64_t bytes;
+  };
+
   static uint32_t _event_queue_max_size;
+  static uint64_t _event_queue_max_bytes;
+  static uint64_t _event_queues_memory_budget;
+  static std::atomic<uint64_t> _memory_used;
+  static std::atomic<uint32_t> _muxers_count;
 
   const std::string _name;
   std::shared_ptr<engine> _engine;
@@ -68,9 +91,15 @@ class muxer : public io::stream {
   std::unique_ptr<persistent_file> _file;
   std::condition_variable _cv;
   mutable std::mutex _mutex;
-  std::list<std::shared_ptr<io::data>> _events;
+  /* The ack cursor is the beginning of the first slice. The read cursor is
+   * given by _pos_slice and _pos_offset, when all the events are read,
+   * _pos_slice is equal to _events.size(). */
+  std::deque<slice> _events;
   size_t _events_size;
-  std::list<std::shared_ptr<io::data>>::iterator _pos;
+  uint64_t _events_bytes;
+  size_t _pos_slice;
+  uint32_t _pos_offset;
+  size_t _unacknowledged;
   std::time_t _last_stats;
 
   static std::mutex _running_muxers_m;
@@ -78,7 +107,13 @@ class muxer : public io::stream {
 
   void _clean();
   void _get_event_from_file(std::shared_ptr<io::data>& event);
-  void _push_to_queue(std::shared_ptr<io::data> const& event);
+  void _fill_from_file();
+  bool _queue_accepts(uint32_t count, uint64_t bytes) const noexcept;
+  void _push_to_queue(const std::shared_ptr<const event_segment>& segment,
+                      uint32_t begin,
+                      uint32_t end,
+                      uint64_t bytes);
+  const std::shared_ptr<io::data>& _read_next();
 
   void _update_stats(void) noexcept;
 
@@ -91,6 +126,11 @@ class muxer : public io::stream {
   static std::string memory_file(const std::string& name);
   static void event_queue_max_size(uint32_t max) noexcept;
   static uint32_t event_queue_max_size() noexcept;
+  static void event_queue_max_bytes(uint64_t max) noexcept;
+  static uint64_t event_queue_max_bytes() noexcept;
+  static void event_queues_memory_budget(uint64_t budget) noexcept;
+  static uint64_t event_queues_memory_budget() noexcept;
+  static uint64_t memory_used() noexcept;
 
   static std::shared_ptr<muxer> create(std::string name,
                                        const std::shared_ptr<engine>& parent,
@@ -101,7 +141,7 @@ class muxer : public io::stream {
   muxer& operator=(const muxer&) = delete;
   ~muxer() noexcept;
   void ack_events(int count);
-  void publish(const std::deque<std::shared_ptr<io::data>>& event);
+  void publish(const std::shared_ptr<const event_segment>& segment);
   bool read(std::shared_ptr<io::data>& event, time_t deadline) override;
   template <class container>
   bool read(container& to_fill, size_t max_to_read,
@@ -142,13 +182,12 @@ bool muxer::read(container& to_fill, size_t max_to_read,
   std::unique_lock<std::mutex> lock(_mutex);
 
   size_t nb_read = 0;
-  while (_pos != _events.end() && nb_read < max_to_read) {
-    to_fill.push_back(*_pos);
-    ++_pos;
+  while (_pos_slice < _events.size() && nb_read < max_to_read) {
+    to_fill.push_back(_read_next());
     ++nb_read;
   }
   // no more data => store handler to call when data will be available
-  if (_pos == _events.end()) {
+  if (_pos_slice == _events.size()) {
     _read_handler = std::move(handler);
     _update_stats();
     return false;
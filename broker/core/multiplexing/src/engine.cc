@@ -74,70 +74,107 @@ void engine::unload() {
   _instance.reset();
 }
 
+/**
+ * @brief Lock the shard used by the current thread. Each thread is given a
+ * shard the first time it publishes, shards are distributed in a round robin
+ * way. If the shard is already locked by another thread, the producer stall
+ * counter is incremented before waiting for it.
+ *
+ * @param lck The lock to fill with the shard mutex.
+ *
+ * @return A reference to the locked shard.
+ */
+engine::shard& engine::_lock_shard(std::unique_lock<std::mutex>& lck) {
+  static std::atomic<uint32_t> next_shard{0};
+  thread_local const uint32_t idx = next_shard++ % shards_count;
+  shard& retval = _shards[idx];
+  lck = std::unique_lock<std::mutex>(retval.m, std::try_to_lock);
+  if (!lck.owns_lock()) {
+    _producer_stalls.fetch_add(1, std::memory_order_relaxed);
+    lck.lock();
+  }
+  return retval;
+}
+
+/**
+ * @brief Change the engine state. All the shards are locked during the
+ * change, so a publisher holding its shard always sees a stable state.
+ * Warning: _engine_m must be locked before calling this function.
+ *
+ * @param s The new state.
+ */
+void engine::_set_state(state s) {
+  std::array<std::unique_lock<std::mutex>, shards_count> locks;
+  for (size_t i = 0; i < shards_count; ++i)
+    locks[i] = std::unique_lock<std::mutex>(_shards[i].m);
+  _state = s;
+}
+
 /**
  *  Send an event to all subscribers.
  *
  *  @param[in] e  Event to publish.
  */
 void engine::publish(const std::shared_ptr<io::data>& e) {
-  // Lock mutex.
-  bool have_to_send = false;
+  state current;
   {
-    std::lock_guard<std::mutex> lock(_engine_m);
-    switch (_state) {
-      case stopped:
-        log_v2::core()->trace("engine::publish one event to file");
-        _cache_file->add(e);
-        _unprocessed_events++;
-        break;
-      case not_started:
-        log_v2::core()->trace("engine::publish one event to queue");
-        _kiew.push_back(e);
-        break;
-      default:
-        log_v2::core()->trace("engine::publish one event to queue_");
-        _kiew.push_back(e);
-        have_to_send = true;
-        break;
+    std::unique_lock<std::mutex> lck;
+    shard& s = _lock_shard(lck);
+    current = _state;
+    if (current != stopped) {
+      log_v2::core()->trace("engine::publish one event to queue");
+      s.events.emplace_back(_next_seq++, e);
     }
   }
-  if (have_to_send) {
-    _send_to_subscribers(nullptr);
+  switch (current) {
+    case stopped: {
+      std::lock_guard<std::mutex> lock(_engine_m);
+      log_v2::core()->trace("engine::publish one event to file");
+      if (_cache_file) {
+        _cache_file->add(e);
+        _unprocessed_events++;
+      }
+    } break;
+    case running:
+      _send_to_subscribers(nullptr);
+      break;
+    default:
+      break;
   }
 }
 
 void engine::publish(const std::deque<std::shared_ptr<io::data>>& to_publish) {
-  bool have_to_send = false;
+  state current;
   {
-    std::lock_guard<std::mutex> lock(_engine_m);
-    switch (_state) {
-      case stopped:
-        log_v2::core()->trace("engine::publish {} event to file",
-                              to_publish.size());
+    std::unique_lock<std::mutex> lck;
+    shard& s = _lock_shard(lck);
+    current = _state;
+    if (current != stopped) {
+      log_v2::core()->trace("engine::publish {} event to queue",
+                            to_publish.size());
+      for (auto& e : to_publish)
+        s.events.emplace_back(_next_seq++, e);
+    }
+  }
+  switch (current) {
+    case stopped: {
+      std::lock_guard<std::mutex> lock(_engine_m);
+      log_v2::core()->trace("engine::publish {} event to file",
+                            to_publish.size());
+      if (_cache_file)
         for (auto& e : to_publish) {
           _cache_file->add(e);
           _unprocessed_events++;
         }
-        break;
-      case not_started:
-        log_v2::core()->trace("engine::publish {} event to queue",
-                              to_publish.size());
-        for (auto& e : to_publish)
-          _kiew.push_back(e);
-        break;
-      default:
-        log_v2::core()->trace("engine::publish {} event to queue_",
-                              to_publish.size());
-        for (auto& e : to_publish)
-          _kiew.push_back(e);
-        have_to_send = true;
-        break;
-    }
-  }
-  if (have_to_send) {
-    _send_to_subscribers(nullptr);
+    } break;
+    case running:
+      _send_to_subscribers(nullptr);
+      break;
+    default:
+      break;
   }
 }
+
 /**
  *  Start multiplexing. This function gets back the retention content and
  *  inserts it in front of the engine's queue. Then all this content is
@@ -150,13 +187,9 @@ void engine::start() {
     if (_state == not_started) {
       // Set writing method.
       log_v2::core()->debug("multiplexing: engine starting");
-      _state = running;
-      stats::center::instance().update(&EngineStats::set_mode, _stats,
-                                       EngineStats::RUNNING);
 
-      // Local queue.
-      std::deque<std::shared_ptr<io::data>> kiew;
-      // Get events from the cache file to the local queue.
+      // Get events from the cache file, they are sent before the events
+      // already published in the shards.
       try {
         persistent_cache cache(_cache_file_path());
         std::shared_ptr<io::data> d;
@@ -164,21 +197,16 @@ void engine::start() {
           cache.get(d);
           if (!d)
             break;
-          kiew.push_back(d);
+          _retention.push_back(d);
         }
       } catch (const std::exception& e) {
         log_v2::core()->error(
             "multiplexing: engine couldn't read cache file: {}", e.what());
       }
 
-      // Copy global event queue to local queue.
-      while (!_kiew.empty()) {
-        kiew.push_back(_kiew.front());
-        _kiew.pop_front();
-      }
-
-      // Send events queued while multiplexing was stopped.
-      _kiew = std::move(kiew);
+      _set_state(running);
+      stats::center::instance().update(&EngineStats::set_mode, _stats,
+                                       EngineStats::RUNNING);
       have_to_send = true;
     }
   }
@@ -199,25 +227,6 @@ void engine::stop() {
     // Notify hooks of multiplexing loop end.
     log_v2::core()->info("multiplexing: stopping engine");
 
-    do {
-      // Make sure that no more data is available.
-      if (!_sending_to_subscribers) {
-        log_v2::core()->info(
-            "multiplexing: sending events to muxers for the last time {} "
-            "events to send",
-            _kiew.size());
-        _sending_to_subscribers = true;
-        lock.unlock();
-        std::promise<void> promise;
-        if (_send_to_subscribers([&promise]() { promise.set_value(); })) {
-          promise.get_future().get();
-        } else {  // nothing to send or no muxer
-          break;
-        }
-        lock.lock();
-      }
-    } while (!_kiew.empty());
-
     // Open the cache file and start the transaction.
     // The cache file is used to cache all the events produced
     // while the engine is stopped. It will be replayed next time
@@ -231,10 +240,39 @@ void engine::stop() {
       _cache_file.reset();
     }
 
-    // Set writing method.
-    _state = stopped;
+    // Set writing method, from now publishers don't fill the shards anymore.
+    _set_state(stopped);
     stats::center::instance().update(&EngineStats::set_mode, _stats,
                                      EngineStats::STOPPED);
+    lock.unlock();
+
+    // Send events already queued to muxers for the last time.
+    for (;;) {
+      std::promise<void> promise;
+      if (_send_to_subscribers([&promise]() { promise.set_value(); }))
+        promise.get_future().get();
+      else if (_sending_to_subscribers)
+        /* A sending is in progress, it will be followed by another one if
+         * needed. */
+        std::this_thread::yield();
+      else  // nothing to send or no muxer
+        break;
+    }
+
+    // Events that could not be sent are kept in the cache file.
+    lock.lock();
+    event_segment kiew;
+    _pop_queued_events(kiew);
+    if (!kiew.empty()) {
+      log_v2::core()->info(
+          "multiplexing: {} events not sent to muxers written to cache file",
+          kiew.size());
+      if (_cache_file)
+        for (auto& e : kiew) {
+          _cache_file->add(e);
+          _unprocessed_events++;
+        }
+    }
   }
   log_v2::core()->debug("multiplexing: engine stopped");
   DEBUG(fmt::format("STOP engine {:p}", static_cast<void*>(this)));
@@ -281,8 +319,13 @@ void engine::unsubscribe_muxer(const muxer* subscriber) {
  */
 engine::engine()
     : _state{not_started},
+      _next_seq{0u},
       _stats{stats::center::instance().register_engine()},
       _unprocessed_events{0u},
+      _producer_stalls{0u},
+      _batches{0u},
+      _batched_events{0u},
+      _max_batch_size{0u},
       _sending_to_subscribers{false} {
   DEBUG(fmt::format("CONSTRUCTOR engine {:p}", static_cast<void*>(this)));
   stats::center::instance().update(&EngineStats::set_mode, _stats,
@@ -346,7 +389,8 @@ class callback_caller {
  * @brief
  *  Send queued events to subscribers. Since events are queued, we use a
  * strand to keep their order. But there are several muxers, so we parallelize
- * the sending of data to each. callback is called only if _kiew is not empty
+ * the sending of data to each. callback is called only if there are queued
+ * events
  * @param callback
  * @return true data sent
  * @return false nothing to sent or sent in progress
@@ -360,12 +404,16 @@ bool engine::_send_to_subscribers(send_to_mux_callback_type&& callback) {
   // now we continue and _sending_to_subscribers = true
 
   // Process all queued events.
-  std::shared_ptr<std::deque<std::shared_ptr<io::data>>> kiew;
+  std::shared_ptr<event_segment> kiew;
   std::shared_ptr<muxer> last_muxer;
   std::shared_ptr<detail::callback_caller> cb;
   {
     std::lock_guard<std::mutex> lck(_engine_m);
-    if (_muxers.empty() || _kiew.empty()) {
+    if (!_muxers.empty()) {
+      kiew = std::make_shared<event_segment>();
+      _pop_queued_events(*kiew);
+    }
+    if (!kiew || kiew->empty()) {
       // nothing to do true => _sending_to_subscribers
       bool expected = true;
       _sending_to_subscribers.compare_exchange_strong(expected, false);
@@ -374,10 +422,8 @@ bool engine::_send_to_subscribers(send_to_mux_callback_type&& callback) {
 
     log_v2::core()->trace(
         "engine::_send_to_subscribers send {} events to {} muxers",
-        _kiew.size(), _muxers.size());
+        kiew->size(), _muxers.size());
 
-    kiew = std::make_shared<std::deque<std::shared_ptr<io::data>>>();
-    std::swap(_kiew, *kiew);
     // completion object
     // it will be destroyed at the end of the scope of this function and at the
     // end of lambdas posted
@@ -396,7 +442,7 @@ bool engine::_send_to_subscribers(send_to_mux_callback_type&& callback) {
       for (auto it = _muxers.begin(); it != it_last; ++it) {
         pool::io_context().post([kiew, m = it->lock(), cb]() {
           try {
-            m->publish(*kiew);
+            m->publish(kiew);
           }  // pool threads protection
           catch (const std::exception& ex) {
             log_v2::core()->error("publish caught exception: {}", ex.what());
@@ -406,18 +452,97 @@ bool engine::_send_to_subscribers(send_to_mux_callback_type&& callback) {
         });
       }
     }
+    _update_batch_stats(kiew->size());
   }
-  stats::center::instance().update(&EngineStats::set_processed_events, _stats,
-                                   static_cast<uint32_t>(kiew->size()));
   /* The same work but by this thread for the last muxer. */
-  last_muxer->publish(*kiew);
+  last_muxer->publish(kiew);
   return true;
 }
 
+/**
+ * @brief Move the queued events into kiew. Events read from the cache file
+ * come first, then the shards are drained up to the current sequence number
+ * and merged so that events are given in their publication order. Events
+ * published during this call are left in the shards for the next call.
+ * Warning: _engine_m must be locked before calling this function.
+ *
+ * @param kiew The queue to fill.
+ */
+void engine::_pop_queued_events(event_segment& kiew) {
+  while (!_retention.empty()) {
+    kiew.push_back(std::move(_retention.front()));
+    _retention.pop_front();
+  }
+
+  /* Since sequence numbers are taken with the shard locked, all the events
+   * with a sequence number lower than last are in the shards as soon as we
+   * can lock them. */
+  const uint64_t last = _next_seq;
+  std::array<std::deque<std::pair<uint64_t, std::shared_ptr<io::data>>>,
+             shards_count>
+      runs;
+  size_t count = 0;
+  for (size_t i = 0; i < shards_count; ++i) {
+    shard& s = _shards[i];
+    std::lock_guard<std::mutex> lck(s.m);
+    if (s.events.empty())
+      continue;
+    if (s.events.back().first < last)
+      std::swap(s.events, runs[i]);
+    else {
+      while (!s.events.empty() && s.events.front().first < last) {
+        runs[i].push_back(std::move(s.events.front()));
+        s.events.pop_front();
+      }
+    }
+    count += runs[i].size();
+  }
+
+  /* Each run is sorted, we just have to merge them. */
+  for (; count > 0; --count) {
+    size_t min_idx = shards_count;
+    for (size_t i = 0; i < shards_count; ++i) {
+      if (!runs[i].empty() &&
+          (min_idx == shards_count ||
+           runs[i].front().first < runs[min_idx].front().first))
+        min_idx = i;
+    }
+    kiew.push_back(std::move(runs[min_idx].front().second));
+    runs[min_idx].pop_front();
+  }
+}
+
+/**
+ * @brief Update the engine statistics after a batch has been built.
+ * Warning: _engine_m must be locked before calling this function.
+ *
+ * @param batch_size The number of events in the batch.
+ */
+void engine::_update_batch_stats(size_t batch_size) {
+  ++_batches;
+  _batched_events += batch_size;
+  if (batch_size > _max_batch_size)
+    _max_batch_size = batch_size;
+  stats::center::instance().execute(
+      [s = _stats, size = static_cast<uint32_t>(batch_size),
+       max_size = _max_batch_size,
+       avg = static_cast<double>(_batched_events) / _batches,
+       stalls = _producer_stalls.load(std::memory_order_relaxed)] {
+        s->set_processed_events(size);
+        s->set_max_batch_size(max_size);
+        s->set_average_batch_size(avg);
+        s->set_producer_stalls(stalls);
+      });
+}
+
 /**
  *  Clear events stored in the multiplexing engine.
  */
 void engine::clear() {
   std::lock_guard<std::mutex> lck(_engine_m);
-  _kiew.clear();
+  _retention.clear();
+  for (shard& s : _shards) {
+    std::lock_guard<std::mutex> shard_lck(s.m);
+    s.events.clear();
+  }
 }
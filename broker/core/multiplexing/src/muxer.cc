@@ -53,6 +53,11 @@ void add_bench_point(bbdo::pb_bench& event,
 }
 
 uint32_t muxer::_event_queue_max_size = std::numeric_limits<uint32_t>::max();
+uint64_t muxer::_event_queue_max_bytes = std::numeric_limits<uint64_t>::max();
+uint64_t muxer::_event_queues_memory_budget =
+    std::numeric_limits<uint64_t>::max();
+std::atomic<uint64_t> muxer::_memory_used{0u};
+std::atomic<uint32_t> muxer::_muxers_count{0u};
 
 std::mutex muxer::_running_muxers_m;
 absl::flat_hash_map<std::string, std::weak_ptr<muxer>> muxer::_running_muxers;
@@ -85,12 +90,19 @@ muxer::muxer(std::string name,
       _write_filters_str{misc::dump_filters(w_filter)},
       _persistent(persistent),
       _events_size{0u},
+      _events_bytes{0u},
+      _pos_slice{0u},
+      _pos_offset{0u},
+      _unacknowledged{0u},
       _last_stats{std::time(nullptr)} {
   // Load head queue file back in memory.
   DEBUG(fmt::format("CONSTRUCTOR muxer {:p} {}", static_cast<void*>(this),
                     _name));
+  ++_muxers_count;
   std::lock_guard<std::mutex> lck(_mutex);
   if (_persistent) {
+    auto segment = std::make_shared<event_segment>();
+    uint64_t bytes = 0;
     try {
       auto mf{std::make_unique<persistent_file>(memory_file(_name), nullptr)};
       std::shared_ptr<io::data> e;
@@ -98,34 +110,28 @@ muxer::muxer(std::string name,
         e.reset();
         mf->read(e, 0);
         if (e) {
-          _events.push_back(e);
-          ++_events_size;
+          bytes += e->estimated_size();
+          segment->push_back(e);
         }
       }
     } catch (const exceptions::shutdown& e) {
       // Memory file was properly read back in memory.
       (void)e;
     }
+    if (!segment->empty())
+      _push_to_queue(segment, 0, segment->size(), bytes);
   }
 
-  _pos = _events.begin();
   // Load queue file back in memory.
   try {
     QueueFileStats* stats =
         stats::center::instance().muxer_stats(_name)->mutable_queue_file();
     _file = std::make_unique<persistent_file>(_queue_file_name, stats);
-    std::shared_ptr<io::data> e;
-    // The following do-while might read an extra event from the queue
+    // The following call might read an extra event from the queue
     // file back in memory. However this is necessary to ensure that a
     // read() operation was done on the queue file and prevent it from
     // being open in case it is empty.
-    do {
-      _get_event_from_file(e);
-      if (!e)
-        break;
-      _events.push_back(e);
-      ++_events_size;
-    } while (_events_size < event_queue_max_size());
+    _fill_from_file();
   } catch (const exceptions::shutdown& e) {
     // Queue file was entirely read back.
     (void)e;
@@ -202,6 +208,7 @@ muxer::~muxer() noexcept {
                      "Destroying muxer {}: number of events in the queue: {}",
                      _name, _events_size);
   _clean();
+  --_muxers_count;
   DEBUG(
       fmt::format("DESTRUCTOR muxer {:p} {}", static_cast<void*>(this), _name));
 }
@@ -224,31 +231,43 @@ void muxer::ack_events(int count) {
         "multiplexing: acknowledging {} events from {} event queue", count,
         _name);
     std::lock_guard<std::mutex> lock(_mutex);
-    for (int i = 0; i < count && !_events.empty(); ++i) {
-      if (_events.begin() == _pos) {
-        log_v2::core()->error(
-            "multiplexing: attempt to acknowledge "
-            "more events than available in {} event queue: {} size: {}, "
-            "requested, {} "
-            "acknowledged",
-            _name, _events_size, count, i);
+    size_t to_ack = count;
+    if (to_ack > _unacknowledged) {
+      log_v2::core()->error(
+          "multiplexing: attempt to acknowledge "
+          "more events than available in {} event queue: {} size: {}, "
+          "requested, {} "
+          "acknowledged",
+          _name, _events_size, count, _unacknowledged);
+      to_ack = _unacknowledged;
+    }
+    _unacknowledged -= to_ack;
+    _events_size -= to_ack;
+    /* The memory of a slice is released with its segment, once all its
+     * events are acknowledged. */
+    uint64_t bytes = 0;
+    while (to_ack > 0) {
+      slice& first = _events.front();
+      size_t available = first.end - first.begin;
+      if (to_ack < available) {
+        first.begin += to_ack;
         break;
       }
+      /* The whole slice is acknowledged, the read cursor is necessarily after
+       * it. */
+      to_ack -= available;
+      bytes += first.bytes;
       _events.pop_front();
-      --_events_size;
+      --_pos_slice;
     }
+    _events_bytes -= bytes;
+    _memory_used -= bytes;
     SPDLOG_LOGGER_TRACE(log_v2::core(),
                         "multiplexing: still {} events in {} event queue",
                         _events_size, _name);
 
     // Fill memory from file.
-    std::shared_ptr<io::data> e;
-    while (_events_size < event_queue_max_size()) {
-      _get_event_from_file(e);
-      if (!e)
-        break;
-      _push_to_queue(e);
-    }
+    _fill_from_file();
     _update_stats();
   } else {
     SPDLOG_LOGGER_TRACE(
@@ -294,22 +313,106 @@ uint32_t muxer::event_queue_max_size() noexcept {
 }
 
 /**
- *  Add a new event to the internal event list.
+ *  Set the maximum memory used by the event queue of each muxer.
  *
- *  @param[in] event Event to add.
+ *  @param[in] max  The size limit in bytes, 0 for no limit.
  */
-void muxer::publish(const std::deque<std::shared_ptr<io::data>>& event_queue) {
-  auto evt = event_queue.begin();
-  while (evt != event_queue.end()) {
+void muxer::event_queue_max_bytes(uint64_t max) noexcept {
+  if (!max)
+    _event_queue_max_bytes = std::numeric_limits<uint64_t>::max();
+  else
+    _event_queue_max_bytes = max;
+}
+
+/**
+ *  Get the maximum memory used by the event queue of each muxer.
+ *
+ *  @return The size limit in bytes.
+ */
+uint64_t muxer::event_queue_max_bytes() noexcept {
+  return _event_queue_max_bytes;
+}
+
+/**
+ *  Set the memory budget shared by all the muxers event queues.
+ *
+ *  @param[in] budget  The size limit in bytes, 0 for no limit.
+ */
+void muxer::event_queues_memory_budget(uint64_t budget) noexcept {
+  if (!budget)
+    _event_queues_memory_budget = std::numeric_limits<uint64_t>::max();
+  else
+    _event_queues_memory_budget = budget;
+}
+
+/**
+ *  Get the memory budget shared by all the muxers event queues.
+ *
+ *  @return The size limit in bytes.
+ */
+uint64_t muxer::event_queues_memory_budget() noexcept {
+  return _event_queues_memory_budget;
+}
+
+/**
+ *  Get the memory used by all the muxers event queues.
+ *
+ *  @return A size in bytes.
+ */
+uint64_t muxer::memory_used() noexcept {
+  return _memory_used;
+}
+
+/**
+ *  Tell if count more events of the given total size can be stored in the
+ *  memory queue. An empty queue always accepts one event, so that an event
+ *  bigger than the limits is not stuck in the retention file.
+ *  Warning: lock _mutex before using this function.
+ *
+ *  @param[in] count  Number of events to add.
+ *  @param[in] bytes  Their estimated size.
+ *
+ *  @return true if they can be stored in memory.
+ */
+bool muxer::_queue_accepts(uint32_t count, uint64_t bytes) const noexcept {
+  if (_events_size == 0 && count <= 1)
+    return true;
+  if (_events_size + count > event_queue_max_size() ||
+      _events_bytes + bytes > _event_queue_max_bytes)
+    return false;
+  if (_memory_used + bytes <= _event_queues_memory_budget)
+    return true;
+  /* The budget is exhausted, only muxers under their fair share can still
+   * grow. */
+  uint32_t count_muxers = std::max(_muxers_count.load(), 1u);
+  return _events_bytes + bytes <= _event_queues_memory_budget / count_muxers;
+}
+
+/**
+ *  Add new events to the internal event list. The events are not copied. If
+ *  the muxer keeps all the events of the segment, it shares the segment,
+ *  otherwise the events it keeps are gathered in a segment of its own.
+ *
+ *  @param[in] segment Events to add.
+ */
+void muxer::publish(const std::shared_ptr<const event_segment>& segment) {
+  const event_segment& event_queue = *segment;
+  uint32_t evt = 0;
+  const uint32_t evt_end = event_queue.size();
+  while (evt != evt_end) {
     bool at_least_one_push_to_queue = false;
     read_handler async_handler;
     {
       // we stop this first loop when mux queue is full on order to release
       // mutex to let read do his job before write to file
       std::lock_guard<std::mutex> lock(_mutex);
-      for (; evt != event_queue.end() && _events_size < event_queue_max_size();
-           ++evt) {
-        auto event = *evt;
+      /* Events allowed by the write filter and accepted in the queue from
+       * first, and their size */
+      const uint32_t first = evt;
+      uint32_t kept = 0;
+      uint64_t bytes = 0;
+      for (; evt != evt_end; ++evt) {
+        const std::shared_ptr<io::data>& event = event_queue[evt];
         if (!_write_filter.allows(event->type())) {
           SPDLOG_LOGGER_TRACE(
               log_v2::core(),
@@ -318,6 +421,12 @@ void muxer::publish(const std::deque<std::shared_ptr<io::data>>& event_queue) {
           continue;
         }
 
+        uint32_t size = event->estimated_size();
+        if (!_queue_accepts(kept + 1, bytes + size))
+          break;
+        bytes += size;
+        ++kept;
+
         if (event->type() == bbdo::pb_bench::static_type()) {
           add_bench_point(*std::static_pointer_cast<bbdo::pb_bench>(event),
                           _name, "publish");
@@ -328,12 +437,23 @@ void muxer::publish(const std::deque<std::shared_ptr<io::data>>& event_queue) {
         SPDLOG_LOGGER_TRACE(
             log_v2::core(),
             "muxer {} event of type {:x} written queue size: {}", _name,
-            event->type(), _events_size);
+            event->type(), _events_size + kept);
 
         at_least_one_push_to_queue = true;
-
-        _push_to_queue(event);
       }
+      /* A segment is only shared when all its events are kept. Otherwise the
+       * kept events are copied, so that the events this muxer does not need
+       * are not kept alive with the segment. */
+      if (kept == evt_end)
+        _push_to_queue(segment, 0, evt_end, bytes);
+      else if (kept) {
+        auto own = std::make_shared<event_segment>();
+        for (uint32_t i = first; i < evt; ++i)
+          if (_write_filter.allows(event_queue[i]->type()))
+            own->push_back(event_queue[i]);
+        _push_to_queue(own, 0, kept, bytes);
+      }
+
       if (at_least_one_push_to_queue &&
           _read_handler) {  // async handler waiting?
         async_handler = std::move(_read_handler);
@@ -344,7 +464,7 @@ void muxer::publish(const std::deque<std::shared_ptr<io::data>>& event_queue) {
       async_handler();
     }
 
-    if (evt == event_queue.end()) {
+    if (evt == evt_end) {
       std::lock_guard<std::mutex> lock(_mutex);
       _update_stats();
       return;
@@ -355,8 +475,8 @@ void muxer::publish(const std::deque<std::shared_ptr<io::data>>& event_queue) {
     }
     // nothing pushed => to file
     std::lock_guard<std::mutex> lock(_mutex);
-    for (; evt != event_queue.end(); ++evt) {
-      auto event = *evt;
+    for (; evt != evt_end; ++evt) {
+      const std::shared_ptr<io::data>& event = event_queue[evt];
       if (!_write_filter.allows(event->type())) {
         SPDLOG_LOGGER_TRACE(
             log_v2::core(),
@@ -407,7 +527,7 @@ bool muxer::read(std::shared_ptr<io::data>& event, time_t deadline) {
   std::unique_lock<std::mutex> lock(_mutex);
 
   // No data is directly available.
-  if (_pos == _events.end()) {
+  if (_pos_slice == _events.size()) {
     // Wait a while if subscriber was not shutdown.
     if ((time_t)-1 == deadline)
       _cv.wait(lock);
@@ -418,9 +538,8 @@ bool muxer::read(std::shared_ptr<io::data>& event, time_t deadline) {
       timed_out = _cv.wait_for(lock, std::chrono::seconds(deadline - now)) ==
                   std::cv_status::timeout;
     }
-    if (_pos != _events.end()) {
-      event = *_pos;
-      ++_pos;
+    if (_pos_slice < _events.size()) {
+      event = _read_next();
       if (event)
         timed_out = false;
     } else
@@ -428,8 +547,7 @@ bool muxer::read(std::shared_ptr<io::data>& event, time_t deadline) {
   }
   // Data is available, no need to wait.
   else {
-    event = *_pos;
-    ++_pos;
+    event = _read_next();
   }
 
   _update_stats();
@@ -487,7 +605,9 @@ void muxer::nack_events() {
                       "{} event queue with {} waiting events",
                       _name, _events_size);
   std::lock_guard<std::mutex> lock(_mutex);
-  _pos = _events.begin();
+  _pos_slice = 0;
+  _pos_offset = _events.empty() ? 0 : _events.front().begin;
+  _unacknowledged = 0;
   _update_stats();
 }
 
@@ -510,10 +630,10 @@ void muxer::statistics(nlohmann::json& tree) const {
   }
 
   // Unacknowledged events count.
-  int32_t count = 0;
-  for (auto it = _events.begin(); it != _pos; ++it)
-    count++;
-  tree["unacknowledged_events"] = count;
+  tree["unacknowledged_events"] = _unacknowledged;
+
+  // Memory used by the queue.
+  tree["memory_size"] = _events_bytes;
 }
 
 /**
@@ -591,9 +711,11 @@ void muxer::_clean() {
                           _events_size, memory_file(_name));
       auto mf{std::make_unique<persistent_file>(memory_file(_name), nullptr)};
       while (!_events.empty()) {
-        mf->write(_events.front());
+        const slice& first = _events.front();
+        for (uint32_t i = first.begin; i < first.end; ++i)
+          mf->write((*first.segment)[i]);
+        _events_size -= first.end - first.begin;
         _events.pop_front();
-        --_events_size;
       }
     } catch (std::exception const& e) {
       log_v2::core()->error(
@@ -603,7 +725,11 @@ void muxer::_clean() {
   }
   _events.clear();
   _events_size = 0;
-  _pos = _events.begin();
+  _memory_used -= _events_bytes;
+  _events_bytes = 0;
+  _pos_slice = 0;
+  _pos_offset = 0;
+  _unacknowledged = 0;
   _update_stats();
 }
 
@@ -657,23 +783,76 @@ std::string muxer::queue_file(std::string const& name) {
 }
 
 /**
- *  Push event to queue (_mutex is locked when this method is called).
+ *  Fill the queue with events read from the retention file until the queue
+ *  is full or the file is empty. These events are stored in a segment owned
+ *  by this muxer.
+ *  Warning: lock _mutex before using this function.
+ */
+void muxer::_fill_from_file() {
+  if (!_file || !_queue_accepts(1, 0))
+    return;
+  auto segment = std::make_shared<event_segment>();
+  uint64_t bytes = 0;
+  std::shared_ptr<io::data> e;
+  /* The size of an event is known once read, so the last one read can exceed
+   * the memory limits. */
+  do {
+    _get_event_from_file(e);
+    if (!e)
+      break;
+    bytes += e->estimated_size();
+    segment->push_back(std::move(e));
+  } while (_queue_accepts(segment->size() + 1, bytes));
+  if (!segment->empty())
+    _push_to_queue(segment, 0, segment->size(), bytes);
+}
+
+/**
+ *  Push a range of events to queue (_mutex is locked when this method is
+ *  called).
  *
- *  @param[in] event  New event.
+ *  @param[in] segment  The segment containing the events.
+ *  @param[in] begin    Index of the first event to push.
+ *  @param[in] end      Index after the last event to push.
+ *  @param[in] bytes    Estimated size of the events of the segment.
  */
-void muxer::_push_to_queue(std::shared_ptr<io::data> const& event) {
-  bool pos_has_no_more_to_read(_pos == _events.end());
-  SPDLOG_LOGGER_TRACE(log_v2::core(), "muxer {} event of type {:x} pushed",
-                      _name, event->type());
-  _events.push_back(event);
-  ++_events_size;
+void muxer::_push_to_queue(const std::shared_ptr<const event_segment>& segment,
+                           uint32_t begin,
+                           uint32_t end,
+                           uint64_t bytes) {
+  bool pos_has_no_more_to_read(_pos_slice == _events.size());
+  SPDLOG_LOGGER_TRACE(log_v2::core(), "muxer {} {} events pushed", _name,
+                      end - begin);
+  _events.push_back(slice{segment, begin, end, bytes});
+  _events_size += end - begin;
+  _events_bytes += bytes;
+  _memory_used += bytes;
 
   if (pos_has_no_more_to_read) {
-    _pos = --_events.end();
+    _pos_offset = begin;
     _cv.notify_one();
   }
 }
 
+/**
+ *  Get the event at the read cursor and move the cursor to the next one.
+ *  There must be an event to read (_mutex is locked when this method is
+ *  called).
+ *
+ *  @return The event.
+ */
+const std::shared_ptr<io::data>& muxer::_read_next() {
+  const slice& current = _events[_pos_slice];
+  const std::shared_ptr<io::data>& retval = (*current.segment)[_pos_offset];
+  ++_pos_offset;
+  ++_unacknowledged;
+  if (_pos_offset == current.end) {
+    ++_pos_slice;
+    _pos_offset = _pos_slice < _events.size() ? _events[_pos_slice].begin : 0;
+  }
+  return retval;
+}
+
 /**
  * @brief Fill statistics if it happened more than 1 second ago
  *
@@ -687,8 +866,8 @@ void muxer::_update_stats() noexcept {
      * in the capture. Then the execute() function can put them in the stats
      * object asynchronously. */
     stats::center::instance().update_muxer(
-        _name, _file ? _queue_file_name : "", _events_size,
-        std::distance(_events.begin(), _pos));
+        _name, _file ? _queue_file_name : "", _events_size, _unacknowledged,
+        _events_bytes, _memory_used);
   }
 }
 
@@ -75,6 +75,7 @@ class database_config {
   bool get_check_replication() const;
   int get_connections_count() const;
   unsigned get_max_commit_delay() const;
+  unsigned get_max_batch_rows() const;
   unsigned get_category() const;
 
   void set_type(std::string const& type);
@@ -87,6 +88,7 @@ class database_config {
   void set_connections_count(int count);
   void set_queries_per_transaction(int qpt);
   void set_check_replication(bool check_replication);
+  void set_max_batch_rows(unsigned max_batch_rows);
   void set_category(unsigned category);
 
   database_config auto_commit_conf() const;
@@ -105,6 +107,7 @@ class database_config {
   bool _check_replication;
   int _connections_count;
   unsigned _max_commit_delay;
+  unsigned _max_batch_rows;
   unsigned _category;
 };
 
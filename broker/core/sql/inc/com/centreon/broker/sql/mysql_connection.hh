@@ -54,11 +54,24 @@ using my_error = database::mysql_error;
  *
  *  A connection works with a list. Each query is pushed back on it. An internal
  *  thread pops them one by one to send to the database.
+ *
+ *  When the server supports column-wise binding, consecutive executions of the
+ *  same statement are sent with only one execution. The maximum number of
+ *  rows of such a batch is adapted to the duration of the previous executions
+ *  and limited by the max_allowed_packet of the server and by the
+ *  max_batch_rows of the database configuration. Batches are only used with
+ *  transactions (queries_per_transaction greater than 1).
  */
 class mysql_connection {
  public:
   enum connection_state { not_started, running, finished };
 
+  /* Type of a column of a batch of statements. */
+  struct column_type {
+    enum_field_types type;
+    bool is_unsigned;
+  };
+
  private:
   std::unique_ptr<std::thread> _thread;
   MYSQL* _conn;
@@ -75,6 +88,15 @@ class mysql_connection {
   std::unordered_map<uint32_t, MYSQL_STMT*> _stmt;
   std::unordered_map<uint32_t, std::string> _stmt_query;
 
+  /* Batches of statements: are they supported by the server, the maximum size
+   * of a packet accepted by the server and the current rows limit of each
+   * statement. */
+  bool _bulk_statements;
+  uint64_t _max_allowed_packet;
+  std::unordered_map<uint32_t, uint32_t> _batch_max_rows;
+  /* Upper limit of the rows count of a batch, 1 disables the batches. */
+  const uint32_t _max_batch_rows;
+
   // Mutex and condition working on start.
   std::mutex _start_m;
   std::condition_variable _start_condition;
@@ -126,6 +148,19 @@ class mysql_connection {
   void _commit(database::mysql_task* t);
   void _prepare(database::mysql_task* t);
   void _statement(database::mysql_task* t);
+  int _execute_statement(MYSQL_STMT* stmt,
+                         uint32_t statement_id,
+                         my_error::code ec);
+  size_t _batch_size(
+      const std::list<std::unique_ptr<database::mysql_task>>& tasks_list,
+      std::vector<column_type>& types);
+  void _statement_batch(
+      const std::list<std::unique_ptr<database::mysql_task>>& tasks_list,
+      size_t count,
+      const std::vector<column_type>& types);
+  void _adapt_batch_max_rows(uint32_t statement_id,
+                             size_t count,
+                             std::chrono::steady_clock::duration duration);
   void _statement_res(database::mysql_task* t);
   template <typename T>
   void _statement_int(database::mysql_task* t);
@@ -45,7 +45,8 @@ namespace sql {
  * * stmt_span: this class looks like query_span but stores the statement id,
  *   the content of the query, the number of lines (important for bulk
  *   statements). At its destruction, it stacks data into a little struct
- *   stat_statement.
+ *   stat_statement and counts the execution in the batch histogram of the
+ *   statement.
  * * loop_span: it looks like the two previous one. When it is intanciated,
  *   it stores a start time, but the span is considered as inactive. There is
  *   a method start_activity() to set loop_span in active state. At its
@@ -122,6 +123,7 @@ class stats {
                     end_time - _start_time)
                     .count() /
                 1000.0f;
+      _parent->_add_batch(_statement_id, _query, _rows_count);
       if (s > 0) {
         stat_statement ss{
             .statement_query = std::move(_query),
@@ -199,6 +201,18 @@ class stats {
     uint32_t rows_count;
   };
 
+ public:
+  /* Number of buckets of a batch histogram. Bucket i counts the executions
+   * of 2^i to 2^(i+1) - 1 rows, the last one counts all the bigger ones. */
+  static constexpr uint32_t batch_buckets = 13;
+
+  struct stat_batch {
+    std::string statement_query;
+    uint32_t max_rows;
+    std::array<uint64_t, batch_buckets> rows_histogram;
+  };
+
+ private:
   /* Stats for queries */
   std::vector<stat_query> _stat_query;
   boost::circular_buffer<float> _query_duration;
@@ -207,9 +221,16 @@ class stats {
   boost::circular_buffer<float> _stmt_duration;
   std::vector<stat_statement> _stat_stmt;
 
+  /* Rows count of the statements executions, by statement id */
+  std::unordered_map<uint32_t, stat_batch> _batch;
+
   /* Stats for the connection loop */
   boost::circular_buffer<loop> _loop;
 
+  void _add_batch(uint32_t statement_id,
+                  const std::string& query,
+                  uint32_t rows_count);
+
  public:
   stats() : _query_duration(20), _stmt_duration(20), _loop(20) {}
   const std::vector<stat_query>& get_stat_query() const;
@@ -217,6 +238,8 @@ class stats {
   const std::vector<stat_statement>& get_stat_stmt() const;
   float average_stmt_duration() const;
   loop average_loop() const;
+  const std::unordered_map<uint32_t, stat_batch>& get_stat_batch() const;
+  void set_batch_max_rows(uint32_t statement_id, uint32_t max_rows);
 };
 
 }  // namespace sql
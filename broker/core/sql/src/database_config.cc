@@ -24,6 +24,9 @@
 
 using namespace com::centreon::broker;
 
+/* Default maximum number of rows sent with one execution of a statement. */
+constexpr unsigned DEFAULT_MAX_BATCH_ROWS = 128;
+
 namespace com::centreon::broker {
 std::ostream& operator<<(std::ostream& s, const database_config cfg) {
   s << cfg.get_type() << ": " << cfg.get_user() << '@';
@@ -35,7 +38,8 @@ std::ostream& operator<<(std::ostream& s, const database_config cfg) {
   s << "queries per transaction:" << cfg.get_queries_per_transaction()
     << " check replication:" << cfg.get_check_replication()
     << " connnexion count:" << cfg.get_connections_count()
-    << " max comit delay:" << cfg.get_max_commit_delay() << 's';
+    << " max comit delay:" << cfg.get_max_commit_delay() << 's'
+    << " max batch rows:" << cfg.get_max_batch_rows();
   return s;
 }
 
@@ -48,6 +52,7 @@ database_config::database_config()
     : _queries_per_transaction(1),
       _check_replication(true),
       _connections_count(1),
+      _max_batch_rows(DEFAULT_MAX_BATCH_ROWS),
       _category(SHARED) {}
 
 /**
@@ -89,6 +94,7 @@ database_config::database_config(const std::string& type,
       _check_replication(check_replication),
       _connections_count(connections_count),
       _max_commit_delay(max_commit_delay),
+      _max_batch_rows(DEFAULT_MAX_BATCH_ROWS),
       _category(SHARED) {}
 
 /**
@@ -208,6 +214,19 @@ database_config::database_config(config::endpoint const& cfg) {
     }
   } else
     _max_commit_delay = 5;
+
+  // max_batch_rows
+  it = cfg.params.find("max_batch_rows");
+  if (it != end) {
+    if (!absl::SimpleAtoi(it->second, &_max_batch_rows)) {
+      log_v2::core()->error(
+          "max_batch_rows is a string containing an integer. If not "
+          "specified, it will be considered as \"{}\".",
+          DEFAULT_MAX_BATCH_ROWS);
+      _max_batch_rows = DEFAULT_MAX_BATCH_ROWS;
+    }
+  } else
+    _max_batch_rows = DEFAULT_MAX_BATCH_ROWS;
 }
 
 /**
@@ -252,7 +271,8 @@ bool database_config::operator==(database_config const& other) const {
                 _name == other._name &&
                 _queries_per_transaction == other._queries_per_transaction &&
                 _connections_count == other._connections_count &&
-                _max_commit_delay == other._max_commit_delay};
+                _max_commit_delay == other._max_commit_delay &&
+                _max_batch_rows == other._max_batch_rows};
     if (!retval) {
       if (_type != other._type)
         log_v2::sql()->debug(
@@ -304,6 +324,11 @@ bool database_config::operator==(database_config const& other) const {
             "database configurations do not match because of their commit "
             "delay: {} != {}",
             _max_commit_delay, other._max_commit_delay);
+      else if (_max_batch_rows != other._max_batch_rows)
+        log_v2::sql()->debug(
+            "database configurations do not match because of their max batch "
+            "rows: {} != {}",
+            _max_batch_rows, other._max_batch_rows);
       return false;
     }
   }
@@ -420,6 +445,16 @@ unsigned database_config::get_max_commit_delay() const {
   return _max_commit_delay;
 }
 
+/**
+ * @brief get the maximum number of rows sent with one execution of a
+ * statement, 1 disables the batches.
+ *
+ * @return unsigned the rows count
+ */
+unsigned database_config::get_max_batch_rows() const {
+  return _max_batch_rows;
+}
+
 /**
  * @brief get_category
  * mysql_manager try to factorise mysql connections and share the same
@@ -525,6 +560,15 @@ void database_config::set_check_replication(bool check_replication) {
   _check_replication = check_replication;
 }
 
+/**
+ *  Set the maximum number of rows sent with one execution of a statement.
+ *
+ *  @param[in] max_batch_rows  Rows count, 1 disables the batches.
+ */
+void database_config::set_max_batch_rows(unsigned max_batch_rows) {
+  _max_batch_rows = max_batch_rows;
+}
+
 /**
  *  Set the category of the connections (connections in mysql_manager aren't
  * shared if cfg have different category).
@@ -552,6 +596,7 @@ void database_config::_internal_copy(database_config const& other) {
   _check_replication = other._check_replication;
   _connections_count = other._connections_count;
   _max_commit_delay = other._max_commit_delay;
+  _max_batch_rows = other._max_batch_rows;
 }
 
 /**
@@ -31,6 +31,12 @@ constexpr const char* mysql_error::msg[];
 
 const int MAX_ATTEMPTS = 2;
 
+/* Rows limit of a new statement batch. */
+constexpr uint32_t BATCH_INITIAL_ROWS = 16;
+/* The rows limit of a statement is halved when an execution lasts more than
+ * this duration and doubled when a full batch lasts less than its half. */
+constexpr std::chrono::milliseconds BATCH_TARGET_DURATION(200);
+
 void (mysql_connection::*const mysql_connection::_task_processing_table[])(
     mysql_task* task) = {
     &mysql_connection::_query,
@@ -82,6 +88,23 @@ void mysql_connection::_prepare_connection() {
   uint32_t timeout = 5;
   mysql_optionsv(_conn, MYSQL_OPT_READ_TIMEOUT, (void*)&timeout);
 
+  /* Batches of statements use column-wise binding, available since MariaDB
+   * 10.2. A batch must fit in a packet accepted by the server. */
+  _bulk_statements =
+      mariadb_connection(_conn) && mysql_get_server_version(_conn) >= 100200;
+  _max_allowed_packet = 0;
+  if (_bulk_statements && !mysql_query(_conn, "SELECT @@max_allowed_packet")) {
+    MYSQL_RES* res = mysql_store_result(_conn);
+    if (res) {
+      MYSQL_ROW row = mysql_fetch_row(res);
+      if (row && row[0])
+        _max_allowed_packet = strtoull(row[0], nullptr, 10);
+      mysql_free_result(res);
+    }
+  }
+  if (_max_allowed_packet == 0)
+    _max_allowed_packet = 4 * 1024 * 1024;
+
   if (_qps > 1)
     mysql_autocommit(_conn, 0);
   else
@@ -152,10 +175,24 @@ void mysql_connection::_update_stats() noexcept {
           sq->set_start_time(l_sq.start_time);
           sq->set_query(l_sq.query);
         }
+
+        _proto_stats->clear_batches();
+        auto& sb = _stats.get_stat_batch();
+        _proto_stats->mutable_batches()->Reserve(sb.size());
+        for (auto& l_sb : sb) {
+          auto* sb = _proto_stats->add_batches();
+          sb->set_statement_id(l_sb.first);
+          sb->set_statement_query(l_sb.second.statement_query);
+          sb->set_max_rows(l_sb.second.max_rows);
+          sb->mutable_rows_histogram()->Add(
+              l_sb.second.rows_histogram.begin(),
+              l_sb.second.rows_histogram.end());
+        }
       } else {
         _proto_stats->set_down_since(_switch_point);
         _proto_stats->clear_slowest_statements();
         _proto_stats->clear_slowest_queries();
+        _proto_stats->clear_batches();
         _proto_stats->set_average_statement_duration(0);
         _proto_stats->set_average_query_duration(0);
       }
@@ -450,70 +487,388 @@ void mysql_connection::_statement(mysql_task* t) {
         log_v2::sql(),
         "mysql_connection: Error while binding values in statement: {}",
         ::mysql_stmt_error(stmt));
-  } else {
-    int32_t attempts = 0;
-    std::chrono::system_clock::time_point request_begin =
-        std::chrono::system_clock::now();
-    for (;;) {
-      SPDLOG_LOGGER_TRACE(
-          log_v2::sql(),
-          "mysql_connection {:p}: execute statement {} attempt {}: {}",
-          static_cast<const void*>(this), task->statement_id, attempts, query);
-      if (mysql_stmt_execute(stmt)) {
-        std::string err_msg(
-            fmt::format("{} errno={} {}", mysql_error::msg[task->error_code],
-                        ::mysql_errno(_conn), ::mysql_stmt_error(stmt)));
-        SPDLOG_LOGGER_ERROR(log_v2::sql(),
-                            "connection fail to execute statement {:p}: {}",
-                            static_cast<const void*>(this), err_msg);
+  } else
+    _execute_statement(stmt, task->statement_id, task->error_code);
+}
+
+/**
+ * @brief Execute a prepared statement whose parameters are already bound. On
+ * deadlock, the execution is tried again.
+ *
+ * @param stmt The statement.
+ * @param statement_id Its id.
+ * @param ec The error code to use in the error message.
+ *
+ * @return 0 on success, 1 if the execution failed and -1 if the server is in
+ * error, in that case the connection is also in error.
+ */
+int mysql_connection::_execute_statement(MYSQL_STMT* stmt,
+                                         uint32_t statement_id,
+                                         my_error::code ec) {
+  int retval = 1;
+  const std::string& query = _stmt_query[statement_id];
+  int32_t attempts = 0;
+  std::chrono::system_clock::time_point request_begin =
+      std::chrono::system_clock::now();
+  for (;;) {
+    SPDLOG_LOGGER_TRACE(
+        log_v2::sql(),
+        "mysql_connection {:p}: execute statement {} attempt {}: {}",
+        static_cast<const void*>(this), statement_id, attempts, query);
+    if (mysql_stmt_execute(stmt)) {
+      std::string err_msg(fmt::format("{} errno={} {}", mysql_error::msg[ec],
+                                      ::mysql_errno(_conn),
+                                      ::mysql_stmt_error(stmt)));
+      SPDLOG_LOGGER_ERROR(log_v2::sql(),
+                          "connection fail to execute statement {:p}: {}",
+                          static_cast<const void*>(this), err_msg);
+      if (_server_error(::mysql_stmt_errno(stmt))) {
+        set_error_message(err_msg);
+        retval = -1;
+        break;
+      }
+      if (mysql_stmt_errno(stmt) != 1213 &&
+          mysql_stmt_errno(stmt) != 1205)  // Dead Lock error
+        attempts = MAX_ATTEMPTS;
+
+      if (mysql_commit(_conn)) {
+        SPDLOG_LOGGER_ERROR(
+            log_v2::sql(),
+            "connection fail commit after execute statement failure {:p}",
+            static_cast<const void*>(this));
+        set_error_message("Commit failed after execute statement");
+        retval = -1;
+        break;
+      }
+
+      SPDLOG_LOGGER_ERROR(log_v2::sql(),
+                          "mysql_connection {:p} attempts {}: {}",
+                          static_cast<const void*>(this), attempts, err_msg);
+      if (++attempts >= MAX_ATTEMPTS) {
         if (_server_error(::mysql_stmt_errno(stmt))) {
-          set_error_message(err_msg);
-          break;
+          set_error_message("{} {}", mysql_error::msg[ec],
+                            ::mysql_stmt_error(stmt));
+          retval = -1;
         }
-        if (mysql_stmt_errno(stmt) != 1213 &&
-            mysql_stmt_errno(stmt) != 1205)  // Dead Lock error
-          attempts = MAX_ATTEMPTS;
+        break;
+      }
+    } else {
+      SPDLOG_LOGGER_TRACE(log_v2::sql(),
+                          "mysql_connection {:p}: success execute statement "
+                          "{} attempt {}",
+                          static_cast<const void*>(this), statement_id,
+                          attempts);
+      _last_access = time(nullptr);
+      set_need_to_commit();
+      retval = 0;
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  }
+  SPDLOG_LOGGER_TRACE(log_v2::sql(),
+                      "mysql_connection {:p}: end execute statement "
+                      "{} attempt {} duration {}s: {}",
+                      static_cast<const void*>(this), statement_id, attempts,
+                      std::chrono::duration_cast<std::chrono::seconds>(
+                          std::chrono::system_clock::now() - request_begin)
+                          .count(),
+                      query);
+  return retval;
+}
 
-        if (mysql_commit(_conn)) {
-          SPDLOG_LOGGER_ERROR(
-              log_v2::sql(),
-              "connection fail commit after execute statement failure {:p}",
-              static_cast<const void*>(this));
-          set_error_message("Commit failed after execute statement");
+/**
+ * @brief Count the tasks at the beginning of tasks_list that can be sent to
+ * the database with only one execution: executions without result of the
+ * same statement with compatible types of values. The count is limited by
+ * the rows limit of the statement and by the max_allowed_packet of the
+ * server.
+ *
+ * @param tasks_list The tasks to execute, the first one is a STATEMENT.
+ * @param types Filled with the types of the columns of the batch. Columns
+ * only containing NULL values are of type MYSQL_TYPE_NULL.
+ *
+ * @return The number of tasks of the batch, at least 1.
+ */
+size_t mysql_connection::_batch_size(
+    const std::list<std::unique_ptr<database::mysql_task>>& tasks_list,
+    std::vector<column_type>& types) {
+  auto* first = static_cast<mysql_task_statement*>(tasks_list.front().get());
+  if (!_bulk_statements || _qps <= 1 || first->bulk || !first->bind ||
+      first->param_count <= 0)
+    return 1;
+
+  uint32_t max_rows = _max_batch_rows;
+  auto found = _batch_max_rows.find(first->statement_id);
+  max_rows = std::min(max_rows, found == _batch_max_rows.end()
+                                    ? BATCH_INITIAL_ROWS
+                                    : found->second);
+  if (max_rows <= 1)
+    return 1;
+
+  /* The packet also contains the statement id and its parameters types. */
+  const uint64_t max_bytes = _max_allowed_packet / 2;
+  uint64_t bytes = 0;
+  types.assign(first->param_count, column_type{MYSQL_TYPE_NULL, false});
+  size_t retval = 0;
+  for (auto it = tasks_list.begin();
+       it != tasks_list.end() && retval < max_rows; ++it) {
+    if ((*it)->type != mysql_task::STATEMENT)
+      break;
+    auto* task = static_cast<mysql_task_statement*>(it->get());
+    if (task->statement_id != first->statement_id || task->bulk ||
+        !task->bind)
+      break;
+    const MYSQL_BIND* bind = task->bind->get_bind();
+    bool compatible = true;
+    for (int i = 0; compatible && i < first->param_count; ++i) {
+      /* One byte for the indicator of each value. */
+      ++bytes;
+      switch (bind[i].buffer_type) {
+        case MYSQL_TYPE_NULL:
+          continue;
+        case MYSQL_TYPE_STRING:
+          bytes += bind[i].buffer_length + 9;
           break;
-        }
-
-        SPDLOG_LOGGER_ERROR(log_v2::sql(),
-                            "mysql_connection {:p} attempts {}: {}",
-                            static_cast<const void*>(this), attempts, err_msg);
-        if (++attempts >= MAX_ATTEMPTS) {
-          if (_server_error(::mysql_stmt_errno(stmt)))
-            set_error_message("{} {}", mysql_error::msg[task->error_code],
-                              ::mysql_stmt_error(stmt));
+        case MYSQL_TYPE_LONG:
+        case MYSQL_TYPE_LONGLONG:
+        case MYSQL_TYPE_FLOAT:
+        case MYSQL_TYPE_DOUBLE:
+        case MYSQL_TYPE_TINY:
+          bytes += 8;
           break;
-        }
+        default:
+          compatible = false;
+          continue;
+      }
+      const bool is_unsigned = bind[i].is_unsigned;
+      if (types[i].type == MYSQL_TYPE_NULL)
+        types[i] = {bind[i].buffer_type, is_unsigned};
+      else if (types[i].type != bind[i].buffer_type ||
+               types[i].is_unsigned != is_unsigned)
+        compatible = false;
+    }
+    if (!compatible || (retval > 0 && bytes > max_bytes))
+      break;
+    ++retval;
+  }
+  return std::max(retval, size_t(1));
+}
+
+/**
+ * @brief Copy a value of a statement bind into the current row of a bulk
+ * bind.
+ *
+ * @param bulk The bulk bind.
+ * @param range The index of the column.
+ * @param value The value to copy.
+ * @param type The type of the column.
+ */
+static void copy_value(mysql_bulk_bind& bulk,
+                       size_t range,
+                       const MYSQL_BIND& value,
+                       const mysql_connection::column_type& type) {
+  const bool null = value.buffer_type == MYSQL_TYPE_NULL;
+  switch (type.type) {
+    case MYSQL_TYPE_LONG:
+      if (type.is_unsigned) {
+        if (null)
+          bulk.set_null_u32(range);
+        else
+          bulk.set_value_as_u32(range,
+                                *static_cast<const uint32_t*>(value.buffer));
       } else {
-        SPDLOG_LOGGER_TRACE(log_v2::sql(),
-                            "mysql_connection {:p}: success execute statement "
-                            "{} attempt {}",
-                            static_cast<const void*>(this), task->statement_id,
-                            _stmt_query[task->statement_id]);
-        _last_access = time(nullptr);
-        set_need_to_commit();
-        break;
+        if (null)
+          bulk.set_null_i32(range);
+        else
+          bulk.set_value_as_i32(range,
+                                *static_cast<const int32_t*>(value.buffer));
       }
-      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      break;
+    case MYSQL_TYPE_LONGLONG:
+      if (type.is_unsigned) {
+        if (null)
+          bulk.set_null_u64(range);
+        else
+          bulk.set_value_as_u64(range,
+                                *static_cast<const uint64_t*>(value.buffer));
+      } else {
+        if (null)
+          bulk.set_null_i64(range);
+        else
+          bulk.set_value_as_i64(range,
+                                *static_cast<const int64_t*>(value.buffer));
+      }
+      break;
+    case MYSQL_TYPE_FLOAT:
+      if (null)
+        bulk.set_null_f32(range);
+      else
+        bulk.set_value_as_f32(range, *static_cast<const float*>(value.buffer));
+      break;
+    case MYSQL_TYPE_DOUBLE:
+      if (null)
+        bulk.set_null_f64(range);
+      else
+        bulk.set_value_as_f64(range, *static_cast<const double*>(value.buffer));
+      break;
+    case MYSQL_TYPE_STRING:
+      if (null)
+        bulk.set_null_str(range);
+      else
+        bulk.set_value_as_str(
+            range, fmt::string_view(static_cast<const char*>(value.buffer),
+                                    value.buffer_length));
+      break;
+    case MYSQL_TYPE_TINY:
+      if (null)
+        bulk.set_null_tiny(range);
+      else
+        bulk.set_value_as_tiny(range, *static_cast<const char*>(value.buffer));
+      break;
+    default:
+      /* The column only contains NULL values */
+      bulk.set_null_i32(range);
+      break;
+  }
+}
+
+/**
+ * @brief Execute the first count tasks of tasks_list, executions of the same
+ * statement, with only one execution using column-wise binding. If this
+ * execution fails, the rows it applied are rolled back to a savepoint and
+ * the tasks are executed one by one so that only the wrong ones are lost.
+ *
+ * @param tasks_list The tasks to execute.
+ * @param count The number of tasks of the batch, computed by _batch_size().
+ * @param types The types of the columns, computed by _batch_size().
+ */
+void mysql_connection::_statement_batch(
+    const std::list<std::unique_ptr<database::mysql_task>>& tasks_list,
+    size_t count,
+    const std::vector<column_type>& types) {
+  auto* first = static_cast<mysql_task_statement*>(tasks_list.front().get());
+  const uint32_t statement_id = first->statement_id;
+  MYSQL_STMT* stmt(_stmt[statement_id]);
+  if (!stmt) {
+    SPDLOG_LOGGER_ERROR(log_v2::sql(),
+                        "mysql_connection: no statement to execute");
+    set_error_message("statement {} not prepared", statement_id);
+    return;
+  }
+
+  mysql_bulk_bind bind(first->param_count, count);
+  auto it = tasks_list.begin();
+  for (size_t row = 0; row < count; ++row, ++it) {
+    const MYSQL_BIND* values =
+        static_cast<mysql_task_statement*>(it->get())->bind->get_bind();
+    for (size_t i = 0; i < types.size(); ++i)
+      copy_value(bind, i, values[i], types[i]);
+    bind.next_row();
+  }
+
+  /* Rows applied before a failure of the batch are cancelled by going back
+   * to this savepoint, so that they are not applied twice when the rows are
+   * executed one by one. */
+  if (mysql_query(_conn, "SAVEPOINT centreon_batch")) {
+    SPDLOG_LOGGER_ERROR(
+        log_v2::sql(),
+        "mysql_connection {:p}: unable to set a savepoint before a batch of "
+        "statement {}: {}",
+        static_cast<const void*>(this), statement_id, ::mysql_error(_conn));
+    if (_server_error(::mysql_errno(_conn))) {
+      set_error_message("{} {}", mysql_error::msg[first->error_code],
+                        ::mysql_error(_conn));
+      return;
     }
-    SPDLOG_LOGGER_TRACE(log_v2::sql(),
-                        "mysql_connection {:p}: end execute statement "
-                        "{} attempt {} duration {}s: {}",
-                        static_cast<const void*>(this), task->statement_id,
-                        attempts,
-                        std::chrono::duration_cast<std::chrono::seconds>(
-                            std::chrono::system_clock::now() - request_begin)
-                            .count(),
-                        _stmt_query[task->statement_id]);
+    it = tasks_list.begin();
+    for (size_t row = 0; row < count && !_error.is_active(); ++row, ++it)
+      _statement(it->get());
+    return;
   }
+
+  int res;
+  {
+    SPDLOG_LOGGER_DEBUG(log_v2::sql(),
+                        "mysql_connection {:p}: execute statement {} with a "
+                        "batch of {} rows",
+                        static_cast<const void*>(this), statement_id, count);
+    sql::stats::stmt_span stats(&_stats, statement_id,
+                                _stmt_query[statement_id]);
+    uint32_t array_size = count;
+    stats.set_rows_count(array_size);
+    auto begin = std::chrono::steady_clock::now();
+    mysql_stmt_attr_set(stmt, STMT_ATTR_ARRAY_SIZE, &array_size);
+    if (mysql_stmt_bind_param(stmt, bind.get_bind())) {
+      SPDLOG_LOGGER_ERROR(
+          log_v2::sql(),
+          "mysql_connection: Error while binding values in statement: {}",
+          ::mysql_stmt_error(stmt));
+      res = 1;
+    } else if (mysql_stmt_execute(stmt)) {
+      SPDLOG_LOGGER_ERROR(
+          log_v2::sql(),
+          "mysql_connection {:p}: fail to execute a batch of statement {}: "
+          "errno={} {}",
+          static_cast<const void*>(this), statement_id,
+          ::mysql_stmt_errno(stmt), ::mysql_stmt_error(stmt));
+      if (_server_error(::mysql_stmt_errno(stmt))) {
+        set_error_message("{} errno={} {}", mysql_error::msg[first->error_code],
+                          ::mysql_stmt_errno(stmt), ::mysql_stmt_error(stmt));
+        res = -1;
+      } else
+        res = 1;
+    } else {
+      _last_access = time(nullptr);
+      set_need_to_commit();
+      res = 0;
+    }
+    /* The statement is also executed without batch. */
+    array_size = 0;
+    mysql_stmt_attr_set(stmt, STMT_ATTR_ARRAY_SIZE, &array_size);
+    if (res == 0)
+      _adapt_batch_max_rows(statement_id, count,
+                            std::chrono::steady_clock::now() - begin);
+  }
+
+  if (res > 0) {
+    /* After a deadlock, the transaction and its savepoint are already rolled
+     * back. */
+    if (mysql_query(_conn, "ROLLBACK TO SAVEPOINT centreon_batch"))
+      SPDLOG_LOGGER_DEBUG(log_v2::sql(),
+                          "mysql_connection {:p}: no savepoint to roll back "
+                          "the batch to: {}",
+                          static_cast<const void*>(this), ::mysql_error(_conn));
+    SPDLOG_LOGGER_INFO(log_v2::sql(),
+                       "mysql_connection {:p}: batch of {} rows of statement "
+                       "{} failed, its rows are executed one by one",
+                       static_cast<const void*>(this), count, statement_id);
+    it = tasks_list.begin();
+    for (size_t row = 0; row < count && !_error.is_active(); ++row, ++it)
+      _statement(it->get());
+  }
+}
+
+/**
+ * @brief Adapt the rows limit of the batches of a statement to the duration
+ * of its last batch execution. The duration contains the round trip to the
+ * server, so the more the server is far, the bigger the batches are. But a
+ * batch must not block the connection too long.
+ *
+ * @param statement_id The statement id.
+ * @param count The number of rows of the last batch.
+ * @param duration The duration of its execution.
+ */
+void mysql_connection::_adapt_batch_max_rows(
+    uint32_t statement_id,
+    size_t count,
+    std::chrono::steady_clock::duration duration) {
+  uint32_t& max_rows =
+      _batch_max_rows.emplace(statement_id, BATCH_INITIAL_ROWS).first->second;
+  if (duration > BATCH_TARGET_DURATION)
+    max_rows = std::max(max_rows / 2, 2u);
+  else if (count >= max_rows && duration < BATCH_TARGET_DURATION / 2)
+    max_rows = std::min(max_rows * 2, _max_batch_rows);
+  _stats.set_batch_max_rows(statement_id, max_rows);
 }
 
 void mysql_connection::_statement_res(mysql_task* t) {
@@ -972,13 +1327,23 @@ void mysql_connection::_send_exceptions_to_task_futures(
  */
 void mysql_connection::_process_tasks(
     std::list<std::unique_ptr<database::mysql_task>>& tasks_list) {
+  std::vector<column_type> types;
   while (!tasks_list.empty()) {
-    --_tasks_count;
-    _update_stats();
     database::mysql_task* task = tasks_list.begin()->get();
+    /* Consecutive executions of the same statement are sent together. */
+    size_t count = task->type == mysql_task::STATEMENT
+                       ? _batch_size(tasks_list, types)
+                       : 1;
+    _tasks_count -= static_cast<int>(count);
+    _update_stats();
 
-    if (task->type <
-        sizeof(_task_processing_table) / sizeof(_task_processing_table[0])) {
+    if (count > 1) {
+      _statement_batch(tasks_list, count, types);
+      if (time(nullptr) > _last_commit + _max_second_commit_delay) {
+        _commit(nullptr);
+      }
+    } else if (task->type < sizeof(_task_processing_table) /
+                                sizeof(_task_processing_table[0])) {
       (this->*(_task_processing_table[task->type]))(task);
       if (time(nullptr) > _last_commit + _max_second_commit_delay) {
         _commit(nullptr);
@@ -993,7 +1358,8 @@ void mysql_connection::_process_tasks(
      * success or failure. Otherwise at the call of
      * _send_exceptions_to_task_futures() the future could be set a second time
      * on case of error. */
-    tasks_list.pop_front();
+    for (; count > 0; --count)
+      tasks_list.pop_front();
     if (_error.is_active())
       return;
   }
@@ -1074,6 +1440,9 @@ mysql_connection::mysql_connection(const database_config& db_cfg,
       _tasks_count{0},
       _need_commit(false),
       _last_access{0},
+      _bulk_statements{false},
+      _max_allowed_packet{0},
+      _max_batch_rows{std::max(db_cfg.get_max_batch_rows(), 1u)},
       _host(db_cfg.get_host()),
       _socket(db_cfg.get_socket()),
       _user(db_cfg.get_user()),
@@ -1229,6 +1598,7 @@ bool mysql_connection::match_config(database_config const& db_cfg) const {
          db_cfg.get_user() == _user && db_cfg.get_password() == _pwd &&
          db_cfg.get_name() == _name && db_cfg.get_port() == _port &&
          db_cfg.get_queries_per_transaction() == _qps &&
+         std::max(db_cfg.get_max_batch_rows(), 1u) == _max_batch_rows &&
          db_cfg.get_category() == _category;
   ;
 }
@@ -48,6 +48,50 @@ float stats::average_stmt_duration() const {
   return retval;
 }
 
+/**
+ * @brief Count an execution of a statement in its batch histogram.
+ *
+ * @param statement_id The statement id.
+ * @param query The query of the statement.
+ * @param rows_count The number of rows sent with this execution.
+ */
+void stats::_add_batch(uint32_t statement_id,
+                       const std::string& query,
+                       uint32_t rows_count) {
+  auto found = _batch.find(statement_id);
+  if (found == _batch.end())
+    found = _batch.emplace(statement_id, stat_batch{query, 1, {}}).first;
+  uint32_t bucket = 0;
+  while (rows_count > 1 && bucket < batch_buckets - 1) {
+    rows_count >>= 1;
+    ++bucket;
+  }
+  ++found->second.rows_histogram[bucket];
+}
+
+/**
+ * @brief Accessor to the batch histograms of the statements.
+ *
+ * @return a map of stat_batch indexed by statement id.
+ */
+const std::unordered_map<uint32_t, stats::stat_batch>& stats::get_stat_batch()
+    const {
+  return _batch;
+}
+
+/**
+ * @brief Set the current maximum number of rows sent with one execution of
+ * a statement.
+ *
+ * @param statement_id The statement id.
+ * @param max_rows The maximum number of rows.
+ */
+void stats::set_batch_max_rows(uint32_t statement_id, uint32_t max_rows) {
+  auto found = _batch.find(statement_id);
+  if (found != _batch.end())
+    found->second.max_rows = max_rows;
+}
+
 /**
  * @brief Returns two averages:
  * * the average duration of a loop in seconds.
@@ -21,6 +21,7 @@
 #include "com/centreon/broker/bbdo/acceptor.hh"
 #include "com/centreon/broker/bbdo/connector.hh"
 #include "com/centreon/broker/bbdo/factory.hh"
+#include "com/centreon/broker/bbdo/internal.hh"
 #include "com/centreon/broker/config/applier/state.hh"
 #include "com/centreon/broker/config/parser.hh"
 #include "com/centreon/broker/io/protocols.hh"
@@ -185,6 +186,10 @@ io::endpoint* factory::new_endpoint(
  *  * the first one contains all the extensions supported by the endpoint.
  *  * the second one contains the mandatory extensions. This one is needed
  *    to report errors.
+ *  When the 'header_checksum' parameter is set to 'no', the NOCRC extension
+ *  is also proposed to the peer. It should only be used on trusted links
+ *  (local or encrypted by TLS), since it disables the checksums of BBDO
+ *  headers.
  *
  *  @param[in] cfg  Endpoint configuration.
  *
@@ -205,5 +210,18 @@ std::list<std::shared_ptr<io::extension>> factory::_extensions(
       retval.push_back(ext);
     }
   }
+
+  auto it = cfg.params.find("header_checksum");
+  if (it != cfg.params.end()) {
+    bool header_checksum;
+    if (!absl::SimpleAtob(it->second, &header_checksum))
+      log_v2::bbdo()->error(
+          "BBDO: cannot parse the 'header_checksum' boolean: its content is "
+          "'{}'",
+          it->second);
+    else if (!header_checksum)
+      retval.push_back(std::make_shared<io::extension>(
+          BBDO_NO_CHECKSUM_EXTENSION, true, false));
+  }
   return retval;
 }
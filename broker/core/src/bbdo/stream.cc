@@ -18,6 +18,8 @@
 
 #include "com/centreon/broker/bbdo/stream.hh"
 
+#include <absl/strings/ascii.h>
+#include <absl/strings/str_cat.h>
 #include <absl/strings/str_split.h>
 #include <arpa/inet.h>
 
@@ -28,6 +30,8 @@
 #include "bbdo/bbdo/stop.hh"
 #include "bbdo/bbdo/version_response.hh"
 #include "com/centreon/broker/bbdo/internal.hh"
+#include "com/centreon/broker/compression/stream.hh"
+#include "com/centreon/broker/compression/zstd.hh"
 #include "com/centreon/broker/config/applier/state.hh"
 #include "com/centreon/broker/exceptions/timeout.hh"
 #include "com/centreon/broker/io/protocols.hh"
@@ -344,9 +348,8 @@ static io::data* unserialize(uint32_t event_type,
  */
 static void get_boolean(io::data const& t,
                         mapping::entry const& member,
-                        std::vector<char>& buffer) {
-  char c(member.get_bool(t) ? 1 : 0);
-  buffer.push_back(c);
+                        char*& buffer) {
+  *buffer++ = member.get_bool(t) ? 1 : 0;
 }
 
 /**
@@ -354,12 +357,12 @@ static void get_boolean(io::data const& t,
  */
 static void get_double(io::data const& t,
                        mapping::entry const& member,
-                       std::vector<char>& buffer) {
-  char str[32];
-  size_t strsz(snprintf(str, sizeof(str), "%f", member.get_double(t)) + 1);
-  if (strsz > sizeof(str))
-    strsz = sizeof(str);
-  std::copy(str, str + strsz, std::back_inserter(buffer));
+                       char*& buffer) {
+  constexpr size_t max_size = 32;
+  size_t strsz(snprintf(buffer, max_size, "%f", member.get_double(t)) + 1);
+  if (strsz > max_size)
+    strsz = max_size;
+  buffer += strsz;
 }
 
 /**
@@ -367,10 +370,10 @@ static void get_double(io::data const& t,
  */
 static void get_integer(io::data const& t,
                         mapping::entry const& member,
-                        std::vector<char>& buffer) {
+                        char*& buffer) {
   uint32_t value(htonl(member.get_int(t)));
-  char* v(reinterpret_cast<char*>(&value));
-  std::copy(v, v + sizeof(value), std::back_inserter(buffer));
+  memcpy(buffer, &value, sizeof(value));
+  buffer += sizeof(value);
 }
 
 /**
@@ -378,10 +381,10 @@ static void get_integer(io::data const& t,
  */
 static void get_short(io::data const& t,
                       mapping::entry const& member,
-                      std::vector<char>& buffer) {
+                      char*& buffer) {
   uint16_t value(htons(member.get_short(t)));
-  char* v(reinterpret_cast<char*>(&value));
-  std::copy(v, v + sizeof(value), std::back_inserter(buffer));
+  memcpy(buffer, &value, sizeof(value));
+  buffer += sizeof(value);
 }
 
 /**
@@ -389,10 +392,21 @@ static void get_short(io::data const& t,
  */
 static void get_string(io::data const& t,
                        mapping::entry const& member,
-                       std::vector<char>& buffer) {
+                       char*& buffer) {
   std::string const& tmp(member.get_string(t));
-  std::copy(tmp.c_str(), tmp.c_str() + tmp.size() + 1,
-            std::back_inserter(buffer));
+  memcpy(buffer, tmp.c_str(), tmp.size() + 1);
+  buffer += tmp.size() + 1;
+}
+
+/**
+ *  Write a 64 bits integer in the BBDO format.
+ */
+static void put_ulong(uint64_t value, char*& buffer) {
+  uint32_t high{htonl(value >> 32)};
+  uint32_t low{htonl(value & 0xffffffff)};
+  memcpy(buffer, &high, sizeof(high));
+  memcpy(buffer + sizeof(high), &low, sizeof(low));
+  buffer += sizeof(high) + sizeof(low);
 }
 
 /**
@@ -400,14 +414,8 @@ static void get_string(io::data const& t,
  */
 static void get_timestamp(io::data const& t,
                           mapping::entry const& member,
-                          std::vector<char>& buffer) {
-  uint64_t ts(member.get_time(t).get_time_t());
-  uint32_t high{htonl(ts >> 32)};
-  uint32_t low{htonl(ts & 0xffffffff)};
-  char* vh{reinterpret_cast<char*>(&high)};
-  char* vl{reinterpret_cast<char*>(&low)};
-  std::copy(vh, vh + sizeof(high), std::back_inserter(buffer));
-  std::copy(vl, vl + sizeof(low), std::back_inserter(buffer));
+                          char*& buffer) {
+  put_ulong(member.get_time(t).get_time_t(), buffer);
 }
 
 /**
@@ -415,10 +423,10 @@ static void get_timestamp(io::data const& t,
  */
 static void get_uint(io::data const& t,
                      mapping::entry const& member,
-                     std::vector<char>& buffer) {
+                     char*& buffer) {
   uint32_t value{htonl(member.get_uint(t))};
-  char* v{reinterpret_cast<char*>(&value)};
-  std::copy(v, v + sizeof(value), std::back_inserter(buffer));
+  memcpy(buffer, &value, sizeof(value));
+  buffer += sizeof(value);
 }
 
 /**
@@ -426,69 +434,176 @@ static void get_uint(io::data const& t,
  */
 static void get_ulong(io::data const& t,
                       mapping::entry const& member,
-                      std::vector<char>& buffer) {
-  uint64_t value{member.get_ulong(t)};
-  uint32_t high{htonl(value >> 32)};
-  uint32_t low{htonl(value & 0xffffffff)};
-  char* vh{reinterpret_cast<char*>(&high)};
-  char* vl{reinterpret_cast<char*>(&low)};
-  std::copy(vh, vh + sizeof(high), std::back_inserter(buffer));
-  std::copy(vl, vl + sizeof(low), std::back_inserter(buffer));
+                      char*& buffer) {
+  put_ulong(member.get_ulong(t), buffer);
+}
+
+/**
+ *  Compute the checksum of a BBDO header and store it in its first two bytes.
+ *
+ *  @param[in] header    The BBDO header.
+ *  @param[in] checksum  false if the peer does not check it, then it is 0.
+ */
+static inline void set_header_checksum(char* header, bool checksum) {
+  *(reinterpret_cast<uint16_t*>(header)) =
+      checksum ? htons(misc::crc16_ccitt(header + 2, BBDO_HEADER_SIZE - 2))
+               : 0;
+}
+
+/**
+ *  Number of BBDO packets needed to send a payload: each one contains at
+ *  most 0xffff bytes, and the last one is always smaller, so that the peer
+ *  knows the event is complete.
+ *
+ *  @param[in] size  Payload size.
+ *
+ *  @return A number of packets.
+ */
+static inline size_t packets_count(size_t size) {
+  return size / 0xffff + 1;
+}
+
+/**
+ *  Maximum size of the payload of an event based on a mapping. It is exact
+ *  except for doubles whose string representation length is not known.
+ *
+ *  @param[in] e      The event.
+ *  @param[in] entry  The first entry of its mapping.
+ *
+ *  @return A size in bytes.
+ */
+static size_t mapping_max_size(const io::data& e,
+                               const mapping::entry* entry) {
+  size_t retval = 0;
+  for (; !entry->is_null(); ++entry) {
+    if (!entry->get_serialize())
+      continue;
+    switch (entry->get_type()) {
+      case mapping::source::BOOL:
+        retval += 1;
+        break;
+      case mapping::source::DOUBLE:
+        retval += 32;
+        break;
+      case mapping::source::SHORT:
+        retval += 2;
+        break;
+      case mapping::source::STRING:
+        retval += entry->get_string(e).size() + 1;
+        break;
+      case mapping::source::INT:
+      case mapping::source::UINT:
+        retval += 4;
+        break;
+      default:
+        retval += 8;
+        break;
+    }
+  }
+  return retval;
 }
 
 /**
- *  Serialize an event in the BBDO protocol.
+ *  The payload of an event is written just after one BBDO header in buffer.
+ *  This function moves its parts to insert the other headers if it has to be
+ *  split, and fills all the headers. buffer must be large enough to contain
+ *  all of them.
  *
- *  @param[in] e  Event to serialize.
+ *  @param[in] e         The serialized event.
+ *  @param[in] checksum  true to compute the header checksums.
+ *  @param[in] start     Offset of the first header in buffer.
+ *  @param[in] size      Payload size.
+ *  @param[out] buffer   The serialization buffer.
  *
- *  @return Serialized event.
+ *  @return The offset in buffer just after the last packet.
  */
-static io::raw* serialize(const io::data& e) {
-  std::deque<std::vector<char>> queue;
+static size_t write_headers(const io::data& e,
+                            bool checksum,
+                            size_t start,
+                            size_t size,
+                            std::vector<char>& buffer) {
+  const size_t count = packets_count(size);
+  char* data = buffer.data() + start;
+  /* Parts are moved from the last one, so that they don't overwrite each
+   * other. */
+  for (size_t i = count - 1; i > 0; --i)
+    memmove(data + i * (BBDO_HEADER_SIZE + 0xffff) + BBDO_HEADER_SIZE,
+            data + BBDO_HEADER_SIZE + i * 0xffff,
+            i == count - 1 ? size - i * 0xffff : 0xffff);
+
+  uint32_t type = htonl(e.type());
+  uint32_t source_id = htonl(e.source_id);
+  uint32_t destination_id = htonl(e.destination_id);
+  for (size_t i = 0; i < count; ++i) {
+    char* header = data + i * (BBDO_HEADER_SIZE + 0xffff);
+    uint16_t packet_size = htons(i == count - 1 ? size - i * 0xffff : 0xffff);
+    memcpy(header + 2, &packet_size, sizeof(packet_size));
+    memcpy(header + 4, &type, sizeof(type));
+    memcpy(header + 8, &source_id, sizeof(source_id));
+    memcpy(header + 12, &destination_id, sizeof(destination_id));
+    set_header_checksum(header, checksum);
+  }
+  return start + count * BBDO_HEADER_SIZE + size;
+}
 
+/**
+ *  Serialize an event in the BBDO protocol. Headers and payload are directly
+ *  written at the end of buffer, its size is computed before so that it is
+ *  allocated at most once.
+ *
+ *  @param[in] e         Event to serialize.
+ *  @param[in] checksum  true to compute the header checksums.
+ *  @param[out] buffer   The buffer to append the serialized event to.
+ *
+ *  @return true if the event has been serialized.
+ */
+static bool serialize(const io::data& e,
+                      bool checksum,
+                      std::vector<char>& buffer) {
   // Get event info (mapping).
   const io::event_info* info = io::events::instance().get_event_info(e.type());
   if (info) {
+    const size_t start = buffer.size();
+    size_t size;
     // Serialize properties of the object.
     const mapping::entry* current_entry = info->get_mapping();
     if (current_entry) {
-      // Serialization buffer.
-      queue.emplace_back(std::vector<char>());
-      auto* header = &queue.back();
-      header->resize(BBDO_HEADER_SIZE);
-      queue.emplace_back(std::vector<char>());
-      auto* content = &queue.back();
-
-      for (mapping::entry const* current_entry(info->get_mapping());
-           !current_entry->is_null(); ++current_entry) {
+      size_t max_size = mapping_max_size(e, current_entry);
+      buffer.resize(start + packets_count(max_size) * BBDO_HEADER_SIZE +
+                    max_size);
+      char* const content = buffer.data() + start + BBDO_HEADER_SIZE;
+      char* c = content;
+
+      for (; !current_entry->is_null(); ++current_entry) {
         // Skip entries that should not be serialized.
         if (current_entry->get_serialize())
           switch (current_entry->get_type()) {
             case mapping::source::BOOL:
-              get_boolean(e, *current_entry, *content);
+              get_boolean(e, *current_entry, c);
               break;
             case mapping::source::DOUBLE:
-              get_double(e, *current_entry, *content);
+              get_double(e, *current_entry, c);
               break;
             case mapping::source::INT:
-              get_integer(e, *current_entry, *content);
+              get_integer(e, *current_entry, c);
               break;
             case mapping::source::SHORT:
-              get_short(e, *current_entry, *content);
+              get_short(e, *current_entry, c);
               break;
             case mapping::source::STRING:
-              get_string(e, *current_entry, *content);
+              get_string(e, *current_entry, c);
               break;
             case mapping::source::TIME:
-              get_timestamp(e, *current_entry, *content);
+              get_timestamp(e, *current_entry, c);
               break;
             case mapping::source::UINT:
-              get_uint(e, *current_entry, *content);
+              get_uint(e, *current_entry, c);
               break;
             case mapping::source::ULONG:
-              get_ulong(e, *current_entry, *content);
+              get_ulong(e, *current_entry, c);
               break;
             default:
+              buffer.resize(start);
               SPDLOG_LOGGER_ERROR(
                   log_v2::bbdo(),
                   "BBDO: invalid mapping for object of type '{}': {} is not a "
@@ -501,91 +616,26 @@ static io::raw* serialize(const io::data& e) {
                   " is not a known type ID",
                   info->get_name(), current_entry->get_type());
           }
-
-        // Packet splitting.
-        while (content->size() >= 0xffff) {
-          queue.emplace_back(std::vector<char>());
-          auto* new_header = &queue.back();
-          new_header->resize(BBDO_HEADER_SIZE);
-          queue.emplace_back(content->begin() + 0xffff, content->end());
-          content->resize(0xffff);
-          auto* new_content = &queue.back();
-          *(reinterpret_cast<uint16_t*>(header->data() + 2)) = 0xffff;
-          *(reinterpret_cast<uint32_t*>(header->data() + 4)) = htonl(e.type());
-          *(reinterpret_cast<uint32_t*>(header->data() + 8)) =
-              htonl(e.source_id);
-          *(reinterpret_cast<uint32_t*>(header->data() + 12)) =
-              htonl(e.destination_id);
-
-          *(reinterpret_cast<uint16_t*>(header->data())) = htons(
-              misc::crc16_ccitt(header->data() + 2, BBDO_HEADER_SIZE - 2));
-          content = new_content;
-          header = new_header;
-        }
       }
-
-      *(reinterpret_cast<uint16_t*>(header->data() + 2)) =
-          htons(content->size());
-      *(reinterpret_cast<uint32_t*>(header->data() + 4)) = htonl(e.type());
-      *(reinterpret_cast<uint32_t*>(header->data() + 8)) = htonl(e.source_id);
-      *(reinterpret_cast<uint32_t*>(header->data() + 12)) =
-          htonl(e.destination_id);
-
-      *(reinterpret_cast<uint16_t*>(header->data())) =
-          htons(misc::crc16_ccitt(header->data() + 2, BBDO_HEADER_SIZE - 2));
-
+      size = c - content;
     } else {
       /* Here is the protobuf case: no mapping */
-      std::string r{info->get_operations().serialize(e)};
-      size_t size = r.size();
-      auto it = r.begin();
-      do {
-        // Serialization buffer.
-        queue.emplace_back(std::vector<char>());
-        auto* content = &queue.back();
-        content->resize(BBDO_HEADER_SIZE);
-        if (size < 0xffff) {
-          content->insert(content->end(), it, r.end());
-          *(reinterpret_cast<uint16_t*>(content->data() + 2)) = htons(size);
-          *(reinterpret_cast<uint32_t*>(content->data() + 4)) = htonl(e.type());
-          *(reinterpret_cast<uint32_t*>(content->data() + 8)) =
-              htonl(e.source_id);
-          *(reinterpret_cast<uint32_t*>(content->data() + 12)) =
-              htonl(e.destination_id);
-
-          *(reinterpret_cast<uint16_t*>(content->data())) = htons(
-              misc::crc16_ccitt(content->data() + 2, BBDO_HEADER_SIZE - 2));
-          break;
-        } else {
-          content->insert(content->end(), it, it + 0xffff);
-          *(reinterpret_cast<uint16_t*>(content->data() + 2)) = 0xffff;
-          *(reinterpret_cast<uint32_t*>(content->data() + 4)) = htonl(e.type());
-          *(reinterpret_cast<uint32_t*>(content->data() + 8)) =
-              htonl(e.source_id);
-          *(reinterpret_cast<uint32_t*>(content->data() + 12)) =
-              htonl(e.destination_id);
-
-          *(reinterpret_cast<uint16_t*>(content->data())) = htons(
-              misc::crc16_ccitt(content->data() + 2, BBDO_HEADER_SIZE - 2));
-          size -= 0xffff;
-          it += 0xffff;
-        }
-      } while (size > 0);
+      const io::protobuf_base* pb = dynamic_cast<const io::protobuf_base*>(&e);
+      if (pb) {
+        size = pb->msg()->ByteSizeLong();
+        buffer.resize(start + packets_count(size) * BBDO_HEADER_SIZE + size);
+        pb->msg()->SerializeWithCachedSizesToArray(reinterpret_cast<uint8_t*>(
+            buffer.data() + start + BBDO_HEADER_SIZE));
+      } else {
+        std::string r{info->get_operations().serialize(e)};
+        size = r.size();
+        buffer.resize(start + packets_count(size) * BBDO_HEADER_SIZE + size);
+        memcpy(buffer.data() + start + BBDO_HEADER_SIZE, r.data(), size);
+      }
     }
 
-    // Finalization: concatenation of all the vectors in the queue.
-    size_t size = 0;
-    for (auto& v : queue)
-      size += v.size();
-
-    // Serialization buffer.
-    std::unique_ptr<io::raw> buffer(std::make_unique<io::raw>());
-    std::vector<char>& data(buffer->get_buffer());
-    data.reserve(size);
-    for (auto& v : queue)
-      data.insert(data.end(), v.begin(), v.end());
-
-    return buffer.release();
+    buffer.resize(write_headers(e, checksum, start, size, buffer));
+    return true;
   } else {
     SPDLOG_LOGGER_INFO(
         log_v2::bbdo(),
@@ -594,7 +644,7 @@ static io::raw* serialize(const io::data& e) {
         e.type());
   }
 
-  return nullptr;
+  return false;
 }
 
 /**
@@ -608,11 +658,13 @@ stream::stream(bool is_input,
                bool grpc_serialized,
                const std::list<std::shared_ptr<io::extension>>& extensions)
     : io::stream("BBDO"),
+      _packet_begin(0),
       _skipped(0),
       _is_input{is_input},
       _coarse(false),
       _negotiate{true},
       _negotiated{false},
+      _header_checksum{true},
       _timeout(5),
       _acknowledged_events{0},
       _ack_limit(1000),
@@ -745,23 +797,112 @@ void stream::_send_event_stop_and_wait_for_ack() {
   }
 }
 
+/**
+ *  Get the id of the zstd dictionary configured with an extension.
+ *
+ *  @param[in] ext  The extension.
+ *
+ *  @return The id, 0 if there is no dictionary or if it cannot be identified.
+ */
+static uint32_t dictionary_id(const io::extension& ext) {
+  auto it = ext.options().find("compression_dictionary");
+  if (it == ext.options().end() || it->second.empty())
+    return 0;
+  return compression::zstd::dictionary_id(
+      compression::zstd::load_dictionary(it->second));
+}
+
+/**
+ *  Append an extension name to the list sent to the peer. The compression
+ *  one is followed by the codecs we can uncompress and by the id of our zstd
+ *  dictionary.
+ *
+ *  @param[in,out] names  The extension names separated by spaces.
+ *  @param[in]     ext    The extension to append.
+ */
+static void append_extension_name(std::string& names,
+                                  const io::extension& ext) {
+  if (!names.empty())
+    names.append(" ");
+  names.append(ext.name());
+  if (ext.name() == "COMPRESSION") {
+    for (compression::codec c :
+         {compression::codec::zstd, compression::codec::lz4})
+      names.append(" ")
+          .append(BBDO_COMPRESSION_CODEC_PREFIX)
+          .append(absl::AsciiStrToUpper(compression::codec_name(c)));
+    uint32_t id = dictionary_id(ext);
+    if (id)
+      names.append(" ")
+          .append(BBDO_COMPRESSION_DICTIONARY_PREFIX)
+          .append(std::to_string(id));
+  }
+}
+
+/**
+ *  Get the options of the stream of an extension. The codec asked for the
+ *  compression is replaced by zlib if the peer cannot uncompress it and the
+ *  zstd dictionary is removed if the peer does not announce the same one.
+ *
+ *  @param[in] ext       The extension.
+ *  @param[in] peer_ext  The extension names sent by the peer.
+ *
+ *  @return The options.
+ */
+static std::unordered_map<std::string, std::string> extension_options(
+    const io::extension& ext,
+    const std::list<std::string_view>& peer_ext) {
+  std::unordered_map<std::string, std::string> retval{ext.options()};
+  if (ext.name() == "COMPRESSION") {
+    auto it = retval.find("compression_codec");
+    compression::codec c;
+    if (it != retval.end() && compression::parse_codec(it->second, &c) &&
+        c != compression::codec::zlib) {
+      std::string peer_codec{
+          absl::StrCat(BBDO_COMPRESSION_CODEC_PREFIX,
+                       absl::AsciiStrToUpper(compression::codec_name(c)))};
+      if (std::find(peer_ext.begin(), peer_ext.end(), peer_codec) ==
+          peer_ext.end()) {
+        SPDLOG_LOGGER_INFO(log_v2::bbdo(),
+                           "BBDO: peer cannot uncompress {} data, zlib is used",
+                           compression::codec_name(c));
+        it->second = compression::codec_name(compression::codec::zlib);
+      } else
+        SPDLOG_LOGGER_INFO(log_v2::bbdo(), "BBDO: data compressed with {}",
+                           compression::codec_name(c));
+    }
+
+    auto dict = retval.find("compression_dictionary");
+    if (dict != retval.end() && !dict->second.empty()) {
+      uint32_t id = dictionary_id(ext);
+      if (id && std::find(peer_ext.begin(), peer_ext.end(),
+                          absl::StrCat(BBDO_COMPRESSION_DICTIONARY_PREFIX,
+                                       id)) != peer_ext.end())
+        SPDLOG_LOGGER_INFO(log_v2::bbdo(),
+                           "BBDO: zstd dictionary {} used with the peer", id);
+      else {
+        SPDLOG_LOGGER_INFO(log_v2::bbdo(),
+                           "BBDO: peer does not use the zstd dictionary '{}', "
+                           "no dictionary is used",
+                           dict->second);
+        retval.erase(dict);
+      }
+    }
+  }
+  return retval;
+}
+
 std::string stream::_get_extension_names(bool mandatory) const {
   std::string retval;
   if (mandatory)
     for (auto& e : _extensions) {
-      if (e->is_mandatory()) {
-        if (!retval.empty())
-          retval.append(" ");
-        retval.append(e->name());
-      }
+      if (e->is_mandatory())
+        append_extension_name(retval, *e);
     }
   else
     for (auto& e : _extensions) {
-      if (e->is_optional() || e->is_mandatory()) {
-        if (!retval.empty())
-          retval.append(" ");
-        retval.append(e->name());
-      }
+      if (e->is_optional() || e->is_mandatory())
+        append_extension_name(retval, *e);
     }
   return retval;
 }
@@ -935,9 +1076,26 @@ void stream::negotiate(stream::negotiation_type neg) {
       extensions,
       fmt::string_view(peer_extensions.data(), peer_extensions.size()));
   std::list<std::string_view> peer_ext{absl::StrSplit(peer_extensions, ' ')};
+  _header_checksum = true;
   for (auto& ext : _extensions) {
     // Find matching extension in peer extension list.
     auto peer_it{std::find(peer_ext.begin(), peer_ext.end(), ext->name())};
+    // This one is not a substream, it just changes how packets are checked.
+    if (ext->name() == BBDO_NO_CHECKSUM_EXTENSION) {
+      if (peer_it != peer_ext.end()) {
+        SPDLOG_LOGGER_INFO(log_v2::bbdo(),
+                           "BBDO: applying extension '{}', header checksums "
+                           "are no more computed",
+                           ext->name());
+        _header_checksum = false;
+      } else if (ext->is_mandatory())
+        SPDLOG_LOGGER_ERROR(
+            log_v2::bbdo(),
+            "BBDO: extension '{}' is set to 'yes' in the configuration but "
+            "cannot be activated because of peer configuration.",
+            ext->name());
+      continue;
+    }
     // Apply extension if found.
     if (peer_it != peer_ext.end()) {
       if (std::find(running_config.begin(), running_config.end(),
@@ -951,7 +1109,8 @@ void stream::negotiate(stream::negotiation_type neg) {
           if (boost::iequals(proto_it->first, ext->name())) {
             std::shared_ptr<io::stream> s{
                 proto_it->second.endpntfactry->new_stream(
-                    _substream, neg == negotiate_second, ext->options())};
+                    _substream, neg == negotiate_second,
+                    extension_options(*ext, peer_ext))};
             set_substream(s);
             break;
           }
@@ -1168,14 +1327,16 @@ bool stream::_read_any(std::shared_ptr<io::data>& d, time_t deadline) {
       // Packet size is now at least BBDO_HEADER_SIZE and maybe contains
       // already a full BBDO packet.
 
-      const char* pack = _packet.data();
+      const char* pack = _packet.data() + _packet_begin;
       uint16_t chksum = ntohs(*reinterpret_cast<uint16_t const*>(pack));
       uint32_t packet_size =
           ntohs(*reinterpret_cast<uint16_t const*>(pack + 2));
       uint32_t event_id = ntohl(*reinterpret_cast<uint32_t const*>(pack + 4));
       uint32_t source_id = ntohl(*reinterpret_cast<uint32_t const*>(pack + 8));
       uint32_t dest_id = ntohl(*reinterpret_cast<uint32_t const*>(pack + 12));
-      uint16_t expected = misc::crc16_ccitt(pack + 2, BBDO_HEADER_SIZE - 2);
+      uint16_t expected =
+          _header_checksum ? misc::crc16_ccitt(pack + 2, BBDO_HEADER_SIZE - 2)
+                           : chksum;
 
       SPDLOG_LOGGER_TRACE(
           log_v2::bbdo(),
@@ -1194,7 +1355,7 @@ bool stream::_read_any(std::shared_ptr<io::data>& d, time_t deadline) {
               peer(), chksum, expected);
         }
         ++_skipped;
-        _packet.erase(_packet.begin());
+        ++_packet_begin;
         continue;
       } else if (_skipped) {
         SPDLOG_LOGGER_INFO(
@@ -1208,48 +1369,31 @@ bool stream::_read_any(std::shared_ptr<io::data>& d, time_t deadline) {
 
       _read_packet(BBDO_HEADER_SIZE + packet_size, deadline);
 
-      // Now, _packet contains at least BBDO_HEADER_SIZE + packet_size bytes.
+      // Now, _packet contains at least BBDO_HEADER_SIZE + packet_size bytes
+      // after _packet_begin. The content is used where it is, _packet_begin
+      // is just moved after it.
 
-      std::vector<char> content;
-      if (_packet.size() == BBDO_HEADER_SIZE + packet_size) {
-        SPDLOG_LOGGER_TRACE(
-            log_v2::bbdo(),
-            "packet matches header + content => extracting content");
-        // We remove the header from the packet: FIXME DBR this is not
-        // beautiful...
-
-        content = std::vector<char>(_packet.begin() + BBDO_HEADER_SIZE,
-                                    _packet.end());
-        _packet.clear();
-        // The size should be of only packet_size now.
-      } else {
-        /* we have _packet.size() > BBDO_HEADER_SIZE + packet_size */
-
-        size_t previous_packet_size = _packet.size();
-        // packet contains more than one BBDO packet...
-        content =
-            std::vector<char>(_packet.begin() + BBDO_HEADER_SIZE,
-                              _packet.begin() + BBDO_HEADER_SIZE + packet_size);
-        _packet.erase(_packet.begin(),
-                      _packet.begin() + BBDO_HEADER_SIZE + packet_size);
-        SPDLOG_LOGGER_TRACE(
-            log_v2::bbdo(),
-            "packet longer than header + content => splitting the whole of "
-            "size {} to content of size {} and remaining of size {}",
-            previous_packet_size, content.size(), _packet.size());
-      }
+      pack = _packet.data() + _packet_begin + BBDO_HEADER_SIZE;
+      _packet_begin += BBDO_HEADER_SIZE + packet_size;
+      SPDLOG_LOGGER_TRACE(log_v2::bbdo(),
+                          "packet of content size {}, remaining size {}",
+                          packet_size, _packet.size() - _packet_begin);
 
       if (packet_size != 0xffff) {
         // Cool we can work with it!
 
         // Is it the next part of an already known input buffer?
+        std::vector<char> content;
         for (auto it = _buffer.begin(); it != _buffer.end(); ++it) {
           auto& b = *it;
           if (b.matches(event_id, source_id, dest_id)) {
             // Good, we've found it.
-            b.push_back(std::move(content));
+            b.push_back(std::vector<char>(pack, pack + packet_size));
             content = b.to_vector();
             _buffer.erase(it);
+            pack = content.data();
+            // Maybe it is bigger now.
+            packet_size = content.size();
             break;
           }
         }
@@ -1271,10 +1415,6 @@ bool stream::_read_any(std::shared_ptr<io::data>& d, time_t deadline) {
           }
         }
 
-        pack = content.data();
-
-        // Maybe it is bigger now.
-        packet_size = content.size();
         d.reset(unserialize(event_id, source_id, dest_id, pack, packet_size));
         if (d) {
           SPDLOG_LOGGER_TRACE(log_v2::bbdo(),
@@ -1295,15 +1435,15 @@ bool stream::_read_any(std::shared_ptr<io::data>& d, time_t deadline) {
           auto& b = *it;
           if (b.matches(event_id, source_id, dest_id)) {
             // Good, we've found it.
-            b.push_back(std::move(content));
-            content.clear();
+            b.push_back(std::vector<char>(pack, pack + packet_size));
             done = true;
             break;
           }
         }
         if (!done)
           _buffer.emplace_back(
-              buffer(event_id, source_id, dest_id, std::move(content)));
+              buffer(event_id, source_id, dest_id,
+                     std::vector<char>(pack, pack + packet_size)));
 
         /* There is no reason to have this but no one knows. */
         if (_buffer.size() > 1) {
@@ -1345,7 +1485,7 @@ bool stream::_read_any(std::shared_ptr<io::data>& d, time_t deadline) {
  */
 void stream::_read_packet(size_t size, time_t deadline) {
   // Read as much data as requested.
-  while (_packet.size() < size) {
+  while (_packet.size() - _packet_begin < size) {
     std::shared_ptr<io::data> d;
     bool timeout = !_substream->read(d, deadline);
 
@@ -1354,11 +1494,20 @@ void stream::_read_packet(size_t size, time_t deadline) {
         std::vector<char>& new_v =
             std::static_pointer_cast<io::raw>(d)->_buffer;
         if (!new_v.empty()) {
-          if (_packet.size() == 0) {
+          if (_packet_begin == _packet.size()) {
             _packet = std::move(new_v);
             new_v.clear();
-          } else
+            _packet_begin = 0;
+          } else {
+            /* Already read bytes are only removed when they are the most
+             * part of the vector, so that the remaining ones are not moved
+             * each time a packet is read. */
+            if (_packet_begin > _packet.size() / 2) {
+              _packet.erase(_packet.begin(), _packet.begin() + _packet_begin);
+              _packet_begin = 0;
+            }
             _packet.insert(_packet.end(), new_v.begin(), new_v.end());
+          }
         }
       } else {
         _grpc_serialized_queue.push_back(d);
@@ -1402,6 +1551,16 @@ void stream::set_negotiate(bool negotiate) {
   _negotiate = negotiate;
 }
 
+/**
+ *  Check if data read from the substream are not returned as events yet.
+ *
+ *  @return True if some data are still pending.
+ */
+bool stream::has_pending_input() const {
+  return _packet_begin < _packet.size() || !_buffer.empty() ||
+         !_grpc_serialized_queue.empty();
+}
+
 /**
  *  Set the timeout supported by this stream.
  *
@@ -1430,8 +1589,8 @@ void stream::_write(const std::shared_ptr<io::data>& d) {
 
   if (!_grpc_serialized || !std::dynamic_pointer_cast<io::protobuf_base>(d)) {
     // Check if data exists.
-    std::shared_ptr<io::raw> serialized(serialize(*d));
-    if (serialized) {
+    auto serialized = std::make_shared<io::raw>();
+    if (serialize(*d, _header_checksum, serialized->get_buffer())) {
       SPDLOG_LOGGER_TRACE(log_v2::bbdo(),
                           "BBDO: serialized event of type {} to {} bytes",
                           d->type(), serialized->size());
@@ -1456,6 +1615,47 @@ int32_t stream::write(std::shared_ptr<io::data> const& d) {
   return retval;
 }
 
+/**
+ *  Write several events to the stream. They are serialized in one buffer
+ *  sent with only one write to the substream. Events directly serialized
+ *  by the grpc stream are sent as is, in their order.
+ *
+ *  @param[in] events  Data to send.
+ *
+ *  @return Number of events acknowledged.
+ */
+int32_t stream::write(const std::vector<std::shared_ptr<io::data>>& events) {
+  auto serialized = std::make_shared<io::raw>();
+  size_t size = 0;
+  for (auto& d : events)
+    size += d->estimated_size();
+  serialized->get_buffer().reserve(size);
+
+  for (auto& d : events) {
+    assert(d);
+    if (!_grpc_serialized ||
+        !std::dynamic_pointer_cast<io::protobuf_base>(d))
+      serialize(*d, _header_checksum, serialized->get_buffer());
+    else {
+      if (!serialized->get_buffer().empty()) {
+        _substream->write(serialized);
+        serialized = std::make_shared<io::raw>();
+      }
+      _substream->write(d);
+    }
+  }
+  if (!serialized->get_buffer().empty()) {
+    SPDLOG_LOGGER_TRACE(log_v2::bbdo(),
+                        "BBDO: serialized {} events to {} bytes",
+                        events.size(), serialized->size());
+    _substream->write(serialized);
+  }
+
+  int32_t retval = _acknowledged_events;
+  _acknowledged_events -= retval;
+  return retval;
+}
+
 /**
  *  Acknowledge a certain amount of events.
  *
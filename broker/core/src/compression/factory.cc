@@ -20,14 +20,82 @@
 
 #include <absl/strings/match.h>
 
+#include <array>
+
 #include "com/centreon/broker/compression/opener.hh"
 #include "com/centreon/broker/compression/stream.hh"
+#include "com/centreon/broker/compression/zstd.hh"
 #include "com/centreon/broker/config/parser.hh"
 #include "com/centreon/broker/log_v2.hh"
 
 using namespace com::centreon::broker;
 using namespace com::centreon::broker::compression;
 
+/* Parameters of an endpoint given to the negotiated compression stream. */
+static constexpr std::array<const char*, 3> stream_params{
+    "compression_level", "compression_codec", "compression_dictionary"};
+
+/**
+ *  Read the parameters of a compression stream.
+ *
+ *  @param[in]  params      The endpoint parameters or extension options.
+ *  @param[out] level       The compression level.
+ *  @param[out] size        The compression buffer size.
+ *  @param[out] c           The codec.
+ *  @param[out] dictionary  The content of the zstd dictionary. It is also
+ *                          loaded with another codec to uncompress the zstd
+ *                          data of the peer.
+ */
+template <typename T>
+static void read_params(const T& params,
+                        int* level,
+                        uint32_t* size,
+                        codec* c,
+                        std::string* dictionary) {
+  // Get compression level.
+  *level = -1;
+  auto it = params.find("compression_level");
+  if (it != params.end()) {
+    if (!absl::SimpleAtoi(it->second, level)) {
+      log_v2::core()->error(
+          "compression: the 'compression_level' should be an integer and not "
+          "'{}'",
+          it->second);
+      *level = -1;
+    }
+  }
+
+  // Get buffer size.
+  *size = 0;
+  it = params.find("compression_buffer");
+  if (it != params.end()) {
+    if (!absl::SimpleAtoi(it->second, size)) {
+      log_v2::core()->error(
+          "compression: compression_buffer is the size of the compression "
+          "buffer represented by an integer and not '{}'",
+          it->second);
+      *size = 0;
+    }
+  }
+
+  // Get codec.
+  *c = codec::zlib;
+  it = params.find("compression_codec");
+  if (it != params.end() && !parse_codec(it->second, c)) {
+    log_v2::core()->error(
+        "compression: compression_codec must be 'zlib', 'zstd' or 'lz4' and "
+        "not '{}', zlib is used",
+        it->second);
+    *c = codec::zlib;
+  }
+
+  // Get the zstd dictionary.
+  dictionary->clear();
+  it = params.find("compression_dictionary");
+  if (it != params.end() && !it->second.empty())
+    *dictionary = zstd::load_dictionary(it->second);
+}
+
 /**
  *  Check if an endpoint configuration match the compression layer.
  *
@@ -97,6 +165,11 @@ bool factory::has_endpoint(config::endpoint& cfg, io::extension* ext) {
       else
         *ext = io::extension("COMPRESSION", false, true);
     }
+    for (const char* param : stream_params) {
+      auto it = cfg.params.find(param);
+      if (it != cfg.params.end())
+        ext->mutable_options()[param] = it->second;
+    }
   }
   return false;
 }
@@ -117,35 +190,15 @@ io::endpoint* factory::new_endpoint(
   (void)is_acceptor;
   (void)cache;
 
-  // Get compression level.
-  int level{-1};
-  std::map<std::string, std::string>::const_iterator it{
-      cfg.params.find("compression_level")};
-  if (it != cfg.params.end()) {
-    if (!absl::SimpleAtoi(it->second, &level)) {
-      log_v2::core()->error(
-          "compression: the 'compression_level' should be an integer and not "
-          "'{}'",
-          it->second);
-      level = -1;
-    }
-  }
-
-  // Get buffer size.
-  uint32_t size = 0;
-  it = cfg.params.find("compression_buffer");
-  if (it != cfg.params.end()) {
-    if (!absl::SimpleAtoi(it->second, &size)) {
-      log_v2::core()->error(
-          "compression: compression_buffer is the size of the compression "
-          "buffer represented by an integer and not '{}'",
-          it->second);
-      size = 0;
-    }
-  }
+  int level;
+  uint32_t size;
+  codec c;
+  std::string dictionary;
+  read_params(cfg.params, &level, &size, &c, &dictionary);
 
   // Create compression object.
-  auto openr{std::make_unique<compression::opener>(level, size)};
+  auto openr{std::make_unique<compression::opener>(level, size, c,
+                                                   std::move(dictionary))};
   return openr.release();
 }
 
@@ -154,7 +207,8 @@ io::endpoint* factory::new_endpoint(
  *
  *  @param[in] to          Lower-layer stream.
  *  @param[in] is_acceptor Unused.
- *  @param[in] proto_name  Unused.
+ *  @param[in] options     The compression parameters of the endpoint, the
+ *                         codec is the negotiated one.
  *
  *  @return New compression stream.
  */
@@ -163,8 +217,13 @@ std::shared_ptr<io::stream> factory::new_stream(
     bool is_acceptor,
     const std::unordered_map<std::string, std::string>& options) {
   (void)is_acceptor;
-  (void)options;
-  std::shared_ptr<io::stream> s{std::make_shared<stream>()};
+  int level;
+  uint32_t size;
+  codec c;
+  std::string dictionary;
+  read_params(options, &level, &size, &c, &dictionary);
+  std::shared_ptr<io::stream> s{
+      std::make_shared<stream>(level, size, c, dictionary)};
   s->set_substream(to);
   return s;
 }
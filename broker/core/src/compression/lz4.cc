@@ -0,0 +1,100 @@
+/**
+ * Copyright 2023 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/broker/compression/lz4.hh"
+
+#include <lz4.h>
+#include <lz4hc.h>
+
+#include "com/centreon/broker/compression/stream.hh"
+#include "com/centreon/broker/exceptions/corruption.hh"
+#include "com/centreon/broker/log_v2.hh"
+#include "com/centreon/exceptions/msg_fmt.hh"
+
+using namespace com::centreon::exceptions;
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::compression;
+
+/**
+ * Compression function
+ *
+ * @param data the data to compress.
+ * @param compression_level The compression level, 0 or less for the fast
+ * compression, from 1 to 12 for the high compression one.
+ *
+ * @return The same data compressed, preceded by their size on four bytes.
+ */
+std::vector<char> lz4::compress(std::vector<char> const& data,
+                                int compression_level) {
+  if (data.empty())
+    return {'\0', '\0', '\0', '\0'};
+
+  int nbytes = data.size();
+  int bound = LZ4_compressBound(nbytes);
+  std::vector<char> retval(bound + 4);
+  int len;
+  if (compression_level <= 0)
+    len = LZ4_compress_default(data.data(), retval.data() + 4, nbytes, bound);
+  else
+    len = LZ4_compress_HC(data.data(), retval.data() + 4, nbytes, bound,
+                          compression_level);
+  if (len <= 0)
+    throw msg_fmt("compression: lz4 cannot compress {} bytes", nbytes);
+
+  retval.resize(len + 4);
+  retval[0] = (nbytes >> 24) & 0xff;
+  retval[1] = (nbytes >> 16) & 0xff;
+  retval[2] = (nbytes >> 8) & 0xff;
+  retval[3] = (nbytes & 0xff);
+  return retval;
+}
+
+/**
+ * Uncompress function
+ *
+ * @param data The data to extract.
+ * @param nbytes The data size in bytes.
+ *
+ * @return the extract data
+ */
+std::vector<char> lz4::uncompress(unsigned char const* data,
+                                  unsigned long nbytes) {
+  if (!data) {
+    log_v2::core()->debug("compression: attempting to uncompress null buffer");
+    return std::vector<char>();
+  }
+  if (nbytes < 4)
+    throw exceptions::corruption(
+        "compression: attempting to uncompress data with invalid size");
+  int expected_size =
+      (data[0] << 24) | (data[1] << 16) | (data[2] << 8) | data[3];
+  if (expected_size < 0 ||
+      static_cast<size_t>(expected_size) > stream::max_data_size)
+    throw exceptions::corruption("compression: data expected size is too big");
+  std::vector<char> retval(expected_size);
+  if (!expected_size)
+    return retval;
+
+  int len = LZ4_decompress_safe(reinterpret_cast<const char*>(data) + 4,
+                                retval.data(), nbytes - 4, expected_size);
+  if (len != expected_size)
+    throw exceptions::corruption(
+        "compression: compressed input data is corrupted, unable to "
+        "uncompress it");
+  return retval;
+}
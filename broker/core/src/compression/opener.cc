@@ -28,9 +28,15 @@ using namespace com::centreon::broker::compression;
  * @param size Size of the compression buffer. Default value is 0.
  * @param level Level of the compression function (in the range [-1, 9]). -1 is
  * the default compression.
+ * @param c The codec used to compress.
+ * @param dictionary The content of the zstd dictionary, empty if none.
  */
-opener::opener(int32_t level, size_t size)
-    : io::endpoint(false, {}), _level(level), _size(size) {}
+opener::opener(int32_t level, size_t size, codec c, std::string dictionary)
+    : io::endpoint(false, {}),
+      _level(level),
+      _size(size),
+      _codec(c),
+      _dictionary(std::move(dictionary)) {}
 
 /**
  *  Open a compression stream.
@@ -52,7 +58,7 @@ std::shared_ptr<io::stream> opener::open() {
 std::shared_ptr<io::stream> opener::_open(std::shared_ptr<io::stream> base) {
   std::shared_ptr<io::stream> retval;
   if (base) {
-    retval = std::make_shared<stream>(_level, _size);
+    retval = std::make_shared<stream>(_level, _size, _codec, _dictionary);
     retval->set_substream(base);
   }
   return retval;
@@ -18,7 +18,11 @@
 
 #include "com/centreon/broker/compression/stream.hh"
 
+#include <absl/strings/match.h>
+
+#include "com/centreon/broker/compression/lz4.hh"
 #include "com/centreon/broker/compression/zlib.hh"
+#include "com/centreon/broker/compression/zstd.hh"
 #include "com/centreon/broker/exceptions/corruption.hh"
 #include "com/centreon/broker/exceptions/interrupt.hh"
 #include "com/centreon/broker/exceptions/shutdown.hh"
@@ -33,14 +37,67 @@ using namespace com::centreon::broker::compression;
 
 const size_t stream::max_data_size = 100000000u;
 
+/* The four high bits of a chunk size contain its codec. */
+constexpr uint32_t codec_shift = 28;
+constexpr uint32_t size_mask = (1u << codec_shift) - 1;
+
+/**
+ *  Get a codec from its name.
+ *
+ *  @param[in]  name  The name: zlib, zstd or lz4 (case is ignored).
+ *  @param[out] c     The codec if found.
+ *
+ *  @return true if the name is known.
+ */
+bool compression::parse_codec(std::string_view name, codec* c) {
+  for (codec v : {codec::zlib, codec::zstd, codec::lz4})
+    if (absl::EqualsIgnoreCase(name, codec_name(v))) {
+      *c = v;
+      return true;
+    }
+  return false;
+}
+
+/**
+ *  Get the name of a codec.
+ *
+ *  @param[in] c  The codec.
+ *
+ *  @return Its name.
+ */
+const char* compression::codec_name(codec c) {
+  switch (c) {
+    case codec::zstd:
+      return "zstd";
+    case codec::lz4:
+      return "lz4";
+    default:
+      return "zlib";
+  }
+}
+
 /**
  *  Constructor.
  *
- *  @param[in] level Compression level.
- *  @param[in] size  Compression buffer size.
+ *  @param[in] level       Compression level.
+ *  @param[in] size        Compression buffer size.
+ *  @param[in] c           Codec used to compress the written data.
+ *  @param[in] dictionary  Content of the zstd dictionary, empty if none.
  */
-stream::stream(int level, size_t size)
-    : io::stream("compression"), _level(level), _shutdown(false), _size(size) {}
+stream::stream(int level,
+               size_t size,
+               codec c,
+               const std::string& dictionary)
+    : io::stream("compression"),
+      _level(level),
+      _codec(c),
+      _dictionary(dictionary),
+      _shutdown(false),
+      _size(size),
+      _uncompressed_bytes{0},
+      _compressed_bytes{0},
+      _compress_ns{0},
+      _uncompress_ns{0} {}
 
 /**
  *  Destructor.
@@ -75,6 +132,7 @@ bool stream::read(std::shared_ptr<io::data>& data, time_t deadline) {
     // or until an exception occurs.
     bool corrupted(true);
     size_t size(0);
+    codec chunk_codec(codec::zlib);
     int skipped(0);
     while (corrupted) {
       // Get compressed data length.
@@ -86,18 +144,20 @@ bool stream::read(std::shared_ptr<io::data>& data, time_t deadline) {
         if (_rbuffer.size() < static_cast<int>(sizeof(int32_t)))
           throw exceptions::shutdown("no more data to uncompress");
 
-        // Extract next chunk's size.
+        // Extract next chunk's size and codec.
         {
           unsigned char const* buff((unsigned char const*)_rbuffer.data());
-          size = static_cast<uint32_t>((buff[0] << 24) | (buff[1] << 16) |
-                                       (buff[2] << 8) | (buff[3]));
+          uint32_t header = (buff[0] << 24) | (buff[1] << 16) |
+                            (buff[2] << 8) | (buff[3]);
+          size = header & size_mask;
+          chunk_codec = static_cast<codec>(header >> codec_shift);
           log_v2::core()->trace(
               "extract size: {} from {:02X} {:02X} {:02X} {:02X}", size,
               buff[0], buff[1], buff[2], buff[3]);
         }
 
         // Check if size is within bounds.
-        if (size <= 0 || size > max_data_size) {
+        if (size <= 0 || size > max_data_size || chunk_codec > codec::lz4) {
           // Skip corrupted data, one byte at a time.
           log_v2::core()->error(
               "compression: stream got corrupted packet size of {} bytes, not "
@@ -126,11 +186,18 @@ bool stream::read(std::shared_ptr<io::data>& data, time_t deadline) {
       if (_rbuffer.size() >= static_cast<int>(size + sizeof(int32_t))) {
         try {
           r->get_buffer() =
-              zlib::uncompress(reinterpret_cast<unsigned char const*>(
-                                   (_rbuffer.data() + sizeof(int32_t))),
-                               size);
+              _uncompress(chunk_codec,
+                          reinterpret_cast<unsigned char const*>(
+                              (_rbuffer.data() + sizeof(int32_t))),
+                          size);
         } catch (exceptions::corruption const& e) {
-          log_v2::core()->debug("corrupted data: {}", e.what());
+          /* Next attempts are done byte after byte to find a valid chunk. */
+          if (!skipped)
+            log_v2::core()->error(
+                "compression: cannot uncompress {} data from peer {}: {}",
+                codec_name(chunk_codec), peer(), e.what());
+          else
+            log_v2::core()->debug("corrupted data: {}", e.what());
         }
       }
       if (!r->size()) {  // No data or uncompressed size of 0 means corrupted
@@ -184,10 +251,27 @@ bool stream::read(std::shared_ptr<io::data>& data, time_t deadline) {
  *  @param[out] buffer Output buffer.
  */
 void stream::statistics(nlohmann::json& tree) const {
+  tree["compression_codec"] = codec_name(_codec);
+  uint64_t uncompressed = _uncompressed_bytes;
+  if (uncompressed)
+    tree["compression_ratio"] =
+        static_cast<double>(_compressed_bytes) / uncompressed;
+  tree["compression_time"] = _compress_ns / 1e9;
+  tree["uncompression_time"] = _uncompress_ns / 1e9;
   if (_substream)
     _substream->statistics(tree);
 }
 
+/**
+ *  Get the number of bytes read from the substream that are not
+ *  uncompressed yet.
+ *
+ *  @return A size in bytes.
+ */
+int stream::pending_input() const {
+  return _rbuffer.size();
+}
+
 /**
  *  Flush the stream.
  *
@@ -265,15 +349,32 @@ void stream::_flush() {
     // Compress data.
     auto compressed{std::make_shared<io::raw>()};
     std::vector<char>& data(compressed->get_buffer());
-    data = zlib::compress(_wbuffer, _level);
+    auto start = std::chrono::steady_clock::now();
+    switch (_codec) {
+      case codec::zstd:
+        data = _get_zstd().compress(_wbuffer);
+        break;
+      case codec::lz4:
+        data = lz4::compress(_wbuffer, _level);
+        break;
+      default:
+        data = zlib::compress(_wbuffer, _level);
+        break;
+    }
+    _compress_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - start)
+                        .count();
+    _uncompressed_bytes += _wbuffer.size();
+    _compressed_bytes += compressed->size();
     log_v2::core()->debug(
-        "compression: stream compressed {} bytes to {} bytes (level {})",
-        _wbuffer.size(), compressed->size(), _level);
+        "compression: stream compressed {} bytes to {} bytes ({} level {})",
+        _wbuffer.size(), compressed->size(), codec_name(_codec), _level);
     _wbuffer.clear();
 
-    // Add compressed data size.
+    // Add compressed data size and codec.
     unsigned char buffer[4];
-    uint32_t size = compressed->size();
+    uint32_t size = compressed->size() |
+                    (static_cast<uint32_t>(_codec) << codec_shift);
     buffer[0] = (size >> 24) & 0xFF;
     buffer[1] = (size >> 16) & 0xFF;
     buffer[2] = (size >> 8) & 0xFF;
@@ -312,3 +413,45 @@ void stream::_get_data(int size, time_t deadline) {
     _shutdown = true;
   }
 }
+
+/**
+ *  Get the zstd binding, created on first use.
+ *
+ *  @return The zstd binding of this stream.
+ */
+zstd& stream::_get_zstd() {
+  if (!_zstd)
+    _zstd = std::make_unique<zstd>(_level, _dictionary);
+  return *_zstd;
+}
+
+/**
+ *  Uncompress a chunk.
+ *
+ *  @param[in] c       The codec of the chunk.
+ *  @param[in] data    The compressed data.
+ *  @param[in] nbytes  Their size.
+ *
+ *  @return The uncompressed data.
+ */
+std::vector<char> stream::_uncompress(codec c,
+                                      unsigned char const* data,
+                                      unsigned long nbytes) {
+  auto start = std::chrono::steady_clock::now();
+  std::vector<char> retval;
+  switch (c) {
+    case codec::zstd:
+      retval = _get_zstd().uncompress(data, nbytes);
+      break;
+    case codec::lz4:
+      retval = lz4::uncompress(data, nbytes);
+      break;
+    default:
+      retval = zlib::uncompress(data, nbytes);
+      break;
+  }
+  _uncompress_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - start)
+                        .count();
+  return retval;
+}
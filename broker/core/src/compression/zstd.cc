@@ -0,0 +1,186 @@
+/**
+ * Copyright 2023 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/broker/compression/zstd.hh"
+
+#include <zstd.h>
+
+#include <fstream>
+
+#include "com/centreon/broker/compression/stream.hh"
+#include "com/centreon/broker/exceptions/corruption.hh"
+#include "com/centreon/broker/log_v2.hh"
+#include "com/centreon/exceptions/msg_fmt.hh"
+
+using namespace com::centreon::exceptions;
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::compression;
+
+/**
+ * @brief Constructor.
+ *
+ * @param level The compression level, -1 for the default one.
+ * @param dictionary The content of a zstd dictionary, empty if none.
+ */
+zstd::zstd(int level, const std::string& dictionary)
+    : _level{level == -1 || level < ZSTD_minCLevel() ||
+                     level > ZSTD_maxCLevel()
+                 ? ZSTD_CLEVEL_DEFAULT
+                 : level},
+      _cctx{ZSTD_createCCtx()},
+      _dctx{ZSTD_createDCtx()},
+      _cdict{nullptr},
+      _ddict{nullptr} {
+  if (!_cctx || !_dctx) {
+    ZSTD_freeCCtx(_cctx);
+    ZSTD_freeDCtx(_dctx);
+    throw msg_fmt("compression: not enough memory to create zstd contexts");
+  }
+  if (!dictionary.empty()) {
+    _cdict =
+        ZSTD_createCDict(dictionary.data(), dictionary.size(), _level);
+    _ddict = ZSTD_createDDict(dictionary.data(), dictionary.size());
+    if (!_cdict || !_ddict) {
+      ZSTD_freeCDict(_cdict);
+      ZSTD_freeDDict(_ddict);
+      ZSTD_freeCCtx(_cctx);
+      ZSTD_freeDCtx(_dctx);
+      throw msg_fmt("compression: cannot load the zstd dictionary");
+    }
+    log_v2::core()->info("compression: zstd dictionary {} loaded ({} bytes)",
+                         ZSTD_getDictID_fromDDict(_ddict), dictionary.size());
+  }
+}
+
+/**
+ * @brief Read a zstd dictionary file.
+ *
+ * @param path The path of the dictionary.
+ *
+ * @return Its content, empty if it cannot be read.
+ */
+std::string zstd::load_dictionary(const std::string& path) {
+  std::string retval;
+  std::ifstream f(path, std::ios::binary);
+  if (f)
+    retval.assign(std::istreambuf_iterator<char>(f),
+                  std::istreambuf_iterator<char>());
+  if (!f || retval.empty())
+    log_v2::core()->error(
+        "compression: cannot read the zstd dictionary '{}', no dictionary is "
+        "used",
+        path);
+  return retval;
+}
+
+/**
+ * @brief Get the id of a dictionary, stored in it by `zstd --train`.
+ *
+ * @param dictionary The content of the dictionary.
+ *
+ * @return The id, 0 for an empty dictionary or a raw content one that cannot
+ * be identified.
+ */
+uint32_t zstd::dictionary_id(const std::string& dictionary) {
+  return dictionary.empty()
+             ? 0
+             : ZSTD_getDictID_fromDict(dictionary.data(), dictionary.size());
+}
+
+/**
+ * @brief Destructor.
+ */
+zstd::~zstd() noexcept {
+  ZSTD_freeCDict(_cdict);
+  ZSTD_freeDDict(_ddict);
+  ZSTD_freeCCtx(_cctx);
+  ZSTD_freeDCtx(_dctx);
+}
+
+/**
+ * Compression function
+ *
+ * @param data the data to compress.
+ *
+ * @return The same data compressed, preceded by their size on four bytes.
+ */
+std::vector<char> zstd::compress(std::vector<char> const& data) {
+  if (data.empty())
+    return {'\0', '\0', '\0', '\0'};
+
+  size_t nbytes = data.size();
+  size_t bound = ZSTD_compressBound(nbytes);
+  std::vector<char> retval(bound + 4);
+  size_t len;
+  if (_cdict)
+    len = ZSTD_compress_usingCDict(_cctx, retval.data() + 4, bound,
+                                   data.data(), nbytes, _cdict);
+  else
+    len = ZSTD_compressCCtx(_cctx, retval.data() + 4, bound, data.data(),
+                            nbytes, _level);
+  if (ZSTD_isError(len))
+    throw msg_fmt("compression: zstd cannot compress {} bytes: {}", nbytes,
+                  ZSTD_getErrorName(len));
+
+  retval.resize(len + 4);
+  retval[0] = (nbytes >> 24) & 0xff;
+  retval[1] = (nbytes >> 16) & 0xff;
+  retval[2] = (nbytes >> 8) & 0xff;
+  retval[3] = (nbytes & 0xff);
+  return retval;
+}
+
+/**
+ * Uncompress function
+ *
+ * @param data The data to extract.
+ * @param nbytes The data size in bytes.
+ *
+ * @return the extract data
+ */
+std::vector<char> zstd::uncompress(unsigned char const* data,
+                                   unsigned long nbytes) {
+  if (!data) {
+    log_v2::core()->debug("compression: attempting to uncompress null buffer");
+    return std::vector<char>();
+  }
+  if (nbytes < 4)
+    throw exceptions::corruption(
+        "compression: attempting to uncompress data with invalid size");
+  size_t expected_size =
+      (data[0] << 24) | (data[1] << 16) | (data[2] << 8) | data[3];
+  if (expected_size > stream::max_data_size)
+    throw exceptions::corruption("compression: data expected size is too big");
+  std::vector<char> retval(expected_size);
+  if (!expected_size)
+    return retval;
+
+  size_t len;
+  if (_ddict)
+    len = ZSTD_decompress_usingDDict(_dctx, retval.data(), expected_size,
+                                     data + 4, nbytes - 4, _ddict);
+  else
+    len = ZSTD_decompressDCtx(_dctx, retval.data(), expected_size, data + 4,
+                              nbytes - 4);
+  if (ZSTD_isError(len) || len != expected_size)
+    throw exceptions::corruption(
+        "compression: compressed input data is corrupted, unable to "
+        "uncompress it: {}",
+        ZSTD_isError(len) ? ZSTD_getErrorName(len) : "unexpected size");
+  return retval;
+}
@@ -18,11 +18,13 @@
 
 #include "com/centreon/broker/config/applier/state.hh"
 
+#include "com/centreon/broker/compression/stream.hh"
 #include "com/centreon/broker/config/applier/endpoint.hh"
 #include "com/centreon/broker/instance_broadcast.hh"
 #include "com/centreon/broker/log_v2.hh"
 #include "com/centreon/broker/multiplexing/engine.hh"
 #include "com/centreon/broker/multiplexing/muxer.hh"
+#include "com/centreon/broker/persistent_file.hh"
 #include "com/centreon/broker/vars.hh"
 #include "com/centreon/exceptions/msg_fmt.hh"
 
@@ -130,6 +132,18 @@ void state::apply(const com::centreon::broker::config::state& s, bool run_mux) {
   // Event queue max size (used to limit memory consumption).
   com::centreon::broker::multiplexing::muxer::event_queue_max_size(
       s.event_queue_max_size());
+  com::centreon::broker::multiplexing::muxer::event_queue_max_bytes(
+      s.event_queue_max_bytes());
+  com::centreon::broker::multiplexing::muxer::event_queues_memory_budget(
+      s.event_queues_memory_budget());
+
+  // Codec of the queue files, they can be read whatever their codec.
+  compression::codec queue_files_codec;
+  if (compression::parse_codec(s.queue_files_compression(), &queue_files_codec))
+    persistent_file::compression_codec(queue_files_codec);
+  persistent_file::file_options(s.queue_files_engine() == "segment_log",
+                                s.queue_files_max_size(),
+                                s.queue_files_sync_interval());
 
   com::centreon::broker::config::state st{s};
 
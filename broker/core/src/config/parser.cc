@@ -24,6 +24,7 @@
 #include <absl/strings/str_split.h>
 #include <streambuf>
 
+#include "com/centreon/broker/compression/stream.hh"
 #include "com/centreon/broker/exceptions/deprecated.hh"
 #include "com/centreon/broker/log_v2.hh"
 #include "com/centreon/broker/misc/filesystem.hh"
@@ -277,6 +278,42 @@ state parser::parse(std::string const& file) {
           auto eqts = check_and_read<uint64_t>(json_document["centreonBroker"],
                                                "event_queues_total_size");
           retval.event_queues_total_size(eqts.value());
+        } else if (it.key() == "event_queue_max_bytes") {
+          auto eqmb = check_and_read<uint64_t>(json_document["centreonBroker"],
+                                               "event_queue_max_bytes");
+          retval.event_queue_max_bytes(eqmb.value());
+        } else if (it.key() == "event_queues_memory_budget") {
+          auto eqmb = check_and_read<uint64_t>(json_document["centreonBroker"],
+                                               "event_queues_memory_budget");
+          retval.event_queues_memory_budget(eqmb.value());
+        } else if (get_conf<state>({it.key(), it.value()},
+                                   "queue_files_compression", retval,
+                                   &state::queue_files_compression,
+                                   &json::is_string)) {
+          compression::codec c;
+          if (!compression::parse_codec(retval.queue_files_compression(), &c))
+            throw msg_fmt(
+                "config parser: queue_files_compression must be 'zlib', "
+                "'zstd' or 'lz4' and not '{}'",
+                retval.queue_files_compression());
+        } else if (get_conf<state>({it.key(), it.value()},
+                                   "queue_files_engine", retval,
+                                   &state::queue_files_engine,
+                                   &json::is_string)) {
+          if (retval.queue_files_engine() != "splitter" &&
+              retval.queue_files_engine() != "segment_log")
+            throw msg_fmt(
+                "config parser: queue_files_engine must be 'splitter' or "
+                "'segment_log' and not '{}'",
+                retval.queue_files_engine());
+        } else if (it.key() == "queue_files_max_size") {
+          auto qfms = check_and_read<uint32_t>(json_document["centreonBroker"],
+                                               "queue_files_max_size");
+          retval.queue_files_max_size(qfms.value());
+        } else if (it.key() == "queue_files_sync_interval") {
+          auto qfsi = check_and_read<uint32_t>(json_document["centreonBroker"],
+                                               "queue_files_sync_interval");
+          retval.queue_files_sync_interval(qfsi.value());
         } else if (it.key() == "output") {
           if (it.value().is_array()) {
             for (const json& node : it.value()) {
@@ -53,6 +53,12 @@ state::state(const state& other)
       _command_protocol(other._command_protocol),
       _endpoints(other._endpoints),
       _event_queue_max_size(other._event_queue_max_size),
+      _event_queue_max_bytes(other._event_queue_max_bytes),
+      _event_queues_memory_budget(other._event_queues_memory_budget),
+      _queue_files_compression(other._queue_files_compression),
+      _queue_files_engine(other._queue_files_engine),
+      _queue_files_max_size(other._queue_files_max_size),
+      _queue_files_sync_interval(other._queue_files_sync_interval),
       _module_dir(other._module_dir),
       _module_list(other._module_list),
       _params(other._params),
@@ -83,6 +89,12 @@ state& state::operator=(state const& other) {
     _command_protocol = other._command_protocol;
     _endpoints = other._endpoints;
     _event_queue_max_size = other._event_queue_max_size;
+    _event_queue_max_bytes = other._event_queue_max_bytes;
+    _event_queues_memory_budget = other._event_queues_memory_budget;
+    _queue_files_compression = other._queue_files_compression;
+    _queue_files_engine = other._queue_files_engine;
+    _queue_files_max_size = other._queue_files_max_size;
+    _queue_files_sync_interval = other._queue_files_sync_interval;
     _module_dir = other._module_dir;
     _module_list = other._module_list;
     _params = other._params;
@@ -106,6 +118,12 @@ void state::clear() {
   _command_protocol = "json";
   _endpoints.clear();
   _event_queue_max_size = 10000;
+  _event_queue_max_bytes = 0u;
+  _event_queues_memory_budget = 0u;
+  _queue_files_compression = "zlib";
+  _queue_files_engine = "splitter";
+  _queue_files_max_size = 100000000u;
+  _queue_files_sync_interval = 0u;
   _module_dir.clear();
   _module_list.clear();
   _params.clear();
@@ -282,6 +300,117 @@ int state::event_queue_max_size() const noexcept {
   return _event_queue_max_size;
 }
 
+/**
+ *  Set the maximum memory used by each event queue, computed from the
+ *  estimated size of events. If 0, there is no limit.
+ *
+ *  @param[in] val Size limit in bytes.
+ */
+void state::event_queue_max_bytes(uint64_t val) noexcept {
+  _event_queue_max_bytes = val;
+}
+
+/**
+ *  Get the maximum memory used by each event queue.
+ *
+ *  @return The size limit in bytes, 0 if no limit.
+ */
+uint64_t state::event_queue_max_bytes() const noexcept {
+  return _event_queue_max_bytes;
+}
+
+/**
+ *  Set the memory budget shared by all the event queues. If 0, there is no
+ *  limit.
+ *
+ *  @param[in] val Size limit in bytes.
+ */
+void state::event_queues_memory_budget(uint64_t val) noexcept {
+  _event_queues_memory_budget = val;
+}
+
+/**
+ *  Get the memory budget shared by all the event queues.
+ *
+ *  @return The size limit in bytes, 0 if no limit.
+ */
+uint64_t state::event_queues_memory_budget() const noexcept {
+  return _event_queues_memory_budget;
+}
+
+/**
+ *  Set the codec used to compress the queue files.
+ *
+ *  @param[in] codec The codec name: zlib, zstd or lz4.
+ */
+void state::queue_files_compression(const std::string& codec) {
+  _queue_files_compression = codec;
+}
+
+/**
+ *  Get the codec used to compress the queue files.
+ *
+ *  @return The codec name.
+ */
+const std::string& state::queue_files_compression() const noexcept {
+  return _queue_files_compression;
+}
+
+/**
+ *  Set the engine used to store the queue files.
+ *
+ *  @param[in] engine The engine name: splitter or segment_log.
+ */
+void state::queue_files_engine(const std::string& engine) {
+  _queue_files_engine = engine;
+}
+
+/**
+ *  Get the engine used to store the queue files.
+ *
+ *  @return The engine name.
+ */
+const std::string& state::queue_files_engine() const noexcept {
+  return _queue_files_engine;
+}
+
+/**
+ *  Set the maximum size of each queue file part.
+ *
+ *  @param[in] size The size in bytes, 0 for no limit.
+ */
+void state::queue_files_max_size(uint32_t size) noexcept {
+  _queue_files_max_size = size;
+}
+
+/**
+ *  Get the maximum size of each queue file part.
+ *
+ *  @return The size in bytes.
+ */
+uint32_t state::queue_files_max_size() const noexcept {
+  return _queue_files_max_size;
+}
+
+/**
+ *  Set the minimum interval between two syncs to disk of the queue files,
+ *  only used by the segment_log engine.
+ *
+ *  @param[in] interval The interval in milliseconds, 0 to never sync.
+ */
+void state::queue_files_sync_interval(uint32_t interval) noexcept {
+  _queue_files_sync_interval = interval;
+}
+
+/**
+ *  Get the minimum interval between two syncs to disk of the queue files.
+ *
+ *  @return The interval in milliseconds.
+ */
+uint32_t state::queue_files_sync_interval() const noexcept {
+  return _queue_files_sync_interval;
+}
+
 /**
  *  Get the module directory.
  *
@@ -16,6 +16,10 @@
 * For more information : contact@centreon.com
 */
 #include "com/centreon/broker/file/disk_accessor.hh"
+
+#include <fcntl.h>
+#include <unistd.h>
+
 #include "com/centreon/broker/log_v2.hh"
 
 using namespace com::centreon::broker::file;
@@ -155,3 +159,61 @@ disk_accessor::fd disk_accessor::fopen(const std::string& name,
 void disk_accessor::fclose(disk_accessor::fd f) {
   ::fclose(f);
 }
+
+/**
+ * @brief Encapsulation of the pwrite() function, with the same limit size
+ * check as fwrite(). In case this limit size is reached, the return value is
+ * -1, errno is set to ENOSPC and nothing is written on disk.
+ *
+ * @param fildes The file descriptor.
+ * @param ptr The data to write.
+ * @param size Their size in bytes.
+ * @param offset Where to write them in the file.
+ *
+ * @return The number of bytes written or -1 on error.
+ */
+ssize_t disk_accessor::pwrite(int fildes,
+                              const void* ptr,
+                              size_t size,
+                              off_t offset) {
+  if (_limit_size == 0 || _current_size + size <= _limit_size) {
+    ssize_t retval = ::pwrite(fildes, ptr, size, offset);
+    if (retval > 0)
+      _current_size += retval;
+    return retval;
+  } else {
+    errno = ENOSPC;
+    log_v2::core()->error(
+        "disk_accessor: the limit size of {} bytes is reached for queue files. "
+        "New events written to disk are lost",
+        _limit_size);
+    return -1;
+  }
+}
+
+/**
+ * @brief Call the libc pread function.
+ *
+ * @param fildes The file descriptor.
+ * @param ptr Where to store the data read.
+ * @param size The maximum number of bytes to read.
+ * @param offset Where to read them in the file.
+ *
+ * @return The number of bytes read, 0 at the end of file or -1 on error.
+ */
+ssize_t disk_accessor::pread(int fildes, void* ptr, size_t size, off_t offset) {
+  return ::pread(fildes, ptr, size, offset);
+}
+
+/**
+ * @brief A binding to the libc open() function. Files are created with the
+ * 0644 mode.
+ *
+ * @param name The file name.
+ * @param flags The open flags.
+ *
+ * @return The file descriptor or -1 on error.
+ */
+int disk_accessor::open(const std::string& name, int flags) {
+  return ::open(name.c_str(), flags | O_CLOEXEC, 0644);
+}
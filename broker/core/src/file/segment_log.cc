@@ -0,0 +1,583 @@
+/**
+ * Copyright 2023 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/broker/file/segment_log.hh"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <fmt/format.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "com/centreon/broker/exceptions/shutdown.hh"
+#include "com/centreon/broker/file/disk_accessor.hh"
+#include "com/centreon/broker/log_v2.hh"
+#include "com/centreon/broker/misc/filesystem.hh"
+#include "com/centreon/exceptions/msg_fmt.hh"
+
+using namespace com::centreon::exceptions;
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::file;
+
+/**
+ *  Build a new segment log.
+ *
+ *  @param[in] path           Base path to file.
+ *  @param[in] max_file_size  Maximum single segment size.
+ *  @param[in] auto_delete    True to delete segments as they are read.
+ *  @param[in] sync_interval  Minimum interval in milliseconds between two
+ *                            fdatasync() of the write segment, 0 to never
+ *                            sync.
+ */
+segment_log::segment_log(const std::string& path,
+                         uint32_t max_file_size,
+                         bool auto_delete,
+                         uint32_t sync_interval)
+    : _auto_delete{auto_delete},
+      _base_path{path},
+      _max_file_size{max_file_size == 0u
+                         ? std::numeric_limits<uint32_t>::max()
+                         : std::max(max_file_size, 10000u)},
+      _sync_interval{sync_interval},
+      _rfd{-1},
+      _roffset{header_size},
+      _checkpoint_id{-1},
+      _checkpoint_offset{0},
+      _wfd{-1},
+      _last_sync{std::chrono::steady_clock::now()},
+      _wpos{0u} {
+  // Segments are named like the splitter parts: /var/lib/foo,
+  // /var/lib/foo1, /var/lib/foo2, ... in this order.
+  std::string base_dir;
+  std::string base_name;
+  {
+    size_t last_slash(_base_path.find_last_of('/'));
+    if (last_slash == std::string::npos) {
+      base_dir = ".";
+      base_name = _base_path;
+    } else {
+      base_dir = _base_path.substr(0, last_slash);
+      base_name = _base_path.substr(last_slash + 1);
+    }
+  }
+  std::list<std::string> parts{
+      misc::filesystem::dir_content_with_filter(base_dir, base_name + '*')};
+  int32_t rid = std::numeric_limits<int32_t>::max();
+  int32_t wid = 0;
+  size_t offset{base_dir.size() + base_name.size()};
+  if (!base_dir.empty() && base_dir.back() != '/')
+    offset++;
+  size_t size = 0;
+  struct stat file_stat;
+  for (auto& f : parts) {
+    const char* ptr{f.c_str() + offset};
+    int val = 0;
+    if (*ptr) {  // Not empty, conversion needed.
+      char* endptr = nullptr;
+      val = strtol(ptr, &endptr, 10);
+      if (endptr && *endptr)  // Invalid conversion, the index for example.
+        continue;
+    }
+
+    if (val < rid)
+      rid = val;
+    if (val > wid)
+      wid = val;
+
+    if (stat(f.c_str(), &file_stat) == 0)
+      size += file_stat.st_size;
+  }
+  disk_accessor::instance().set_current_size(size);
+
+  if (rid == std::numeric_limits<int32_t>::max() || rid < 0)
+    rid = 0;
+  _rid = rid;
+
+  _load_index();
+
+  std::lock_guard<std::mutex> lck(_write_m);
+  _open_write_file(wid);
+}
+
+/**
+ *  Destructor.
+ */
+segment_log::~segment_log() noexcept {
+  close();
+}
+
+/**
+ *  Close the segments and save the read position in the index.
+ */
+void segment_log::close() {
+  std::lock_guard<std::mutex> lck(_write_m);
+  _close_read_file();
+  _close_write_file();
+  _save_index();
+}
+
+/**
+ *  Read data. The write mutex is never taken here, data are read up to the
+ *  end published by the writers.
+ *
+ *  @param[out] buffer    Output buffer.
+ *  @param[in]  max_size  Maximum number of bytes that can be read.
+ *
+ *  @return Number of bytes read.
+ */
+long segment_log::read(void* buffer, long max_size) {
+  for (;;) {
+    uint64_t pos = _wpos.load();
+    int32_t rid = _rid;
+
+    /* The reader closed the last segment and no one wrote since. */
+    if (_id(pos) < rid)
+      return 0;
+
+    if (_rfd < 0) {
+      _open_read_file();
+      if (_rfd < 0)
+        return 0;
+    }
+
+    long roffset = _roffset;
+    ssize_t rb;
+    if (_id(pos) == rid) {
+      long available = static_cast<long>(_offset(pos)) - roffset;
+      rb = available > 0 ? disk_accessor::instance().pread(
+                               _rfd, buffer, std::min(available, max_size),
+                               roffset)
+                         : 0;
+    } else
+      rb = disk_accessor::instance().pread(_rfd, buffer, max_size, roffset);
+
+    if (rb < 0) {
+      if (errno == EAGAIN || errno == EINTR)
+        return 0;
+      char msg[1024];
+      throw msg_fmt("error while reading file '{}': {}", get_file_path(rid),
+                    strerror_r(errno, msg, sizeof(msg)));
+    }
+
+    if (rb > 0) {
+      log_v2::bbdo()->debug("segment_log: read {} bytes at offset {} from '{}'",
+                            rb, roffset, get_file_path(rid));
+      _roffset = roffset + rb;
+      return rb;
+    }
+
+    /* End of the segment. If the writers are on a later one, this one is
+     * complete. */
+    if (_id(pos) > rid) {
+      _close_read_file();
+      if (_auto_delete) {
+        log_v2::bbdo()->info("file: end of file '{}' reached, erasing it",
+                             get_file_path(rid));
+        disk_accessor::instance().remove(get_file_path(rid));
+      }
+      _roffset = header_size;
+      _rid = rid + 1;
+      continue;
+    }
+
+    if (_auto_delete) {
+      /* Fails if a writer published new data meanwhile, we read them. */
+      if (!_wpos.compare_exchange_strong(pos, pos | closed_flag))
+        continue;
+      _close_read_file();
+      log_v2::bbdo()->info("file: end of file '{}' reached, erasing it",
+                           get_file_path(rid));
+      disk_accessor::instance().remove(get_file_path(rid));
+      _roffset = header_size;
+      _rid = rid + 1;
+    }
+    throw exceptions::shutdown("No more data to read");
+  }
+}
+
+/**
+ *  Throw an exception.
+ *
+ *  @param[in] offset  Unused.
+ *  @param[in] whence  Unused.
+ */
+void segment_log::seek(long offset, fs_file::seek_whence whence) {
+  (void)offset;
+  (void)whence;
+  throw msg_fmt("cannot seek within a segment log");
+}
+
+/**
+ *  Get current position.
+ *
+ *  @return Current position in file.
+ */
+long segment_log::tell() {
+  return _roffset;
+}
+
+/**
+ *  Write data.
+ *
+ *  @param[in] buffer  Data.
+ *  @param[in] size    Number of bytes in buffer.
+ *
+ *  @return Number of bytes written.
+ */
+long segment_log::write(void const* buffer, long size) {
+  std::lock_guard<std::mutex> lck(_write_m);
+  for (;;) {
+    uint64_t pos = _wpos.load();
+
+    /* The reader removed the write segment, we continue in the next one. */
+    if (pos & closed_flag) {
+      _close_write_file();
+      if (!_open_write_file(_id(pos) + 1))
+        return 0;
+      continue;
+    }
+
+    if (_wfd < 0) {
+      if (!_open_write_file(_id(pos)))
+        return 0;
+      continue;
+    }
+
+    uint32_t woffset = _offset(pos);
+    if (woffset > header_size &&
+        static_cast<uint64_t>(woffset) + size > _max_file_size) {
+      _sync(true);
+      _close_write_file();
+      if (!_open_write_file(_id(pos) + 1))
+        return 0;
+      continue;
+    }
+
+    log_v2::bbdo()->debug("file: write request of {} bytes for '{}'", size,
+                          get_file_path(_id(pos)));
+
+    ssize_t wb =
+        disk_accessor::instance().pwrite(_wfd, buffer, size, woffset);
+    if (wb != size) {
+      char msg[1024];
+      log_v2::bbdo()->critical("segment_log: cannot write to file '{}': {}",
+                               get_file_path(_id(pos)),
+                               strerror_r(errno, msg, sizeof(msg)));
+      return 0;
+    }
+
+    /* Fails only if the reader closed the segment while we were writing in
+     * it, the data are then written again in the next segment. */
+    if (_wpos.compare_exchange_strong(pos, _pos(_id(pos), woffset + size))) {
+      _sync(false);
+      return size;
+    }
+  }
+}
+
+/**
+ *  Data are already in the kernel after each write. If syncing is enabled,
+ *  they are synced to disk now.
+ */
+void segment_log::flush() {
+  std::lock_guard<std::mutex> lck(_write_m);
+  _sync(true);
+}
+
+/**
+ *  Remember the position of the last consumed byte, it is saved in the
+ *  index on close. If the unread bytes begin in a previous segment, the
+ *  previous checkpoint is kept.
+ *
+ *  @param[in] unread  Number of bytes read but not consumed yet.
+ */
+void segment_log::checkpoint(long unread) {
+  long offset = _roffset - unread;
+  if (offset >= static_cast<long>(header_size)) {
+    _checkpoint_id = _rid;
+    _checkpoint_offset = offset;
+  }
+}
+
+/**
+ *  Get the file path matching the ID.
+ *
+ *  @param[in] id Current ID.
+ */
+std::string segment_log::get_file_path(int id) const {
+  if (id)
+    return fmt::format("{}{}", _base_path, id);
+  else
+    return _base_path;
+}
+
+/**
+ *  Get max file size.
+ *
+ *  @return Max file size.
+ */
+size_t segment_log::max_file_size() const {
+  return _max_file_size;
+}
+
+/**
+ *  Get current read ID.
+ *
+ *  @return Current read ID.
+ */
+int32_t segment_log::get_rid() const {
+  return _rid;
+}
+
+/**
+ *  Get current read offset.
+ *
+ *  @return Current read offset.
+ */
+long segment_log::get_roffset() const {
+  return _roffset;
+}
+
+/**
+ *  Get current write ID. If the reader closed the write segment, this is
+ *  the one the next write will create.
+ *
+ *  @return Current write ID.
+ */
+int32_t segment_log::get_wid() const {
+  uint64_t pos = _wpos;
+  return pos & closed_flag ? _id(pos) + 1 : _id(pos);
+}
+
+/**
+ *  Get current write offset.
+ *
+ *  @return Current write offset.
+ */
+long segment_log::get_woffset() const {
+  uint64_t pos = _wpos;
+  return pos & closed_flag ? header_size : _offset(pos);
+}
+
+/**
+ *  Remove all the segments and the index.
+ */
+void segment_log::remove_all_files() {
+  std::lock_guard<std::mutex> lck(_write_m);
+  _close_read_file();
+  _close_write_file();
+  std::string base_dir;
+  std::string base_name;
+  {
+    size_t last_slash(_base_path.find_last_of('/'));
+    if (last_slash == std::string::npos) {
+      base_dir = "./";
+      base_name = _base_path;
+    } else {
+      base_dir = _base_path.substr(0, last_slash + 1);
+      base_name = _base_path.substr(last_slash + 1);
+    }
+  }
+  std::list<std::string> parts{
+      misc::filesystem::dir_content_with_filter(base_dir, base_name + '*')};
+  for (const std::string& f : parts)
+    disk_accessor::instance().remove(f);
+
+  /* No more files, the next write creates the first segment again. */
+  _rid = 0;
+  _roffset = header_size;
+  _checkpoint_id = -1;
+  _wpos = _pos(0, header_size);
+}
+
+/**
+ *  Get the path of the index file.
+ *
+ *  @return The index path.
+ */
+std::string segment_log::_index_path() const {
+  return fmt::format("{}.idx", _base_path);
+}
+
+/**
+ *  Load the read position saved by a previous instance and remove the index.
+ *  It is used only if it points into the first segment.
+ */
+void segment_log::_load_index() {
+  std::string path(_index_path());
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return;
+
+  uint32_t index[2];
+  ssize_t rb = ::read(fd, index, sizeof(index));
+  ::close(fd);
+  std::remove(path.c_str());
+
+  if (rb != sizeof(index))
+    return;
+
+  int32_t id = ntohl(index[0]);
+  uint32_t offset = ntohl(index[1]);
+  struct stat file_stat;
+  if (id == _rid && stat(get_file_path(id).c_str(), &file_stat) == 0 &&
+      offset >= header_size && offset <= file_stat.st_size) {
+    log_v2::bbdo()->info("segment_log: resume reading '{}' at offset {}",
+                         get_file_path(id), offset);
+    _roffset = offset;
+    _checkpoint_id = id;
+    _checkpoint_offset = offset;
+  }
+}
+
+/**
+ *  Save the last checkpoint in the index if its segment still exists.
+ */
+void segment_log::_save_index() {
+  if (_checkpoint_id < 0 ||
+      !misc::filesystem::file_exists(get_file_path(_checkpoint_id)))
+    return;
+
+  std::string path(_index_path());
+  int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd < 0) {
+    char msg[1024];
+    log_v2::bbdo()->error("segment_log: cannot open index '{}': {}", path,
+                          strerror_r(errno, msg, sizeof(msg)));
+    return;
+  }
+  uint32_t index[2]{htonl(_checkpoint_id),
+                    htonl(static_cast<uint32_t>(_checkpoint_offset))};
+  if (::write(fd, index, sizeof(index)) != sizeof(index)) {
+    char msg[1024];
+    log_v2::bbdo()->error("segment_log: cannot write index '{}': {}", path,
+                          strerror_r(errno, msg, sizeof(msg)));
+    ::close(fd);
+    std::remove(path.c_str());
+    return;
+  }
+  ::close(fd);
+}
+
+/**
+ *  Open the read segment. If it does not exist, _rfd stays negative.
+ */
+void segment_log::_open_read_file() {
+  std::string fname(get_file_path(_rid));
+  _rfd = disk_accessor::instance().open(fname, O_RDONLY);
+  if (_rfd >= 0) {
+    log_v2::bbdo()->debug("segment_log: read open '{}'", fname);
+    return;
+  }
+  if (errno == ENOENT)
+    return;
+  char msg[1024];
+  throw msg_fmt("cannot open '{}' to read: {}", fname,
+                strerror_r(errno, msg, sizeof(msg)));
+}
+
+/**
+ *  Close the read segment if it is open.
+ */
+void segment_log::_close_read_file() {
+  if (_rfd >= 0) {
+    ::close(_rfd);
+    _rfd = -1;
+  }
+}
+
+/**
+ *  Open or create a write segment, preallocate its blocks and publish its
+ *  end as the write position. This call must be protected by the _write_m
+ *  mutex.
+ *
+ *  @param[in] id  The segment id.
+ *
+ *  @return True on success, False otherwise.
+ */
+bool segment_log::_open_write_file(int32_t id) {
+  std::string fname(get_file_path(id));
+  _wfd = disk_accessor::instance().open(fname, O_RDWR | O_CREAT);
+  if (_wfd < 0) {
+    char msg[1024];
+    log_v2::bbdo()->error("segment_log: write fail open '{}'", fname);
+    throw msg_fmt("cannot open '{}' to read/write: {}", fname,
+                  strerror_r(errno, msg, sizeof(msg)));
+  }
+  log_v2::bbdo()->debug("segment_log: write open '{}'", fname);
+
+  struct stat file_stat;
+  uint32_t woffset = fstat(_wfd, &file_stat) == 0 ? file_stat.st_size : 0u;
+
+  // Ensure 8-bytes header is written at file beginning.
+  if (woffset < header_size) {
+    uint32_t header[2]{0, htonl(header_size)};
+    if (disk_accessor::instance().pwrite(_wfd, header, sizeof(header), 0) !=
+        sizeof(header)) {
+      char msg[1024];
+      log_v2::bbdo()->critical("segment_log: cannot write to file '{}': {}",
+                               fname, strerror_r(errno, msg, sizeof(msg)));
+      _close_write_file();
+      return false;
+    }
+    woffset = header_size;
+  }
+
+  /* Blocks are reserved without changing the file size, it is still the end
+   * of data. Not all file systems support it, it is only an optimization. */
+  if (_max_file_size != std::numeric_limits<uint32_t>::max() &&
+      woffset < _max_file_size)
+    fallocate(_wfd, FALLOC_FL_KEEP_SIZE, woffset, _max_file_size - woffset);
+
+  _wpos = _pos(id, woffset);
+  return true;
+}
+
+/**
+ *  Close the write segment if it is open. This call must be protected by the
+ *  _write_m mutex.
+ */
+void segment_log::_close_write_file() {
+  if (_wfd >= 0) {
+    _sync(true);
+    ::close(_wfd);
+    _wfd = -1;
+  }
+}
+
+/**
+ *  Sync the write segment to disk if syncing is enabled and the last sync is
+ *  older than the sync interval. This call must be protected by the _write_m
+ *  mutex.
+ *
+ *  @param[in] force  True to sync even if the interval is not elapsed.
+ */
+void segment_log::_sync(bool force) {
+  if (_sync_interval == 0 || _wfd < 0)
+    return;
+  auto now = std::chrono::steady_clock::now();
+  if (force || now - _last_sync >= std::chrono::milliseconds(_sync_interval)) {
+    if (fdatasync(_wfd)) {
+      char msg[1024];
+      log_v2::bbdo()->error("segment_log: cannot sync file '{}': {}",
+                            get_file_path(_id(_wpos)),
+                            strerror_r(errno, msg, sizeof(msg)));
+    }
+    _last_sync = now;
+  }
+}
@@ -21,6 +21,8 @@
 #include <fmt/chrono.h>
 
 #include "broker.pb.h"
+#include "com/centreon/broker/file/segment_log.hh"
+#include "com/centreon/broker/file/splitter.hh"
 #include "com/centreon/broker/io/raw.hh"
 #include "com/centreon/broker/log_v2.hh"
 #include "com/centreon/broker/misc/math.hh"
@@ -35,14 +37,28 @@ static constexpr double eps = 0.000001;
 /**
  *  Constructor.
  *
- *  @param[in] file  Splitted file on which the stream will operate.
+ *  @param[in] path           Base path of the splitted file on which the
+ *                            stream will operate.
+ *  @param[in] s              Statistics of the file, may be null.
+ *  @param[in] max_file_size  Maximum size of each file part.
+ *  @param[in] auto_delete    True to delete file parts as they are read.
+ *  @param[in] segmented      True to use a segment_log instead of a
+ *                            splitter.
+ *  @param[in] sync_interval  Interval in milliseconds between two syncs of
+ *                            a segment_log to disk, 0 to never sync.
  */
 stream::stream(const std::string& path,
                QueueFileStats* s,
                uint32_t max_file_size,
-               bool auto_delete)
+               bool auto_delete,
+               bool segmented,
+               uint32_t sync_interval)
     : io::stream("file"),
-      _splitter(path, max_file_size, auto_delete),
+      _splitter{segmented ? std::unique_ptr<splitted_file>(new segment_log(
+                                path, max_file_size, auto_delete,
+                                sync_interval))
+                          : std::unique_ptr<splitted_file>(new splitter(
+                                path, max_file_size, auto_delete))},
       _stats{s},
       _last_stats{time(nullptr)},
       _last_stats_perc{time(nullptr)},
@@ -59,7 +75,7 @@ stream::stream(const std::string& path,
  *  @return Peer name.
  */
 std::string stream::peer() const {
-  return fmt::format("file://{}", _splitter.get_file_path());
+  return fmt::format("file://{}", _splitter->get_file_path());
 }
 
 /**
@@ -80,7 +96,7 @@ bool stream::read(std::shared_ptr<io::data>& d, time_t deadline) {
   data->resize(BUFSIZ);
 
   // Read data.
-  long rb(_splitter.read(data->data(), data->size()));
+  long rb(_splitter->read(data->data(), data->size()));
   if (rb) {
     data->resize(rb);
     d.reset(data.release());
@@ -97,11 +113,11 @@ bool stream::read(std::shared_ptr<io::data>& d, time_t deadline) {
  */
 void stream::statistics(nlohmann::json& tree) const {
   // Get base properties.
-  uint32_t max_file_size(_splitter.max_file_size());
-  int rid(_splitter.get_rid());
-  long roffset(_splitter.get_roffset());
-  int wid(_splitter.get_wid());
-  long woffset(_splitter.get_woffset());
+  uint32_t max_file_size(_splitter->max_file_size());
+  int rid(_splitter->get_rid());
+  long roffset(_splitter->get_roffset());
+  int wid(_splitter->get_wid());
+  long woffset(_splitter->get_woffset());
 
   // Easy to print.
   tree["file_read_path"] = rid;
@@ -165,11 +181,11 @@ void stream::_update_stats() {
   if (now > _last_stats) {
     _last_stats = now;
 
-    const double mm = _splitter.max_file_size();
-    int32_t roffset = _splitter.get_roffset();
-    int32_t woffset = _splitter.get_woffset();
-    int32_t wid = _splitter.get_wid();
-    int32_t rid = _splitter.get_rid();
+    const double mm = _splitter->max_file_size();
+    int32_t roffset = _splitter->get_roffset();
+    int32_t woffset = _splitter->get_woffset();
+    int32_t wid = _splitter->get_wid();
+    int32_t rid = _splitter->get_rid();
     double a = static_cast<double>(roffset) + static_cast<double>(rid) * mm;
     double b = static_cast<double>(woffset) + static_cast<double>(wid) * mm;
     double m, p;
@@ -271,7 +287,7 @@ int32_t stream::write(std::shared_ptr<io::data> const& d) {
 
     // Write data.
     while (size > 0) {
-      long wb(_splitter.write(memory, size));
+      long wb(_splitter->write(memory, size));
       size -= wb;
       memory += wb;
     }
@@ -290,13 +306,23 @@ int32_t stream::stop() {
   return 0;
 }
 
+/**
+ *  Tell the file that all the data read but the last unread bytes have been
+ *  consumed.
+ *
+ *  @param[in] unread  Number of bytes read but not consumed yet.
+ */
+void stream::checkpoint(long unread) {
+  _splitter->checkpoint(unread);
+}
+
 /**
  *  Remove all the files this stream in concerned by.
  */
 void stream::remove_all_files() {
-  _splitter.remove_all_files();
+  _splitter->remove_all_files();
 }
 
 uint32_t stream::max_file_size() const {
-  return _splitter.max_file_size();
+  return _splitter->max_file_size();
 }
@@ -20,6 +20,7 @@
 #include <cassert>
 #include "bbdo/events.hh"
 #include "com/centreon/broker/io/events.hh"
+#include "com/centreon/broker/mapping/entry.hh"
 
 using namespace com::centreon::broker::io;
 
@@ -29,7 +30,10 @@ uint32_t data::broker_id(0);
  *  Constructor.
  */
 data::data(uint32_t type)
-    : _type(type), source_id(broker_id), destination_id(0) {
+    : _type(type),
+      _estimated_size{0u},
+      source_id(broker_id),
+      destination_id(0) {
   assert(type);
 }
 
@@ -40,6 +44,7 @@ data::data(uint32_t type)
  */
 data::data(data const& other)
     : _type(other._type),
+      _estimated_size{0u},
       source_id(other.source_id),
       destination_id(other.destination_id) {}
 
@@ -54,6 +59,7 @@ data& data::operator=(data const& other) {
   if (this != &other) {
     source_id = other.source_id;
     destination_id = other.destination_id;
+    _estimated_size = 0u;
   }
   return *this;
 }
@@ -90,3 +96,60 @@ void data::dump_more_detail(std::ostream& s) const {
  * @param s
  */
 void data::dump_to_json(std::ostream& s [[maybe_unused]]) const {}
+
+/**
+ * @brief Estimate the size of this event once serialized. This size is used
+ * to limit the memory used by queues, so it does not need to be exact. It is
+ * computed the first time it is asked and then kept.
+ *
+ * @return A size in bytes, header included.
+ */
+uint32_t data::estimated_size() const {
+  uint32_t retval = _estimated_size.load(std::memory_order_relaxed);
+  if (!retval) {
+    retval = _compute_size();
+    _estimated_size.store(retval, std::memory_order_relaxed);
+  }
+  return retval;
+}
+
+/**
+ * @brief Default size estimation, used by events based on a mapping. Each
+ * entry is counted with its BBDO size, strings with their real length.
+ * Events without mapping are given a fixed size.
+ *
+ * @return A size in bytes, header included.
+ */
+uint32_t data::_compute_size() const {
+  constexpr uint32_t header_size = 16;
+  uint32_t retval = header_size;
+  const auto event_info = io::events::instance().get_event_info(_type);
+  if (event_info && event_info->get_mapping()) {
+    for (const mapping::entry* current_entry = event_info->get_mapping();
+         !current_entry->is_null(); ++current_entry) {
+      if (!current_entry->get_serialize())
+        continue;
+      switch (current_entry->get_type()) {
+        case mapping::source::BOOL:
+          retval += 1;
+          break;
+        case mapping::source::SHORT:
+        case mapping::source::USHORT:
+          retval += 2;
+          break;
+        case mapping::source::INT:
+        case mapping::source::UINT:
+          retval += 4;
+          break;
+        case mapping::source::STRING:
+          retval += current_entry->get_string(*this).size() + 1;
+          break;
+        default:
+          retval += 8;
+          break;
+      }
+    }
+  } else
+    retval += 48;
+  return retval;
+}
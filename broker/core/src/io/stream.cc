@@ -49,6 +49,20 @@ int stream::flush() {
   return 0;
 }
 
+/**
+ *  Write several events. By default, they are written one by one.
+ *
+ *  @param[in] events  Data to send.
+ *
+ *  @return Number of events acknowledged.
+ */
+int32_t stream::write(const std::vector<std::shared_ptr<data>>& events) {
+  int32_t retval = 0;
+  for (auto& d : events)
+    retval += write(d);
+  return retval;
+}
+
 /**
  *  Get peer name.
  *
@@ -49,9 +49,30 @@ std::string misc::temp_path() {
   return (path);
 }
 
-static const uint16_t crc_tbl[16] = {
-    0x0000, 0x1081, 0x2102, 0x3183, 0x4204, 0x5285, 0x6306, 0x7387,
-    0x8408, 0x9489, 0xa50a, 0xb58b, 0xc60c, 0xd68d, 0xe70e, 0xf78f};
+namespace {
+/**
+ * @brief Lookup tables of the reflected CRC-CCITT (polynomial 0x8408) used by
+ * crc16_ccitt(). The first one gives the remainder of one byte, the second
+ * one the remainder of a byte followed by eight zero bits, so that two bytes
+ * are consumed per iteration (slice-by-2).
+ */
+struct crc16_tables {
+  uint16_t tbl[2][256];
+
+  constexpr crc16_tables() : tbl{} {
+    for (uint32_t i = 0; i < 256; ++i) {
+      uint16_t crc = i;
+      for (int j = 0; j < 8; ++j)
+        crc = (crc & 1) ? (crc >> 1) ^ 0x8408 : crc >> 1;
+      tbl[0][i] = crc;
+    }
+    for (uint32_t i = 0; i < 256; ++i)
+      tbl[1][i] = (tbl[0][i] >> 8) ^ tbl[0][tbl[0][i] & 0xff];
+  }
+};
+
+constexpr crc16_tables crc_tbl;
+}  // namespace
 
 /**
  *
@@ -64,12 +85,12 @@ static const uint16_t crc_tbl[16] = {
 uint16_t misc::crc16_ccitt(char const* data, uint32_t data_len) {
   uint16_t crc = 0xffff;
   const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
-  while (data_len--) {
-    uint8_t c = *p++;
-    crc = ((crc >> 4) & 0x0fff) ^ crc_tbl[((crc ^ c) & 15)];
-    c >>= 4;
-    crc = ((crc >> 4) & 0x0fff) ^ crc_tbl[((crc ^ c) & 15)];
+  for (; data_len >= 2; data_len -= 2, p += 2) {
+    crc ^= p[0] | (p[1] << 8);
+    crc = crc_tbl.tbl[1][crc & 0xff] ^ crc_tbl.tbl[0][crc >> 8];
   }
+  if (data_len)
+    crc = (crc >> 8) ^ crc_tbl.tbl[0][(crc ^ *p) & 0xff];
   return ~crc & 0xffff;
 }
 
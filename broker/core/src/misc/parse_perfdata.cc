@@ -16,7 +16,7 @@
 * For more information : contact@centreon.com
 */
 
-#include <cctype>
+#include <array>
 #include <cfloat>
 #include <cmath>
 
@@ -29,6 +29,96 @@
 using namespace com::centreon::broker;
 using namespace com::centreon::broker::misc;
 
+namespace {
+/* Classes of the characters met in a perfdata string. */
+enum char_class : uint8_t {
+  /* isspace() in the C locale. */
+  space = 1,
+  /* Spaces trimmed around a metric name. */
+  blank = 2,
+  /* Characters ending a metric name out of quotes. */
+  name_end = 4,
+  /* Characters ending a metric name in quotes. */
+  quoted_name_end = 8,
+};
+
+/**
+ *  Build the table giving the classes of each character.
+ *
+ *  @return A table indexed by unsigned chars.
+ */
+constexpr std::array<uint8_t, 256> build_char_classes() {
+  std::array<uint8_t, 256> retval{};
+  for (unsigned char c : {' ', '\t', '\n', '\v', '\f', '\r'})
+    retval[c] |= space | name_end;
+  for (unsigned char c : {' ', '\t', '\n', '\r'})
+    retval[c] |= blank;
+  for (unsigned char c : {'\0', '=', '\''})
+    retval[c] |= name_end;
+  for (unsigned char c : {'\0', '\''})
+    retval[c] |= quoted_name_end;
+  return retval;
+}
+
+constexpr std::array<uint8_t, 256> char_classes = build_char_classes();
+
+inline bool is(char c, char_class cls) {
+  return char_classes[static_cast<unsigned char>(c)] & cls;
+}
+
+/* Powers of ten exactly represented as doubles. */
+constexpr double pow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                            1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                            1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+}  // namespace
+
+/**
+ *  Parse a plain decimal number (no exponent, no hexadecimal, no inf/nan),
+ *  only when the result is exact with one double division, so it is the
+ *  same as the strtod() one.
+ *
+ *  @param[in]  str  The string to parse.
+ *  @param[out] end  The end of the number if successful.
+ *
+ *  @return The number or NaN if strtod() has to be used.
+ */
+static inline double fast_strtod(char const* str, char const** end) {
+  constexpr uint64_t max_exact = 1ull << 53;
+  char const* p = str;
+  bool negative = false;
+  if (*p == '-' || *p == '+') {
+    negative = *p == '-';
+    ++p;
+  }
+  uint64_t mantissa = 0;
+  uint32_t digits = 0;
+  uint32_t decimals = 0;
+  while (*p >= '0' && *p <= '9') {
+    mantissa = mantissa * 10 + (*p - '0');
+    if (mantissa > max_exact)
+      return NAN;
+    ++digits;
+    ++p;
+  }
+  if (*p == '.') {
+    ++p;
+    while (*p >= '0' && *p <= '9') {
+      mantissa = mantissa * 10 + (*p - '0');
+      if (mantissa > max_exact || decimals == 22)
+        return NAN;
+      ++digits;
+      ++decimals;
+      ++p;
+    }
+  }
+  /* Exponents and hexadecimal numbers are left to strtod(). */
+  if (!digits || *p == 'e' || *p == 'E' || *p == 'x' || *p == 'X')
+    return NAN;
+  *end = p;
+  double retval = static_cast<double>(mantissa) / pow10[decimals];
+  return negative ? -retval : retval;
+}
+
 /**
  *  Extract a real value from a perfdata string.
  *
@@ -39,28 +129,32 @@ using namespace com::centreon::broker::misc;
  */
 static inline double extract_double(char const** str, bool skip = true) {
   double retval;
-  char* tmp;
-  if (isspace(**str))
+  char const* tmp;
+  if (is(**str, space))
     retval = NAN;
   else {
-    char const* comma{strchr(*str, ',')};
-    if (comma) {
-      /* In case of comma decimal separator, we duplicate the number and
-       * replace the comma by a point. */
-      size_t t = strcspn(comma, " \t\n\r;");
-      char* nb = strndup(*str, (comma - *str) + t);
-      nb[comma - *str] = '.';
-      retval = strtod(nb, &tmp);
-      if (nb == tmp)
-        retval = NAN;
-      *str = *str + (tmp - nb);
-      free(nb);
-    } else {
-      retval = strtod(*str, &tmp);
-      if (*str == tmp)
-        retval = NAN;
-      *str = tmp;
+    retval = fast_strtod(*str, &tmp);
+    if (std::isnan(retval) || *tmp == ',') {
+      /* strtod() never goes beyond a space or a semicolon. */
+      char const* comma = *str + strcspn(*str, " \t\n\r;,");
+      if (*comma == ',') {
+        /* In case of comma decimal separator, we duplicate the number and
+         * replace the comma by a point. */
+        size_t t = strcspn(comma, " \t\n\r;");
+        std::string nb(*str, (comma - *str) + t);
+        nb[comma - *str] = '.';
+        char* end;
+        retval = strtod(nb.c_str(), &end);
+        tmp = *str + (end - nb.c_str());
+      } else {
+        char* end;
+        retval = strtod(*str, &end);
+        tmp = end;
+      }
     }
+    if (*str == tmp)
+      retval = NAN;
+    *str = tmp;
     if (skip && (**str == ';'))
       ++*str;
   }
@@ -121,12 +215,12 @@ static inline void extract_range(double* low,
  * @param service_id The service id of the service with this perfdata
  * @param str The perfdata string to parse
  *
- * @return A list of perfdata
+ * @return An array of perfdata
  */
-std::list<perfdata> misc::parse_perfdata(uint32_t host_id,
-                                         uint32_t service_id,
-                                         const char* str) {
-  std::list<perfdata> retval;
+std::vector<perfdata> misc::parse_perfdata(uint32_t host_id,
+                                           uint32_t service_id,
+                                           const char* str) {
+  std::vector<perfdata> retval;
   auto id = [host_id, service_id] {
     if (host_id || service_id)
       return fmt::format("({}:{})", host_id, service_id);
@@ -138,15 +232,16 @@ std::list<perfdata> misc::parse_perfdata(uint32_t host_id,
   const char* buf = str + start;
 
   // Debug message.
-  log_v2::perfdata()->debug("storage: parsing service {} perfdata string '{}'",
-                            id(), buf);
+  if (log_v2::perfdata()->level() <= spdlog::level::debug)
+    log_v2::perfdata()->debug(
+        "storage: parsing service {} perfdata string '{}'", id(), buf);
 
   char const* tmp = buf;
 
   auto skip = [](char const* tmp) -> char const* {
-    while (*tmp && !isspace(*tmp))
+    while (*tmp && !is(*tmp, space))
       ++tmp;
-    while (isspace(*tmp))
+    while (is(*tmp, space))
       ++tmp;
     return tmp;
   };
@@ -160,10 +255,12 @@ std::list<perfdata> misc::parse_perfdata(uint32_t host_id,
     // Get metric name.
     bool in_quote{false};
     char const* end{tmp};
-    while (*end && (in_quote || (*end != '=' && !isspace(*end)) ||
-                    static_cast<unsigned char>(*end) >= 128)) {
-      if ('\'' == *end)
-        in_quote = !in_quote;
+    for (;;) {
+      while (!is(*end, in_quote ? quoted_name_end : name_end))
+        ++end;
+      if (*end != '\'')
+        break;
+      in_quote = !in_quote;
       ++end;
     }
 
@@ -176,16 +273,16 @@ std::list<perfdata> misc::parse_perfdata(uint32_t host_id,
     // We also remove spaces by the way.
     if (*s == '\'')
       ++s;
-    if (*end == '\'')
+    if (end >= s && *end == '\'')
       --end;
 
-    while (*s && strchr(" \n\r\t", *s))
+    while (is(*s, blank))
       ++s;
-    while (end != s && strchr(" \n\r\t", *end))
+    while (end > s && is(*end, blank))
       --end;
 
     /* The label is given by s and finishes at end */
-    if (*end == ']') {
+    if (end >= s && *end == ']') {
       --end;
       if (strncmp(s, "a[", 2) == 0) {
         s += 2;
@@ -210,7 +307,7 @@ std::list<perfdata> misc::parse_perfdata(uint32_t host_id,
     } else {
       log_v2::perfdata()->error(
           "In service {}, metric name empty before '{}...'", id(),
-          fmt::string_view(s, 10));
+          fmt::string_view(s, strnlen(s, 10)));
       error = true;
     }
 
@@ -297,11 +394,11 @@ std::list<perfdata> misc::parse_perfdata(uint32_t host_id,
         p.name(), p.value(), p.unit(), p.warning(), p.critical(), p.min(),
         p.max());
 
-    // Append to list.
+    // Append to array.
     retval.emplace_back(std::move(p));
 
     // Skip whitespaces.
-    while (isspace(*tmp))
+    while (is(*tmp, space))
       ++tmp;
   }
   return retval;
@@ -0,0 +1,85 @@
+/**
+ * Copyright 2023 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/broker/misc/shared_perfdata.hh"
+
+#include "com/centreon/broker/misc/misc.hh"
+
+using namespace com::centreon::broker::misc;
+
+std::atomic<uint64_t> shared_perfdata::_parsed{0};
+std::atomic<uint64_t> shared_perfdata::_reused{0};
+
+/**
+ *  Assignment operator, the perfdata of the new content will be parsed
+ *  again.
+ *
+ *  @param[in] other  Unused.
+ *
+ *  @return This object.
+ */
+shared_perfdata& shared_perfdata::operator=(const shared_perfdata& other
+                                            [[maybe_unused]]) {
+  std::atomic_store(&_perfdata, std::shared_ptr<const array>());
+  return *this;
+}
+
+/**
+ *  Get the parsed perfdata, the string is only parsed on the first call.
+ *
+ *  @param[in] host_id     The host id of the service.
+ *  @param[in] service_id  The service id.
+ *  @param[in] str         The perfdata string of the event.
+ *
+ *  @return The perfdata array, shared with the other callers.
+ */
+std::shared_ptr<const shared_perfdata::array> shared_perfdata::get(
+    uint32_t host_id,
+    uint32_t service_id,
+    const std::string& str) const {
+  std::shared_ptr<const array> retval = std::atomic_load(&_perfdata);
+  if (retval) {
+    _reused.fetch_add(1, std::memory_order_relaxed);
+    return retval;
+  }
+  auto parsed = std::make_shared<const array>(
+      parse_perfdata(host_id, service_id, str.c_str()));
+  _parsed.fetch_add(1, std::memory_order_relaxed);
+  /* If another stream has been faster, its result is kept. */
+  if (std::atomic_compare_exchange_strong(&_perfdata, &retval, parsed))
+    return parsed;
+  return retval;
+}
+
+/**
+ *  Number of perfdata strings parsed since the start.
+ *
+ *  @return A number of events.
+ */
+uint64_t shared_perfdata::parsed_count() noexcept {
+  return _parsed.load(std::memory_order_relaxed);
+}
+
+/**
+ *  Number of times already parsed perfdata have been reused since the start.
+ *
+ *  @return A number of accesses.
+ */
+uint64_t shared_perfdata::reused_count() noexcept {
+  return _reused.load(std::memory_order_relaxed);
+}
@@ -26,6 +26,41 @@
 
 using namespace com::centreon::broker;
 
+std::atomic<compression::codec> persistent_file::_codec{
+    compression::codec::zlib};
+
+/**
+ *  Set the codec used to write the queue files opened from now. They are
+ *  read whatever the codec used to write them.
+ *
+ *  @param[in] c  The codec.
+ */
+void persistent_file::compression_codec(compression::codec c) noexcept {
+  _codec = c;
+}
+
+std::atomic<bool> persistent_file::_segmented{false};
+std::atomic<uint32_t> persistent_file::_max_file_size{100000000u};
+std::atomic<uint32_t> persistent_file::_sync_interval{0u};
+
+/**
+ *  Set how the queue files opened from now are stored on disk.
+ *
+ *  @param[in] segmented      True to use a segment log, false to use the
+ *                            stdio splitter.
+ *  @param[in] max_file_size  Maximum size of each file part.
+ *  @param[in] sync_interval  Segment log only, minimum interval in
+ *                            milliseconds between two syncs to disk, 0 to
+ *                            never sync.
+ */
+void persistent_file::file_options(bool segmented,
+                                   uint32_t max_file_size,
+                                   uint32_t sync_interval) noexcept {
+  _segmented = segmented;
+  _max_file_size = max_file_size;
+  _sync_interval = sync_interval;
+}
+
 /**
  *  Constructor.
  *
@@ -36,21 +71,21 @@ using namespace com::centreon::broker;
 persistent_file::persistent_file(const std::string& path, QueueFileStats* stats)
     : io::stream("persistent_file") {
   // On-disk file.
-  constexpr uint32_t max_size{100000000u};
-  _splitter = std::make_shared<file::stream>(path, stats, max_size, true);
+  _splitter = std::make_shared<file::stream>(
+      path, stats, _max_file_size, true, _segmented, _sync_interval);
 
   // Compression layer.
-  auto cs{std::make_shared<compression::stream>()};
-  cs->set_substream(_splitter);
+  _compression = std::make_shared<compression::stream>(-1, 0, _codec);
+  _compression->set_substream(_splitter);
 
   // BBDO layer.
-  auto bs{std::make_shared<bbdo::stream>(true)};
-  bs->set_coarse(true);
-  bs->set_negotiate(false);
-  bs->set_substream(cs);
+  _bbdo = std::make_shared<bbdo::stream>(true);
+  _bbdo->set_coarse(true);
+  _bbdo->set_negotiate(false);
+  _bbdo->set_substream(_compression);
 
   // Set stream.
-  io::stream::set_substream(bs);
+  io::stream::set_substream(_bbdo);
   if (stats)
     stats::center::instance().execute(
         [path, stats, max_file_size = _splitter->max_file_size()] {
@@ -68,7 +103,12 @@ persistent_file::persistent_file(const std::string& path, QueueFileStats* stats)
  *  @return Always return true, as file never times out.
  */
 bool persistent_file::read(std::shared_ptr<io::data>& d, time_t deadline) {
-  return _substream->read(d, deadline);
+  bool retval = _substream->read(d, deadline);
+  /* Events already returned are consumed, the file can resume after them
+   * unless some of them are still in the BBDO layer. */
+  if (d && !_bbdo->has_pending_input())
+    _splitter->checkpoint(_compression->pending_input());
+  return retval;
 }
 
 /**
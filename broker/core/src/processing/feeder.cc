@@ -198,9 +198,11 @@ void feeder::_read_from_muxer() {
 }
 
 /**
- * @brief write event to client stream
+ * @brief write events to client stream, all in one write so that a bbdo
+ * client serializes them in one buffer. If the write fails, none of them is
+ * considered as written.
  * _protect must be locked
- * @param event
+ * @param events
  * @return number of events written
  */
 unsigned feeder::_write_to_client(
@@ -219,9 +221,9 @@ unsigned feeder::_write_to_client(
             "feeder '{}': sending 1 event {:x} from muxer to stream", _name,
             event->type());
       }
-      _client->write(event);
-      ++written;
     }
+    _client->write(events);
+    written = events.size();
   } catch (exceptions::shutdown const&) {
     // Normal termination.
     SPDLOG_LOGGER_INFO(log_v2::core(), "from muxer feeder '{}' shutdown",
@@ -25,6 +25,7 @@
 #include "com/centreon/broker/config/applier/state.hh"
 #include "com/centreon/broker/log_v2.hh"
 #include "com/centreon/broker/misc/filesystem.hh"
+#include "com/centreon/broker/misc/shared_perfdata.hh"
 #include "com/centreon/broker/pool.hh"
 #include "com/centreon/broker/version.hh"
 
@@ -144,17 +145,23 @@ void center::unregister_muxer(const std::string& name) {
  * @param queue_file its queue file
  * @param size current total events.
  * @param unack current unacknowledged events.
+ * @param memory_size estimated memory used by its queue.
+ * @param memory_used estimated memory used by all the muxers queues.
  */
 void center::update_muxer(std::string name,
                           std::string queue_file,
                           uint32_t size,
-                          uint32_t unack) {
+                          uint32_t unack,
+                          uint64_t memory_size,
+                          uint64_t memory_used) {
   std::lock_guard<std::mutex> lck(_stats_m);
   auto ms = &(*_stats.mutable_processing()->mutable_muxers())[std::move(name)];
   if (ms) {
     ms->mutable_queue_file()->set_name(std::move(queue_file));
     ms->set_total_events(size);
     ms->set_unacknowledged_events(unack);
+    ms->set_memory_size(memory_size);
+    ms->set_memory_used_by_all_muxers(memory_used);
   }
 }
 
@@ -320,6 +327,7 @@ std::string center::to_string() {
   std::lock_guard<std::mutex> lck(_stats_m);
   _json_stats_file_creation = now;
   _stats.set_now(now);
+  _update_perfdata_stats();
   MessageToJsonString(_stats, &retval, options);
   return retval;
 }
@@ -364,8 +372,19 @@ MuxerStats* center::muxer_stats(const std::string& name) {
   return &(*_stats.mutable_processing()->mutable_muxers())[name];
 }
 
+/**
+ * @brief Copy the counters of the perfdata parsings into the stats. _stats_m
+ * must be locked.
+ */
+void center::_update_perfdata_stats() {
+  auto pd = _stats.mutable_processing()->mutable_perfdata();
+  pd->set_parsed(misc::shared_perfdata::parsed_count());
+  pd->set_reused(misc::shared_perfdata::reused_count());
+}
+
 void center::get_processing_stats(ProcessingStats* response) {
   std::lock_guard<std::mutex> lck(_stats_m);
+  _update_perfdata_stats();
   *response = _stats.processing();
 }
 
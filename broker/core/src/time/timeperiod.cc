@@ -28,7 +28,7 @@ using namespace com::centreon::broker::time;
 /**
  *  Default constructor.
  */
-timeperiod::timeperiod() : _id(0) {
+timeperiod::timeperiod() : _id(0), _compiled_next_day(-1) {
   _timeranges.resize(7);
   _exceptions.resize(daterange::daterange_types);
 }
@@ -38,7 +38,7 @@ timeperiod::timeperiod() : _id(0) {
  *
  *  @param[in] obj  The object to copy.
  */
-timeperiod::timeperiod(timeperiod const& obj) {
+timeperiod::timeperiod(timeperiod const& obj) : _compiled_next_day(-1) {
   timeperiod::operator=(obj);
 }
 
@@ -65,7 +65,10 @@ timeperiod::timeperiod(uint32_t id,
                        std::string const& thursday,
                        std::string const& friday,
                        std::string const& saturday)
-    : _id(id), _alias(alias), _timeperiod_name(name) {
+    : _id(id),
+      _alias(alias),
+      _timeperiod_name(name),
+      _compiled_next_day(-1) {
   _timeranges.resize(7);
   _exceptions.resize(daterange::daterange_types);
   std::vector<bool> success;
@@ -95,6 +98,7 @@ timeperiod timeperiod::operator=(timeperiod const& obj) {
     _timeperiod_name = obj._timeperiod_name;
     _timeranges = obj._timeranges;
     _timezone = obj._timezone;
+    _invalidate();
   }
   return *this;
 }
@@ -270,6 +274,7 @@ std::list<timerange> const& timeperiod::get_timeranges_by_day(
  *  @return  True if the string is valid.
  */
 bool timeperiod::set_timerange(std::string const& timerange_text, int day) {
+  _invalidate();
   return timerange::build_timeranges_from_string(timerange_text,
                                                  _timeranges[day]);
 }
@@ -290,6 +295,7 @@ std::string const& timeperiod::get_timezone() const noexcept {
  */
 void timeperiod::set_timezone(std::string const& tz) {
   _timezone = tz;
+  _invalidate();
 }
 
 /**
@@ -310,6 +316,33 @@ bool timeperiod::is_valid(time_t preferred_time) const {
  *  @return The next valid time.
  */
 time_t timeperiod::get_next_valid(time_t preferred_time) const {
+  time_t retval = _lookup(_valid, preferred_time);
+  if (retval == common::time_segments::not_compiled)
+    retval = _compute_next_valid(preferred_time);
+  return retval;
+}
+
+/**
+ *  Get the next invalid time from preferred time in this timeperiod.
+ *
+ *  @param[in] preferred_time  The preferred time.
+ *
+ *  @return                    The next invalid time.
+ */
+time_t timeperiod::get_next_invalid(time_t preferred_time) const {
+  time_t retval = _lookup(_invalid, preferred_time);
+  if (retval == common::time_segments::not_compiled)
+    retval = _compute_next_invalid(preferred_time);
+  return retval;
+}
+
+/**
+ *  Compute the next valid time from preferred time in this timeperiod.
+ *
+ *  @param[in] preferred_time The preferred time.
+ *  @return The next valid time.
+ */
+time_t timeperiod::_compute_next_valid(time_t preferred_time) const {
   // Set timezone.
   timezone_locker tzlock(_timezone.empty() ? nullptr : _timezone.c_str());
 
@@ -376,13 +409,13 @@ time_t timeperiod::get_next_valid(time_t preferred_time) const {
 }
 
 /**
- *  Get the next invalid time from preferred time in this timeperiod.
+ *  Compute the next invalid time from preferred time in this timeperiod.
  *
  *  @param[in] preferred_time  The preferred time.
  *
  *  @return                    The next invalid time.
  */
-time_t timeperiod::get_next_invalid(time_t preferred_time) const {
+time_t timeperiod::_compute_next_invalid(time_t preferred_time) const {
   // Set timezone.
   timezone_locker tzlock(_timezone.empty() ? nullptr : _timezone.c_str());
 
@@ -438,6 +471,104 @@ time_t timeperiod::get_next_invalid(time_t preferred_time) const {
   return (time_t)-1;
 }
 
+/**
+ *  Look up a time in compiled segments. They are compiled first if they are
+ *  not for the current day.
+ *
+ *  @param[in] segments        _valid or _invalid.
+ *  @param[in] preferred_time  The preferred time.
+ *
+ *  @return The result of the lookup or time_segments::not_compiled if the
+ *          preferred time is not in the compiled days.
+ */
+time_t timeperiod::_lookup(common::time_segments const& segments,
+                           time_t preferred_time) const {
+  time_t now = ::time(nullptr);
+  {
+    std::lock_guard<std::mutex> lck(_compiled_m);
+    if (now >= _valid.start() && now < _compiled_next_day)
+      return segments.lookup(preferred_time);
+  }
+
+  // The compilation mutex is not held while the timezone is locked, lookups
+  // may be done with the timezone already locked.
+  common::time_segments valid;
+  common::time_segments invalid;
+  time_t next_day;
+  {
+    timezone_locker tzlock(_timezone.empty() ? nullptr : _timezone.c_str());
+
+    struct tm today;
+    localtime_r(&now, &today);
+    today.tm_sec = 0;
+    today.tm_min = 0;
+    today.tm_hour = 0;
+    today.tm_isdst = -1;
+    time_t start = mktime(&today);
+    next_day = add_round_days_to_midnight(start, 24 * 60 * 60);
+    time_t end = add_round_days_to_midnight(start, 8 * 24 * 60 * 60);
+
+    // Results may only change at midnights, at range limits and at DST
+    // changes.
+    std::vector<time_t> boundaries;
+    for (time_t day = start; day < end;) {
+      boundaries.push_back(day);
+      struct tm day_midnight;
+      localtime_r(&day, &day_midnight);
+      for (timerange const& trange : _timeranges[day_midnight.tm_wday]) {
+        time_t range_start((time_t)-1);
+        time_t range_end((time_t)-1);
+        trange.to_time_t(day_midnight, range_start, range_end);
+        boundaries.push_back(range_start);
+        boundaries.push_back(range_end);
+      }
+
+      time_t next = add_round_days_to_midnight(day, 24 * 60 * 60);
+      struct tm next_midnight;
+      localtime_r(&next, &next_midnight);
+      if (next_midnight.tm_gmtoff != day_midnight.tm_gmtoff) {
+        time_t before = day;
+        time_t after = next;
+        while (after - before > 1) {
+          time_t middle = before + (after - before) / 2;
+          struct tm middle_tm;
+          localtime_r(&middle, &middle_tm);
+          if (middle_tm.tm_gmtoff == day_midnight.tm_gmtoff)
+            before = middle;
+          else
+            after = middle;
+        }
+        boundaries.push_back(after);
+      }
+      day = next;
+    }
+
+    valid.compile(
+        start, end, boundaries,
+        [this](time_t t) { return _compute_next_valid(t); }, true);
+    invalid.compile(
+        start, end, boundaries,
+        [this](time_t t) { return _compute_next_invalid(t); }, false);
+  }
+
+  std::lock_guard<std::mutex> lck(_compiled_m);
+  _valid = std::move(valid);
+  _invalid = std::move(invalid);
+  _compiled_next_day = next_day;
+  return segments.lookup(preferred_time);
+}
+
+/**
+ *  Forget the compiled segments, they are compiled again on the next
+ *  lookup.
+ */
+void timeperiod::_invalidate() {
+  std::lock_guard<std::mutex> lck(_compiled_m);
+  _compiled_next_day = -1;
+  _valid.clear();
+  _invalid.clear();
+}
+
 /**
  *  @brief Get the intersection of a timeperiod and a range.
  *
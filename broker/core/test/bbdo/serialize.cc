@@ -0,0 +1,203 @@
+/**
+ * Copyright 2023 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include "com/centreon/broker/bbdo/internal.hh"
+#include "com/centreon/broker/bbdo/stream.hh"
+#include "com/centreon/broker/config/applier/init.hh"
+#include "com/centreon/broker/config/applier/modules.hh"
+#include "com/centreon/broker/io/raw.hh"
+#include "com/centreon/broker/neb/internal.hh"
+#include "com/centreon/broker/neb/service.hh"
+
+using namespace com::centreon::broker;
+
+extern std::shared_ptr<asio::io_context> g_io_context;
+
+/**
+ * @brief A stream keeping in memory all the buffers written to it.
+ */
+class serialized_memory : public io::stream {
+  std::vector<char> _memory;
+  uint32_t _writes = 0;
+
+ public:
+  serialized_memory() : io::stream("serialized_memory") {}
+
+  bool read(std::shared_ptr<io::data>&, time_t) override { return false; }
+
+  int write(std::shared_ptr<io::data> const& d) override {
+    auto& buffer = std::static_pointer_cast<io::raw>(d)->get_buffer();
+    _memory.insert(_memory.end(), buffer.begin(), buffer.end());
+    ++_writes;
+    return 1;
+  }
+
+  int32_t stop() override { return 0; }
+
+  void clear() {
+    _memory.clear();
+    _writes = 0;
+  }
+  const std::vector<char>& memory() const { return _memory; }
+  uint32_t writes() const { return _writes; }
+};
+
+/**
+ * @brief A stream returning a buffer by pieces of the given size.
+ */
+class chunked_input : public io::stream {
+  std::vector<char> _memory;
+  size_t _pos = 0;
+  size_t _chunk;
+
+ public:
+  chunked_input(const std::vector<char>& memory, size_t chunk)
+      : io::stream("chunked_input"), _memory(memory), _chunk(chunk) {}
+
+  bool read(std::shared_ptr<io::data>& d, time_t) override {
+    if (_pos >= _memory.size())
+      return false;
+    size_t size = std::min(_chunk, _memory.size() - _pos);
+    d = std::make_shared<io::raw>(std::vector<char>(
+        _memory.begin() + _pos, _memory.begin() + _pos + size));
+    _pos += size;
+    return true;
+  }
+
+  int write(std::shared_ptr<io::data> const&) override { return 1; }
+  int32_t stop() override { return 0; }
+};
+
+class BbdoSerialize : public ::testing::Test {
+ protected:
+  std::shared_ptr<serialized_memory> _memory;
+  std::unique_ptr<bbdo::stream> _stream;
+
+ public:
+  void SetUp() override {
+    io::data::broker_id = 0;
+    g_io_context->restart();
+    config::applier::init(0, "broker_test", 0);
+    config::applier::modules modules;
+    modules.load_file("./lib/10-neb.so");
+
+    _memory = std::make_shared<serialized_memory>();
+    _stream = std::make_unique<bbdo::stream>(true);
+    _stream->set_substream(_memory);
+    _stream->set_coarse(false);
+    _stream->set_negotiate(false);
+    _stream->negotiate(bbdo::stream::negotiate_first);
+  }
+
+  void TearDown() override {
+    _stream.reset();
+    _memory.reset();
+    config::applier::deinit();
+  }
+
+  static std::deque<std::shared_ptr<io::data>> services(uint32_t count) {
+    std::deque<std::shared_ptr<io::data>> retval;
+    for (uint32_t i = 0; i < count; ++i) {
+      auto svc = std::make_shared<neb::service>();
+      svc->host_id = 1 + i / 10;
+      svc->service_id = i;
+      svc->output = fmt::format("OK - service {} is fine", i);
+      svc->perf_data = fmt::format("metric={};80;90;0;100", i % 100);
+      retval.push_back(std::move(svc));
+    }
+    return retval;
+  }
+};
+
+/**
+ * @brief Each event is serialized in one buffer. A long payload is split in
+ * packets of 0xffff bytes followed by a smaller one.
+ */
+TEST_F(BbdoSerialize, LongEventInPackets) {
+  auto svc = std::make_shared<neb::service>();
+  svc->output = std::string(150000, 'a');
+  _stream->write(svc);
+  ASSERT_EQ(_memory->writes(), 1u);
+
+  const std::vector<char>& memory = _memory->memory();
+  std::vector<uint16_t> sizes;
+  for (size_t pos = 0; pos < memory.size();) {
+    ASSERT_LE(pos + BBDO_HEADER_SIZE, memory.size());
+    uint16_t size;
+    memcpy(&size, memory.data() + pos + 2, sizeof(size));
+    sizes.push_back(ntohs(size));
+    pos += BBDO_HEADER_SIZE + sizes.back();
+    ASSERT_LE(pos, memory.size());
+  }
+  ASSERT_EQ(sizes.size(), 3u);
+  ASSERT_EQ(sizes[0], 0xffff);
+  ASSERT_EQ(sizes[1], 0xffff);
+  ASSERT_LT(sizes[2], 0xffff);
+}
+
+/**
+ * @brief Several events written at once are serialized in one buffer, the
+ * same bytes as when they are written one by one.
+ */
+TEST_F(BbdoSerialize, BatchInOneBuffer) {
+  auto events = services(100);
+  for (auto& e : events)
+    _stream->write(e);
+  ASSERT_EQ(_memory->writes(), 100u);
+  std::vector<char> one_by_one(_memory->memory());
+
+  _memory->clear();
+  _stream->write(std::vector<std::shared_ptr<io::data>>(events.begin(),
+                                                         events.end()));
+  ASSERT_EQ(_memory->writes(), 1u);
+  ASSERT_EQ(_memory->memory(), one_by_one);
+}
+
+/**
+ * @brief Events are read back whatever the way the buffer is cut by the
+ * substream.
+ */
+TEST_F(BbdoSerialize, ReadByChunks) {
+  auto events = services(20);
+  auto svc = std::make_shared<neb::service>();
+  svc->output = std::string(150000, 'a');
+  events.insert(events.begin() + 7, svc);
+  for (auto& e : events)
+    _stream->write(e);
+
+  for (size_t chunk : {1u, 7u, 100u, 4096u, 1000000u}) {
+    bbdo::stream input(true);
+    input.set_substream(
+        std::make_shared<chunked_input>(_memory->memory(), chunk));
+    input.set_coarse(true);
+    for (auto& e : events) {
+      std::shared_ptr<io::data> d;
+      ASSERT_TRUE(input.read(d, 0));
+      ASSERT_TRUE(d);
+      ASSERT_EQ(d->type(), neb::service::static_type());
+      auto s = std::static_pointer_cast<neb::service>(d);
+      auto expected = std::static_pointer_cast<neb::service>(e);
+      ASSERT_EQ(s->service_id, expected->service_id);
+      ASSERT_EQ(s->output, expected->output);
+      ASSERT_EQ(s->perf_data, expected->perf_data);
+    }
+  }
+}
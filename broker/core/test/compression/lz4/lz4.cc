@@ -0,0 +1,73 @@
+/**
+ * Copyright 2023 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+#include "com/centreon/broker/compression/lz4.hh"
+#include <gtest/gtest.h>
+#include "com/centreon/broker/exceptions/corruption.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::compression;
+
+// Given a simple buffer
+// When lz4::compress() is called and then lz4::uncompress()
+// Then we get as result the same buffer as the input one
+TEST(CompressionLz4, Simple) {
+  // Given
+  char str[] = "Some data compression";
+  std::vector<char> data{str, str + sizeof(str)};
+  for (int level : {-1, 9}) {
+    // When
+    std::vector<char> compressed(lz4::compress(data, level));
+    std::vector<char> uncompressed(
+        lz4::uncompress(reinterpret_cast<unsigned char const*>(&compressed[0]),
+                        compressed.size()));
+
+    // Then
+    ASSERT_EQ(uncompressed, data);
+  }
+}
+
+// Given an empty buffer
+// When lz4::compress() is called
+// Then we get as result a buffer containing "\0\0\0\0"
+TEST(CompressionLz4, Empty) {
+  // Given
+  std::vector<char> data;
+  // When
+  std::vector<char> compressed(lz4::compress(data, -1));
+
+  std::vector<char> expected(4, '\0');
+  ASSERT_EQ(compressed, expected);
+}
+
+// Given a compressed buffer
+// When it is truncated
+// Then lz4::uncompress() throws a corruption exception
+TEST(CompressionLz4, Truncated) {
+  // Given
+  std::vector<char> data(10000, 'a');
+  std::vector<char> compressed(lz4::compress(data, -1));
+  // When
+  compressed.resize(compressed.size() - 2);
+
+  // Then
+  ASSERT_THROW(
+      lz4::uncompress(reinterpret_cast<unsigned char const*>(&compressed[0]),
+                      compressed.size()),
+      exceptions::corruption);
+}
@@ -211,3 +211,51 @@ TEST_F(CompressionStreamRead, FragmentGreaterThanMaxSize) {
   ASSERT_EQ(std::static_pointer_cast<io::raw>(d)->get_buffer(),
             predefined_data()->get_buffer());
 }
+
+// Given compression streams writing with each codec
+// When a zlib stream reads their data
+// Then the data are extracted, the codec being given with each chunk
+TEST_F(CompressionStreamRead, ReadAnyCodec) {
+  for (auto c : {compression::codec::zlib, compression::codec::zstd,
+                 compression::codec::lz4}) {
+    // Given
+    compression::stream writer(-1, 0, c);
+    writer.set_substream(_substream);
+    writer.write(predefined_data());
+    writer.flush();
+
+    // When
+    std::shared_ptr<io::data> d;
+    bool retval(_stream->read(d));
+
+    // Then
+    ASSERT_TRUE(retval);
+    ASSERT_FALSE(!d);
+    ASSERT_EQ(std::static_pointer_cast<io::raw>(d)->get_buffer(),
+              predefined_data()->get_buffer());
+  }
+}
+
+// Given a compression stream
+// And the substream has a chunk with an unknown codec followed by valid data
+// When read() is called
+// Then the valid data is extracted
+TEST_F(CompressionStreamRead, UnknownCodec) {
+  // Given
+  _stream->write(predefined_data());
+  _stream->flush();
+  _stream->write(predefined_data());
+  _stream->flush();
+  std::shared_ptr<io::raw>& buffer(_substream->get_buffer());
+  buffer->data()[0] |= 0x70;
+
+  // When
+  std::shared_ptr<io::data> d;
+  bool retval(_stream->read(d));
+
+  // Then
+  ASSERT_TRUE(retval);
+  ASSERT_FALSE(!d);
+  ASSERT_EQ(std::static_pointer_cast<io::raw>(d)->get_buffer(),
+            predefined_data()->get_buffer());
+}
@@ -191,3 +191,22 @@ TEST_F(CompressionStreamWrite, Flush) {
   _stream->read(d);
   ASSERT_TRUE(d);
 }
+
+// Given a compression stream
+// And write() is called with a data payload
+// When flush() is called
+// Then the statistics give the codec and the compression ratio
+TEST_F(CompressionStreamWrite, Statistics) {
+  // Given
+  _stream->write(new_data());
+
+  // When
+  _stream->flush();
+
+  // Then
+  nlohmann::json tree;
+  _stream->statistics(tree);
+  ASSERT_EQ(tree["compression_codec"], "zlib");
+  ASSERT_LT(tree["compression_ratio"].get<double>(), 1.0);
+  ASSERT_GE(tree["compression_time"].get<double>(), 0.0);
+}
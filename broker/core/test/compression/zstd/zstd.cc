@@ -0,0 +1,124 @@
+/**
+ * Copyright 2023 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+#include "com/centreon/broker/compression/zstd.hh"
+#include <gtest/gtest.h>
+#include <zdict.h>
+#include <fstream>
+#include "com/centreon/broker/exceptions/corruption.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::compression;
+
+// Given a simple buffer
+// When zstd::compress() is called and then zstd::uncompress()
+// Then we get as result the same buffer as the input one
+TEST(CompressionZstd, Simple) {
+  // Given
+  char str[] = "Some data compression";
+  std::vector<char> data{str, str + sizeof(str)};
+  zstd z(-1);
+  // When
+  std::vector<char> compressed(z.compress(data));
+  std::vector<char> uncompressed(
+      z.uncompress(reinterpret_cast<unsigned char const*>(&compressed[0]),
+                   compressed.size()));
+
+  // Then
+  ASSERT_EQ(uncompressed, data);
+}
+
+// Given an empty buffer
+// When zstd::compress() is called
+// Then we get as result a buffer containing "\0\0\0\0"
+TEST(CompressionZstd, Empty) {
+  // Given
+  std::vector<char> data;
+  zstd z(-1);
+  // When
+  std::vector<char> compressed(z.compress(data));
+
+  std::vector<char> expected(4, '\0');
+  ASSERT_EQ(compressed, expected);
+}
+
+// Given data compressed with a dictionary
+// When they are uncompressed with the same dictionary
+// Then we get the input data, without it they are corrupted
+TEST(CompressionZstd, Dictionary) {
+  // Given
+  std::string dictionary;
+  for (int i = 0; i < 100; ++i)
+    dictionary += fmt::format("host_id={} service_id={} output=OK ", i, i);
+  std::string str{"host_id=12 service_id=34 output=OK"};
+  std::vector<char> data{str.begin(), str.end()};
+  zstd with_dict(-1, dictionary);
+  zstd without_dict(-1);
+
+  // When
+  std::vector<char> compressed(with_dict.compress(data));
+  std::vector<char> uncompressed(with_dict.uncompress(
+      reinterpret_cast<unsigned char const*>(&compressed[0]),
+      compressed.size()));
+
+  // Then
+  ASSERT_EQ(uncompressed, data);
+  ASSERT_LT(compressed.size(), without_dict.compress(data).size());
+  ASSERT_THROW(without_dict.uncompress(
+                   reinterpret_cast<unsigned char const*>(&compressed[0]),
+                   compressed.size()),
+               exceptions::corruption);
+}
+
+// Given a dictionary trained by zstd and written in a file
+// When it is loaded
+// Then it has an id announced to the peers, a raw content one has none
+TEST(CompressionZstd, DictionaryId) {
+  // Given
+  std::string samples;
+  std::vector<size_t> sizes;
+  for (int i = 0; i < 2000; ++i) {
+    std::string sample{fmt::format(
+        "host_id={} service_id={} output=OK - service {} is fine", i % 97, i,
+        i * 7)};
+    samples += sample;
+    sizes.push_back(sample.size());
+  }
+  std::string trained(4096, '\0');
+  size_t len = ZDICT_trainFromBuffer(&trained[0], trained.size(),
+                                     samples.data(), sizes.data(),
+                                     sizes.size());
+  ASSERT_FALSE(ZDICT_isError(len));
+  trained.resize(len);
+  const char* path = "/tmp/zstd_dictionary_test";
+  {
+    std::ofstream f(path, std::ios::binary | std::ios::trunc);
+    f << trained;
+  }
+
+  // When
+  std::string loaded{zstd::load_dictionary(path)};
+  ::unlink(path);
+
+  // Then
+  ASSERT_EQ(loaded, trained);
+  ASSERT_NE(zstd::dictionary_id(loaded), 0u);
+  ASSERT_EQ(zstd::dictionary_id(samples.substr(0, 1000)), 0u);
+  ASSERT_EQ(zstd::dictionary_id(""), 0u);
+  ASSERT_TRUE(zstd::load_dictionary(path).empty());
+}
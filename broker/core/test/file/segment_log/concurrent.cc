@@ -0,0 +1,107 @@
+/**
+ * Copyright 2023 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+#include <gtest/gtest.h>
+
+#include "com/centreon/broker/file/disk_accessor.hh"
+#include "com/centreon/broker/file/segment_log.hh"
+#include "com/centreon/broker/misc/filesystem.hh"
+
+using namespace com::centreon::broker;
+
+#define RETENTION_DIR "/tmp/"
+#define RETENTION_FILE "test-concurrent-segment"
+
+class FileSegmentLogConcurrent : public ::testing::Test {
+ public:
+  void SetUp() override {
+    file::disk_accessor::load(1000000u);
+    _path = RETENTION_DIR RETENTION_FILE;
+    _remove_files();
+
+    _file = std::make_unique<file::segment_log>(_path, 10000, true);
+  }
+
+  void TearDown() override {
+    _file.reset();
+    _remove_files();
+    file::disk_accessor::unload();
+  }
+
+ protected:
+  std::unique_ptr<file::segment_log> _file;
+  std::string _path;
+
+  void _remove_files() {
+    for (const std::string& f : misc::filesystem::dir_content_with_filter(
+             RETENTION_DIR, RETENTION_FILE "*"))
+      std::remove(f.c_str());
+  }
+};
+
+// Given a segment_log object
+// When twenty writers write in parallel while the reader reads
+// And the reader often reaches the end of the data and removes the write
+// segment
+// Then the reader gets all the data in order for each writer and nothing is
+// lost.
+TEST_F(FileSegmentLogConcurrent, ConcurrentReadWrite) {
+  constexpr int COUNT = 20;
+  constexpr int LENGTH = 10000;
+  constexpr int BLOCK = 100;
+  std::vector<std::thread> v;
+  for (int i = 0; i < COUNT; i++)
+    v.emplace_back([file = _file.get(), i]() {
+      /* Each block contains the writer id and the block number. */
+      char buf[BLOCK];
+      for (int j = 0; j < LENGTH / BLOCK; ++j) {
+        memset(buf, i, BLOCK);
+        buf[1] = j;
+        while (file->write(buf, BLOCK) != BLOCK)
+          ;
+        if (j % 10 == 0)
+          usleep(rand() % 100);
+      }
+    });
+
+  std::vector<uint8_t> result(COUNT * LENGTH, '\0');
+  int current = 0;
+  constexpr int size = COUNT * LENGTH;
+  do {
+    try {
+      current += _file->read(result.data() + current, size - current);
+      ASSERT_LE(current, size);
+    } catch (...) {
+    }
+  } while (current < size);
+
+  for (auto& t : v)
+    t.join();
+
+  std::array<int, COUNT> next_block{};
+  for (int delta = 0; delta < size; delta += BLOCK) {
+    int writer = result[delta];
+    ASSERT_LT(writer, COUNT);
+    ASSERT_EQ(result[delta + 1], next_block[writer]);
+    next_block[writer]++;
+    for (int i = 2; i < BLOCK; i++)
+      ASSERT_EQ(result[delta + i], writer);
+  }
+  for (int n : next_block)
+    ASSERT_EQ(n, LENGTH / BLOCK);
+}
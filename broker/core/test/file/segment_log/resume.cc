@@ -0,0 +1,105 @@
+/**
+ * Copyright 2023 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+#include <gtest/gtest.h>
+#include "com/centreon/broker/file/disk_accessor.hh"
+#include "com/centreon/broker/file/segment_log.hh"
+#include "com/centreon/broker/misc/filesystem.hh"
+
+using namespace com::centreon::broker;
+
+class FileSegmentLogResume : public ::testing::Test {
+ public:
+  void SetUp() override {
+    file::disk_accessor::load(100000u);
+    std::list<std::string> lst{
+        misc::filesystem::dir_content_with_filter("/tmp/", "resume-segment*")};
+    for (std::string const& f : lst)
+      std::remove(f.c_str());
+    _path = "/tmp/resume-segment";
+
+    file::segment_log f(_path, 10000, true);
+    char buffer[1000];
+    for (int i = 0; i < 5; ++i) {
+      memset(buffer, i, sizeof(buffer));
+      f.write(buffer, sizeof(buffer));
+    }
+  }
+
+  void TearDown() override { file::disk_accessor::unload(); }
+
+ protected:
+  std::string _path;
+};
+
+// Given a segment log containing 5000 bytes
+// When 2500 bytes are read and 500 of them are not consumed
+// And the segment log is closed and opened again
+// Then reading resumes at byte 2000
+TEST_F(FileSegmentLogResume, ResumeAtCheckpoint) {
+  char buffer[2500];
+  {
+    file::segment_log f(_path, 10000, true);
+    ASSERT_EQ(f.read(buffer, sizeof(buffer)), 2500);
+    f.checkpoint(500);
+  }
+  ASSERT_TRUE(misc::filesystem::file_exists(_path + ".idx"));
+
+  file::segment_log f(_path, 10000, true);
+  ASSERT_FALSE(misc::filesystem::file_exists(_path + ".idx"));
+  ASSERT_EQ(f.read(buffer, 1000), 1000);
+  for (int i = 0; i < 1000; ++i)
+    ASSERT_EQ(buffer[i], 2);
+}
+
+// Given a segment log containing 5000 bytes
+// When some bytes are read without checkpoint
+// And the segment log is closed and opened again
+// Then reading starts again at the beginning of the segment
+TEST_F(FileSegmentLogResume, NoCheckpoint) {
+  char buffer[2500];
+  {
+    file::segment_log f(_path, 10000, true);
+    ASSERT_EQ(f.read(buffer, sizeof(buffer)), 2500);
+  }
+  ASSERT_FALSE(misc::filesystem::file_exists(_path + ".idx"));
+
+  file::segment_log f(_path, 10000, true);
+  ASSERT_EQ(f.read(buffer, 1000), 1000);
+  for (int i = 0; i < 1000; ++i)
+    ASSERT_EQ(buffer[i], 0);
+}
+
+// Given an index saved by a segment log
+// When remove_all_files() is called
+// Then no file remains
+TEST_F(FileSegmentLogResume, RemoveAllFiles) {
+  char buffer[1000];
+  {
+    file::segment_log f(_path, 10000, true);
+    f.read(buffer, sizeof(buffer));
+    f.checkpoint(0);
+  }
+  file::segment_log f(_path, 10000, true);
+  f.checkpoint(0);
+  f.remove_all_files();
+  f.close();
+  ASSERT_TRUE(
+      misc::filesystem::dir_content_with_filter("/tmp/", "resume-segment*")
+          .empty());
+}
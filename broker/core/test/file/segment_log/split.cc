@@ -0,0 +1,117 @@
+/**
+ * Copyright 2023 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+#include "com/centreon/broker/exceptions/shutdown.hh"
+#include "com/centreon/broker/file/disk_accessor.hh"
+#include "com/centreon/broker/file/segment_log.hh"
+#include "com/centreon/broker/file/splitter.hh"
+#include "com/centreon/broker/misc/filesystem.hh"
+
+using namespace com::centreon::broker;
+
+class FileSegmentLogSplit : public ::testing::Test {
+ public:
+  void SetUp() override {
+    file::disk_accessor::load(200000);
+    _path = "/tmp/segment";
+    {
+      std::list<std::string> parts{
+          misc::filesystem::dir_content_with_filter("/tmp/", "segment*")};
+      for (std::string const& f : parts)
+        std::remove(f.c_str());
+    }
+    _file = std::make_unique<file::segment_log>(_path, 10008, true, 10);
+    char buffer[10];
+    for (int i = 0; i < 10; ++i)
+      buffer[i] = i;
+    for (int i = 0; i < 10001; ++i)
+      _file->write(buffer, sizeof(buffer));
+    _file->flush();
+  }
+
+  void TearDown() override { file::disk_accessor::unload(); }
+
+ protected:
+  std::unique_ptr<file::segment_log> _file;
+  std::string _path;
+};
+
+// Given a segment_log object configured with a max_size of 10008
+// When write() is called 10001 times with 10 bytes of data
+// Then eleven segments are created
+// And all segments but the last are 10008 bytes long, preallocation does not
+// change their size
+// And the last segment is 18 bytes long
+TEST_F(FileSegmentLogSplit, MultipleFilesCreated) {
+  // Then
+  ASSERT_EQ(misc::filesystem::file_size(_path), 10008u);
+  for (int i = 1; i < 10; ++i)
+    ASSERT_EQ(misc::filesystem::file_size(fmt::format("{}{}", _path, i)),
+              10008u);
+  ASSERT_EQ(misc::filesystem::file_size(_path + "10"), 18u);
+  ASSERT_EQ(_file->get_wid(), 10);
+  ASSERT_EQ(_file->get_woffset(), 18);
+}
+
+// Given a segment_log object configured with a max_size of 10008
+// And write() was called 10001 times with 10 bytes of data
+// When I read 10 times for a maximum of 10001 bytes
+// Then every time 10000 bytes are read
+// And the last time 10 bytes are read
+// And segments are removed once read
+TEST_F(FileSegmentLogSplit, EntireFilesReadBack) {
+  // When
+  char buffer[10001];
+  for (int i = 0; i < 10; ++i) {
+    // Then
+    long bytes_read(_file->read(buffer, sizeof(buffer)));
+    ASSERT_EQ(bytes_read, 10000);
+    for (int j = 0; j < bytes_read; ++j)
+      ASSERT_EQ(buffer[j], j % 10);
+  }
+  long bytes_read(_file->read(buffer, sizeof(buffer)));
+  ASSERT_EQ(bytes_read, 10);
+  ASSERT_THROW(_file->read(buffer, sizeof(buffer)), exceptions::shutdown);
+
+  for (int i = 0; i <= 10; ++i)
+    ASSERT_FALSE(misc::filesystem::file_exists(_file->get_file_path(i)));
+
+  // The next write starts a new segment.
+  _file->write(buffer, 10);
+  ASSERT_EQ(_file->get_wid(), 11);
+  ASSERT_EQ(_file->read(buffer, sizeof(buffer)), 10);
+}
+
+// Given segments written by a segment_log
+// When a splitter is opened on them
+// Then it reads the same data
+TEST_F(FileSegmentLogSplit, ReadBySplitter) {
+  _file.reset();
+  file::splitter s(_path, 10008, true);
+  char buffer[10001];
+  long total = 0;
+  try {
+    for (;;)
+      total += s.read(buffer, sizeof(buffer));
+  } catch (const exceptions::shutdown& e) {
+    (void)e;
+  }
+  ASSERT_EQ(total, 100010);
+}
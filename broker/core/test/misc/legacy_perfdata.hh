@@ -0,0 +1,278 @@
+/**
+ * Copyright 2023 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#ifndef CCB_TEST_MISC_LEGACY_PERFDATA_HH
+#define CCB_TEST_MISC_LEGACY_PERFDATA_HH
+
+#include <fmt/format.h>
+
+#include <cmath>
+
+#include "com/centreon/broker/misc/misc.hh"
+#include "com/centreon/broker/misc/string.hh"
+#include "com/centreon/broker/sql/table_max_size.hh"
+
+/* The char by char parser used before the current one, kept as reference by
+ * the perfdata parser tests, benchmark and fuzzer. Logs are removed and an
+ * empty metric name is no longer read before its beginning. */
+namespace legacy {
+using namespace com::centreon::broker;
+
+inline double extract_double(char const** str, bool skip = true) {
+  double retval;
+  char* tmp;
+  if (isspace(**str))
+    retval = NAN;
+  else {
+    char const* comma{strchr(*str, ',')};
+    if (comma) {
+      size_t t = strcspn(comma, " \t\n\r;");
+      char* nb = strndup(*str, (comma - *str) + t);
+      nb[comma - *str] = '.';
+      retval = strtod(nb, &tmp);
+      if (nb == tmp)
+        retval = NAN;
+      *str = *str + (tmp - nb);
+      free(nb);
+    } else {
+      retval = strtod(*str, &tmp);
+      if (*str == tmp)
+        retval = NAN;
+      *str = tmp;
+    }
+    if (skip && (**str == ';'))
+      ++*str;
+  }
+  return retval;
+}
+
+inline void extract_range(double* low,
+                          double* high,
+                          bool* inclusive,
+                          char const** str) {
+  if ((**str) == '@') {
+    *inclusive = true;
+    ++*str;
+  } else
+    *inclusive = false;
+
+  double low_value;
+  if ('~' == **str) {
+    low_value = -std::numeric_limits<double>::infinity();
+    ++*str;
+  } else
+    low_value = extract_double(str);
+
+  double high_value;
+  if (**str != ':') {
+    high_value = low_value;
+    if (!std::isnan(low_value))
+      low_value = 0.0;
+  } else {
+    ++*str;
+    char const* ptr(*str);
+    high_value = extract_double(str);
+    if (std::isnan(high_value) && ((*str == ptr) || (*str == (ptr + 1))))
+      high_value = std::numeric_limits<double>::infinity();
+  }
+  *low = low_value;
+  *high = high_value;
+}
+
+inline std::vector<misc::perfdata> parse_perfdata(const char* str) {
+  std::vector<misc::perfdata> retval;
+  char const* tmp = str + strspn(str, " \n\r\t");
+
+  auto skip = [](char const* tmp) -> char const* {
+    while (*tmp && !isspace(*tmp))
+      ++tmp;
+    while (isspace(*tmp))
+      ++tmp;
+    return tmp;
+  };
+
+  while (*tmp) {
+    bool error = false;
+    misc::perfdata p;
+
+    bool in_quote{false};
+    char const* end{tmp};
+    while (*end && (in_quote || (*end != '=' && !isspace(*end)) ||
+                    static_cast<unsigned char>(*end) >= 128)) {
+      if ('\'' == *end)
+        in_quote = !in_quote;
+      ++end;
+    }
+
+    char const* s{tmp};
+    tmp = end;
+    --end;
+
+    if (*s == '\'')
+      ++s;
+    if (end >= s && *end == '\'')
+      --end;
+
+    while (*s && strchr(" \n\r\t", *s))
+      ++s;
+    while (end > s && strchr(" \n\r\t", *end))
+      --end;
+
+    if (end >= s && *end == ']') {
+      --end;
+      if (strncmp(s, "a[", 2) == 0) {
+        s += 2;
+        p.value_type(misc::perfdata::absolute);
+      } else if (strncmp(s, "c[", 2) == 0) {
+        s += 2;
+        p.value_type(misc::perfdata::counter);
+      } else if (strncmp(s, "d[", 2) == 0) {
+        s += 2;
+        p.value_type(misc::perfdata::derive);
+      } else if (strncmp(s, "g[", 2) == 0) {
+        s += 2;
+        p.value_type(misc::perfdata::gauge);
+      }
+    }
+
+    if (end - s + 1 > 0) {
+      std::string name(s, end - s + 1);
+      name.resize(misc::string::adjust_size_utf8(
+          name, get_metrics_col_size(metrics_metric_name)));
+      p.name(std::move(name));
+    } else
+      error = true;
+
+    if (*tmp != '=')
+      error = true;
+    else
+      ++tmp;
+
+    if (error) {
+      tmp = skip(tmp);
+      continue;
+    }
+
+    p.value(extract_double(&tmp, false));
+    if (std::isnan(p.value())) {
+      tmp = skip(tmp);
+      continue;
+    }
+
+    size_t t = strcspn(tmp, " \t\n\r;");
+    {
+      std::string unit(tmp, t);
+      unit.resize(misc::string::adjust_size_utf8(
+          unit, get_metrics_col_size(metrics_unit_name)));
+      p.unit(std::move(unit));
+    }
+    tmp += t;
+    if (*tmp == ';')
+      ++tmp;
+
+    {
+      double high, low;
+      bool mode;
+      extract_range(&low, &high, &mode, &tmp);
+      p.warning(high);
+      p.warning_low(low);
+      p.warning_mode(mode);
+    }
+    {
+      double high, low;
+      bool mode;
+      extract_range(&low, &high, &mode, &tmp);
+      p.critical(high);
+      p.critical_low(low);
+      p.critical_mode(mode);
+    }
+    p.min(extract_double(&tmp));
+    p.max(extract_double(&tmp));
+
+    retval.emplace_back(std::move(p));
+
+    while (isspace(*tmp))
+      ++tmp;
+  }
+  return retval;
+}
+
+/**
+ * @brief Strict comparison of two doubles, perfdata::operator== accepts a
+ * relative error of 1%.
+ */
+inline bool same(double a, double b) {
+  return (std::isnan(a) && std::isnan(b)) ||
+         (a == b && std::signbit(a) == std::signbit(b));
+}
+
+inline bool same(const misc::perfdata& a, const misc::perfdata& b) {
+  return a.name() == b.name() && a.unit() == b.unit() &&
+         a.value_type() == b.value_type() && same(a.value(), b.value()) &&
+         same(a.warning(), b.warning()) &&
+         same(a.warning_low(), b.warning_low()) &&
+         a.warning_mode() == b.warning_mode() &&
+         same(a.critical(), b.critical()) &&
+         same(a.critical_low(), b.critical_low()) &&
+         a.critical_mode() == b.critical_mode() && same(a.min(), b.min()) &&
+         same(a.max(), b.max());
+}
+
+/* Real world perfdata strings. */
+inline std::vector<std::string> samples() {
+  std::vector<std::string> retval{
+      "time=2.45698s;2.000000;5.000000;0.000000;10.000000",
+      "'ABCD12E'=18.00%;15:;10:;0;100",
+      "time=2.45698s;;nan;;inf d[metric]=239765B/s;5;;-inf; "
+      "infotraffic=18x;;;; a[foo]=1234;10;11: c[bar]=1234;~:10;20:30 "
+      "baz=1234;@10:20; 'q u x'=9queries_per_second;@10:;@5:;0;100",
+      "metric1= 10 metric2=42",
+      "metric=kb/s",
+      "'foo bar   '=2s;2;5;;",
+      "'foo bar   '=2s;2;5;;\n'foo bar2   '=3s;2;5;;",
+      "rta=0,054ms;200,000;500,000;0; pl=0%;20;50;; rtmax=0,110ms;;;; "
+      "rtmin=0,031ms;;;;",
+      "'C:\\ Used Space'=13,28Go;0,00;0,00;0,00;39,90",
+      "user1=1 user2=2 =1 user3=3",
+      "user1=1 user2=2 user4= user3=3",
+      "'load1'=0.25;;;0; 'load5'=0.39;;;0; 'load15'=0.44;;;0;",
+      "'cpu.utilization.percentage'=4.50%;80;90;0;100 "
+      "'core0#cpu.utilization.percentage'=3.00%;;;0;100",
+      "'used'=3541118976B;;;0;8201912320 "
+      "'free'=4660793344B;;;0;8201912320 "
+      "'used_prct'=43.17%;80;90;0;100",
+      "rta=1e3ms;1E2;0x10;-1.5e-3;.5 pl=-0;+1;1.;-.5;1.5.3",
+      "'é=1'=1 'long name with \xc3\xa9 and spaces'=12.5kB/s",
+  };
+  /* A check_snmp interfaces like output. */
+  std::string interfaces;
+  for (int i = 0; i < 200; ++i)
+    interfaces += fmt::format(
+        "'eth{0}#interface.traffic.in.bitspersecond'={1}.{2}b/s;;;0;"
+        "1000000000 'eth{0}#interface.traffic.out.bitspersecond'={2}.{1}b/"
+        "s;;;0;1000000000 'eth{0}#interface.packets.in.error.percentage'="
+        "0.00%;;;0;100 ",
+        i, 1234567 * i % 1000000000, 987 * i % 1000);
+  retval.push_back(std::move(interfaces));
+  return retval;
+}
+
+}  // namespace legacy
+
+#endif  // !CCB_TEST_MISC_LEGACY_PERFDATA_HH
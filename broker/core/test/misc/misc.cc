@@ -19,6 +19,7 @@
 
 #include "com/centreon/broker/misc/misc.hh"
 #include <gtest/gtest.h>
+#include <random>
 
 using namespace com::centreon::broker::misc;
 
@@ -53,3 +54,39 @@ TEST(MiscTest, BadLengthFromHex) {
   std::string const str = "abcde";
   ASSERT_THROW(from_hex(str), std::exception);
 }
+
+/**
+ * @brief Reference implementation of crc16_ccitt(), the one working on
+ * nibbles, used to check the table driven one.
+ */
+static uint16_t crc16_ccitt_nibbles(const char* data, uint32_t data_len) {
+  static const uint16_t crc_tbl[16] = {
+      0x0000, 0x1081, 0x2102, 0x3183, 0x4204, 0x5285, 0x6306, 0x7387,
+      0x8408, 0x9489, 0xa50a, 0xb58b, 0xc60c, 0xd68d, 0xe70e, 0xf78f};
+  uint16_t crc = 0xffff;
+  const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
+  while (data_len--) {
+    uint8_t c = *p++;
+    crc = ((crc >> 4) & 0x0fff) ^ crc_tbl[((crc ^ c) & 15)];
+    c >>= 4;
+    crc = ((crc >> 4) & 0x0fff) ^ crc_tbl[((crc ^ c) & 15)];
+  }
+  return ~crc & 0xffff;
+}
+
+TEST(MiscTest, Crc16CheckValue) {
+  ASSERT_EQ(crc16_ccitt("123456789", 9), 0x906e);
+  ASSERT_EQ(crc16_ccitt("", 0), 0x0000);
+}
+
+TEST(MiscTest, Crc16SameAsNibbles) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> dist(0, 255);
+  std::vector<char> buffer(64);
+  for (char& c : buffer)
+    c = dist(gen);
+  for (uint32_t offset = 0; offset < 8; ++offset)
+    for (uint32_t len = 0; len + offset <= buffer.size(); ++len)
+      ASSERT_EQ(crc16_ccitt(buffer.data() + offset, len),
+                crc16_ccitt_nibbles(buffer.data() + offset, len));
+}
@@ -0,0 +1,64 @@
+/**
+ * Copyright 2023 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "bbdo/storage/metric.hh"
+#include "com/centreon/broker/config/applier/init.hh"
+#include "legacy_perfdata.hh"
+
+using namespace com::centreon::broker;
+
+extern std::shared_ptr<asio::io_context> g_io_context;
+
+/**
+ * @brief Check that the current parser returns exactly what the legacy one
+ * returns.
+ */
+static ::testing::AssertionResult same_as_legacy(const std::string& str) {
+  auto expected = legacy::parse_perfdata(str.c_str());
+  auto result = misc::parse_perfdata(0, 0, str.c_str());
+  if (expected.size() != result.size())
+    return ::testing::AssertionFailure()
+           << "'" << str << "': " << result.size() << " perfdata instead of "
+           << expected.size();
+  for (size_t i = 0; i < expected.size(); ++i)
+    if (!legacy::same(expected[i], result[i]))
+      return ::testing::AssertionFailure()
+             << "'" << str << "': perfdata " << i << " differs";
+  return ::testing::AssertionSuccess();
+}
+
+class MiscParsePerfdataLegacy : public testing::Test {
+ public:
+  void SetUp() override {
+    g_io_context->restart();
+    config::applier::init(0, "test_broker", 0);
+  }
+  void TearDown() override { config::applier::deinit(); };
+};
+
+/**
+ * @brief The real world samples give the same perfdata as the legacy parser.
+ */
+TEST_F(MiscParsePerfdataLegacy, Samples) {
+  for (auto& s : legacy::samples())
+    ASSERT_TRUE(same_as_legacy(s));
+}
@@ -24,6 +24,7 @@
 
 #include "com/centreon/broker/config/applier/init.hh"
 #include "com/centreon/broker/misc/misc.hh"
+#include "com/centreon/broker/misc/shared_perfdata.hh"
 
 using namespace com::centreon::broker;
 
@@ -208,12 +209,12 @@ class MiscParserParsePerfdata : public testing::Test {
 // Then perfdata are returned in a list
 TEST_F(MiscParserParsePerfdata, Simple1) {
   // Parse perfdata.
-  std::list<misc::perfdata> lst{misc::parse_perfdata(
+  std::vector<misc::perfdata> lst{misc::parse_perfdata(
       0, 0, "time=2.45698s;2.000000;5.000000;0.000000;10.000000")};
 
   // Assertions.
   ASSERT_EQ(lst.size(), 1u);
-  std::list<misc::perfdata>::const_iterator it(lst.begin());
+  std::vector<misc::perfdata>::const_iterator it(lst.begin());
   misc::perfdata expected;
   expected.name("time");
   expected.value_type(misc::perfdata::gauge);
@@ -230,12 +231,12 @@ TEST_F(MiscParserParsePerfdata, Simple1) {
 
 TEST_F(MiscParserParsePerfdata, Simple2) {
   // Parse perfdata.
-  std::list<misc::perfdata> list{
+  std::vector<misc::perfdata> list{
       misc::parse_perfdata(0, 0, "'ABCD12E'=18.00%;15:;10:;0;100")};
 
   // Assertions.
   ASSERT_EQ(list.size(), 1u);
-  std::list<misc::perfdata>::const_iterator it(list.begin());
+  std::vector<misc::perfdata>::const_iterator it(list.begin());
   misc::perfdata expected;
   expected.name("ABCD12E");
   expected.value_type(misc::perfdata::gauge);
@@ -252,7 +253,7 @@ TEST_F(MiscParserParsePerfdata, Simple2) {
 
 TEST_F(MiscParserParsePerfdata, Complex1) {
   // Parse perfdata.
-  std::list<misc::perfdata> list{misc::parse_perfdata(
+  std::vector<misc::perfdata> list{misc::parse_perfdata(
       0, 0,
       "time=2.45698s;;nan;;inf d[metric]=239765B/s;5;;-inf; "
       "infotraffic=18x;;;; a[foo]=1234;10;11: c[bar]=1234;~:10;20:30 "
@@ -260,7 +261,7 @@ TEST_F(MiscParserParsePerfdata, Complex1) {
 
   // Assertions.
   ASSERT_EQ(list.size(), 7u);
-  std::list<misc::perfdata>::const_iterator it(list.begin());
+  std::vector<misc::perfdata>::const_iterator it(list.begin());
   misc::perfdata expected;
 
   // #1.
@@ -350,7 +351,7 @@ TEST_F(MiscParserParsePerfdata, Complex1) {
 // Then the corresponding perfdata list is returned
 TEST_F(MiscParserParsePerfdata, Loop) {
   // Objects.
-  std::list<misc::perfdata> list;
+  std::vector<misc::perfdata> list;
 
   // Loop.
   for (uint32_t i(0); i < 10000; ++i) {
@@ -360,7 +361,7 @@ TEST_F(MiscParserParsePerfdata, Loop) {
 
     // Assertions.
     ASSERT_EQ(list.size(), 1u);
-    std::list<misc::perfdata>::const_iterator it(list.begin());
+    std::vector<misc::perfdata>::const_iterator it(list.begin());
     misc::perfdata expected;
     expected.name("time");
     expected.value_type(misc::perfdata::counter);
@@ -401,7 +402,7 @@ TEST_F(MiscParserParsePerfdata, LabelWithSpaces) {
 
   // Assertions.
   ASSERT_EQ(lst.size(), 1u);
-  std::list<misc::perfdata>::const_iterator it(lst.begin());
+  std::vector<misc::perfdata>::const_iterator it(lst.begin());
   misc::perfdata expected;
   expected.name("foo  bar");
   expected.value_type(misc::perfdata::gauge);
@@ -420,7 +421,7 @@ TEST_F(MiscParserParsePerfdata, LabelWithSpacesMultiline) {
 
   // Assertions.
   ASSERT_EQ(lst.size(), 1u);
-  std::list<misc::perfdata>::const_iterator it(lst.begin());
+  std::vector<misc::perfdata>::const_iterator it(lst.begin());
   misc::perfdata expected;
   expected.name("foo  bar");
   expected.value_type(misc::perfdata::gauge);
@@ -444,7 +445,7 @@ TEST_F(MiscParserParsePerfdata, Complex2) {
 
   // Assertions.
   ASSERT_EQ(list.size(), 6u);
-  std::list<misc::perfdata>::const_iterator it(list.begin());
+  std::vector<misc::perfdata>::const_iterator it(list.begin());
   misc::perfdata expected;
 
   // #1.
@@ -525,7 +526,7 @@ TEST_F(MiscParserParsePerfdata, SimpleWithR) {
 
   // Assertions.
   ASSERT_EQ(lst.size(), 1u);
-  std::list<misc::perfdata>::const_iterator it(lst.begin());
+  std::vector<misc::perfdata>::const_iterator it(lst.begin());
   misc::perfdata expected;
   expected.name("total");
   expected.value_type(misc::perfdata::gauge);
@@ -568,3 +569,29 @@ TEST_F(MiscParserParsePerfdata, BadMetric1) {
     ++i;
   }
 }
+
+// Given a misc::shared_perfdata object
+// When get() is called several times
+// Then the perfdata are parsed only once and shared by all the callers
+TEST_F(MiscParserParsePerfdata, SharedParsedOnce) {
+  misc::shared_perfdata spd;
+  const std::string perf_data{"user1=1 user2=2"};
+  uint64_t parsed = misc::shared_perfdata::parsed_count();
+  uint64_t reused = misc::shared_perfdata::reused_count();
+
+  auto first = spd.get(1, 2, perf_data);
+  auto second = spd.get(1, 2, perf_data);
+
+  // Assertions.
+  ASSERT_EQ(first, second);
+  ASSERT_EQ(first->size(), 2u);
+  ASSERT_EQ(misc::shared_perfdata::parsed_count(), parsed + 1);
+  ASSERT_EQ(misc::shared_perfdata::reused_count(), reused + 1);
+
+  // A copy parses its perfdata again.
+  misc::shared_perfdata copy{spd};
+  auto third = copy.get(1, 2, perf_data);
+  ASSERT_NE(first, third);
+  ASSERT_EQ(third->size(), 2u);
+  ASSERT_EQ(misc::shared_perfdata::parsed_count(), parsed + 2);
+}
@@ -0,0 +1,140 @@
+/**
+ * Copyright 2023 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include "com/centreon/broker/multiplexing/engine.hh"
+#include <gtest/gtest.h>
+#include "com/centreon/broker/config/applier/init.hh"
+#include "com/centreon/broker/io/raw.hh"
+#include "com/centreon/broker/multiplexing/muxer.hh"
+
+using namespace com::centreon::broker;
+
+extern std::shared_ptr<asio::io_context> g_io_context;
+
+class MultiplexingEngine : public testing::Test {
+ public:
+  void SetUp() override {
+    g_io_context->restart();
+    config::applier::init(0, "test_broker", 0);
+  }
+
+  void TearDown() override { config::applier::deinit(); }
+};
+
+/**
+ * @brief Build a raw event containing the producer id and the event index.
+ */
+static std::shared_ptr<io::raw> make_event(uint32_t producer, uint32_t idx) {
+  std::vector<char> buffer(2 * sizeof(uint32_t));
+  memcpy(buffer.data(), &producer, sizeof(producer));
+  memcpy(buffer.data() + sizeof(producer), &idx, sizeof(idx));
+  return std::make_shared<io::raw>(std::move(buffer));
+}
+
+/**
+ * @brief Several threads publish at the same time, each one on its shard. The
+ * muxer must receive all the events and those of a given producer in their
+ * publication order.
+ */
+TEST_F(MultiplexingEngine, ConcurrentPublishKeepsProducerOrder) {
+  constexpr uint32_t producers = 8;
+  constexpr uint32_t events_per_producer = 2000;
+
+  multiplexing::muxer_filter filters{io::raw::static_type()};
+  std::shared_ptr<multiplexing::muxer> mux = multiplexing::muxer::create(
+      "core_multiplexing_engine_concurrent",
+      multiplexing::engine::instance_ptr(), filters, filters, false);
+  multiplexing::engine::instance_ptr()->start();
+
+  std::vector<std::thread> threads;
+  for (uint32_t p = 0; p < producers; ++p)
+    threads.emplace_back([p] {
+      for (uint32_t i = 0; i < events_per_producer; ++i) {
+        if (i % 3)
+          multiplexing::engine::instance_ptr()->publish(make_event(p, i));
+        else {
+          std::deque<std::shared_ptr<io::data>> q{make_event(p, i)};
+          multiplexing::engine::instance_ptr()->publish(q);
+        }
+      }
+    });
+  for (auto& t : threads)
+    t.join();
+
+  std::array<uint32_t, producers> expected;
+  expected.fill(0);
+  uint32_t received = 0;
+  while (received < producers * events_per_producer) {
+    std::shared_ptr<io::data> d;
+    mux->read(d, time(nullptr) + 5);
+    ASSERT_TRUE(d);
+    auto raw = std::static_pointer_cast<io::raw>(d);
+    ASSERT_EQ(raw->size(), 2 * sizeof(uint32_t));
+    uint32_t producer, idx;
+    memcpy(&producer, raw->const_data(), sizeof(producer));
+    memcpy(&idx, raw->const_data() + sizeof(producer), sizeof(idx));
+    ASSERT_LT(producer, producers);
+    ASSERT_EQ(idx, expected[producer]);
+    ++expected[producer];
+    ++received;
+  }
+  mux->ack_events(received);
+  mux->unsubscribe();
+}
+
+/**
+ * @brief Events published before the engine start are sent in their
+ * publication order once it is started.
+ */
+TEST_F(MultiplexingEngine, PublishBeforeStart) {
+  multiplexing::muxer_filter filters{io::raw::static_type()};
+  std::shared_ptr<multiplexing::muxer> mux = multiplexing::muxer::create(
+      "core_multiplexing_engine_before_start",
+      multiplexing::engine::instance_ptr(), filters, filters, false);
+
+  std::thread t([] {
+    for (uint32_t i = 0; i < 100; i += 2)
+      multiplexing::engine::instance_ptr()->publish(make_event(0, i));
+  });
+  t.join();
+  t = std::thread([] {
+    for (uint32_t i = 1; i < 100; i += 2)
+      multiplexing::engine::instance_ptr()->publish(make_event(1, i));
+  });
+  t.join();
+
+  {
+    std::shared_ptr<io::data> d;
+    mux->read(d, 0);
+    ASSERT_FALSE(d);
+  }
+
+  multiplexing::engine::instance_ptr()->start();
+  for (uint32_t i = 0; i < 100; ++i) {
+    std::shared_ptr<io::data> d;
+    mux->read(d, time(nullptr) + 5);
+    ASSERT_TRUE(d);
+    auto raw = std::static_pointer_cast<io::raw>(d);
+    uint32_t idx;
+    memcpy(&idx, raw->const_data() + sizeof(uint32_t), sizeof(idx));
+    ASSERT_EQ(idx, i < 50 ? 2 * i : 2 * (i - 50) + 1);
+  }
+  mux->ack_events(100);
+  mux->unsubscribe();
+}
@@ -0,0 +1,207 @@
+/**
+ * Copyright 2023 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include "com/centreon/broker/multiplexing/muxer.hh"
+#include <gtest/gtest.h>
+#include "com/centreon/broker/config/applier/init.hh"
+#include "com/centreon/broker/io/raw.hh"
+
+using namespace com::centreon::broker;
+
+extern std::shared_ptr<asio::io_context> g_io_context;
+
+class MultiplexingMuxer : public ::testing::Test {
+ public:
+  void SetUp() override {
+    g_io_context->restart();
+    config::applier::init(0, "test_broker", 0);
+  }
+
+  void TearDown() override { config::applier::deinit(); }
+
+  std::shared_ptr<multiplexing::muxer> create(
+      const std::string& name,
+      const multiplexing::muxer_filter& w_filter) {
+    multiplexing::muxer_filter r_filter{io::raw::static_type()};
+    return multiplexing::muxer::create(
+        name, multiplexing::engine::instance_ptr(), r_filter, w_filter, false);
+  }
+
+  /**
+   * @brief Build a segment of count raw events containing their index.
+   */
+  static std::shared_ptr<multiplexing::event_segment> segment(int from,
+                                                              int count) {
+    auto retval = std::make_shared<multiplexing::event_segment>();
+    for (int i = from; i < from + count; ++i) {
+      auto r = std::make_shared<io::raw>();
+      r->resize(sizeof(i));
+      memcpy(r->data(), &i, sizeof(i));
+      retval->push_back(std::move(r));
+    }
+    return retval;
+  }
+
+  static int value(const std::shared_ptr<io::data>& d) {
+    int retval;
+    memcpy(&retval, std::static_pointer_cast<io::raw>(d)->data(),
+           sizeof(retval));
+    return retval;
+  }
+
+  static void reread(const std::shared_ptr<multiplexing::muxer>& m,
+                     int from,
+                     int to) {
+    for (int i = from; i < to; ++i) {
+      std::shared_ptr<io::data> d;
+      m->read(d, 0);
+      ASSERT_TRUE(d);
+      ASSERT_EQ(value(d), i);
+    }
+    std::shared_ptr<io::data> d;
+    m->read(d, 0);
+    ASSERT_FALSE(d);
+  }
+};
+
+/**
+ * @brief Two muxers share the same segments, each one with its own cursors.
+ */
+TEST_F(MultiplexingMuxer, SharedSegments) {
+  auto m1 = create("MultiplexingMuxer_SharedSegments1",
+                   multiplexing::muxer_filter());
+  auto m2 = create("MultiplexingMuxer_SharedSegments2",
+                   multiplexing::muxer_filter());
+  auto s1 = segment(0, 100);
+  auto s2 = segment(100, 100);
+  m1->publish(s1);
+  m2->publish(s1);
+  m1->publish(s2);
+  m2->publish(s2);
+
+  reread(m1, 0, 200);
+  m1->ack_events(150);
+  m1->nack_events();
+  reread(m1, 150, 200);
+  ASSERT_EQ(m1->get_event_queue_size(), 50u);
+
+  reread(m2, 0, 200);
+  m2->ack_events(200);
+  ASSERT_EQ(m2->get_event_queue_size(), 0u);
+  m1->unsubscribe();
+  m2->unsubscribe();
+}
+
+/**
+ * @brief Events rejected by the write filter are left out of the queue, they
+ * are never read.
+ */
+TEST_F(MultiplexingMuxer, WriteFilterSplitsSegment) {
+  auto m = create("MultiplexingMuxer_WriteFilterSplitsSegment",
+                  multiplexing::muxer_filter{io::raw::static_type()});
+  auto s = segment(0, 10);
+  /* Events that are not raw ones are rejected by the write filter. */
+  s->insert(s->begin() + 5, std::make_shared<io::data>(0u));
+  s->insert(s->begin() + 3, std::make_shared<io::data>(0u));
+  s->push_front(std::make_shared<io::data>(0u));
+  m->publish(s);
+  ASSERT_EQ(m->get_event_queue_size(), 10u);
+
+  reread(m, 0, 10);
+  m->ack_events(4);
+  m->nack_events();
+  reread(m, 4, 10);
+  m->ack_events(6);
+  ASSERT_EQ(m->get_event_queue_size(), 0u);
+
+  /* Too many acknowledged events are ignored. */
+  m->publish(segment(10, 5));
+  std::shared_ptr<io::data> d;
+  m->read(d, 0);
+  m->ack_events(10);
+  ASSERT_EQ(m->get_event_queue_size(), 4u);
+  reread(m, 11, 15);
+  m->unsubscribe();
+}
+
+/**
+ * @brief A muxer does not keep alive the events rejected by its write filter,
+ * and the memory of its events is counted until they are all acknowledged.
+ */
+TEST_F(MultiplexingMuxer, RejectedEventsNotKept) {
+  auto m = create("MultiplexingMuxer_RejectedEventsNotKept",
+                  multiplexing::muxer_filter{io::raw::static_type()});
+  auto s = segment(0, 4);
+  auto rejected = std::make_shared<io::data>(0u);
+  std::weak_ptr<io::data> rejected_ref(rejected);
+  s->push_back(std::move(rejected));
+  m->publish(s);
+  s.reset();
+  ASSERT_TRUE(rejected_ref.expired());
+  ASSERT_EQ(m->get_event_queue_size(), 4u);
+  ASSERT_EQ(multiplexing::muxer::memory_used(), 4 * sizeof(int));
+
+  reread(m, 0, 4);
+  m->ack_events(2);
+  ASSERT_EQ(multiplexing::muxer::memory_used(), 4 * sizeof(int));
+  m->ack_events(2);
+  ASSERT_EQ(multiplexing::muxer::memory_used(), 0u);
+  m->unsubscribe();
+}
+
+/**
+ * @brief The memory queue is limited by the estimated size of events, the
+ * other events go to the queue file.
+ */
+TEST_F(MultiplexingMuxer, MemoryLimit) {
+  /* Each raw event contains an int, so 10 events fit in 40 bytes. */
+  multiplexing::muxer::event_queue_max_bytes(10 * sizeof(int));
+  auto m =
+      create("MultiplexingMuxer_MemoryLimit", multiplexing::muxer_filter());
+  m->publish(segment(0, 100));
+  ASSERT_EQ(m->get_event_queue_size(), 10u);
+  ASSERT_EQ(multiplexing::muxer::memory_used(), 10 * sizeof(int));
+  multiplexing::muxer::event_queue_max_bytes(0);
+  m->unsubscribe();
+  m->remove_queue_files();
+}
+
+/**
+ * @brief When the global memory budget is exhausted, a muxer can still use
+ * its fair share of it.
+ */
+TEST_F(MultiplexingMuxer, MemoryBudgetFairShare) {
+  multiplexing::muxer::event_queues_memory_budget(20 * sizeof(int));
+  auto m1 = create("MultiplexingMuxer_MemoryBudgetFairShare1",
+                   multiplexing::muxer_filter());
+  auto m2 = create("MultiplexingMuxer_MemoryBudgetFairShare2",
+                   multiplexing::muxer_filter());
+  auto s = segment(0, 100);
+  /* m1 uses the whole budget. */
+  m1->publish(s);
+  ASSERT_EQ(m1->get_event_queue_size(), 20u);
+  /* m2 is limited to its fair share. */
+  m2->publish(s);
+  ASSERT_EQ(m2->get_event_queue_size(), 10u);
+  multiplexing::muxer::event_queues_memory_budget(0);
+  m1->unsubscribe();
+  m2->unsubscribe();
+  m1->remove_queue_files();
+  m2->remove_queue_files();
+}
@@ -2294,3 +2294,118 @@ TEST_F(DatabaseStorageTest, bulk_or_multi_bbdo_event_multi) {
     ASSERT_EQ(select_res.value_as_i32(6), 789 + data_index);
   }
 }
+
+/**
+ * @brief Service status updates are executed with the same statement, the
+ * connection sends them by batches. This test checks the rows updated without
+ * and with batches.
+ */
+TEST_F(DatabaseStorageTest, BatchServiceStatusUpdates) {
+  database_config db_cfg("MySQL", "127.0.0.1", MYSQL_SOCKET, 3306, "root",
+                         "centreon", "centreon_storage", 5, true, 5);
+  db_cfg.set_max_batch_rows(1);
+  auto ms{std::make_unique<mysql>(db_cfg)};
+  ms->run_query("DROP TABLE IF EXISTS ut_services");
+  ms->commit();
+  ms->run_query(
+      "CREATE TABLE ut_services (host_id INT UNSIGNED NOT NULL, service_id "
+      "INT UNSIGNED NOT NULL, state TINYINT, output VARCHAR(255), perfdata "
+      "VARCHAR(255) DEFAULT NULL, last_check BIGINT, PRIMARY KEY (host_id, "
+      "service_id))");
+  ms->commit();
+
+  constexpr uint32_t TOTAL = 20000;
+  mysql_stmt insert(ms->prepare_query(
+      "INSERT INTO ut_services (host_id, service_id) VALUES (?,?)"));
+  for (uint32_t i = 0; i < TOTAL; i++) {
+    insert.bind_value_as_u32(0, 1 + i / 20);
+    insert.bind_value_as_u32(1, i);
+    ms->run_statement(insert);
+  }
+  ms->commit();
+
+  auto update_all = [](mysql& ms, int64_t last_check) {
+    mysql_stmt update(ms.prepare_query(
+        "UPDATE ut_services SET state=?, output=?, perfdata=?, last_check=? "
+        "WHERE host_id=? AND service_id=?"));
+    for (uint32_t i = 0; i < TOTAL; i++) {
+      update.bind_value_as_tiny(0, i % 4);
+      update.bind_value_as_str(1, fmt::format("service {} is fine", i));
+      /* Some values are NULL, they can be mixed with the others. */
+      if (i % 3)
+        update.bind_value_as_str(2, fmt::format("metric={};80;90", i % 100));
+      else
+        update.bind_null_str(2);
+      update.bind_value_as_i64(3, last_check);
+      update.bind_value_as_u32(4, 1 + i / 20);
+      update.bind_value_as_u32(5, i);
+      ms.run_statement(update);
+    }
+    ms.commit();
+  };
+
+  auto check = [&](int64_t last_check) {
+    std::promise<mysql_result> promise;
+    std::future<mysql_result> future = promise.get_future();
+    ms->run_query_and_get_result(
+        fmt::format("SELECT count(*), count(perfdata), sum(state) FROM "
+                    "ut_services WHERE last_check={}",
+                    last_check),
+        std::move(promise));
+    mysql_result res(future.get());
+    ASSERT_TRUE(ms->fetch_row(res));
+    ASSERT_EQ(res.value_as_u32(0), TOTAL);
+    ASSERT_EQ(res.value_as_u32(1), TOTAL - (TOTAL + 2) / 3);
+    ASSERT_EQ(res.value_as_u32(2), TOTAL / 4 * (0 + 1 + 2 + 3));
+  };
+
+  update_all(*ms, 1000);
+  check(1000);
+
+  database_config batch_cfg(db_cfg);
+  batch_cfg.set_max_batch_rows(4096);
+  mysql batch_ms(batch_cfg);
+  update_all(batch_ms, 2000);
+  check(2000);
+}
+
+/**
+ * @brief A batch whose execution fails on one of its rows is rolled back and
+ * its rows are executed one by one: only the wrong row is lost and the rows
+ * applied before the failure are not inserted twice.
+ */
+TEST_F(DatabaseStorageTest, BatchFailureNotAppliedTwice) {
+  database_config db_cfg("MySQL", "127.0.0.1", MYSQL_SOCKET, 3306, "root",
+                         "centreon", "centreon_storage", 5, true, 1);
+  db_cfg.set_max_batch_rows(4096);
+  auto ms{std::make_unique<mysql>(db_cfg)};
+  ms->run_query("DROP TABLE IF EXISTS ut_batch");
+  ms->commit();
+  ms->run_query(
+      "CREATE TABLE ut_batch (id INT UNSIGNED NOT NULL, u INT UNSIGNED "
+      "DEFAULT NULL, UNIQUE KEY (u))");
+  ms->run_query("INSERT INTO ut_batch (id, u) VALUES (1000, 1)");
+  ms->commit();
+
+  /* Only the row 50 fails, NULL values of the unique key can be repeated. */
+  mysql_stmt insert(
+      ms->prepare_query("INSERT INTO ut_batch (id, u) VALUES (?,?)"));
+  for (uint32_t i = 0; i < 100; i++) {
+    insert.bind_value_as_u32(0, i);
+    if (i == 50)
+      insert.bind_value_as_u32(1, 1);
+    else
+      insert.bind_null_u32(1);
+    ms->run_statement(insert);
+  }
+  ms->commit();
+
+  std::promise<mysql_result> promise;
+  std::future<mysql_result> future = promise.get_future();
+  ms->run_query_and_get_result(
+      "SELECT count(*), count(DISTINCT id) FROM ut_batch", std::move(promise));
+  mysql_result res(future.get());
+  ASSERT_TRUE(ms->fetch_row(res));
+  ASSERT_EQ(res.value_as_u32(0), 100u);
+  ASSERT_EQ(res.value_as_u32(1), 100u);
+}
@@ -98,9 +98,9 @@ TEST_F(BrokerRpc, GetMuxerStats) {
       "unacknowledged_events: "
       "1790\n"};
 
-  stats::center::instance().update_muxer("mx1", "qufl_", 18u, 1789u);
+  stats::center::instance().update_muxer("mx1", "qufl_", 18u, 1789u, 0u, 0u);
 
-  stats::center::instance().update_muxer("mx2", "_qufl", 18u, 1790u);
+  stats::center::instance().update_muxer("mx2", "_qufl", 18u, 1790u, 0u, 0u);
 
   std::list<std::string> output = execute("GetMuxerStats mx1 mx2");
 
@@ -0,0 +1,95 @@
+/**
+ * Copyright 2023 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include "com/centreon/broker/time/timeperiod.hh"
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace com::centreon::broker::time;
+
+static constexpr time_t day = 24 * 60 * 60;
+
+/**
+ *  Expected next valid time in a UTC timeperiod valid every day from 08:00 to
+ *  12:00 and from 14:00 to 18:00.
+ */
+static time_t expected_next_valid(time_t t) {
+  time_t midnight = t - t % day;
+  time_t s = t % day;
+  if (s < 8 * 3600)
+    return midnight + 8 * 3600;
+  if (s < 12 * 3600)
+    return t;
+  if (s < 14 * 3600)
+    return midnight + 14 * 3600;
+  if (s < 18 * 3600)
+    return t;
+  return midnight + day + 8 * 3600;
+}
+
+/**
+ *  Expected next invalid time in the same timeperiod.
+ */
+static time_t expected_next_invalid(time_t t) {
+  time_t midnight = t - t % day;
+  time_t s = t % day;
+  if (s >= 8 * 3600 && s < 12 * 3600)
+    return midnight + 12 * 3600;
+  if (s >= 14 * 3600 && s < 18 * 3600)
+    return midnight + 18 * 3600;
+  return t;
+}
+
+// Given a timeperiod
+// When next valid and invalid times are looked up in the next days, where
+// they are compiled, and in the previous days, where they are computed
+// Then they are right
+TEST(Timeperiod, CompiledLookups) {
+  std::string ranges{"08:00-12:00,14:00-18:00"};
+  timeperiod tp(1, "test", "alias", ranges, ranges, ranges, ranges, ranges,
+                ranges, ranges);
+  tp.set_timezone("UTC");
+
+  time_t now = ::time(nullptr);
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<time_t> dist(now - 7 * day, now + 7 * day);
+  for (int i = 0; i < 10000; ++i) {
+    time_t t = dist(gen);
+    if (i % 2)
+      t -= t % 1800;
+    ASSERT_EQ(tp.get_next_valid(t), expected_next_valid(t)) << "t=" << t;
+    ASSERT_EQ(tp.get_next_invalid(t), expected_next_invalid(t)) << "t=" << t;
+    ASSERT_EQ(tp.is_valid(t), expected_next_valid(t) == t) << "t=" << t;
+  }
+}
+
+// Given a timeperiod whose lookups are compiled
+// When its timeranges change
+// Then lookups use the new timeranges
+TEST(Timeperiod, CompiledInvalidate) {
+  timeperiod tp(1, "test", "alias", "", "", "", "", "", "", "");
+  tp.set_timezone("UTC");
+
+  time_t now = ::time(nullptr);
+  ASSERT_EQ(tp.get_next_valid(now), (time_t)-1);
+  for (int i = 0; i < 7; ++i)
+    tp.set_timerange("00:00-24:00", i);
+  ASSERT_EQ(tp.get_next_valid(now), now);
+  ASSERT_EQ(tp.get_next_invalid(now), (time_t)-1);
+}
@@ -140,7 +140,10 @@ cc_file_create_event_with_data_function = """
 /**
  * @brief this function create a event_with_data structure that will be send on grpc.
  * stream_content don't have a copy of event, so event mustn't be
- * deleted before stream_content
+ * deleted before stream_content.
+ * The unsafe_arena accessors are used because a relayed event may live in the
+ * arena of a received batch: the safe ones would copy it to the heap and the
+ * releaser would leak that copy.
  *
  * @param event to send
  * @return object used for send on the wire
@@ -210,8 +213,8 @@ for directory in args.proto_directory:
                     cc_file_create_event_with_data_function += f"""        case make_type({id}):
             ret = std::make_shared<channel::event_with_data>(
                 event, reinterpret_cast<channel::event_with_data::releaser_type>(
-                &grpc_event_type::release_{lower_mess}_));
-            ret->grpc_event.set_allocated_{lower_mess}_(&std::static_pointer_cast<io::protobuf<{mess}, make_type({id})>>(event)->mut_obj());
+                &grpc_event_type::unsafe_arena_release_{lower_mess}_));
+            ret->grpc_event.unsafe_arena_set_allocated_{lower_mess}_(&std::static_pointer_cast<io::protobuf<{mess}, make_type({id})>>(event)->mut_obj());
             break;
 
 """
@@ -226,6 +229,9 @@ package com.centreon.broker.stream;
     fp.write(file_message_centreon_event)
     fp.write("""
     }
+    // when the peers negotiated it, several events are sent in one message,
+    // content is then empty
+    repeated CentreonEvent events = 125;
     uint32 destination_id = 126;
     uint32 source_id = 127;
 }
@@ -54,6 +54,11 @@ struct detail_centreon_event {
 };
 
 const std::string authorization_header("authorization");
+/**
+ * @brief metadata sent by each peer to announce the maximum size of the
+ * batches of events it accepts
+ */
+const std::string batch_size_header("centreon-batch-size");
 
 constexpr uint32_t calc_accept_all_compression_mask() {
   uint32_t ret = 0;
@@ -97,6 +102,9 @@ class channel : public std::enable_shared_from_this<channel> {
       if (releaser) {
         (grpc_event.*releaser)();
       }
+      // events of a batch are owned by the write queue
+      while (grpc_event.events_size())
+        grpc_event.mutable_events()->UnsafeArenaReleaseLast();
     }
   };
 
@@ -118,7 +126,11 @@ class channel : public std::enable_shared_from_this<channel> {
   // write section
   write_queue _write_queue;
   event_with_data::pointer _write_current;
+  // number of events of _write_queue sent by _write_current
+  size_t _write_current_count;
   bool _write_pending;
+  // negotiated maximum batch size, 0 if events are sent one by one
+  uint32_t _batch_size;
 
   bool _error;
   bool _thrown;
@@ -151,6 +163,7 @@ class channel : public std::enable_shared_from_this<channel> {
   bool is_down() const { return _error || _thrown; };
   bool is_alive() const { return !_error && !_thrown; }
   grpc_config::pointer get_conf() const { return _conf; }
+  void set_peer_batch_size(uint32_t peer_batch_size);
 
   std::pair<event_ptr, bool> read(time_t deadline) {
     return read(system_clock::from_time_t(deadline));
@@ -65,6 +65,7 @@ class client : public channel,
 
   void shutdown() override;
 
+  void OnReadInitialMetadataDone(bool ok) override;
   void OnReadDone(bool ok) override;
   void OnWriteDone(bool ok) override;
 };
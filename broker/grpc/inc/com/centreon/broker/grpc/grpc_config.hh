@@ -39,19 +39,30 @@ class grpc_config {
    *
    */
   const bool _grpc_serialized;
+  /**
+   * @brief maximum size in bytes of a batch of events sent in one message.
+   * The real size is the minimum of the sizes announced by both peers, 0
+   * disables batching and events are sent one by one.
+   *
+   */
+  const uint32_t _batch_size;
 
  public:
   using pointer = std::shared_ptr<grpc_config>;
 
+  static constexpr uint32_t default_batch_size = 65536u;
+
   grpc_config()
       : _compress(NO),
         _second_keepalive_interval(30),
-        _grpc_serialized(false) {}
+        _grpc_serialized(false),
+        _batch_size(default_batch_size) {}
   grpc_config(const std::string& hostp)
       : _hostport(hostp),
         _compress(NO),
         _second_keepalive_interval(30),
-        _grpc_serialized(false) {}
+        _grpc_serialized(false),
+        _batch_size(default_batch_size) {}
   grpc_config(const std::string& hostp,
               bool crypted,
               const std::string& certificate,
@@ -61,7 +72,8 @@ class grpc_config {
               const std::string& ca_name,
               compression_active compression,
               int second_keepalive_interval,
-              bool grpc_serialized)
+              bool grpc_serialized,
+              uint32_t batch_size = default_batch_size)
       : _hostport(hostp),
         _crypted(crypted),
         _certificate(certificate),
@@ -71,7 +83,8 @@ class grpc_config {
         _ca_name(ca_name),
         _compress(compression),
         _second_keepalive_interval(second_keepalive_interval),
-        _grpc_serialized(grpc_serialized) {}
+        _grpc_serialized(grpc_serialized),
+        _batch_size(batch_size) {}
 
   constexpr const std::string& get_hostport() const { return _hostport; }
   constexpr bool is_crypted() const { return _crypted; }
@@ -84,6 +97,7 @@ class grpc_config {
   const std::string& get_ca_name() const { return _ca_name; }
   constexpr compression_active get_compression() const { return _compress; }
   constexpr bool get_grpc_serialized() const { return _grpc_serialized; }
+  constexpr uint32_t get_batch_size() const { return _batch_size; }
 
   int get_second_keepalive_interval() const {
     return _second_keepalive_interval;
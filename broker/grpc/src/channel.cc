@@ -80,7 +80,9 @@ channel::channel(const std::string& class_name,
                  const grpc_config::pointer& conf)
     : _class_name(class_name),
       _read_pending(false),
+      _write_current_count(0),
       _write_pending(false),
+      _batch_size(0),
       _error(false),
       _thrown(false),
       _conf(conf) {
@@ -114,6 +116,20 @@ int channel::stop() {
   return ret;
 }
 
+/**
+ * @brief called once the peer has announced the size of the batches it
+ * accepts. From then, several events can be sent in one message.
+ *
+ * @param peer_batch_size the size announced by the peer, 0 if it does not
+ * understand batches
+ */
+void channel::set_peer_batch_size(uint32_t peer_batch_size) {
+  lock_guard l(_protect);
+  _batch_size = std::min(peer_batch_size, _conf->get_batch_size());
+  SPDLOG_LOGGER_DEBUG(log_v2::grpc(), "{} this={:p} batch size: {}",
+                      _class_name, static_cast<void*>(this), _batch_size);
+}
+
 /***************************************************************
  *    read section
  ***************************************************************/
@@ -146,7 +162,16 @@ void channel::start_read(bool first_read) {
     if (_read_pending) {
       return;
     }
-    to_read = _read_current = std::make_shared<grpc_event_type>();
+    if (_batch_size) {
+      /* The peer has negotiated batches, their events are allocated in an
+       * arena shared by all of them. Without it, the message stays on the
+       * heap as before. */
+      auto arena = std::make_shared<google::protobuf::Arena>();
+      to_read = _read_current = event_ptr(
+          arena,
+          google::protobuf::Arena::CreateMessage<grpc_event_type>(arena.get()));
+    } else
+      to_read = _read_current = std::make_shared<grpc_event_type>();
 
     _read_pending = true;
     if (first_read)
@@ -163,9 +188,16 @@ void channel::on_read_done(bool ok) {
   if (ok) {
     {
       lock_guard l(_protect);
-      SPDLOG_LOGGER_DEBUG(log_v2::grpc(), "receive: {}", *_read_current);
-
-      _read_queue.push_back(_read_current);
+      if (_read_current->events_size()) {
+        SPDLOG_LOGGER_DEBUG(log_v2::grpc(), "receive batch of {} events",
+                            _read_current->events_size());
+        /* Each event of the batch keeps the whole batch alive. */
+        for (grpc_event_type& evt : *_read_current->mutable_events())
+          _read_queue.emplace_back(_read_current, &evt);
+      } else {
+        SPDLOG_LOGGER_DEBUG(log_v2::grpc(), "receive: {}", *_read_current);
+        _read_queue.push_back(_read_current);
+      }
       _read_cond.notify_one();
       _read_pending = false;
     }
@@ -193,6 +225,13 @@ int channel::write(const event_with_data::pointer& to_send) {
   return 0;
 }
 
+/**
+ * @brief send the first event of the write queue. If the peer accepts
+ * batches, the events queued while the previous write was in progress are
+ * sent in one message of at most _batch_size bytes (or one event if it is
+ * bigger). Events are not copied, the batch only points to them.
+ *
+ */
 void channel::start_write() {
   event_with_data::pointer write_current;
   {
@@ -204,9 +243,31 @@ void channel::start_write() {
       return;
     }
     _write_pending = true;
-    write_current = _write_current = _write_queue.front();
+    _write_current_count = 1;
+    if (_batch_size && _write_queue.size() > 1) {
+      auto batch = std::make_shared<event_with_data>();
+      auto* events = batch->grpc_event.mutable_events();
+      size_t batch_bytes = 0;
+      for (const event_with_data::pointer& to_send : _write_queue) {
+        size_t size = to_send->grpc_event.ByteSizeLong();
+        if (!events->empty() && batch_bytes + size > _batch_size)
+          break;
+        events->UnsafeArenaAddAllocated(&to_send->grpc_event);
+        batch_bytes += size;
+      }
+      if (events->size() > 1) {
+        _write_current_count = events->size();
+        write_current = _write_current = batch;
+      } else
+        events->UnsafeArenaReleaseLast();
+    }
+    if (!write_current)
+      write_current = _write_current = _write_queue.front();
   }
-  if (write_current->bbdo_event)
+  if (_write_current_count > 1)
+    SPDLOG_LOGGER_TRACE(log_v2::grpc(), "write batch of {} events",
+                        _write_current_count);
+  else if (write_current->bbdo_event)
     SPDLOG_LOGGER_TRACE(log_v2::grpc(), "write: {}",
                         *write_current->bbdo_event);
   else
@@ -221,14 +282,19 @@ void channel::on_write_done(bool ok) {
     {
       lock_guard l(_protect);
       _write_pending = false;
-      if (_write_current->bbdo_event)
+      if (_write_current_count > 1) {
+        SPDLOG_LOGGER_TRACE(log_v2::grpc(), "write done: batch of {} events",
+                            _write_current_count);
+        _write_current.reset();
+      } else if (_write_current->bbdo_event)
         SPDLOG_LOGGER_TRACE(log_v2::grpc(), "write done: {}",
                             *_write_current->bbdo_event);
       else
         SPDLOG_LOGGER_TRACE(log_v2::grpc(), "write done: {}",
                             _write_current->grpc_event);
 
-      _write_queue.pop_front();
+      _write_queue.erase(_write_queue.begin(),
+                         _write_queue.begin() + _write_current_count);
       data_to_write = !_write_queue.empty();
     }
     _write_cond.notify_all();
@@ -237,7 +303,10 @@ void channel::on_write_done(bool ok) {
     }
   } else {
     lock_guard l(_protect);
-    if (_write_current->bbdo_event)
+    if (_write_current_count > 1)
+      SPDLOG_LOGGER_ERROR(log_v2::grpc(), "write failed: batch of {} events",
+                          _write_current_count);
+    else if (_write_current->bbdo_event)
       SPDLOG_LOGGER_ERROR(log_v2::grpc(), "write failed: {}",
                           *_write_current->bbdo_event);
     else
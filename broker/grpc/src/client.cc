@@ -17,6 +17,8 @@
  *
  */
 
+#include <absl/strings/numbers.h>
+
 #include "grpc_stream.grpc.pb.h"
 #include "grpc_stream.pb.h"
 
@@ -96,6 +98,10 @@ client::client(const grpc_config::pointer& conf)
   if (!_conf->get_authorization().empty()) {
     _context->AddMetadata(authorization_header, _conf->get_authorization());
   }
+  if (_conf->get_batch_size()) {
+    _context->AddMetadata(batch_size_header,
+                          std::to_string(_conf->get_batch_size()));
+  }
   _stub->async()->exchange(_context.get(), this);
 }
 
@@ -130,6 +136,26 @@ void client::start_read(event_ptr& to_read, bool first_read) {
   }
 }
 
+/**
+ * @brief the server announces in its initial metadata the size of the
+ * batches it accepts, an old server announces nothing and receives events
+ * one by one.
+ *
+ * @param ok
+ */
+void client::OnReadInitialMetadataDone(bool ok) {
+  if (!ok || !_conf->get_batch_size())
+    return;
+  const auto& metas = _context->GetServerInitialMetadata();
+  auto header_search = metas.find(batch_size_header);
+  uint32_t peer_batch_size;
+  if (header_search != metas.end() &&
+      absl::SimpleAtoi(absl::string_view(header_search->second.data(),
+                                         header_search->second.size()),
+                       &peer_batch_size))
+    set_peer_batch_size(peer_batch_size);
+}
+
 void client::OnReadDone(bool ok) {
   on_read_done(ok);
 }
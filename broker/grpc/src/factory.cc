@@ -69,6 +69,30 @@ static std::string read_file(const std::string& path) {
     throw msg_fmt("Cannot open file '{}': {}", path, strerror(errno));
 }
 
+/**
+ *  Read the maximum size of a batch of events sent in one gRPC message.
+ *
+ *  @param[in] cfg  Endpoint configuration.
+ *
+ *  @return The 'batch_size' parameter, the default one if not set. 0 means
+ *  events are sent one by one.
+ */
+static uint32_t read_batch_size(const config::endpoint& cfg) {
+  uint32_t batch_size = grpc_config::default_batch_size;
+  auto it = cfg.params.find("batch_size");
+  if (it != cfg.params.end()) {
+    if (!absl::SimpleAtoi(it->second, &batch_size)) {
+      log_v2::grpc()->error(
+          "GRPC: 'batch_size' field should be an integer and not '{}'",
+          it->second);
+      throw msg_fmt(
+          "GRPC: 'batch_size' field should be an integer and not '{}'",
+          it->second);
+    }
+  }
+  return batch_size;
+}
+
 /**
  *  Create a new endpoint from a configuration.
  *
@@ -219,6 +243,8 @@ io::endpoint* factory::new_endpoint(
     }
   }
 
+  uint32_t batch_size = read_batch_size(cfg);
+
   std::string hostport;
   if (host.empty()) {
     is_acceptor = true;
@@ -231,7 +257,7 @@ io::endpoint* factory::new_endpoint(
   grpc_config::pointer conf(std::make_shared<grpc_config>(
       hostport, encrypted, certificate, certificate_key, certificate_authority,
       authorization, ca_name, enable_compression, keepalive_interval,
-      direct_grpc_serialized(cfg)));
+      direct_grpc_serialized(cfg), batch_size));
 
   std::unique_ptr<io::endpoint> endp;
 
@@ -437,6 +463,8 @@ io::endpoint* factory::_new_endpoint_bbdo_cs(
     }
   }
 
+  uint32_t batch_size = read_batch_size(cfg);
+
   std::string hostport;
   if (cfg.type == "bbdo_server") {
     is_acceptor = true;
@@ -449,7 +477,7 @@ io::endpoint* factory::_new_endpoint_bbdo_cs(
   grpc_config::pointer conf(std::make_shared<grpc_config>(
       hostport, encryption, certificate, private_key, ca_certificate,
       authorization, ca_name, enable_compression, keepalive_interval,
-      direct_grpc_serialized(cfg)));
+      direct_grpc_serialized(cfg), batch_size));
 
   // Acceptor.
   std::unique_ptr<io::endpoint> endp;
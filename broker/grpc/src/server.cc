@@ -17,6 +17,8 @@
  *
  */
 
+#include <absl/strings/numbers.h>
+
 #include "grpc_stream.grpc.pb.h"
 
 #include "com/centreon/broker/grpc/server.hh"
@@ -41,6 +43,10 @@ accepted_service::accepted_service(const grpc_config::pointer& conf,
 }
 
 void accepted_service::start() {
+  /* The batch size is only set if the client announced it, we answer with
+   * ours at once so that the client doesn't wait for our first event. */
+  if (_batch_size)
+    StartSendInitialMetadata();
   channel::start_read(true);
 }
 
@@ -215,15 +221,32 @@ server::pointer server::create(const grpc_config::pointer& conf) {
       found = _conf->get_authorization() == header_search->second;
     }
   }
-  accepted_service::pointer serv;
+  accepted_service::pointer serv =
+      std::make_shared<accepted_service>(_conf, _server_finished);
+
+  // batch negotiation, an old client announces nothing
+  if (_conf->get_batch_size()) {
+    const auto& metas = context->client_metadata();
+    auto header_search = metas.find(batch_size_header);
+    uint32_t peer_batch_size;
+    if (header_search != metas.end() &&
+        absl::SimpleAtoi(absl::string_view(header_search->second.data(),
+                                           header_search->second.size()),
+                         &peer_batch_size)) {
+      context->AddInitialMetadata(batch_size_header,
+                                  std::to_string(_conf->get_batch_size()));
+      serv->set_peer_batch_size(peer_batch_size);
+    }
+  }
+
+  /* The service is started before being given to a stream, so initial
+   * metadata are sent before any write. */
+  serv->start();
   {
     unique_lock l(_protect);
-    serv = std::make_shared<accepted_service>(_conf, _server_finished);
     _accepted.push(serv);
     _accept_cond.notify_one();
   }
-
-  serv->start();
   return serv.get();
 }
 
@@ -21,6 +21,8 @@
 #include <thread>
 #include "grpc_test_include.hh"
 
+#include "com/centreon/broker/grpc/grpc_bridge.hh"
+
 using namespace com::centreon::broker;
 using namespace com::centreon::broker::grpc;
 using namespace com::centreon::exceptions;
@@ -192,3 +194,128 @@ TEST_F(grpc_channel_tester, throw_write_after_failure) {
                msg_fmt);
   ASSERT_THROW(channel->read(std::chrono::milliseconds(1)), msg_fmt);
 }
+
+class channel_test_batch : public channel_test {
+ public:
+  std::vector<int> sent_sizes;
+  std::vector<size_t> sent_bytes;
+
+  channel_test_batch(const grpc_config::pointer& conf) : channel_test(conf) {}
+
+  void simul_on_write() override {
+    sent_sizes.push_back(_write_current->grpc_event.events_size()
+                             ? _write_current->grpc_event.events_size()
+                             : 1);
+    sent_bytes.push_back(_write_current->grpc_event.ByteSizeLong());
+    on_write_done(true);
+  }
+};
+
+static channel::event_with_data::pointer create_raw_event(size_t size) {
+  auto ret = std::make_shared<channel::event_with_data>();
+  ret->grpc_event.mutable_buffer()->assign(size, 'a');
+  return ret;
+}
+
+// Given a channel whose peer accepts batches of 65536 bytes
+// When 100 events are written while the first write is in progress
+// Then the 99 last events are sent in one message
+TEST_F(grpc_channel_tester, write_batched) {
+  auto channel = std::make_shared<channel_test_batch>(conf1);
+  channel->set_peer_batch_size(65536);
+  channel->start();
+
+  pool::io_context().post(
+      []() { std::this_thread::sleep_for(std::chrono::milliseconds(20)); });
+  for (int ii = 0; ii < 100; ++ii)
+    channel->write(create_raw_event(10));
+  ASSERT_TRUE(channel->wait_for_all_events_written(1000));
+  ASSERT_EQ(channel->sent_sizes, std::vector<int>({1, 99}));
+}
+
+// Given a channel whose peer accepts batches of 1000 bytes
+// When 100 events of 103 bytes are written while the first write is in
+// progress
+// Then the 99 last events are sent by 9 in messages not bigger than 1000 bytes
+TEST_F(grpc_channel_tester, write_batched_size_limit) {
+  auto channel = std::make_shared<channel_test_batch>(conf1);
+  channel->set_peer_batch_size(1000);
+  channel->start();
+
+  pool::io_context().post(
+      []() { std::this_thread::sleep_for(std::chrono::milliseconds(20)); });
+  for (int ii = 0; ii < 100; ++ii)
+    channel->write(create_raw_event(100));
+  ASSERT_TRUE(channel->wait_for_all_events_written(1000));
+  ASSERT_EQ(channel->sent_sizes.size(), 12u);
+  ASSERT_EQ(channel->sent_sizes[0], 1);
+  for (size_t ii = 1; ii < channel->sent_sizes.size(); ++ii) {
+    ASSERT_EQ(channel->sent_sizes[ii], 9);
+    ASSERT_LE(channel->sent_bytes[ii], 1000u + 9 * 3);
+  }
+}
+
+// Given a channel whose peer does not accept batches
+// When 100 events are written while the first write is in progress
+// Then they are sent one by one
+TEST_F(grpc_channel_tester, write_not_batched) {
+  auto channel = std::make_shared<channel_test_batch>(conf1);
+  channel->start();
+
+  pool::io_context().post(
+      []() { std::this_thread::sleep_for(std::chrono::milliseconds(20)); });
+  for (int ii = 0; ii < 100; ++ii)
+    channel->write(create_raw_event(10));
+  ASSERT_TRUE(channel->wait_for_all_events_written(1000));
+  ASSERT_EQ(channel->sent_sizes, std::vector<int>(100, 1));
+}
+
+// Given a channel
+// When it receives a batch of 10 events
+// Then read() returns them one by one in the same order
+TEST_F(grpc_channel_tester, read_batch) {
+  std::shared_ptr<channel_test> channel = channel_test::create(conf1);
+  auto batch = std::make_shared<grpc_event_type>();
+  for (int ii = 0; ii < 10; ++ii) {
+    grpc_event_type* evt = batch->add_events();
+    evt->set_buffer(std::to_string(ii));
+    evt->set_source_id(ii);
+  }
+  channel->to_read.push(batch);
+  channel->start();
+
+  for (int ii = 0; ii < 10; ++ii) {
+    auto read_ret = channel->read(std::chrono::milliseconds(100));
+    ASSERT_TRUE(read_ret.second) << "ii=" << ii;
+    ASSERT_EQ(read_ret.first->buffer(), std::to_string(ii));
+    ASSERT_EQ(read_ret.first->source_id(), ii);
+  }
+  ASSERT_FALSE(channel->read(std::chrono::milliseconds(10)).second);
+}
+
+// Given a batch received in an arena
+// When one of its events is relayed to another peer
+// Then the message sent is the received one, not a copy
+// And the received event is still owned by the batch
+TEST_F(grpc_channel_tester, relay_event_from_arena) {
+  auto arena = std::make_shared<google::protobuf::Arena>();
+  event_ptr batch(
+      arena,
+      google::protobuf::Arena::CreateMessage<grpc_event_type>(arena.get()));
+  grpc_event_type* evt = batch->add_events();
+  evt->mutable_service_()->set_host_id(12);
+  evt->mutable_service_()->set_service_id(25);
+  event_ptr received(batch, evt);
+
+  std::shared_ptr<io::data> relayed = protobuf_to_event(received);
+  ASSERT_TRUE(relayed);
+  {
+    channel::event_with_data::pointer to_send =
+        create_event_with_data(relayed);
+    ASSERT_TRUE(to_send);
+    ASSERT_EQ(&to_send->grpc_event.service_(), &received->service_());
+  }
+  ASSERT_TRUE(received->has_service_());
+  ASSERT_EQ(received->service_().host_id(), 12u);
+  ASSERT_EQ(received->service_().service_id(), 25u);
+}
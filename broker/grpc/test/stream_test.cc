@@ -435,3 +435,70 @@ TEST_P(grpc_test_server_crypted, ServerToClientWithKeyAndBadAuthorization) {
 
   ASSERT_EQ(accepted.get(), nullptr);
 }
+
+/*************************************
+ * batches
+ *************************************/
+
+class grpc_batch : public ::testing::Test {
+ public:
+  static void SetUpTestSuite() {
+    // log_v2::grpc()->set_level(spdlog::level::trace);
+    com::centreon::broker::pool::load(std::make_shared<asio::io_context>(), 1);
+  }
+};
+
+static com::centreon::broker::grpc::grpc_config::pointer batch_conf(
+    uint32_t batch_size) {
+  return std::make_shared<com::centreon::broker::grpc::grpc_config>(
+      "127.0.0.1:4447", false, "", "", "", "", "",
+      com::centreon::broker::grpc::grpc_config::NO, 30, false, batch_size);
+}
+
+// Given a server and a client with events sent one by one, a batched server
+// with an old client, and a batched server with a batched client
+// When the client sends 10000 events to the server
+// Then the server receives all of them in order
+TEST_F(grpc_batch, ClientToServerInOrder) {
+  constexpr unsigned count = 10000;
+  constexpr uint32_t batch_size =
+      com::centreon::broker::grpc::grpc_config::default_batch_size;
+  struct {
+    const char* name;
+    uint32_t server_batch_size;
+    uint32_t client_batch_size;
+  } modes[] = {
+      {"single", 0, 0},
+      {"old client", batch_size, 0},
+      {"batched", batch_size, batch_size},
+  };
+
+  for (const auto& mode : modes) {
+    auto s = std::make_unique<com::centreon::broker::grpc::acceptor>(
+        batch_conf(mode.server_batch_size));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    com::centreon::broker::grpc::stream client(
+        batch_conf(mode.client_batch_size));
+    std::shared_ptr<io::stream> accepted =
+        s->open(std::chrono::milliseconds(1000));
+    ASSERT_NE(accepted.get(), nullptr) << mode.name;
+
+    std::thread writer([&client]() {
+      for (unsigned ii = 0; ii < count; ++ii)
+        client.write(create_event(test_param{0, 0, 0, std::to_string(ii)}));
+    });
+
+    unsigned received = 0;
+    while (received < count) {
+      std::shared_ptr<io::data> receive;
+      bool read_ret = accepted->read(receive, time(nullptr) + 5);
+      ASSERT_TRUE(read_ret) << mode.name << " received=" << received;
+      test_param expected{0, 0, 0, std::to_string(received)};
+      COMPARE_EVENT(read_ret, receive, expected);
+      ++received;
+    }
+    writer.join();
+    accepted.reset();
+    s.reset();
+  }
+}
@@ -0,0 +1,59 @@
+/**
+ * Copyright 2023 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CCB_HTTP_TSDB_BODY_ENCODER_HH
+#define CCB_HTTP_TSDB_BODY_ENCODER_HH
+
+#include "http_tsdb_config.hh"
+
+struct z_stream_s;
+struct ZSTD_CCtx_s;
+
+namespace com::centreon::broker {
+
+namespace http_tsdb {
+
+/**
+ * @brief this class compresses request bodies in gzip or zstd format
+ * the compression context is kept from one request to the other, so an
+ * object must not be used by several threads at the same time
+ *
+ */
+class body_encoder {
+  const http_tsdb_config::compression _compression;
+  const int _level;
+  std::unique_ptr<z_stream_s> _zstream;
+  ZSTD_CCtx_s* _zstd_ctx;
+
+ public:
+  body_encoder(http_tsdb_config::compression compression, int level = -1);
+  ~body_encoder();
+  body_encoder(const body_encoder&) = delete;
+  body_encoder& operator=(const body_encoder&) = delete;
+
+  void encode(const std::string& in, std::string& out);
+  const char* content_encoding() const;
+
+  static http_tsdb_config::compression parse(const std::string& name);
+};
+
+}  // namespace http_tsdb
+
+}  // namespace com::centreon::broker
+
+#endif
@@ -26,12 +26,25 @@ namespace com::centreon::broker {
 
 namespace http_tsdb {
 class http_tsdb_config : public http_client::http_config {
+ public:
+  /**
+   * @brief Content-Encoding of the request bodies
+   */
+  enum class compression { none, gzip, zstd };
+
+ private:
   std::string _http_target;
   std::string _user;
   std::string _pwd;
   unsigned _max_queries_per_transaction;
   std::vector<column> _status_columns;
   std::vector<column> _metric_columns;
+  compression _compression;
+  // -1 for the default level of the algorithm
+  int _compression_level;
+  // if not null, the number of queries per request is adapted to keep the
+  // server response time under this duration
+  duration _target_latency;
 
  public:
   http_tsdb_config(const http_client::http_config& http_conf,
@@ -40,20 +53,36 @@ class http_tsdb_config : public http_client::http_config {
                    const std::string& pwd,
                    unsigned max_queries_per_transaction,
                    const std::vector<column>& status_columns,
-                   const std::vector<column>& metric_columns)
+                   const std::vector<column>& metric_columns,
+                   compression body_compression = compression::none,
+                   int compression_level = -1,
+                   duration target_latency = duration::zero())
       : http_client::http_config(http_conf),
         _http_target(http_target),
         _user(user),
         _pwd(pwd),
         _max_queries_per_transaction(max_queries_per_transaction),
         _status_columns(status_columns),
-        _metric_columns(metric_columns) {}
+        _metric_columns(metric_columns),
+        _compression(body_compression),
+        _compression_level(compression_level),
+        _target_latency(target_latency) {}
 
-  http_tsdb_config() : _max_queries_per_transaction(0) {}
+  http_tsdb_config()
+      : _max_queries_per_transaction(0),
+        _compression(compression::none),
+        _compression_level(-1),
+        _target_latency(duration::zero()) {}
   http_tsdb_config(const http_client::http_config& http_conf,
-                   unsigned max_queries_per_transaction)
+                   unsigned max_queries_per_transaction,
+                   compression body_compression = compression::none,
+                   int compression_level = -1,
+                   duration target_latency = duration::zero())
       : http_client::http_config(http_conf),
-        _max_queries_per_transaction(max_queries_per_transaction) {}
+        _max_queries_per_transaction(max_queries_per_transaction),
+        _compression(body_compression),
+        _compression_level(compression_level),
+        _target_latency(target_latency) {}
 
   const std::string& get_http_target() const { return _http_target; }
   const std::string& get_user() const { return _user; }
@@ -68,6 +97,9 @@ class http_tsdb_config : public http_client::http_config {
   const std::vector<column>& get_metric_columns() const {
     return _metric_columns;
   }
+  compression get_compression() const { return _compression; }
+  int get_compression_level() const { return _compression_level; }
+  const duration& get_target_latency() const { return _target_latency; }
 };
 }  // namespace http_tsdb
 
@@ -22,6 +22,7 @@
 #include "com/centreon/broker/http_client/http_client.hh"
 #include "com/centreon/broker/io/stream.hh"
 #include "com/centreon/broker/persistent_cache.hh"
+#include "body_encoder.hh"
 #include "http_tsdb_config.hh"
 #include "internal.hh"
 #include "line_protocol_query.hh"
@@ -37,17 +38,30 @@ class request : public http_client::request_base {
   unsigned _nb_metric;
   unsigned _nb_status;
 
+  // when the body is compressed, the plain text body is kept here in case of
+  // the request must be appended to another one
+  std::string _plain_body;
+  bool _compressed;
+  // time spent to fill and compress the body
+  std::chrono::nanoseconds _serialize_time;
+
  public:
   using pointer = std::shared_ptr<request>;
 
-  request() : _nb_metric(0), _nb_status(0) {}
+  request()
+      : _nb_metric(0),
+        _nb_status(0),
+        _compressed(false),
+        _serialize_time(0) {}
   request(boost::beast::http::verb method,
           const std::string& server_name,
           boost::beast::string_view target,
           unsigned version = 11)
       : http_client::request_base(method, server_name, target),
         _nb_metric(0),
-        _nb_status(0) {}
+        _nb_status(0),
+        _compressed(false),
+        _serialize_time(0) {}
 
   void dump(std::ostream&) const override;
 
@@ -57,6 +71,22 @@ class request : public http_client::request_base {
 
   virtual void append(const request::pointer& data_to_append);
 
+  void compress(body_encoder& encoder);
+  void uncompress();
+  size_t plain_body_size() const {
+    return _compressed ? _plain_body.size() : body().size();
+  }
+  void add_serialize_time(std::chrono::nanoseconds spent) {
+    _serialize_time += spent;
+  }
+  std::chrono::nanoseconds get_serialize_time() const {
+    return _serialize_time;
+  }
+
+  void reuse_buffers(std::vector<std::string>& buffers, bool with_plain_body);
+  void release_buffers(std::vector<std::string>& buffers,
+                       size_t max_buffers);
+
   unsigned get_nb_metric() const { return _nb_metric; }
   unsigned get_nb_status() const { return _nb_status; }
   unsigned get_nb_data() const { return _nb_metric + _nb_status; }
@@ -122,6 +152,20 @@ class stream : public io::stream, public std::enable_shared_from_this<stream> {
   stat_average _connect_avg;
   stat_average _send_avg;
   stat_average _recv_avg;
+  // compressed size * 100 / plain size
+  stat_average _compression_ratio_avg;
+  // time spent to fill and compress request bodies in microseconds
+  stat_average _serialize_avg;
+
+  // compresses bodies if compression is enabled
+  std::unique_ptr<body_encoder> _encoder;
+  // number of queries that triggers the send of a request, it follows the
+  // server response time if a target latency is configured
+  unsigned _queries_per_request;
+  // body buffers of the sent requests, reused by the next ones
+  std::vector<std::string> _buffers;
+  // initial capacity of request bodies, the plain size of the last body sent
+  size_t _body_size_to_reserve;
 
   mutable std::mutex _protect;
 
@@ -134,8 +178,12 @@ class stream : public io::stream, public std::enable_shared_from_this<stream> {
 
   virtual request::pointer create_request() const = 0;
 
+  request::pointer new_request();
+
   void send_request(const request::pointer& request);
 
+  void adapt_queries_per_request(const request::pointer& request, bool failed);
+
   void send_handler(const boost::beast::error_code& err,
                     const std::string& detail,
                     const request::pointer& request,
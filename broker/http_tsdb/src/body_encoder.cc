@@ -0,0 +1,142 @@
+/**
+ * Copyright 2023 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/broker/http_tsdb/body_encoder.hh"
+
+#include <zlib.h>
+#include <zstd.h>
+
+#include "com/centreon/exceptions/msg_fmt.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::exceptions;
+using namespace com::centreon::broker::http_tsdb;
+
+/**
+ * @brief Construct a new body encoder object
+ *
+ * @param compression gzip, zstd or none
+ * @param level compression level, -1 for the default of the algorithm
+ */
+body_encoder::body_encoder(http_tsdb_config::compression compression,
+                           int level)
+    : _compression(compression), _level(level), _zstd_ctx(nullptr) {
+  switch (_compression) {
+    case http_tsdb_config::compression::gzip:
+      _zstream = std::make_unique<z_stream>();
+      // 16 + MAX_WBITS asks zlib to write a gzip header and trailer
+      if (deflateInit2(_zstream.get(),
+                       level < 0 || level > 9 ? Z_DEFAULT_COMPRESSION : level,
+                       Z_DEFLATED, 16 + MAX_WBITS, 8,
+                       Z_DEFAULT_STRATEGY) != Z_OK)
+        throw msg_fmt("unable to initialize gzip compression: {}",
+                      _zstream->msg ? _zstream->msg : "");
+      break;
+    case http_tsdb_config::compression::zstd:
+      _zstd_ctx = ZSTD_createCCtx();
+      if (!_zstd_ctx)
+        throw msg_fmt("unable to initialize zstd compression");
+      break;
+    default:
+      break;
+  }
+}
+
+body_encoder::~body_encoder() {
+  if (_zstream)
+    deflateEnd(_zstream.get());
+  if (_zstd_ctx)
+    ZSTD_freeCCtx(_zstd_ctx);
+}
+
+/**
+ * @brief compress in into out
+ * out is overwritten but its capacity is reused
+ *
+ * @param in
+ * @param out
+ * @throw msg_fmt on compression error
+ */
+void body_encoder::encode(const std::string& in, std::string& out) {
+  switch (_compression) {
+    case http_tsdb_config::compression::gzip: {
+      deflateReset(_zstream.get());
+      out.resize(deflateBound(_zstream.get(), in.size()));
+      _zstream->next_in =
+          reinterpret_cast<Bytef*>(const_cast<char*>(in.data()));
+      _zstream->avail_in = in.size();
+      _zstream->next_out = reinterpret_cast<Bytef*>(out.data());
+      _zstream->avail_out = out.size();
+      int ret = deflate(_zstream.get(), Z_FINISH);
+      if (ret != Z_STREAM_END)
+        throw msg_fmt("gzip compression failed: {}",
+                      _zstream->msg ? _zstream->msg : std::to_string(ret));
+      out.resize(_zstream->total_out);
+    } break;
+    case http_tsdb_config::compression::zstd: {
+      out.resize(ZSTD_compressBound(in.size()));
+      size_t ret = ZSTD_compressCCtx(
+          _zstd_ctx, out.data(), out.size(), in.data(), in.size(),
+          _level < ZSTD_minCLevel() || _level > ZSTD_maxCLevel()
+              ? ZSTD_CLEVEL_DEFAULT
+              : _level);
+      if (ZSTD_isError(ret))
+        throw msg_fmt("zstd compression failed: {}", ZSTD_getErrorName(ret));
+      out.resize(ret);
+    } break;
+    default:
+      out = in;
+      break;
+  }
+}
+
+/**
+ * @brief value of the Content-Encoding header
+ *
+ * @return const char* nullptr if there is no compression
+ */
+const char* body_encoder::content_encoding() const {
+  switch (_compression) {
+    case http_tsdb_config::compression::gzip:
+      return "gzip";
+    case http_tsdb_config::compression::zstd:
+      return "zstd";
+    default:
+      return nullptr;
+  }
+}
+
+/**
+ * @brief parse the compression parameter of the configuration
+ *
+ * @param name none, gzip or zstd (case insensitive)
+ * @return http_tsdb_config::compression
+ * @throw msg_fmt if name is unknown
+ */
+http_tsdb_config::compression body_encoder::parse(const std::string& name) {
+  if (name.empty() || absl::EqualsIgnoreCase(name, "none") ||
+      absl::EqualsIgnoreCase(name, "no"))
+    return http_tsdb_config::compression::none;
+  if (absl::EqualsIgnoreCase(name, "gzip"))
+    return http_tsdb_config::compression::gzip;
+  if (absl::EqualsIgnoreCase(name, "zstd"))
+    return http_tsdb_config::compression::zstd;
+  throw msg_fmt("unknown compression '{}', allowed values are none, gzip and "
+                "zstd",
+                name);
+}
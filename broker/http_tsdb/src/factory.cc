@@ -19,6 +19,7 @@
 #include "com/centreon/broker/http_tsdb/factory.hh"
 
 #include "com/centreon/broker/config/parser.hh"
+#include "com/centreon/broker/http_tsdb/body_encoder.hh"
 #include "com/centreon/broker/http_tsdb/column.hh"
 #include "com/centreon/exceptions/msg_fmt.hh"
 
@@ -130,6 +131,12 @@ static const absl::flat_hash_map<std::string, asio::ssl::context_base::method>
  *      - tls
  *      .
  *  - "certificate_path" -> http_config._certificate_path
+ *  - "compression" -> http_tsdb_config._compression
+ *    Content-Encoding of request bodies: none (default), gzip or zstd
+ *  - "compression_level" -> http_tsdb_config._compression_level
+ *  - "target_latency" -> http_tsdb_config._target_latency
+ *    in milliseconds, 0 (default) to always send
+ *    queries_per_transaction queries per request
  *  .
  * @throw if db_user or db_password or db_host aren't found in cfg
  * @param cfg
@@ -244,15 +251,29 @@ void factory::create_conf(const config::endpoint& cfg,
     certificate_path = it->second;
   }
 
+  http_tsdb_config::compression compression =
+      http_tsdb_config::compression::none;
+  it = cfg.params.find("compression");
+  if (it != cfg.params.end()) {
+    compression = body_encoder::parse(it->second);
+  }
+
+  int compression_level = -1;
+  extract_int(cfg, "compression_level", compression_level);
+
+  unsigned target_latency_ms = 0;
+  extract_int(cfg, "target_latency", target_latency_ms);
+
   http_client::http_config http_cfg(
       res_it->endpoint(), addr, encryption, connect_timeout, send_timeout,
       receive_timeout, second_tcp_keep_alive_interval, std::chrono::seconds(1),
       0, default_http_keepalive_duration, max_connections, ssl_method,
       certificate_path);
 
-  conf =
-      http_tsdb_config(http_cfg, target, user, passwd, queries_per_transaction,
-                       status_column_list, metric_column_list);
+  conf = http_tsdb_config(http_cfg, target, user, passwd,
+                          queries_per_transaction, status_column_list,
+                          metric_column_list, compression, compression_level,
+                          std::chrono::milliseconds(target_latency_ms));
 }
 
 std::vector<column> factory::get_columns(const json& cfg) {
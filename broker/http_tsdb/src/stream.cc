@@ -39,9 +39,85 @@ using namespace com::centreon::broker::http_tsdb;
  * @param data_to_append
  */
 void request::append(const request::pointer& data_to_append) {
+  uncompress();
+  data_to_append->uncompress();
   body() += data_to_append->body();
   _nb_metric += data_to_append->_nb_metric;
   _nb_status += data_to_append->_nb_status;
+  _serialize_time += data_to_append->_serialize_time;
+}
+
+/**
+ * @brief compress the body and set the Content-Encoding header
+ * the plain body is kept in order to be able to append other data if the
+ * request fails. Nothing is done if the body is already compressed.
+ *
+ * @param encoder
+ * @throw msg_fmt if compression fails, the body is then left uncompressed
+ */
+void request::compress(body_encoder& encoder) {
+  if (_compressed || !encoder.content_encoding())
+    return;
+  auto start = std::chrono::steady_clock::now();
+  _plain_body.swap(body());
+  try {
+    encoder.encode(_plain_body, body());
+  } catch (const std::exception&) {
+    body().swap(_plain_body);
+    throw;
+  }
+  set(boost::beast::http::field::content_encoding, encoder.content_encoding());
+  _compressed = true;
+  _serialize_time += std::chrono::steady_clock::now() - start;
+}
+
+/**
+ * @brief restore the plain body of a compressed request
+ *
+ */
+void request::uncompress() {
+  if (!_compressed)
+    return;
+  body().swap(_plain_body);
+  _plain_body.clear();
+  erase(boost::beast::http::field::content_encoding);
+  _compressed = false;
+}
+
+/**
+ * @brief take the body buffers of previous requests in order to avoid
+ * reallocations
+ *
+ * @param buffers buffers released by sent requests
+ * @param with_plain_body if true, a buffer is also taken for the plain body
+ * that will be kept during compression
+ */
+void request::reuse_buffers(std::vector<std::string>& buffers,
+                            bool with_plain_body) {
+  if (!buffers.empty()) {
+    body().swap(buffers.back());
+    body().clear();
+    buffers.pop_back();
+  }
+  if (with_plain_body && !buffers.empty()) {
+    _plain_body.swap(buffers.back());
+    _plain_body.clear();
+    buffers.pop_back();
+  }
+}
+
+/**
+ * @brief give the buffers of a sent request to the next ones
+ *
+ * @param buffers
+ * @param max_buffers buffers are freed when there are already max_buffers
+ */
+void request::release_buffers(std::vector<std::string>& buffers,
+                              size_t max_buffers) {
+  if (body().capacity() && buffers.size() < max_buffers)
+    buffers.emplace_back(std::move(body()));
+  if (_plain_body.capacity() && buffers.size() < max_buffers)
+    buffers.emplace_back(std::move(_plain_body));
 }
 
 void request::dump(std::ostream& stream) const {
@@ -128,7 +204,12 @@ stream::stream(const std::string& name,
       _success_request_stat{{0, 0}, {0, 0}},
       _failed_request_stat{{0, 0}, {0, 0}},
       _metric_stat{{0, 0}, {0, 0}},
-      _status_stat{{0, 0}, {0, 0}} {
+      _status_stat{{0, 0}, {0, 0}},
+      _queries_per_request(conf->get_max_queries_per_transaction()),
+      _body_size_to_reserve(0) {
+  if (conf->get_compression() != http_tsdb_config::compression::none)
+    _encoder = std::make_unique<body_encoder>(conf->get_compression(),
+                                              conf->get_compression_level());
   _http_client =
       http_client::client::load(io_context, logger, conf, conn_creator);
 }
@@ -198,9 +279,13 @@ void stream::statistics(nlohmann::json& tree) const {
   tree["metric_sent"] = _metric_stat[0].value;
   tree["status_sent"] = _status_stat[0].value;
 
+  tree["queries_per_request"] = _queries_per_request;
+
   extract_stat("avg_connect_ms", _connect_avg);
   extract_stat("avg_send_ms", _send_avg);
-  extract_stat("avg_connect_ms", _recv_avg);
+  extract_stat("avg_recv_ms", _recv_avg);
+  extract_stat("avg_compression_ratio_percent", _compression_ratio_avg);
+  extract_stat("avg_serialize_us", _serialize_avg);
 }
 
 /**
@@ -232,11 +317,12 @@ int stream::write(std::shared_ptr<io::data> const& data) {
   request::pointer to_send;
   {
     std::lock_guard<std::mutex> l(_protect);
+    auto start = std::chrono::steady_clock::now();
     // Process metric events.
     switch (data->type()) {
       case storage::metric::static_type(): {
         if (!_request) {
-          _request = create_request();
+          _request = new_request();
         }
         SPDLOG_LOGGER_TRACE(_logger, "add metric: {}", *data);
         Metric converted;
@@ -247,7 +333,7 @@ int stream::write(std::shared_ptr<io::data> const& data) {
       }
       case storage::pb_metric::static_type():
         if (!_request) {
-          _request = create_request();
+          _request = new_request();
         }
         SPDLOG_LOGGER_TRACE(_logger, "add metric: {}", *data);
         _request->add_metric(
@@ -255,7 +341,7 @@ int stream::write(std::shared_ptr<io::data> const& data) {
         break;
       case storage::status::static_type(): {
         if (!_request) {
-          _request = create_request();
+          _request = new_request();
         }
         SPDLOG_LOGGER_TRACE(_logger, "add status: {}", *data);
         Status converted;
@@ -281,7 +367,7 @@ int stream::write(std::shared_ptr<io::data> const& data) {
       }
       case storage::pb_status::static_type():
         if (!_request) {
-          _request = create_request();
+          _request = new_request();
         }
         SPDLOG_LOGGER_TRACE(_logger, "add status: {}", *data);
         _request->add_status(
@@ -291,9 +377,10 @@ int stream::write(std::shared_ptr<io::data> const& data) {
         ++_acknowledged;
         break;
     }
+    if (_request)
+      _request->add_serialize_time(std::chrono::steady_clock::now() - start);
     // enought metrics to send?
-    if (_request &&
-        _request->get_nb_data() >= _conf->get_max_queries_per_transaction()) {
+    if (_request && _request->get_nb_data() >= _queries_per_request) {
       to_send.swap(_request);
     }
     acknowledged = _acknowledged;
@@ -313,13 +400,37 @@ int32_t stream::stop() {
   return retval;
 }
 
+/**
+ * @brief create a new request that reuses the buffers of the sent ones
+ * _protect must be locked
+ *
+ * @return request::pointer
+ */
+request::pointer stream::new_request() {
+  request::pointer ret = create_request();
+  ret->reuse_buffers(_buffers, _encoder != nullptr);
+  if (ret->body().capacity() < _body_size_to_reserve)
+    ret->body().reserve(_body_size_to_reserve);
+  return ret;
+}
+
 /**
  * @brief send request to tsdb
- * it only calculates content-length of the request before sending it
+ * it compresses the body if compression is enabled and calculates
+ * content-length of the request before sending it
  *
  * @param request
  */
 void stream::send_request(const request::pointer& request) {
+  if (_encoder) {
+    try {
+      request->compress(*_encoder);
+    } catch (const std::exception& e) {
+      SPDLOG_LOGGER_ERROR(
+          _logger, "{} fail to compress request, it is sent uncompressed: {}",
+          get_name(), e.what());
+    }
+  }
   request->content_length(request->body().length());
   _http_client->send(request, [me = shared_from_this(), request](
                                   const boost::beast::error_code& err,
@@ -367,6 +478,14 @@ void stream::send_handler(const boost::beast::error_code& err,
               request->get_receive_time() - request->get_sent_time())
               .count());
     }
+    if (request->plain_body_size()) {
+      _compression_ratio_avg.add_point(request->body().size() * 100 /
+                                       request->plain_body_size());
+    }
+    _serialize_avg.add_point(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            request->get_serialize_time())
+            .count());
   };
   if (err) {
     SPDLOG_LOGGER_ERROR(_logger, "fail to send {} events to database: {} , {}",
@@ -374,6 +493,9 @@ void stream::send_handler(const boost::beast::error_code& err,
     std::lock_guard<std::mutex> l(_protect);
     add_to_stat(_failed_request_stat, 1);
     actu_stat_avg();
+    adapt_queries_per_request(request, true);
+    // the next events are added to the plain body
+    request->uncompress();
     if (_request) {  // we musn't lost any data
       request->append(_request);
     }
@@ -386,7 +508,47 @@ void stream::send_handler(const boost::beast::error_code& err,
     add_to_stat(_metric_stat, request->get_nb_metric());
     add_to_stat(_status_stat, request->get_nb_status());
     actu_stat_avg();
+    adapt_queries_per_request(request, false);
     _acknowledged += request->get_nb_data();
+    _body_size_to_reserve = request->plain_body_size();
+    request->release_buffers(_buffers, 2 * _conf->get_max_connections() + 2);
+  }
+}
+
+/**
+ * @brief if a target latency is configured, the number of queries per
+ * request follows the server response time: it is halved when the server is
+ * too slow or fails and raised by 25% when the server answers in less than
+ * half the target. It stays between max_queries_per_transaction / 16 and
+ * max_queries_per_transaction.
+ * _protect must be locked
+ *
+ * @param request the request just sent
+ * @param failed true if the request failed
+ */
+void stream::adapt_queries_per_request(const request::pointer& request,
+                                       bool failed) {
+  const duration& target = _conf->get_target_latency();
+  if (target == duration::zero())
+    return;
+  unsigned max_queries = _conf->get_max_queries_per_transaction();
+  unsigned min_queries = std::max(1u, max_queries / 16);
+  bool measured = request->get_receive_time() > _epoch &&
+                  request->get_sent_time() > _epoch;
+  duration latency = measured
+                         ? request->get_receive_time() - request->get_sent_time()
+                         : duration::zero();
+  unsigned previous = _queries_per_request;
+  if (failed || latency > target) {
+    _queries_per_request = std::max(min_queries, _queries_per_request / 2);
+  } else if (measured && latency < target / 2 &&
+             request->get_nb_data() >= _queries_per_request) {
+    _queries_per_request = std::min(
+        max_queries, _queries_per_request + _queries_per_request / 4 + 1);
+  }
+  if (previous != _queries_per_request) {
+    SPDLOG_LOGGER_DEBUG(_logger, "{} queries per request: {} -> {}",
+                        get_name(), previous, _queries_per_request);
   }
 }
 
@@ -92,6 +92,9 @@ TEST(HttpTsdbFactory, DefaultParameter) {
   ASSERT_EQ(conf.get_second_tcp_keep_alive_interval(), 30);
   ASSERT_EQ(conf.get_default_http_keepalive_duration(), std::chrono::hours(1));
   ASSERT_EQ(conf.get_max_connections(), 5);
+  ASSERT_EQ(conf.get_compression(),
+            http_tsdb::http_tsdb_config::compression::none);
+  ASSERT_EQ(conf.get_target_latency(), duration::zero());
 }
 
 TEST(HttpTsdbFactory, ParseParameter) {
@@ -116,6 +119,9 @@ TEST(HttpTsdbFactory, ParseParameter) {
   cfg.params["second_tcp_keep_alive_interval"] = "8";
   cfg.params["default_http_keepalive_duration"] = "9";
   cfg.params["max_connections"] = "10";
+  cfg.params["compression"] = "Zstd";
+  cfg.params["compression_level"] = "3";
+  cfg.params["target_latency"] = "500";
 
   fact.create_conf(cfg, conf);
   ASSERT_EQ(conf.get_user(), "admin");
@@ -129,4 +135,11 @@ TEST(HttpTsdbFactory, ParseParameter) {
   ASSERT_EQ(conf.get_default_http_keepalive_duration(),
             std::chrono::seconds(9));
   ASSERT_EQ(conf.get_max_connections(), 10);
+  ASSERT_EQ(conf.get_compression(),
+            http_tsdb::http_tsdb_config::compression::zstd);
+  ASSERT_EQ(conf.get_compression_level(), 3);
+  ASSERT_EQ(conf.get_target_latency(), std::chrono::milliseconds(500));
+
+  cfg.params["compression"] = "brotli";
+  ASSERT_THROW(fact.create_conf(cfg, conf), msg_fmt);
 }
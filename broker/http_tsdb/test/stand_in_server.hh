@@ -0,0 +1,225 @@
+/**
+ * Copyright 2023 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#ifndef CCB_HTTP_TSDB_TEST_STAND_IN_SERVER_HH
+#define CCB_HTTP_TSDB_TEST_STAND_IN_SERVER_HH
+
+#include <zlib.h>
+#include <zstd.h>
+
+#include <boost/beast.hpp>
+
+#include "com/centreon/broker/http_tsdb/stream.hh"
+#include "com/centreon/broker/log_v2.hh"
+
+/* Helpers shared by the http_tsdb tests and benchmarks: a stream writing
+ * metrics in line protocol and a server standing in for a tsdb. */
+
+extern std::shared_ptr<asio::io_context> g_io_context;
+
+namespace com::centreon::broker::http_tsdb::test {
+
+/**
+ * @brief request that writes metrics in line protocol
+ *
+ */
+class line_request : public http_tsdb::request {
+ public:
+  line_request()
+      : http_tsdb::request(boost::beast::http::verb::post,
+                           "localhost",
+                           "/write") {}
+
+  void add_metric(const storage::pb_metric& metric) override {
+    absl::StrAppend(&body(), "metric,id=", metric.obj().metric_id(),
+                    ",name=", metric.obj().name(),
+                    ",host_id=", metric.obj().host_id(),
+                    ",serv_id=", metric.obj().service_id(),
+                    " val=", metric.obj().value(), " ", metric.obj().time(),
+                    "\n");
+    ++_nb_metric;
+  }
+
+  void add_status(const storage::pb_status& status) override { ++_nb_status; }
+};
+
+class line_stream : public http_tsdb::stream {
+ public:
+  line_stream(const std::shared_ptr<http_tsdb::http_tsdb_config>& conf,
+              http_client::client::connection_creator conn_creator =
+                  http_client::http_connection::load)
+      : http_tsdb::stream("line_stream",
+                          g_io_context,
+                          log_v2::tcp(),
+                          conf,
+                          conn_creator) {
+    _body_size_to_reserve = conf->get_max_queries_per_transaction() * 128;
+  }
+  http_tsdb::request::pointer create_request() const override {
+    return std::make_shared<line_request>();
+  }
+};
+
+inline std::string gunzip(const std::string& in) {
+  z_stream zs{};
+  inflateInit2(&zs, 16 + MAX_WBITS);
+  zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(in.data()));
+  zs.avail_in = in.size();
+  std::string out;
+  char buff[65536];
+  int ret;
+  do {
+    zs.next_out = reinterpret_cast<Bytef*>(buff);
+    zs.avail_out = sizeof(buff);
+    ret = inflate(&zs, Z_NO_FLUSH);
+    out.append(buff, sizeof(buff) - zs.avail_out);
+  } while (ret == Z_OK);
+  inflateEnd(&zs);
+  return out;
+}
+
+inline std::string unzstd(const std::string& in) {
+  std::string out(ZSTD_getFrameContentSize(in.data(), in.size()), 0);
+  out.resize(ZSTD_decompress(out.data(), out.size(), in.data(), in.size()));
+  return out;
+}
+
+inline std::shared_ptr<storage::pb_metric> create_metric(unsigned index) {
+  auto event = std::make_shared<storage::pb_metric>();
+  event->mut_obj().set_metric_id(index % 5000);
+  event->mut_obj().set_name(fmt::format("metric_{}", index % 50));
+  event->mut_obj().set_host_id(index % 100);
+  event->mut_obj().set_service_id(index % 5000);
+  event->mut_obj().set_value(index % 1000 * 0.25);
+  event->mut_obj().set_time(1700000000 + index / 5000 * 60);
+  return event;
+}
+
+/**
+ * @brief http server standing in for a tsdb
+ * it decodes request bodies, counts received lines and answers after a delay
+ * that simulates a link limited to bytes_per_ms and a server that
+ * handles lines_per_ms
+ */
+class stand_in_server {
+  asio::io_context _io_context;
+  asio::ip::tcp::acceptor _acceptor;
+  std::thread _thread;
+  const unsigned _bytes_per_ms;
+  const unsigned _lines_per_ms;
+
+  class session : public std::enable_shared_from_this<session> {
+    stand_in_server& _server;
+    boost::beast::tcp_stream _stream;
+    boost::beast::flat_buffer _buffer;
+    boost::beast::http::request<boost::beast::http::string_body> _request;
+    asio::steady_timer _timer;
+
+   public:
+    session(stand_in_server& server, asio::ip::tcp::socket&& socket)
+        : _server(server),
+          _stream(std::move(socket)),
+          _timer(server._io_context) {}
+
+    void read() {
+      _request = {};
+      boost::beast::http::async_read(
+          _stream, _buffer, _request,
+          [me = shared_from_this()](const boost::beast::error_code& err,
+                                    std::size_t) {
+            if (!err)
+              me->on_read();
+          });
+    }
+
+    void on_read() {
+      size_t bytes = _request.body().size();
+      std::string plain;
+      auto encoding =
+          _request.find(boost::beast::http::field::content_encoding);
+      if (encoding == _request.end())
+        plain = std::move(_request.body());
+      else if (encoding->value() == "gzip")
+        plain = gunzip(_request.body());
+      else
+        plain = unzstd(_request.body());
+      unsigned lines = std::count(plain.begin(), plain.end(), '\n');
+      _server.received_bytes += bytes;
+      _server.received_lines += lines;
+
+      _timer.expires_after(std::chrono::milliseconds(
+          bytes / _server._bytes_per_ms +
+          lines / _server._lines_per_ms));
+      _timer.async_wait([me = shared_from_this(),
+                         version = _request.version()](
+                            const boost::beast::error_code&) {
+        auto resp = std::make_shared<
+            boost::beast::http::response<boost::beast::http::string_body>>(
+            boost::beast::http::status::no_content, version);
+        resp->keep_alive(true);
+        boost::beast::http::async_write(
+            me->_stream, *resp,
+            [me, resp](const boost::beast::error_code& err, std::size_t) {
+              if (!err)
+                me->read();
+            });
+      });
+    }
+  };
+
+  void accept() {
+    _acceptor.async_accept(
+        [this](const boost::beast::error_code& err,
+               asio::ip::tcp::socket socket) {
+          if (err)
+            return;
+          std::make_shared<session>(*this, std::move(socket))->read();
+          accept();
+        });
+  }
+
+ public:
+  std::atomic_size_t received_bytes;
+  std::atomic_size_t received_lines;
+
+  stand_in_server(unsigned bytes_per_ms, unsigned lines_per_ms)
+      : _acceptor(_io_context,
+                  asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(),
+                                          0)),
+        _bytes_per_ms(bytes_per_ms),
+        _lines_per_ms(lines_per_ms),
+        received_bytes(0),
+        received_lines(0) {
+    accept();
+    _thread = std::thread([this] { _io_context.run(); });
+  }
+
+  ~stand_in_server() {
+    _io_context.stop();
+    _thread.join();
+  }
+
+  asio::ip::tcp::endpoint endpoint() const {
+    return _acceptor.local_endpoint();
+  }
+};
+
+}  // namespace com::centreon::broker::http_tsdb::test
+
+#endif  // !CCB_HTTP_TSDB_TEST_STAND_IN_SERVER_HH
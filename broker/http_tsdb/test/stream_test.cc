@@ -34,9 +34,11 @@ using duration = system_clock::duration;
 #include "com/centreon/broker/log_v2.hh"
 #include "com/centreon/broker/pool.hh"
 #include "com/centreon/exceptions/msg_fmt.hh"
+#include "stand_in_server.hh"
 
 using namespace com::centreon::exceptions;
 using namespace com::centreon::broker;
+using namespace com::centreon::broker::http_tsdb::test;
 using namespace nlohmann;
 
 extern std::shared_ptr<asio::io_context> g_io_context;
@@ -198,3 +200,201 @@ TEST_F(http_tsdb_stream_test, all_event_sent) {
       []() { return connection_send_bagot::success == 1000; });
   ASSERT_EQ(connection_send_bagot::success, 1000);
 }
+
+// Given a request filled with metrics
+// When it is compressed with gzip or zstd
+// Then the body decoded by the server is the plain body
+// And appending data to it after a failure works on the plain body
+TEST_F(http_tsdb_stream_test, compressed_body) {
+  for (auto compression : {http_tsdb::http_tsdb_config::compression::gzip,
+                           http_tsdb::http_tsdb_config::compression::zstd}) {
+    http_tsdb::body_encoder encoder(compression);
+    auto req = std::make_shared<line_request>();
+    for (unsigned i = 0; i < 1000; ++i)
+      req->add_metric(*create_metric(i));
+    std::string plain = req->body();
+
+    req->compress(encoder);
+    ASSERT_LT(req->body().size(), plain.size() / 4);
+    ASSERT_EQ(req->plain_body_size(), plain.size());
+    ASSERT_EQ(req->at(boost::beast::http::field::content_encoding),
+              encoder.content_encoding());
+    if (compression == http_tsdb::http_tsdb_config::compression::gzip)
+      ASSERT_EQ(gunzip(req->body()), plain);
+    else
+      ASSERT_EQ(unzstd(req->body()), plain);
+
+    auto pending = std::make_shared<line_request>();
+    pending->add_metric(*create_metric(1000));
+    req->append(pending);
+    ASSERT_EQ(req->body(), plain + pending->body());
+    ASSERT_EQ(req->count(boost::beast::http::field::content_encoding), 0u);
+    ASSERT_EQ(req->get_nb_metric(), 1001u);
+  }
+}
+
+/**
+ * @brief connection that fails the first request and records the decoded
+ * body of the following ones
+ *
+ */
+class connection_fail_first : public http_client::connection_base {
+ public:
+  static std::mutex protect;
+  static std::condition_variable cond;
+  static unsigned failed;
+  static std::vector<std::string> received;
+
+  connection_fail_first(const std::shared_ptr<asio::io_context>& io_context,
+                        const std::shared_ptr<spdlog::logger>& logger,
+                        const http_client::http_config::pointer& conf)
+      : connection_base(io_context, logger, conf) {}
+
+  void shutdown() override { _state = e_not_connected; }
+
+  void connect(http_client::connect_callback_type&& callback) override {
+    _state = e_idle;
+    _io_context->post([cb = std::move(callback)]() { cb({}, {}); });
+  }
+
+  void send(http_client::request_ptr request,
+            http_client::send_callback_type&& callback) override {
+    std::lock_guard<std::mutex> l(protect);
+    if (!failed) {
+      _io_context->post([cb = std::move(callback)]() {
+        cb(std::make_error_code(std::errc::connection_reset), "reset", {});
+        std::lock_guard<std::mutex> l(protect);
+        ++failed;
+        cond.notify_all();
+      });
+    } else {
+      auto encoding =
+          request->find(boost::beast::http::field::content_encoding);
+      received.push_back(encoding == request->end() ? request->body()
+                                                    : unzstd(request->body()));
+      _io_context->post([cb = std::move(callback)]() {
+        auto resp = std::make_shared<http_client::response_type>();
+        resp->keep_alive(false);
+        cb({}, "", resp);
+        cond.notify_all();
+      });
+    }
+  }
+};
+
+std::mutex connection_fail_first::protect;
+std::condition_variable connection_fail_first::cond;
+unsigned connection_fail_first::failed = 0;
+std::vector<std::string> connection_fail_first::received;
+
+// Given a stream compressing its requests with zstd
+// When a request fails
+// And a metric is written before the request is sent again
+// Then the body sent again decodes to all the metrics
+TEST_F(http_tsdb_stream_test, compressed_body_resent_after_failure) {
+  http_client::http_config conf(
+      asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 80),
+      "localhost", false, std::chrono::seconds(10), std::chrono::seconds(10),
+      std::chrono::seconds(10), 30, std::chrono::seconds(1), 0,
+      std::chrono::seconds(1), 1);
+  auto str = std::make_shared<line_stream>(
+      std::make_shared<http_tsdb::http_tsdb_config>(
+          conf, 10, http_tsdb::http_tsdb_config::compression::zstd),
+      [](const std::shared_ptr<asio::io_context>& io_context,
+         const std::shared_ptr<spdlog::logger>& logger,
+         const http_client::http_config::pointer& conf) {
+        return std::make_shared<connection_fail_first>(io_context, logger,
+                                                       conf);
+      });
+  connection_fail_first::failed = 0;
+  connection_fail_first::received.clear();
+
+  line_request expected;
+  for (unsigned i = 0; i < 11; ++i)
+    expected.add_metric(*create_metric(i));
+
+  for (unsigned i = 0; i < 10; ++i)
+    str->write(create_metric(i));
+  {
+    std::unique_lock<std::mutex> l(connection_fail_first::protect);
+    ASSERT_TRUE(connection_fail_first::cond.wait_for(
+        l, std::chrono::seconds(10),
+        [] { return connection_fail_first::failed == 1; }));
+  }
+
+  str->write(create_metric(10));
+  std::unique_lock<std::mutex> l(connection_fail_first::protect);
+  ASSERT_TRUE(connection_fail_first::cond.wait_for(
+      l, std::chrono::seconds(10),
+      [] { return !connection_fail_first::received.empty(); }));
+  ASSERT_EQ(connection_fail_first::received.size(), 1u);
+  ASSERT_EQ(connection_fail_first::received[0], expected.body());
+}
+
+/**
+ * @brief write nb_events metrics to a stream connected to server and wait
+ * for their acknowledgement
+ *
+ */
+static void send_to_server(stand_in_server& server,
+                           unsigned nb_events,
+                           http_tsdb::http_tsdb_config::compression compression,
+                           duration target_latency,
+                           nlohmann::json& stats) {
+  http_client::http_config conf(
+      server.endpoint(), "localhost", false, std::chrono::seconds(10),
+      std::chrono::seconds(10), std::chrono::seconds(10), 30,
+      std::chrono::seconds(1), 100, std::chrono::seconds(1), 2);
+  auto str = std::make_shared<line_stream>(
+      std::make_shared<http_tsdb::http_tsdb_config>(conf, 10000, compression,
+                                                    -1, target_latency));
+
+  time_point start = system_clock::now();
+  unsigned acknowledged = 0;
+  for (unsigned i = 0; i < nb_events; ++i)
+    acknowledged += str->write(create_metric(i));
+  while (acknowledged < nb_events &&
+         system_clock::now() < start + std::chrono::seconds(60)) {
+    acknowledged += str->flush();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  str->statistics(stats);
+  str->stop();
+  EXPECT_EQ(acknowledged, nb_events);
+}
+
+// Given a server
+// When metrics are sent uncompressed, with gzip and with zstd
+// Then the server receives all of them
+// And compressed bodies are at least four times smaller
+TEST_F(http_tsdb_stream_test, compressed_requests) {
+  constexpr unsigned nb_events = 20000;
+  size_t plain_bytes = 0;
+  for (auto compression : {http_tsdb::http_tsdb_config::compression::none,
+                           http_tsdb::http_tsdb_config::compression::gzip,
+                           http_tsdb::http_tsdb_config::compression::zstd}) {
+    stand_in_server server(1000000, 1000000);
+    nlohmann::json stats;
+    send_to_server(server, nb_events, compression, duration::zero(), stats);
+    ASSERT_EQ(server.received_lines, nb_events);
+    if (compression == http_tsdb::http_tsdb_config::compression::none)
+      plain_bytes = server.received_bytes;
+    else {
+      ASSERT_LT(server.received_bytes * 4, plain_bytes);
+      ASSERT_LT(stats["avg_compression_ratio_percent"].get<unsigned>(), 25u);
+    }
+  }
+}
+
+// Given a server handling 100 lines per millisecond
+// When metrics are sent with a target latency of 20ms
+// Then requests are made smaller than queries_per_transaction
+TEST_F(http_tsdb_stream_test, adaptive_queries_per_request) {
+  stand_in_server server(1000000, 100);
+  nlohmann::json stats;
+  send_to_server(server, 50000, http_tsdb::http_tsdb_config::compression::none,
+                 std::chrono::milliseconds(20), stats);
+  ASSERT_EQ(server.received_lines, 50000u);
+  ASSERT_LT(stats["queries_per_request"].get<unsigned>(), 10000u);
+  ASSERT_GE(stats["queries_per_request"].get<unsigned>(), 10000u / 16);
+}
@@ -28,6 +28,11 @@ extern "C" {
 
 namespace com::centreon::broker {
 
+// Forward declaration.
+namespace io {
+class data;
+}
+
 namespace lua {
 /**
  *  @class broker_utils broker_utils.hh
@@ -39,6 +44,7 @@ namespace lua {
 class broker_utils {
  public:
   static void broker_utils_reg(lua_State* L);
+  static void set_current_event(lua_State* L, const io::data* d);
 };
 }  // namespace lua
 
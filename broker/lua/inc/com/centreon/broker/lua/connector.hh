@@ -39,13 +39,15 @@ class connector : public io::endpoint {
   connector& operator=(connector const&) = delete;
   void connect_to(std::string const& lua_script,
                   std::map<std::string, misc::variant> const& cfg_params,
-                  std::shared_ptr<persistent_cache> const& cache);
+                  std::shared_ptr<persistent_cache> const& cache,
+                  uint32_t states = 1);
   std::shared_ptr<io::stream> open() override;
 
  private:
   std::string _lua_script;
   std::map<std::string, misc::variant> _conf_params;
   std::shared_ptr<persistent_cache> _cache;
+  uint32_t _states;
 };
 }  // namespace lua
 
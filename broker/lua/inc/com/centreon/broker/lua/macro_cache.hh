@@ -69,8 +69,10 @@ class macro_cache {
 
  public:
   macro_cache(std::shared_ptr<persistent_cache> const& cache);
+  macro_cache(const macro_cache& other);
   ~macro_cache();
 
+  static bool is_cached(uint32_t type);
   void write(std::shared_ptr<io::data> const& data);
 
   const storage::pb_index_mapping& get_index_mapping(uint64_t index_id) const;
@@ -109,7 +111,6 @@ class macro_cache {
       uint64_t id) const;
 
  private:
-  macro_cache(macro_cache const& f);
   macro_cache& operator=(macro_cache const& f);
 
   void _process_instance(std::shared_ptr<io::data> const& data);
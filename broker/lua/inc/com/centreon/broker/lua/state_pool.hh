@@ -0,0 +1,118 @@
+/**
+ * Copyright 2023 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#ifndef CCB_LUA_STATE_POOL_HH
+#define CCB_LUA_STATE_POOL_HH
+
+#include <nlohmann/json.hpp>
+
+#include "com/centreon/broker/lua/luabinding.hh"
+#include "com/centreon/broker/mapping/entry.hh"
+
+namespace google::protobuf {
+class FieldDescriptor;
+}
+
+namespace com::centreon::broker {
+
+namespace lua {
+/**
+ *  @class state_pool state_pool.hh "com/centreon/broker/lua/state_pool.hh"
+ *  @brief Pool of Lua states running the same script in parallel.
+ *
+ *  Each state has its own thread, its own macro_cache and runs its own
+ *  instance of the script. Events are given to the state in charge of their
+ *  host, the host_id modulo the number of states, so events of a host are
+ *  always handled in order by the same script instance. Events without host
+ *  are handled by the first state. Events stored in the macro cache are
+ *  also given to the other states, only to keep their cache up to date.
+ *
+ *  Events are numbered in the order they are written, acknowledge() returns
+ *  how many of them are acknowledged by their state, in that order. Only the
+ *  stream thread is allowed to call write(), flush(), acknowledge() and
+ *  stop().
+ */
+class state_pool {
+ public:
+  /* If a state has more events than that waiting, write() waits. */
+  static constexpr size_t max_pending_events = 10000;
+
+ private:
+  static constexpr uint64_t no_event = std::numeric_limits<uint64_t>::max();
+
+  struct pending_event {
+    std::shared_ptr<io::data> data;
+    /* False if the event is only given to the state for its cache. */
+    bool owned;
+  };
+
+  struct state {
+    std::unique_ptr<macro_cache> cache;
+    std::unique_ptr<luabinding> binding;
+    std::mutex m;
+    std::condition_variable cv;
+    std::condition_variable done_cv;
+    std::deque<pending_event> queue;
+    /* Numbers of the events owned by the state and not acknowledged yet. */
+    std::deque<uint64_t> unacknowledged;
+    bool flush = false;
+    bool exit = false;
+    int32_t stop_acknowledged = 0;
+    uint64_t events = 0;
+    uint64_t acknowledged = 0;
+    std::chrono::steady_clock::duration busy{0};
+    std::thread thread;
+  };
+
+  /* Where the host_id is found in events of a given type. */
+  struct host_id_field {
+    const mapping::entry* entry = nullptr;
+    const google::protobuf::FieldDescriptor* field = nullptr;
+  };
+
+  std::vector<std::unique_ptr<state>> _states;
+  absl::flat_hash_map<uint32_t, host_id_field> _host_id_fields;
+  uint64_t _next_event;
+  uint64_t _acknowledged;
+  bool _stopped;
+
+  void _run(state& s);
+  void _acknowledge(state& s, int32_t count);
+  uint64_t _host_id(const io::data& d);
+
+ public:
+  state_pool(uint32_t size,
+             const std::string& lua_script,
+             const std::map<std::string, misc::variant>& conf_params,
+             const macro_cache& cache);
+  ~state_pool() noexcept;
+  state_pool(const state_pool&) = delete;
+  state_pool& operator=(const state_pool&) = delete;
+
+  void write(const std::shared_ptr<io::data>& data);
+  int32_t acknowledge();
+  int32_t flush();
+  int32_t stop();
+  void statistics(nlohmann::json& tree) const;
+};
+}  // namespace lua
+
+}
+
+#endif  // !CCB_LUA_STATE_POOL_HH
@@ -23,6 +23,7 @@
 
 #include "com/centreon/broker/lua/luabinding.hh"
 #include "com/centreon/broker/lua/macro_cache.hh"
+#include "com/centreon/broker/lua/state_pool.hh"
 #include "com/centreon/broker/misc/variant.hh"
 
 namespace com::centreon::broker {
@@ -55,12 +56,16 @@ class stream : public io::stream {
   macro_cache _cache;
 
   /* The Lua engine */
-  luabinding _luabinding;
+  std::unique_ptr<luabinding> _luabinding;
+
+  /* The Lua states used instead of _luabinding when there are several. */
+  std::unique_ptr<state_pool> _pool;
 
  public:
   stream(std::string const& lua_script,
          std::map<std::string, misc::variant> const& conf_params,
-         std::shared_ptr<persistent_cache> const& cache);
+         std::shared_ptr<persistent_cache> const& cache,
+         uint32_t states = 1);
   ~stream() noexcept;
   stream& operator=(const stream&) = delete;
   stream(const stream&) = delete;
@@ -68,6 +73,7 @@ class stream : public io::stream {
   int write(std::shared_ptr<io::data> const& d) override;
   int32_t flush() override;
   int32_t stop() override;
+  void statistics(nlohmann::json& tree) const override;
 };
 }  // namespace lua
 
@@ -37,6 +37,8 @@
 #include "com/centreon/broker/log_v2.hh"
 #include "com/centreon/broker/mapping/entry.hh"
 #include "com/centreon/broker/misc/misc.hh"
+#include "com/centreon/broker/neb/internal.hh"
+#include "com/centreon/broker/neb/service.hh"
 #include "com/centreon/exceptions/msg_fmt.hh"
 
 using namespace com::centreon::broker;
@@ -614,6 +616,55 @@ static auto l_stacktrace = [](lua_State* L) -> void {
   }
 };
 
+/* Key in the Lua registry of the event given to the write() function. */
+static const char* const current_event_key = "broker_current_event";
+
+/**
+ *  Parse a perfdata string. When it is the one of the service event given to
+ *  the write() function, its perfdata already parsed by the other streams are
+ *  used.
+ *
+ * @param L The Lua interpreter
+ * @param perf_data The perfdata string
+ *
+ * @return The parsed perfdata.
+ */
+static std::shared_ptr<const misc::shared_perfdata::array> parse_perfdata(
+    lua_State* L,
+    std::string_view perf_data) {
+  lua_getfield(L, LUA_REGISTRYINDEX, current_event_key);
+  const io::data* d = static_cast<const io::data*>(lua_touserdata(L, -1));
+  lua_pop(L, 1);
+  if (d) {
+    const neb::service_status* ss = nullptr;
+    switch (d->type()) {
+      case neb::service_status::static_type():
+        ss = static_cast<const neb::service_status*>(d);
+        break;
+      case neb::service::static_type():
+        ss = static_cast<const neb::service*>(d);
+        break;
+      case neb::pb_service_status::static_type(): {
+        auto s = static_cast<const neb::pb_service_status*>(d);
+        if (s->obj().perfdata() == perf_data)
+          return s->parsed_perfdata().get(
+              s->obj().host_id(), s->obj().service_id(), s->obj().perfdata());
+      } break;
+      case neb::pb_service::static_type(): {
+        auto s = static_cast<const neb::pb_service*>(d);
+        if (s->obj().perfdata() == perf_data)
+          return s->parsed_perfdata().get(
+              s->obj().host_id(), s->obj().service_id(), s->obj().perfdata());
+      } break;
+    }
+    if (ss && ss->perf_data == perf_data)
+      return ss->parsed_perf_data.get(ss->host_id, ss->service_id,
+                                      ss->perf_data);
+  }
+  return std::make_shared<const misc::shared_perfdata::array>(
+      misc::parse_perfdata(0, 0, std::string(perf_data).c_str()));
+}
+
 /**
  *  The Lua parse_perfdata function
  *
@@ -622,11 +673,12 @@ static auto l_stacktrace = [](lua_State* L) -> void {
  * @return 1
  */
 static int l_broker_parse_perfdata(lua_State* L) {
-  char const* perf_data(lua_tostring(L, 1));
+  size_t len;
+  char const* perf_data(lua_tolstring(L, 1, &len));
   int full(lua_toboolean(L, 2));
-  std::list<misc::perfdata> pds{misc::parse_perfdata(0, 0, perf_data)};
-  lua_createtable(L, 0, pds.size());
-  for (auto const& pd : pds) {
+  auto pds = parse_perfdata(L, std::string_view(perf_data, len));
+  lua_createtable(L, 0, pds->size());
+  for (auto const& pd : *pds) {
     lua_pushlstring(L, pd.name().c_str(), pd.name().size());
     if (full) {
       std::string_view name{pd.name()};
@@ -841,3 +893,15 @@ void broker_utils::broker_utils_reg(lua_State* L) {
   lua_setglobal(L, "broker");
 #endif
 }
+
+/**
+ *  Set the event given to the write() function, so that parse_perfdata() can
+ *  reuse its already parsed perfdata.
+ *
+ *  @param L The Lua interpreter
+ *  @param d The event or nullptr when the write() function returns.
+ */
+void broker_utils::set_current_event(lua_State* L, const io::data* d) {
+  lua_pushlightuserdata(L, const_cast<io::data*>(d));
+  lua_setfield(L, LUA_REGISTRYINDEX, current_event_key);
+}
@@ -25,7 +25,7 @@ using namespace com::centreon::broker::lua;
 /**
  *  Default constructor.
  */
-connector::connector() : io::endpoint(false, {}) {}
+connector::connector() : io::endpoint(false, {}), _states(1) {}
 
 /**
  *  Copy constructor.
@@ -36,7 +36,8 @@ connector::connector(connector const& other)
     : io::endpoint(other),
       _lua_script(other._lua_script),
       _conf_params(other._conf_params),
-      _cache(other._cache) {}
+      _cache(other._cache),
+      _states(other._states) {}
 
 /**
  *  Destructor.
@@ -50,14 +51,18 @@ connector::~connector() {}
  *  @param[in] cfg_params              A hash table containing the user
  *                                     parameters
  *  @param[in] cache                   The cache
+ *  @param[in] states                  Number of Lua states running the
+ *                                     script
  */
 void connector::connect_to(
     const std::string& lua_script,
     const std::map<std::string, misc::variant>& cfg_params,
-    const std::shared_ptr<persistent_cache>& cache) {
+    const std::shared_ptr<persistent_cache>& cache,
+    uint32_t states) {
   _conf_params = cfg_params;
   _lua_script = lua_script;
   _cache = cache;
+  _states = states;
 }
 
 /**
@@ -66,5 +71,5 @@ void connector::connect_to(
  *  @return a lua connection object.
  */
 std::shared_ptr<io::stream> connector::open() {
-  return std::make_unique<stream>(_lua_script, _conf_params, _cache);
+  return std::make_unique<stream>(_lua_script, _conf_params, _cache, _states);
 }
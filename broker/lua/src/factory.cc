@@ -145,9 +145,20 @@ io::endpoint* factory::new_endpoint(
       }
     }
   }
+  // Number of Lua states running the script, events are dispatched among
+  // them by host.
+  uint32_t states = 1;
+  {
+    std::map<std::string, std::string>::const_iterator it{
+        cfg.params.find("lua_states")};
+    if (it != cfg.params.end() &&
+        (!absl::SimpleAtoi(it->second, &states) || states == 0))
+      throw msg_fmt("lua: bad lua_states defined for endpoint '{}'", cfg.name);
+  }
+
   // Connector.
   auto c{std::make_unique<lua::connector>()};
-  c->connect_to(filename, conf_map, cache);
+  c->connect_to(filename, conf_map, cache, states);
   is_acceptor = false;
   return c.release();
 }
@@ -348,6 +348,7 @@ int luabinding::write(std::shared_ptr<io::data> const& data) noexcept {
     return 0;
 
   // Let's get the function to call
+  broker_utils::set_current_event(_L, data.get());
   lua_getglobal(_L, "write");
 
   // We add data as argument
@@ -363,7 +364,9 @@ int luabinding::write(std::shared_ptr<io::data> const& data) noexcept {
       break;
   }
 
-  if (lua_pcall(_L, 1, 1, 0) != 0) {
+  int status = lua_pcall(_L, 1, 1, 0);
+  broker_utils::set_current_event(_L, nullptr);
+  if (status != 0) {
     const char* ret = lua_tostring(_L, -1);
     if (ret)
       SPDLOG_LOGGER_ERROR(log_v2::lua(),
@@ -45,6 +45,27 @@ macro_cache::macro_cache(const std::shared_ptr<persistent_cache>& cache)
   }
 }
 
+/**
+ *  Copy constructor. The copy shares the cached events with other but it is
+ *  not bound to the persistent cache, so it is never saved to disk.
+ *
+ *  @param[in] other  The cache to copy.
+ */
+macro_cache::macro_cache(const macro_cache& other)
+    : _instances(other._instances),
+      _hosts(other._hosts),
+      _host_groups(other._host_groups),
+      _host_group_members(other._host_group_members),
+      _custom_vars(other._custom_vars),
+      _services(other._services),
+      _service_groups(other._service_groups),
+      _service_group_members(other._service_group_members),
+      _index_mappings(other._index_mappings),
+      _metric_mappings(other._metric_mappings),
+      _dimension_ba_events(other._dimension_ba_events),
+      _dimension_ba_bv_relation_events(other._dimension_ba_bv_relation_events),
+      _dimension_bv_events(other._dimension_bv_events) {}
+
 /**
  *  Destructor.
  */
@@ -502,6 +523,51 @@ macro_cache::get_dimension_bv_event(uint64_t bv_id) const {
   return found->second;
 }
 
+/**
+ *  Check if events of a type are stored in the cache.
+ *
+ *  @param[in] type  The event type.
+ *
+ *  @return true if write() has something to do with such events.
+ */
+bool macro_cache::is_cached(uint32_t type) {
+  switch (type) {
+    case neb::instance::static_type():
+    case neb::pb_instance::static_type():
+    case neb::host::static_type():
+    case neb::pb_host::static_type():
+    case neb::pb_adaptive_host::static_type():
+    case neb::host_group::static_type():
+    case neb::pb_host_group::static_type():
+    case neb::host_group_member::static_type():
+    case neb::pb_host_group_member::static_type():
+    case neb::service::static_type():
+    case neb::pb_service::static_type():
+    case neb::pb_adaptive_service::static_type():
+    case neb::service_group::static_type():
+    case neb::pb_service_group::static_type():
+    case neb::service_group_member::static_type():
+    case neb::pb_service_group_member::static_type():
+    case neb::custom_variable::static_type():
+    case neb::pb_custom_variable::static_type():
+    case storage::pb_index_mapping::static_type():
+    case storage::index_mapping::static_type():
+    case storage::pb_metric_mapping::static_type():
+    case storage::metric_mapping::static_type():
+    case bam::dimension_ba_event::static_type():
+    case bam::pb_dimension_ba_event::static_type():
+    case bam::dimension_ba_bv_relation_event::static_type():
+    case bam::pb_dimension_ba_bv_relation_event::static_type():
+    case bam::dimension_bv_event::static_type():
+    case bam::pb_dimension_bv_event::static_type():
+    case bam::dimension_truncate_table_signal::static_type():
+    case bam::pb_dimension_truncate_table_signal::static_type():
+      return true;
+    default:
+      return false;
+  }
+}
+
 /**
  *  Write an event into the cache.
  *
@@ -666,9 +732,14 @@ void macro_cache::_process_pb_adaptive_host(
                       h->obj().host_id());
   auto& ah = h->obj();
   auto it = _hosts.find(ah.host_id());
+  /* Cached events may be shared with other caches, so they are replaced by
+   * updated copies instead of being modified. */
   if (it != _hosts.end()) {
     if (it->second->type() == make_type(io::neb, neb::de_host)) {
-      auto& h = *std::static_pointer_cast<neb::host>(it->second);
+      auto copy = std::make_shared<neb::host>(
+          *std::static_pointer_cast<neb::host>(it->second));
+      it->second = copy;
+      auto& h = *copy;
       if (ah.has_notify())
         h.notifications_enabled = ah.notify();
       if (ah.has_active_checks())
@@ -700,7 +771,10 @@ void macro_cache::_process_pb_adaptive_host(
       if (ah.has_notification_period())
         h.notification_period = ah.notification_period();
     } else {
-      auto& h = std::static_pointer_cast<neb::pb_host>(it->second)->mut_obj();
+      auto copy = std::make_shared<neb::pb_host>(
+          *std::static_pointer_cast<neb::pb_host>(it->second));
+      it->second = copy;
+      auto& h = copy->mut_obj();
       if (ah.has_notify())
         h.set_notify(ah.notify());
       if (ah.has_active_checks())
@@ -858,9 +932,14 @@ void macro_cache::_process_pb_adaptive_service(
                       s->obj().host_id(), s->obj().service_id());
   auto& as = s->obj();
   auto it = _services.find({as.host_id(), as.service_id()});
+  /* Cached events may be shared with other caches, so they are replaced by
+   * updated copies instead of being modified. */
   if (it != _services.end()) {
     if (it->second->type() == make_type(io::neb, neb::de_service)) {
-      auto& s = *std::static_pointer_cast<neb::service>(it->second);
+      auto copy = std::make_shared<neb::service>(
+          *std::static_pointer_cast<neb::service>(it->second));
+      it->second = copy;
+      auto& s = *copy;
       if (as.has_notify())
         s.notifications_enabled = as.notify();
       if (as.has_active_checks())
@@ -892,8 +971,10 @@ void macro_cache::_process_pb_adaptive_service(
       if (as.has_notification_period())
         s.notification_period = as.notification_period();
     } else {
-      auto& s =
-          std::static_pointer_cast<neb::pb_service>(it->second)->mut_obj();
+      auto copy = std::make_shared<neb::pb_service>(
+          *std::static_pointer_cast<neb::pb_service>(it->second));
+      it->second = copy;
+      auto& s = copy->mut_obj();
       if (as.has_notify())
         s.set_notify(as.notify());
       if (as.has_active_checks())
@@ -0,0 +1,298 @@
+/**
+ * Copyright 2023 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include "com/centreon/broker/lua/state_pool.hh"
+
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/message.h>
+
+#include "com/centreon/broker/io/events.hh"
+#include "com/centreon/broker/io/protobuf.hh"
+#include "com/centreon/broker/log_v2.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::lua;
+
+/**
+ *  Constructor. The script is loaded and initialized in each state before
+ *  the threads are started.
+ *
+ *  @param[in] size        Number of Lua states.
+ *  @param[in] lua_script  The script to load.
+ *  @param[in] conf_params The parameters given to the init() function.
+ *  @param[in] cache       The cache copied into each state.
+ */
+state_pool::state_pool(uint32_t size,
+                       const std::string& lua_script,
+                       const std::map<std::string, misc::variant>& conf_params,
+                       const macro_cache& cache)
+    : _next_event(0), _acknowledged(0), _stopped(false) {
+  if (size == 0)
+    size = 1;
+  _states.reserve(size);
+  for (uint32_t i = 0; i < size; ++i) {
+    auto s = std::make_unique<state>();
+    s->cache = std::make_unique<macro_cache>(cache);
+    s->binding =
+        std::make_unique<luabinding>(lua_script, conf_params, *s->cache);
+    _states.emplace_back(std::move(s));
+  }
+  for (auto& s : _states)
+    s->thread = std::thread(&state_pool::_run, this, std::ref(*s));
+  SPDLOG_LOGGER_INFO(log_v2::lua(), "lua: {} states started to run '{}'",
+                     size, lua_script);
+}
+
+/**
+ *  Destructor. States are stopped if it is not already done.
+ */
+state_pool::~state_pool() noexcept {
+  if (!_stopped)
+    stop();
+}
+
+/**
+ *  Give an event to the state in charge of its host, and to the other states
+ *  if it is stored in their cache. If a state has too many events waiting,
+ *  this call waits for it to handle them.
+ *
+ *  @param[in] data The event.
+ */
+void state_pool::write(const std::shared_ptr<io::data>& data) {
+  size_t owner = _host_id(*data) % _states.size();
+  bool cached = macro_cache::is_cached(data->type());
+  uint64_t number = _next_event++;
+  for (size_t i = 0; i < _states.size(); ++i) {
+    if (i != owner && !cached)
+      continue;
+    state& s = *_states[i];
+    std::unique_lock<std::mutex> lck(s.m);
+    s.done_cv.wait(lck,
+                   [&s] { return s.queue.size() < max_pending_events; });
+    s.queue.push_back({data, i == owner});
+    if (i == owner)
+      s.unacknowledged.push_back(number);
+    s.cv.notify_one();
+  }
+}
+
+/**
+ *  Get the number of events acknowledged since the previous call. An event
+ *  is only counted when all the previous ones are.
+ *
+ *  @return The number of events to acknowledge.
+ */
+int32_t state_pool::acknowledge() {
+  uint64_t oldest = _next_event;
+  for (auto& s : _states) {
+    std::lock_guard<std::mutex> lck(s->m);
+    if (!s->unacknowledged.empty())
+      oldest = std::min(oldest, s->unacknowledged.front());
+  }
+  int32_t retval = oldest - _acknowledged;
+  _acknowledged = oldest;
+  return retval;
+}
+
+/**
+ *  Call the flush() function of each state once their waiting events are
+ *  handled.
+ *
+ *  @return The number of events to acknowledge.
+ */
+int32_t state_pool::flush() {
+  for (auto& s : _states) {
+    std::lock_guard<std::mutex> lck(s->m);
+    s->flush = true;
+    s->cv.notify_one();
+  }
+  for (auto& s : _states) {
+    std::unique_lock<std::mutex> lck(s->m);
+    s->done_cv.wait(lck, [&s] { return !s->flush; });
+  }
+  return acknowledge();
+}
+
+/**
+ *  Stop the states once their waiting events are handled.
+ *
+ *  @return The number of events to acknowledge.
+ */
+int32_t state_pool::stop() {
+  for (auto& s : _states) {
+    std::lock_guard<std::mutex> lck(s->m);
+    s->exit = true;
+    s->cv.notify_one();
+  }
+  for (auto& s : _states)
+    s->thread.join();
+  _stopped = true;
+  return acknowledge();
+}
+
+/**
+ *  Fill the statistics tree with the activity of each state.
+ *
+ *  @param[out] tree Output tree.
+ */
+void state_pool::statistics(nlohmann::json& tree) const {
+  nlohmann::json states = nlohmann::json::array();
+  for (auto& s : _states) {
+    std::lock_guard<std::mutex> lck(s->m);
+    states.push_back(
+        {{"events", s->events},
+         {"acknowledged", s->acknowledged},
+         {"pending_events", s->queue.size()},
+         {"unacknowledged_events", s->unacknowledged.size()},
+         {"busy_ms", std::chrono::duration_cast<std::chrono::milliseconds>(
+                         s->busy)
+                         .count()}});
+  }
+  tree["lua_states"] = std::move(states);
+}
+
+/**
+ *  Thread main loop: handle the waiting events, then call flush() if asked.
+ *  When the state is stopped, the script is stopped once all the events are
+ *  handled.
+ *
+ *  @param[in] s The state of the thread.
+ */
+void state_pool::_run(state& s) {
+  std::unique_lock<std::mutex> lck(s.m);
+  for (;;) {
+    s.cv.wait(lck, [&s] { return s.exit || s.flush || !s.queue.empty(); });
+    if (!s.queue.empty()) {
+      std::deque<pending_event> to_handle;
+      to_handle.swap(s.queue);
+      s.done_cv.notify_all();
+      lck.unlock();
+
+      auto start = std::chrono::steady_clock::now();
+      int32_t count = 0;
+      uint64_t events = 0;
+      for (auto& e : to_handle) {
+        if (e.owned) {
+          count += s.binding->write(e.data);
+          ++events;
+        } else
+          s.cache->write(e.data);
+      }
+      auto busy = std::chrono::steady_clock::now() - start;
+
+      lck.lock();
+      s.busy += busy;
+      s.events += events;
+      _acknowledge(s, count);
+    } else if (s.flush) {
+      lck.unlock();
+      int32_t count = s.binding->flush();
+      lck.lock();
+      _acknowledge(s, count);
+      s.flush = false;
+      s.done_cv.notify_all();
+    } else {
+      lck.unlock();
+      int32_t count = s.binding->stop();
+      lck.lock();
+      _acknowledge(s, count);
+      break;
+    }
+  }
+}
+
+/**
+ *  Mark the oldest events of a state as acknowledged. s.m must be locked.
+ *
+ *  @param[in] s     The state.
+ *  @param[in] count The number of events acknowledged by its script.
+ */
+void state_pool::_acknowledge(state& s, int32_t count) {
+  size_t n = std::min<size_t>(count, s.unacknowledged.size());
+  s.unacknowledged.erase(s.unacknowledged.begin(),
+                         s.unacknowledged.begin() + n);
+  s.acknowledged += n;
+}
+
+/**
+ *  Get the host_id of an event, from its mapping for the BBDO events or
+ *  from its message for the protobuf events. The field to read is looked up
+ *  once per event type.
+ *
+ *  @param[in] d The event.
+ *
+ *  @return The host_id or 0 if the event has none.
+ */
+uint64_t state_pool::_host_id(const io::data& d) {
+  auto found = _host_id_fields.find(d.type());
+  if (found == _host_id_fields.end()) {
+    host_id_field f;
+    const io::event_info* info = io::events::instance().get_event_info(d.type());
+    if (info) {
+      if (info->get_mapping()) {
+        for (const mapping::entry* e = info->get_mapping(); !e->is_null(); ++e) {
+          const char* name = e->get_name_v2();
+          if (name && strcmp(name, "host_id") == 0 &&
+              (e->get_type() == mapping::source::INT ||
+               e->get_type() == mapping::source::UINT ||
+               e->get_type() == mapping::source::ULONG)) {
+            f.entry = e;
+            break;
+          }
+        }
+      } else {
+        const google::protobuf::Message* msg =
+            static_cast<const io::protobuf_base&>(d).msg();
+        f.field = msg->GetDescriptor()->FindFieldByName("host_id");
+        if (f.field && f.field->is_repeated())
+          f.field = nullptr;
+      }
+    }
+    found = _host_id_fields.emplace(d.type(), f).first;
+  }
+
+  const host_id_field& f = found->second;
+  if (f.entry) {
+    switch (f.entry->get_type()) {
+      case mapping::source::INT:
+        return f.entry->get_int(d);
+      case mapping::source::UINT:
+        return f.entry->get_uint(d);
+      default:
+        return f.entry->get_ulong(d);
+    }
+  } else if (f.field) {
+    const google::protobuf::Message* msg =
+        static_cast<const io::protobuf_base&>(d).msg();
+    const google::protobuf::Reflection* r = msg->GetReflection();
+    switch (f.field->cpp_type()) {
+      case google::protobuf::FieldDescriptor::CPPTYPE_UINT64:
+        return r->GetUInt64(*msg, f.field);
+      case google::protobuf::FieldDescriptor::CPPTYPE_UINT32:
+        return r->GetUInt32(*msg, f.field);
+      case google::protobuf::FieldDescriptor::CPPTYPE_INT64:
+        return r->GetInt64(*msg, f.field);
+      case google::protobuf::FieldDescriptor::CPPTYPE_INT32:
+        return r->GetInt32(*msg, f.field);
+      default:
+        break;
+    }
+  }
+  return 0;
+}
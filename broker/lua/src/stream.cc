@@ -31,15 +31,24 @@ using namespace com::centreon::broker::lua;
 /**
  *  Constructor.
  *
- *  @param[in] addr                    Address to connect to
- *  @param[in] port                    port
+ *  @param[in] lua_script   The script to run.
+ *  @param[in] conf_params  The parameters given to its init() function.
+ *  @param[in] cache        The persistent cache.
+ *  @param[in] states       Number of Lua states running the script, events
+ *                          are dispatched by host among them if more than 1.
  */
 stream::stream(const std::string& lua_script,
                const std::map<std::string, misc::variant>& conf_params,
-               const std::shared_ptr<persistent_cache>& cache)
-    : io::stream("lua"),
-      _cache{cache},
-      _luabinding(lua_script, conf_params, _cache) {}
+               const std::shared_ptr<persistent_cache>& cache,
+               uint32_t states)
+    : io::stream("lua"), _cache{cache} {
+  if (states > 1)
+    _pool = std::make_unique<state_pool>(states, lua_script, conf_params,
+                                         _cache);
+  else
+    _luabinding =
+        std::make_unique<luabinding>(lua_script, conf_params, _cache);
+}
 
 stream::~stream() noexcept {
   log_v2::lua()->debug("lua: Stream destruction");
@@ -71,7 +80,11 @@ int stream::write(std::shared_ptr<io::data> const& data) {
   // Give data to cache.
   _cache.write(data);
 
-  return _luabinding.write(data);
+  if (_pool) {
+    _pool->write(data);
+    return _pool->acknowledge();
+  }
+  return _luabinding->write(data);
 }
 
 /**
@@ -83,8 +96,11 @@ int stream::write(std::shared_ptr<io::data> const& data) {
  */
 int32_t stream::flush() {
   int32_t retval = 0;
-  if (_luabinding.has_flush()) {
-    retval = _luabinding.flush();
+  if (_pool) {
+    retval = _pool->flush();
+    log_v2::lua()->debug("stream: flush {} events acknowledged", retval);
+  } else if (_luabinding->has_flush()) {
+    retval = _luabinding->flush();
     log_v2::lua()->debug("stream: flush {} events acknowledged", retval);
   }
   return retval;
@@ -97,5 +113,17 @@ int32_t stream::flush() {
  */
 int32_t stream::stop() {
   log_v2::lua()->debug("lua: stop stream");
-  return _luabinding.stop();
+  if (_pool)
+    return _pool->stop();
+  return _luabinding->stop();
+}
+
+/**
+ *  Get the statistics of the Lua states if there are several.
+ *
+ *  @param[out] tree Output tree.
+ */
+void stream::statistics(nlohmann::json& tree) const {
+  if (_pool)
+    _pool->statistics(tree);
 }
@@ -31,6 +31,7 @@
 #include "com/centreon/broker/config/applier/modules.hh"
 #include "com/centreon/broker/lua/luabinding.hh"
 #include "com/centreon/broker/lua/macro_cache.hh"
+#include "com/centreon/broker/lua/state_pool.hh"
 #include "com/centreon/broker/misc/variant.hh"
 #include "com/centreon/broker/neb/events.hh"
 #include "com/centreon/broker/neb/instance.hh"
@@ -4764,3 +4765,99 @@ TEST_F(LuaTest, JsonDecodeNull) {
   RemoveFile(filename);
   RemoveFile("/tmp/log");
 }
+
+// Given a pool of 4 Lua states
+// When events of 20 hosts are written
+// Then each state handles the events of its hosts in order
+// And all the events are acknowledged once the states are flushed
+TEST_F(LuaTest, StatePoolHostOrder) {
+  config::applier::modules modules;
+  modules.load_file("./lib/10-neb.so");
+  std::map<std::string, misc::variant> conf;
+  std::string filename("/tmp/state_pool.lua");
+  RemoveFile("/tmp/state_pool.log");
+  CreateScript(filename,
+               "broker_api_version = 2\n"
+               "local last = {}\n"
+               "local count = 0\n"
+               "function init(conf)\n"
+               "  broker_log:set_parameters(3, '/tmp/state_pool.log')\n"
+               "end\n\n"
+               "function write(d)\n"
+               "  local prev = last[d.host_id]\n"
+               "  if prev and prev + 1 ~= d.service_id then\n"
+               "    broker_log:error(0, 'bad order for host ' .. d.host_id)\n"
+               "  end\n"
+               "  last[d.host_id] = d.service_id\n"
+               "  count = count + 1\n"
+               "  return count % 10 == 0\n"
+               "end\n\n"
+               "function flush()\n"
+               "  return true\n"
+               "end\n");
+  auto pool{std::make_unique<state_pool>(4, filename, conf, *_cache)};
+  int32_t acknowledged = 0;
+  for (int i = 0; i < 1000; ++i) {
+    auto ss{std::make_shared<neb::pb_service_status>()};
+    ss->mut_obj().set_host_id(i % 20 + 1);
+    ss->mut_obj().set_service_id(i / 20 + 1);
+    pool->write(ss);
+    acknowledged += pool->acknowledge();
+  }
+  acknowledged += pool->flush();
+  ASSERT_EQ(acknowledged, 1000);
+
+  nlohmann::json tree;
+  pool->statistics(tree);
+  ASSERT_EQ(tree["lua_states"].size(), 4u);
+  for (auto& s : tree["lua_states"]) {
+    ASSERT_EQ(s["events"].get<uint64_t>(), 250u);
+    ASSERT_EQ(s["unacknowledged_events"].get<uint64_t>(), 0u);
+  }
+  ASSERT_EQ(pool->stop(), 0);
+
+  std::string result(ReadFile("/tmp/state_pool.log"));
+  ASSERT_EQ(result.find("bad order"), std::string::npos);
+  RemoveFile(filename);
+  RemoveFile("/tmp/state_pool.log");
+}
+
+// Given a pool of 4 Lua states
+// When a host is written and then a status of another host
+// Then the state handling the status knows the first host from its cache
+TEST_F(LuaTest, StatePoolCache) {
+  config::applier::modules modules;
+  modules.load_file("./lib/10-neb.so");
+  std::map<std::string, misc::variant> conf;
+  std::string filename("/tmp/state_pool.lua");
+  RemoveFile("/tmp/state_pool.log");
+  CreateScript(filename,
+               "broker_api_version = 2\n"
+               "function init(conf)\n"
+               "  broker_log:set_parameters(3, '/tmp/state_pool.log')\n"
+               "end\n\n"
+               "function write(d)\n"
+               "  if d.host_id == 2 then\n"
+               "    broker_log:info(0, 'host 1 is ' .. "
+               "tostring(broker_cache:get_hostname(1)))\n"
+               "  end\n"
+               "  return true\n"
+               "end\n");
+  auto pool{std::make_unique<state_pool>(4, filename, conf, *_cache)};
+  auto hst{std::make_shared<neb::pb_host>()};
+  hst->mut_obj().set_host_id(1);
+  hst->mut_obj().set_name("centreon");
+  hst->mut_obj().set_enabled(true);
+  pool->write(hst);
+  auto ss{std::make_shared<neb::pb_service_status>()};
+  ss->mut_obj().set_host_id(2);
+  ss->mut_obj().set_service_id(1);
+  pool->write(ss);
+  ASSERT_EQ(pool->flush(), 2);
+  pool->stop();
+
+  std::string result(ReadFile("/tmp/state_pool.log"));
+  ASSERT_NE(result.find("host 1 is centreon"), std::string::npos);
+  RemoveFile(filename);
+  RemoveFile("/tmp/state_pool.log");
+}
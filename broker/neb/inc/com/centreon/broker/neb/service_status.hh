@@ -22,6 +22,7 @@
 #include "com/centreon/broker/io/event_info.hh"
 #include "com/centreon/broker/io/events.hh"
 #include "com/centreon/broker/mapping/entry.hh"
+#include "com/centreon/broker/misc/shared_perfdata.hh"
 #include "com/centreon/broker/neb/host_service_status.hh"
 #include "com/centreon/broker/neb/internal.hh"
 #include "com/centreon/broker/timestamp.hh"
@@ -53,6 +54,8 @@ class service_status : public host_service_status {
   timestamp last_time_warning;
   std::string service_description;
   uint32_t service_id;
+  /* perf_data parsed on demand */
+  misc::shared_perfdata parsed_perf_data;
 
   static mapping::entry const entries[];
   static io::event_info::event_operations const operations;
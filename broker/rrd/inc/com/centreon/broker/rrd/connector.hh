@@ -45,6 +45,8 @@ class connector : public io::endpoint {
   void set_status_path(std::string const& status_path);
   void set_write_metrics(bool write_metrics) noexcept;
   void set_write_status(bool write_status) noexcept;
+  void set_writer_threads(uint32_t writer_threads) noexcept;
+  void set_creation_threads(uint32_t creation_threads) noexcept;
 
  private:
   std::string _real_path_of(std::string const& path);
@@ -57,6 +59,8 @@ class connector : public io::endpoint {
   std::string _status_path;
   bool _write_metrics;
   bool _write_status;
+  uint32_t _writer_threads;
+  uint32_t _creation_threads;
 };
 }  // namespace rrd
 
@@ -0,0 +1,104 @@
+/**
+ * Copyright 2023 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#ifndef CCB_RRD_CREATION_QUEUE_HH
+#define CCB_RRD_CREATION_QUEUE_HH
+
+#include "com/centreon/broker/rrd/creator.hh"
+
+namespace com::centreon::broker {
+
+namespace rrd {
+/**
+ *  @class creation_queue creation_queue.hh
+ * "com/centreon/broker/rrd/creation_queue.hh"
+ *  @brief Create RRD files in background.
+ *
+ *  Files are created by a bounded number of threads. Until a file exists,
+ *  the points written to it are held in memory, they are written by the
+ *  creating thread once the file is created, before the file is considered
+ *  as existing by the backends.
+ *
+ *  Held points are only in memory, so the events they come from must not be
+ *  acknowledged before they are written. acknowledge() gives how many events
+ *  can be acknowledged, held points are stamped with this number: the events
+ *  from this one may have points held.
+ */
+class creation_queue {
+  static constexpr uint64_t no_event = std::numeric_limits<uint64_t>::max();
+
+  struct request {
+    std::string filename;
+    uint32_t length;
+    time_t from;
+    uint32_t step;
+    short value_type;
+  };
+
+  std::shared_ptr<creator> _creator;
+
+  mutable std::mutex _m;
+  std::condition_variable _cv;
+  std::condition_variable _idle_cv;
+  std::deque<request> _requests;
+  struct pending_file {
+    std::deque<std::string> pts;
+    /* Stamp of the oldest held point. */
+    uint64_t first_event = no_event;
+    /* Stamp of the oldest point being written by _create(). */
+    uint64_t written_first_event = no_event;
+  };
+  /* Files queued or being created with their held points. */
+  std::unordered_map<std::string, pending_file> _pending;
+  /* Events that can be acknowledged, returned by the last acknowledge(). */
+  uint64_t _acknowledged;
+  bool _exit;
+  std::vector<std::thread> _threads;
+
+  void _run();
+  void _create(const request& r);
+
+ public:
+  creation_queue(const std::string& tmpl_path,
+                 uint32_t cache_size,
+                 uint32_t threads);
+  creation_queue(std::shared_ptr<creator> shared_creator, uint32_t threads);
+  ~creation_queue() noexcept;
+  creation_queue(const creation_queue&) = delete;
+  creation_queue& operator=(const creation_queue&) = delete;
+
+  void create(const std::string& filename,
+              uint32_t length,
+              time_t from,
+              uint32_t step,
+              short value_type);
+  bool is_pending(const std::string& filename) const;
+  bool hold(const std::string& filename, std::string&& pt);
+  bool hold(const std::string& filename, const std::deque<std::string>& pts);
+  uint64_t acknowledge(uint64_t written);
+  void wait_idle();
+  void clear();
+  size_t pending_files() const;
+  const std::shared_ptr<creator>& get_creator() const;
+};
+}  // namespace rrd
+
+}
+
+#endif  // !CCB_RRD_CREATION_QUEUE_HH
@@ -29,7 +29,9 @@ namespace rrd {
  *  @class creator creator.hh "com/centreon/broker/rrd/creator.hh"
  *  @brief RRD creator.
  *
- *  Create RRD objects.
+ *  Create RRD objects. New files are copies of template files kept in the
+ *  template directory, templates are reused after a restart. This class is
+ *  thread safe, several files can be created at the same time.
  */
 class creator {
  public:
@@ -74,6 +76,7 @@ class creator {
   };
 
   void _duplicate(std::string const& filename, fd_info const& in_fd);
+  void _load_templates();
   void _open(std::string const& filename,
              uint32_t length,
              time_t from,
@@ -84,6 +87,10 @@ class creator {
                    ssize_t size,
                    std::string const& filename);
 #ifdef __linux__
+  bool _copy_file_range(int out_fd,
+                        int in_fd,
+                        ssize_t size,
+                        std::string const& filename);
   void _sendfile(int out_fd,
                  int in_fd,
                  off_t already_transferred,
@@ -92,6 +99,8 @@ class creator {
 #endif  // Linux
 
   uint32_t _cache_size;
+  /* Protects _fds. */
+  std::mutex _fds_m;
   std::map<tmpl_info, fd_info> _fds;
   std::string _tmpl_path;
 };
@@ -20,6 +20,7 @@
 #define CCB_RRD_LIB_HH
 
 #include "com/centreon/broker/rrd/backend.hh"
+#include "com/centreon/broker/rrd/creation_queue.hh"
 #include "com/centreon/broker/rrd/creator.hh"
 
 namespace com::centreon::broker {
@@ -30,11 +31,16 @@ namespace rrd {
  *  @brief Handle RRD file access through librrd.
  *
  *  Handle creation, deletion, tuning and update of an RRD file with
- *  librrd.
+ *  librrd. When a creation queue is given, files are created in background
+ *  and their first points are held by the queue.
  */
 class lib : public backend {
  public:
-  lib(std::string const& tmpl_path, uint32_t cache_size);
+  lib(std::string const& tmpl_path,
+      uint32_t cache_size,
+      std::shared_ptr<creation_queue> creation = nullptr);
+  lib(std::shared_ptr<creator> shared_creator,
+      std::shared_ptr<creation_queue> creation = nullptr);
   lib(lib const& l) = delete;
   ~lib() = default;
   lib& operator=(lib const& l) = delete;
@@ -42,6 +48,7 @@ class lib : public backend {
   void clean() override;
   void close() override;
   void commit() override;
+  const std::shared_ptr<creator>& get_creator() const;
   void open(std::string const& filename) override;
   void open(std::string const& filename,
             uint32_t length,
@@ -52,9 +59,12 @@ class lib : public backend {
   void remove(std::string const& filename) override;
   void update(time_t t, std::string const& value) override;
   void update(const std::deque<std::string>& pts) override;
+  static void write_points(const std::string& filename,
+                           const std::deque<std::string>& pts);
 
  private:
-  creator _creator;
+  std::shared_ptr<creator> _creator;
+  std::shared_ptr<creation_queue> _creation;
   std::string _filename;
 };
 }  // namespace rrd
@@ -24,6 +24,7 @@
 #include "com/centreon/broker/rrd/backend.hh"
 #include "com/centreon/broker/rrd/cached.hh"
 #include "com/centreon/broker/rrd/lib.hh"
+#include "com/centreon/broker/rrd/sharded_writer.hh"
 
 namespace com::centreon::broker {
 
@@ -50,9 +51,26 @@ class output : public io::stream {
   rebuild_cache _status_rebuild;
   const bool _write_metrics;
   const bool _write_status;
+  /* When set, files are created in background. It is declared before
+   * _backend that uses it. */
+  std::shared_ptr<creation_queue> _creation;
   T _backend;
+  /* When set, points are written by this pool of threads. */
+  std::unique_ptr<sharded_writer> _writers;
+  /* Events whose points are written or held by _creation, and events
+   * acknowledged, since the beginning. */
+  uint64_t _written = 0;
+  uint64_t _acknowledged = 0;
 
+  int32_t _acknowledge();
   void _rebuild_data(const RebuildMessage& rm);
+  void _write(std::shared_ptr<io::data> const& d);
+  void _wait_idle();
+  void _update(uint64_t id,
+               const std::string& path,
+               const sharded_writer::file_def& def,
+               time_t t,
+               const std::string& value);
 
  public:
   output(std::string const& metrics_path,
@@ -60,7 +78,9 @@ class output : public io::stream {
          uint32_t cache_size,
          bool ignore_update_errors,
          bool write_metrics = true,
-         bool write_status = true);
+         bool write_status = true,
+         uint32_t writer_threads = 0,
+         uint32_t creation_threads = 0);
   output(std::string const& metrics_path,
          std::string const& status_path,
          uint32_t cache_size,
@@ -81,7 +101,9 @@ class output : public io::stream {
   bool read(std::shared_ptr<io::data>& d, time_t deadline) override;
   void update() override;
   int32_t write(std::shared_ptr<io::data> const& d) override;
-  int32_t stop() override { return 0; }
+  int32_t flush() override;
+  int32_t stop() override;
+  void statistics(nlohmann::json& tree) const override;
 };
 
 }  // namespace rrd
@@ -0,0 +1,125 @@
+/**
+ * Copyright 2023 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#ifndef CCB_RRD_SHARDED_WRITER_HH
+#define CCB_RRD_SHARDED_WRITER_HH
+
+#include <nlohmann/json.hpp>
+
+#include "com/centreon/broker/rrd/backend.hh"
+
+namespace com::centreon::broker {
+
+namespace rrd {
+/**
+ *  @class sharded_writer sharded_writer.hh
+ * "com/centreon/broker/rrd/sharded_writer.hh"
+ *  @brief Pool of threads writing RRD files.
+ *
+ *  Each thread owns a backend and the files whose id modulo the number of
+ *  threads is its index, so points of a file are always written in order by
+ *  the same thread. Points received while a thread is busy are buffered per
+ *  file and written with one backend update.
+ *
+ *  Events are numbered by next_event(), acknowledge() returns how many of
+ *  them have all their points written, in the order they were received.
+ *  Only the stream thread is allowed to call next_event(), update() and
+ *  acknowledge().
+ */
+class sharded_writer {
+ public:
+  /**
+   * @brief parameters used to create the file if it does not exist yet.
+   */
+  struct file_def {
+    uint32_t length;
+    time_t from;
+    uint32_t step;
+    short value_type;
+  };
+
+  using backend_builder = std::function<std::unique_ptr<backend>()>;
+
+  /* If a thread has more points than that waiting, update() waits. */
+  static constexpr size_t max_pending_points = 100000;
+
+ private:
+  static constexpr uint64_t no_event = std::numeric_limits<uint64_t>::max();
+
+  struct file_points {
+    file_def def;
+    std::deque<std::string> pts;
+  };
+  using file_buffer = std::unordered_map<std::string, file_points>;
+
+  struct shard {
+    std::unique_ptr<backend> file_backend;
+    /* Protects file_backend while files are written. */
+    std::mutex backend_m;
+    std::mutex m;
+    std::condition_variable cv;
+    std::condition_variable done_cv;
+    file_buffer buffer;
+    size_t buffer_points = 0;
+    /* The oldest event waiting in buffer. */
+    uint64_t buffer_first_event = no_event;
+    /* The oldest event being written by the thread. */
+    uint64_t written_first_event = no_event;
+    bool exit = false;
+    std::thread thread;
+  };
+
+  std::vector<std::unique_ptr<shard>> _shards;
+  uint64_t _next_event;
+  uint64_t _acknowledged;
+
+  std::atomic<uint64_t> _pending_points;
+  std::atomic<uint64_t> _updates;
+  std::atomic<uint64_t> _points;
+
+  mutable std::mutex _stats_m;
+  mutable std::chrono::steady_clock::time_point _stats_time;
+  mutable uint64_t _stats_updates;
+
+  void _run(shard& s);
+  void _write(backend& b, const std::string& path, const file_points& f);
+
+ public:
+  sharded_writer(uint32_t threads, const backend_builder& builder);
+  ~sharded_writer() noexcept;
+  sharded_writer(const sharded_writer&) = delete;
+  sharded_writer& operator=(const sharded_writer&) = delete;
+
+  void next_event();
+  void update(uint64_t id,
+              const std::string& path,
+              const file_def& def,
+              time_t t,
+              const std::string& value);
+  uint32_t acknowledge();
+  void wait_idle();
+  void clean();
+  uint64_t pending_points() const;
+  void statistics(nlohmann::json& tree) const;
+};
+}  // namespace rrd
+
+}
+
+#endif  // !CCB_RRD_SHARDED_WRITER_HH
@@ -47,7 +47,9 @@ connector::connector()
       _cached_port(0),
       _ignore_update_errors(true),
       _write_metrics(true),
-      _write_status(true) {}
+      _write_status(true),
+      _writer_threads(0),
+      _creation_threads(0) {}
 
 /**
  *  Connect.
@@ -67,7 +69,8 @@ std::shared_ptr<io::stream> connector::open() {
   else
     retval.reset(new output<lib>(_metrics_path, _status_path, _cache_size,
                                  _ignore_update_errors, _write_metrics,
-                                 _write_status));
+                                 _write_status, _writer_threads,
+                                 _creation_threads));
   return retval;
 }
 
@@ -144,6 +147,25 @@ void connector::set_write_status(bool write_status) noexcept {
   _write_status = write_status;
 }
 
+/**
+ *  Set the number of threads writing RRD files with librrd.
+ *
+ *  @param[in] writer_threads 0 to write files from the stream thread.
+ */
+void connector::set_writer_threads(uint32_t writer_threads) noexcept {
+  _writer_threads = writer_threads;
+}
+
+/**
+ *  Set the number of threads creating RRD files in background.
+ *
+ *  @param[in] creation_threads 0 to create files when their first point is
+ *                              written.
+ */
+void connector::set_creation_threads(uint32_t creation_threads) noexcept {
+  _creation_threads = creation_threads;
+}
+
 /**************************************
  *                                     *
  *           Private Methods           *
@@ -0,0 +1,264 @@
+/**
+ * Copyright 2023 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include "com/centreon/broker/rrd/creation_queue.hh"
+
+#include "com/centreon/broker/log_v2.hh"
+#include "com/centreon/broker/rrd/lib.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::rrd;
+
+/**
+ *  Constructor.
+ *
+ *  @param[in] tmpl_path  The template path.
+ *  @param[in] cache_size The maximum number of cache element.
+ *  @param[in] threads    Maximum number of files created at the same time.
+ */
+creation_queue::creation_queue(const std::string& tmpl_path,
+                               uint32_t cache_size,
+                               uint32_t threads)
+    : creation_queue(std::make_shared<creator>(tmpl_path, cache_size),
+                     threads) {}
+
+/**
+ *  Constructor using the creator of the backends, so that they share the
+ *  same template cache.
+ *
+ *  @param[in] shared_creator The creator to use.
+ *  @param[in] threads        Maximum number of files created at the same
+ *                            time.
+ */
+creation_queue::creation_queue(std::shared_ptr<creator> shared_creator,
+                               uint32_t threads)
+    : _creator(std::move(shared_creator)), _acknowledged(0), _exit(false) {
+  if (threads == 0)
+    threads = 1;
+  _threads.reserve(threads);
+  for (uint32_t i = 0; i < threads; ++i)
+    _threads.emplace_back(&creation_queue::_run, this);
+  SPDLOG_LOGGER_INFO(log_v2::rrd(),
+                     "RRD: {} threads started to create files in background",
+                     threads);
+}
+
+/**
+ *  Destructor. Queued files are created before threads exit.
+ */
+creation_queue::~creation_queue() noexcept {
+  {
+    std::lock_guard<std::mutex> lck(_m);
+    _exit = true;
+    _cv.notify_all();
+  }
+  for (auto& t : _threads)
+    t.join();
+}
+
+/**
+ *  Queue the creation of a file. Nothing is done if the file is already
+ *  waiting for its creation.
+ *
+ *  @param[in] filename   Path to the RRD file.
+ *  @param[in] length     Duration in seconds that the RRD file should
+ *                        retain.
+ *  @param[in] from       Timestamp of the first record.
+ *  @param[in] step       Time interval between each record.
+ *  @param[in] value_type Type of the metric.
+ */
+void creation_queue::create(const std::string& filename,
+                            uint32_t length,
+                            time_t from,
+                            uint32_t step,
+                            short value_type) {
+  std::lock_guard<std::mutex> lck(_m);
+  if (!_pending.emplace(filename, pending_file()).second)
+    return;
+  _requests.push_back({filename, length, from, step, value_type});
+  _cv.notify_one();
+}
+
+/**
+ *  Check if a file is queued or being created.
+ *
+ *  @param[in] filename Path to the RRD file.
+ *
+ *  @return true if the file does not exist yet.
+ */
+bool creation_queue::is_pending(const std::string& filename) const {
+  std::lock_guard<std::mutex> lck(_m);
+  return _pending.find(filename) != _pending.end();
+}
+
+/**
+ *  Keep a point of a file not created yet.
+ *
+ *  @param[in] filename Path to the RRD file.
+ *  @param[in] pt       Point formatted as "time:value".
+ *
+ *  @return true if the point is held, false if the file exists and the point
+ *  must be written by the caller.
+ */
+bool creation_queue::hold(const std::string& filename, std::string&& pt) {
+  std::lock_guard<std::mutex> lck(_m);
+  auto found = _pending.find(filename);
+  if (found == _pending.end())
+    return false;
+  if (found->second.pts.empty())
+    found->second.first_event = _acknowledged;
+  found->second.pts.emplace_back(std::move(pt));
+  return true;
+}
+
+/**
+ *  Keep points of a file not created yet.
+ *
+ *  @param[in] filename Path to the RRD file.
+ *  @param[in] pts      Points formatted as "time:value".
+ *
+ *  @return true if the points are held, false if the file exists and the
+ *  points must be written by the caller.
+ */
+bool creation_queue::hold(const std::string& filename,
+                          const std::deque<std::string>& pts) {
+  std::lock_guard<std::mutex> lck(_m);
+  auto found = _pending.find(filename);
+  if (found == _pending.end())
+    return false;
+  if (found->second.pts.empty())
+    found->second.first_event = _acknowledged;
+  found->second.pts.insert(found->second.pts.end(), pts.begin(), pts.end());
+  return true;
+}
+
+/**
+ *  Get how many events can be acknowledged: the written ones, except those
+ *  that may have points held. The result is never lower than the previous
+ *  one, a point held meanwhile comes from an event not acknowledged yet.
+ *
+ *  @param[in] written Number of events whose points are written or held,
+ *                     since the beginning.
+ *
+ *  @return Number of events that can be acknowledged, since the beginning.
+ */
+uint64_t creation_queue::acknowledge(uint64_t written) {
+  std::lock_guard<std::mutex> lck(_m);
+  uint64_t oldest = written;
+  for (auto& p : _pending)
+    oldest = std::min(
+        {oldest, p.second.first_event, p.second.written_first_event});
+  if (oldest > _acknowledged)
+    _acknowledged = oldest;
+  return _acknowledged;
+}
+
+/**
+ *  Wait for all the queued files to be created and their held points
+ *  written.
+ */
+void creation_queue::wait_idle() {
+  std::unique_lock<std::mutex> lck(_m);
+  _idle_cv.wait(lck, [this] { return _pending.empty(); });
+}
+
+/**
+ *  Clean the template cache.
+ */
+void creation_queue::clear() {
+  _creator->clear();
+}
+
+/**
+ *  Get the number of files queued or being created.
+ *
+ *  @return A number of files.
+ */
+size_t creation_queue::pending_files() const {
+  std::lock_guard<std::mutex> lck(_m);
+  return _pending.size();
+}
+
+/**
+ *  Get the creator of the queue.
+ *
+ *  @return The creator, it is shared with the backends.
+ */
+const std::shared_ptr<creator>& creation_queue::get_creator() const {
+  return _creator;
+}
+
+/**
+ *  Thread main loop.
+ */
+void creation_queue::_run() {
+  std::unique_lock<std::mutex> lck(_m);
+  for (;;) {
+    _cv.wait(lck, [this] { return _exit || !_requests.empty(); });
+    if (_requests.empty())
+      break;
+    request r{std::move(_requests.front())};
+    _requests.pop_front();
+    lck.unlock();
+    _create(r);
+    lck.lock();
+  }
+}
+
+/**
+ *  Create a file and write its held points. Points received while they are
+ *  written are also held, so they are written in order. The file is no more
+ *  pending once there is no point left.
+ *
+ *  @param[in] r The creation request.
+ */
+void creation_queue::_create(const request& r) {
+  bool created = true;
+  try {
+    _creator->create(r.filename, r.length, r.from, r.step, r.value_type);
+  } catch (const std::exception& e) {
+    log_v2::rrd()->error("RRD: could not create file '{}': {}", r.filename,
+                         e.what());
+    created = false;
+  }
+
+  std::deque<std::string> pts;
+  std::unique_lock<std::mutex> lck(_m);
+  for (;;) {
+    auto found = _pending.find(r.filename);
+    pending_file& f = found->second;
+    f.written_first_event = no_event;
+    if (!created && !f.pts.empty())
+      log_v2::rrd()->error("RRD: {} points lost for file '{}'", f.pts.size(),
+                           r.filename);
+    if (!created || f.pts.empty()) {
+      _pending.erase(found);
+      if (_pending.empty())
+        _idle_cv.notify_all();
+      return;
+    }
+    pts.swap(f.pts);
+    f.written_first_event = f.first_event;
+    f.first_event = no_event;
+    lck.unlock();
+    lib::write_points(r.filename, pts);
+    pts.clear();
+    lck.lock();
+  }
+}
@@ -30,6 +30,7 @@
 
 #include "bbdo/storage/metric.hh"
 #include "com/centreon/broker/log_v2.hh"
+#include "com/centreon/broker/misc/filesystem.hh"
 #include "com/centreon/broker/misc/perfdata.hh"
 #include "com/centreon/broker/rrd/creator.hh"
 #include "com/centreon/broker/rrd/exceptions/open.hh"
@@ -37,6 +38,10 @@
 using namespace com::centreon::broker;
 using namespace com::centreon::broker::rrd;
 
+/* Makes the temporary name of a template unique between the creators of the
+ * process. */
+static std::atomic_uint32_t _tmp_count{0};
+
 /**
  *  Constructor.
  *
@@ -48,19 +53,22 @@ creator::creator(std::string const& tmpl_path, uint32_t cache_size)
   log_v2::rrd()->debug(
       "RRD: file creator will maintain at most {} templates in '{}'",
       _cache_size, _tmpl_path);
+  _load_templates();
 }
 
 /**
- *  Destructor.
+ *  Destructor. Template files are kept to be reused at the next start.
  */
 creator::~creator() {
-  clear();
+  for (auto& p : _fds)
+    ::close(p.second.fd);
 }
 
 /**
  *  Clear cache and remove template file.
  */
 void creator::clear() {
+  std::lock_guard<std::mutex> lck(_fds_m);
   for (std::map<tmpl_info, fd_info>::const_iterator it(_fds.begin()),
        end(_fds.end());
        it != end; ++it) {
@@ -97,14 +105,16 @@ void creator::create(std::string const& filename,
   if (!without_cache) {
     tmpl_info info = {
         .from = 0, .length = length, .step = step, .value_type = value_type};
+    fd_info tmpl{-1, 0, {}};
 
+    std::unique_lock<std::mutex> lck(_fds_m);
     // Find fd informations.
     std::map<tmpl_info, fd_info>::const_iterator it(_fds.lower_bound(info));
 
     // Is in the cache, just duplicate file.
     if (it != _fds.end() && it->first.is_length_step_type_equal(info) &&
         it->first.from <= from) {
-      _duplicate(filename, it->second);
+      tmpl = it->second;
       log_v2::rrd()->debug("reuse {} for {}", it->second.path, filename);
     }
     // Not in the cache, but we have enough space in the cache.
@@ -115,8 +125,19 @@ void creator::create(std::string const& filename,
                                             value_type));
       info.from = from;
 
-      // Create new template.
-      _open(tmpl_filename, length, from, step, value_type);
+      // Create new template. It is renamed once complete so that an
+      // incomplete template is never loaded at the next start. Its
+      // temporary name is unique in the host, another creator may build the
+      // same template at the same time.
+      std::string tmp_filename(fmt::format("{}.{}.{}.tmp", tmpl_filename,
+                                           getpid(), _tmp_count++));
+      _open(tmp_filename, length, from, step, value_type);
+      if (::rename(tmp_filename.c_str(), tmpl_filename.c_str())) {
+        char const* msg(strerror(errno));
+        ::remove(tmp_filename.c_str());
+        throw exceptions::open("RRD: could not create template file '{}': {}",
+                               tmpl_filename, msg);
+      }
 
       // Get template file size.
       struct stat s;
@@ -144,12 +165,32 @@ void creator::create(std::string const& filename,
       fdinfo.size = s.st_size;
       fdinfo.path = tmpl_filename;
       _fds[info] = fdinfo;
+      tmpl = fdinfo;
+    }
 
-      _duplicate(filename, fdinfo);
+    // The template fd is duplicated so that the copy can be done while
+    // other files are created or the cache is cleared.
+    if (tmpl.fd >= 0) {
+      tmpl.fd = ::dup(tmpl.fd);
+      lck.unlock();
+      if (tmpl.fd < 0) {
+        char const* msg(strerror(errno));
+        throw exceptions::open("RRD: could not create file '{}': {}", filename,
+                               msg);
+      }
+      try {
+        _duplicate(filename, tmpl);
+      } catch (...) {
+        ::close(tmpl.fd);
+        throw;
+      }
+      ::close(tmpl.fd);
     }
     // No more space in the cache, just create rrd file.
-    else
+    else {
+      lck.unlock();
       _open(filename, length, from - 1, step, value_type);
+    }
   } else
     _open(filename, length, from - 1, step, value_type);
 }
@@ -169,6 +210,19 @@ void creator::_duplicate(std::string const& filename, fd_info const& in_fd) {
   }
 
 #ifdef __linux__
+  // Reserve the blocks of the file at once to avoid fragmentation, it is
+  // only an optimization, so errors are ignored.
+  if (::fallocate(out_fd, 0, 0, in_fd.size) < 0)
+    SPDLOG_LOGGER_TRACE(log_v2::rrd(), "RRD: could not preallocate '{}': {}",
+                        filename, strerror(errno));
+
+  // copy_file_range can share the blocks of the template on filesystems
+  // supporting it and avoids copies in user space anyway.
+  if (_copy_file_range(out_fd, in_fd.fd, in_fd.size, filename)) {
+    ::close(out_fd);
+    return;
+  }
+
   // First call(s) to sendfile detect if the kernel support the syscall
   // on any FD (Linux < 2.6.33 only supports writing to socket FD).
   off_t offset(0);
@@ -286,17 +340,13 @@ void creator::_read_write(int out_fd,
                           int in_fd,
                           ssize_t size,
                           std::string const& filename) {
-  // Reset position of in_fd.
-  if (lseek(in_fd, 0, SEEK_SET) == (off_t)-1) {
-    char const* msg(strerror(errno));
-    throw exceptions::open("RRD: could not create file '{}: {}", filename, msg);
-  }
-
+  // pread() is used because the position of in_fd is shared with the other
+  // creations using the same template.
   char buffer[4096];
   ssize_t transfered(0);
   while (transfered < size) {
     // Read from in_fd.
-    ssize_t rb(::read(in_fd, buffer, sizeof(buffer)));
+    ssize_t rb(::pread(in_fd, buffer, sizeof(buffer), transfered));
     if (rb <= 0) {
       if (errno != EAGAIN) {
         char const* msg(strerror(errno));
@@ -326,6 +376,42 @@ void creator::_read_write(int out_fd,
 }
 
 #ifdef __linux__
+/**
+ *  Transfer file between two FDs using copy_file_range.
+ *
+ *  @param[in] out_fd   Output FD.
+ *  @param[in] in_fd    Input FD.
+ *  @param[in] size     Size to transfer.
+ *  @param[in] filename Path to the file being created.
+ *
+ *  @return false if the syscall is not supported between these FDs and
+ *  nothing has been transfered.
+ */
+bool creator::_copy_file_range(int out_fd,
+                               int in_fd,
+                               ssize_t size,
+                               std::string const& filename) {
+  loff_t in_off(0);
+  loff_t out_off(0);
+  while (in_off < size) {
+    ssize_t ret =
+        ::copy_file_range(in_fd, &in_off, out_fd, &out_off, size - in_off, 0);
+    if (ret < 0) {
+      if (errno == EAGAIN || errno == EINTR)
+        continue;
+      if (in_off == 0 && (errno == ENOSYS || errno == EXDEV ||
+                          errno == EINVAL || errno == EOPNOTSUPP))
+        return false;
+      char const* msg(strerror(errno));
+      throw exceptions::open("RRD: could not create file '{}: {}", filename,
+                             msg);
+    } else if (ret == 0)
+      throw exceptions::open(
+          "RRD: could not create file '{}': template is truncated", filename);
+  }
+  return true;
+}
+
 /**
  *  Transfer file between two FDs using sendfile.
  *
@@ -354,3 +440,42 @@ void creator::_sendfile(int out_fd,
   }
 }
 #endif  // Linux
+
+/**
+ *  Fill the cache with the templates created before the last stop.
+ */
+void creator::_load_templates() {
+  std::list<std::string> files;
+  try {
+    files =
+        misc::filesystem::dir_content_with_filter(_tmpl_path, "tmpl_*.rrd");
+  } catch (const std::exception& e) {
+    log_v2::rrd()->debug("RRD: no template loaded from '{}': {}", _tmpl_path,
+                         e.what());
+    return;
+  }
+
+  for (const std::string& path : files) {
+    if (_fds.size() >= _cache_size)
+      break;
+    tmpl_info info;
+    long from;
+    std::string name{path.substr(path.rfind('/') + 1)};
+    if (sscanf(name.c_str(), "tmpl_%ld_%u_%u_%hd.rrd", &from, &info.length,
+               &info.step, &info.value_type) != 4)
+      continue;
+    info.from = from;
+
+    struct stat s;
+    if (stat(path.c_str(), &s) < 0 || s.st_size == 0)
+      continue;
+    int fd(open(path.c_str(), O_RDONLY));
+    if (fd < 0)
+      continue;
+    auto res = _fds.emplace(info, fd_info{fd, s.st_size, path});
+    if (res.second)
+      log_v2::rrd()->debug("RRD: template '{}' loaded", path);
+    else
+      ::close(fd);
+  }
+}
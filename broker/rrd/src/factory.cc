@@ -99,6 +99,30 @@ io::endpoint* factory::new_endpoint(
     }
   }
 
+  // Number of threads writing files, 0 to write them from the stream.
+  uint32_t writer_threads = 0;
+  {
+    std::map<std::string, std::string>::const_iterator it{
+        cfg.params.find("writer_threads")};
+    if (it != cfg.params.end() &&
+        !absl::SimpleAtoi(it->second, &writer_threads)) {
+      throw msg_fmt("RRD: bad writer_threads defined for endpoint '{}'",
+                    cfg.name);
+    }
+  }
+
+  // Number of threads creating files, 0 to create them from the stream.
+  uint32_t creation_threads = 0;
+  {
+    std::map<std::string, std::string>::const_iterator it{
+        cfg.params.find("creation_threads")};
+    if (it != cfg.params.end() &&
+        !absl::SimpleAtoi(it->second, &creation_threads)) {
+      throw msg_fmt("RRD: bad creation_threads defined for endpoint '{}'",
+                    cfg.name);
+    }
+  }
+
   // Should metrics be written ?
   bool write_metrics;
   {
@@ -171,6 +195,8 @@ io::endpoint* factory::new_endpoint(
   endp->set_write_metrics(write_metrics);
   endp->set_write_status(write_status);
   endp->set_ignore_update_errors(ignore_update_errors);
+  endp->set_writer_threads(writer_threads);
+  endp->set_creation_threads(creation_threads);
   is_acceptor = false;
   return endp.release();
 }
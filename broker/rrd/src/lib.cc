@@ -38,9 +38,25 @@ using namespace com::centreon::broker::rrd;
  *
  *  @param[in] tmpl_path  The template path.
  *  @param[in] cache_size The maximum number of cache element.
+ *  @param[in] creation   Queue creating files in background, may be null.
  */
-lib::lib(std::string const& tmpl_path, uint32_t cache_size)
-    : _creator(tmpl_path, cache_size) {}
+lib::lib(std::string const& tmpl_path,
+         uint32_t cache_size,
+         std::shared_ptr<creation_queue> creation)
+    : _creator(std::make_shared<creator>(tmpl_path, cache_size)),
+      _creation(std::move(creation)) {}
+
+/**
+ *  Constructor using the creator of another backend, so that the writer
+ *  threads share the same template cache.
+ *
+ *  @param[in] shared_creator The creator to use.
+ *  @param[in] creation       Queue creating files in background, may be
+ *                            null.
+ */
+lib::lib(std::shared_ptr<creator> shared_creator,
+         std::shared_ptr<creation_queue> creation)
+    : _creator(std::move(shared_creator)), _creation(std::move(creation)) {}
 
 /**
  *  @brief Initiates the bulk load of multiple commands.
@@ -53,7 +69,9 @@ void lib::begin() {}
  *  Clean the template cache.
  */
 void lib::clean() {
-  _creator.clear();
+  _creator->clear();
+  if (_creation)
+    _creation->clear();
 }
 
 /**
@@ -70,6 +88,15 @@ void lib::close() {
  */
 void lib::commit() {}
 
+/**
+ *  Get the creator of this backend.
+ *
+ *  @return The creator, it can be shared with other backends.
+ */
+const std::shared_ptr<creator>& lib::get_creator() const {
+  return _creator;
+}
+
 /**
  *  Open a RRD file which already exists.
  *
@@ -79,8 +106,10 @@ void lib::open(std::string const& filename) {
   // Close previous file.
   this->close();
 
-  // Check that the file exists.
-  if (access(filename.c_str(), F_OK))
+  // Check that the file exists. A file being created is considered as
+  // existing, its points are held until it is.
+  if ((!_creation || !_creation->is_pending(filename)) &&
+      access(filename.c_str(), F_OK))
     throw exceptions::open("RRD: file '{}' does not exist", filename);
 
   // Remember information for further operations.
@@ -96,6 +125,8 @@ void lib::open(std::string const& filename) {
  *  @param[in] from       Timestamp of the first record.
  *  @param[in] step       Time interval between each record.
  *  @param[in] value_type Type of the metric.
+ *  @param[in] without_cache  Force the synchronous creation of the file
+ *                            (needed by the rebuild).
  */
 void lib::open(std::string const& filename,
                uint32_t length,
@@ -108,7 +139,10 @@ void lib::open(std::string const& filename,
 
   // Remember informations for further operations.
   _filename = filename;
-  _creator.create(filename, length, from, step, value_type, without_cache);
+  if (_creation && !without_cache)
+    _creation->create(filename, length, from, step, value_type);
+  else
+    _creator->create(filename, length, from, step, value_type, without_cache);
 }
 
 /**
@@ -140,6 +174,8 @@ void lib::update(time_t t, std::string const& value) {
   }
 
   std::string arg(fmt::format("{}:{}", t, value));
+  if (_creation && _creation->hold(_filename, std::move(arg)))
+    return;
 
   // Set argument table.
   char const* argv[2];
@@ -164,25 +200,71 @@ void lib::update(time_t t, std::string const& value) {
   }
 }
 
+/**
+ *  Update the RRD file with several points in one call.
+ *
+ *  @param[in] pts Points formatted as "time:value".
+ */
 void lib::update(const std::deque<std::string>& pts) {
-  const char* argv[pts.size() + 1];
-  argv[pts.size()] = nullptr;
-  auto it = pts.begin();
-  for (uint32_t i = 0; i < pts.size(); i++) {
-    log_v2::rrd()->trace("insertion of {} in rrd file", *it);
-    argv[i] = it->data();
-    ++it;
+  if (!_creation || !_creation->hold(_filename, pts))
+    write_points(_filename, pts);
+}
+
+/**
+ *  Write several points to a RRD file.
+ *
+ *  rrd_update_r() stops at the first point it rejects, the points before it
+ *  are written. So if the update fails, only the points after the last
+ *  update of the file are written again, one by one, to keep them.
+ *
+ *  @param[in] filename Path to the RRD file.
+ *  @param[in] pts      Points formatted as "time:value".
+ */
+void lib::write_points(const std::string& filename,
+                       const std::deque<std::string>& pts) {
+  std::vector<const char*> argv;
+  argv.reserve(pts.size() + 1);
+  for (auto& pt : pts) {
+    log_v2::rrd()->trace("insertion of {} in rrd file", pt);
+    argv.push_back(pt.c_str());
   }
+  argv.push_back(nullptr);
   rrd_clear_error();
-  if (rrd_update_r(_filename.c_str(), nullptr, sizeof(argv) / sizeof(*argv) - 1,
-                   argv)) {
+  if (rrd_update_r(filename.c_str(), nullptr, pts.size(), argv.data())) {
     char const* msg(rrd_get_error());
-    if (!strstr(msg, "illegal attempt to update using time"))
+    if (pts.size() > 1) {
+      SPDLOG_LOGGER_DEBUG(log_v2::rrd(),
+                          "RRD: update of {} points in file '{}' failed ({}), "
+                          "points not written yet are written one by one",
+                          pts.size(), filename, msg);
+      rrd_clear_error();
+      time_t last = rrd_last_r(filename.c_str());
+      for (auto& pt : pts) {
+        if (last >= 0 && strtoll(pt.c_str(), nullptr, 10) <= last) {
+          SPDLOG_LOGGER_DEBUG(log_v2::rrd(),
+                              "RRD: point {} not after the last update of "
+                              "file '{}', skipped",
+                              pt, filename);
+          continue;
+        }
+        const char* one_arg[2] = {pt.c_str(), nullptr};
+        rrd_clear_error();
+        if (rrd_update_r(filename.c_str(), nullptr, 1, one_arg)) {
+          msg = rrd_get_error();
+          if (!strstr(msg, "illegal attempt to update using time"))
+            log_v2::rrd()->error("RRD: failed to update value in file '{}': {}",
+                                 filename, msg);
+          else
+            log_v2::rrd()->error("RRD: ignored update error in file '{}': {}",
+                                 filename, msg);
+        }
+      }
+    } else if (!strstr(msg, "illegal attempt to update using time"))
       log_v2::rrd()->error("RRD: failed to update value in file '{}': {}",
-                           _filename, msg);
+                           filename, msg);
 
     else
       log_v2::rrd()->error("RRD: ignored update error in file '{}': {}",
-                           _filename, msg);
+                           filename, msg);
   }
 }
@@ -71,6 +71,12 @@ std::set<typename map_type::mapped_type> values_of_map(const map_type& data) {
  *                                  written.
  *  @param[in] write_status         Set to true if status graph must be
  *                                  written.
+ *  @param[in] writer_threads       Number of threads writing metrics and
+ *                                  status files, 0 to write them from the
+ *                                  stream thread.
+ *  @param[in] creation_threads     Number of threads creating files in
+ *                                  background, 0 to create them when their
+ *                                  first point is written.
  */
 template <>
 output<lib>::output(std::string const& metrics_path,
@@ -78,14 +84,35 @@ output<lib>::output(std::string const& metrics_path,
                     uint32_t cache_size,
                     bool ignore_update_errors,
                     bool write_metrics,
-                    bool write_status)
+                    bool write_status,
+                    uint32_t writer_threads,
+                    uint32_t creation_threads)
     : io::stream("RRD"),
       _ignore_update_errors(ignore_update_errors),
       _metrics_path(metrics_path),
       _status_path(status_path),
       _write_metrics(write_metrics),
       _write_status(write_status),
-      _backend(!metrics_path.empty() ? metrics_path : status_path, cache_size) {
+      _creation(creation_threads
+                    ? std::make_shared<creation_queue>(
+                          !metrics_path.empty() ? metrics_path : status_path,
+                          cache_size, creation_threads)
+                    : nullptr),
+      _backend(_creation
+                   ? _creation->get_creator()
+                   : std::make_shared<creator>(
+                         !metrics_path.empty() ? metrics_path : status_path,
+                         cache_size),
+               _creation) {
+  if (writer_threads)
+    // The writer threads share the template cache of _backend and of the
+    // creation queue.
+    _writers = std::make_unique<sharded_writer>(
+        writer_threads,
+        [tmpl_creator = _backend.get_creator(),
+         creation = _creation]() -> std::unique_ptr<backend> {
+          return std::make_unique<lib>(tmpl_creator, creation);
+        });
 }
 
 /**
@@ -175,6 +202,8 @@ bool output<T>::read(std::shared_ptr<io::data>& d, time_t deadline) {
 template <typename T>
 void output<T>::update() {
   _backend.clean();
+  if (_writers)
+    _writers->clean();
 }
 
 /**
@@ -182,14 +211,126 @@ void output<T>::update() {
  *
  *  @param[in] d Data to write.
  *
- *  @return Number of events acknowledged.
+ *  @return Number of events acknowledged. Events are acknowledged once their
+ *  points are written: with writer threads, when the threads wrote them, and
+ *  with a creation queue, when the points held until their file is created
+ *  are written.
  */
 template <typename T>
 int output<T>::write(std::shared_ptr<io::data> const& d) {
   SPDLOG_LOGGER_TRACE(log_v2::rrd(), "RRD: output::write.");
+  if (_writers)
+    _writers->next_event();
+  _write(d);
+  if (!_writers)
+    ++_written;
+  return _acknowledge();
+}
+
+/**
+ *  Get the events written since the last acknowledgement.
+ *
+ *  @return Number of events acknowledged.
+ */
+template <typename T>
+int32_t output<T>::flush() {
+  return _acknowledge();
+}
+
+/**
+ *  Wait for the writer threads to write their points and for the files
+ *  being created.
+ *
+ *  @return Number of events acknowledged.
+ */
+template <typename T>
+int32_t output<T>::stop() {
+  _wait_idle();
+  return _acknowledge();
+}
+
+/**
+ *  Get the number of events written since the previous call. The writer
+ *  threads are asked before the creation queue: a point they hold in the
+ *  queue is then always seen.
+ *
+ *  @return Number of events acknowledged.
+ */
+template <typename T>
+int32_t output<T>::_acknowledge() {
+  if (_writers)
+    _written += _writers->acknowledge();
+  uint64_t acknowledged =
+      _creation ? _creation->acknowledge(_written) : _written;
+  int32_t retval = acknowledged - _acknowledged;
+  _acknowledged = acknowledged;
+  return retval;
+}
+
+/**
+ *  Get statistics of the writer threads.
+ *
+ *  @param[out] tree Output tree.
+ */
+template <typename T>
+void output<T>::statistics(nlohmann::json& tree) const {
+  if (_writers)
+    _writers->statistics(tree);
+  if (_creation)
+    tree["rrd_files_being_created"] = _creation->pending_files();
+}
+
+/**
+ *  Wait for all the points to be written and all the files to be created.
+ *  It is needed before touching files from the stream thread.
+ */
+template <typename T>
+void output<T>::_wait_idle() {
+  if (_writers)
+    _writers->wait_idle();
+  if (_creation)
+    _creation->wait_idle();
+}
+
+/**
+ *  Write the point of a metric or a status, directly or by the writer
+ *  threads.
+ *
+ *  @param[in] id    The metric id or the index id.
+ *  @param[in] path  The RRD file.
+ *  @param[in] def   Parameters used to create the file if needed.
+ *  @param[in] t     Timestamp of the point.
+ *  @param[in] value Value of the point.
+ */
+template <typename T>
+void output<T>::_update(uint64_t id,
+                        const std::string& path,
+                        const sharded_writer::file_def& def,
+                        time_t t,
+                        const std::string& value) {
+  if (_writers) {
+    _writers->update(id, path, def, t, value);
+    return;
+  }
+  try {
+    _backend.open(path);
+  } catch (exceptions::open const& b) {
+    assert(def.length);
+    _backend.open(path, def.length, def.from, def.step, def.value_type);
+  }
+  _backend.update(t, value);
+}
+
+/**
+ *  Handle an event.
+ *
+ *  @param[in] d Data to write.
+ */
+template <typename T>
+void output<T>::_write(std::shared_ptr<io::data> const& d) {
   // Check that data exists.
   if (!validate(d, "RRD"))
-    return 1;
+    return;
 
   switch (d->type()) {
     case storage::pb_metric::static_type():
@@ -209,15 +350,6 @@ int output<T>::write(std::shared_ptr<io::data> const& d) {
         // Check that metric is not being rebuilt.
         rebuild_cache::iterator it = _metrics_rebuild.find(metric_path);
         if (it == _metrics_rebuild.end()) {
-          // Write metrics RRD.
-          try {
-            _backend.open(metric_path);
-          } catch (exceptions::open const& b) {
-            time_t interval(m.interval() ? m.interval() : 60);
-            assert(m.rrd_len());
-            _backend.open(metric_path, m.rrd_len(), m.time() - 1, interval,
-                          m.value_type());
-          }
           std::string v;
           switch (m.value_type()) {
             case misc::perfdata::gauge:
@@ -253,7 +385,13 @@ int output<T>::write(std::shared_ptr<io::data> const& d) {
                                   m.metric_id(), m.value_type(), v);
               break;
           }
-          _backend.update(m.time(), v);
+          // Write metrics RRD.
+          _update(m.metric_id(), metric_path,
+                  {static_cast<uint32_t>(m.rrd_len()),
+                   static_cast<time_t>(m.time() - 1),
+                   static_cast<uint32_t>(m.interval() ? m.interval() : 60),
+                   static_cast<short>(m.value_type())},
+                  m.time(), v);
         } else
           // Cache value.
           it->second.push_back(d);
@@ -275,15 +413,6 @@ int output<T>::write(std::shared_ptr<io::data> const& d) {
         // Check that metric is not being rebuilt.
         rebuild_cache::iterator it = _metrics_rebuild.find(metric_path);
         if (e->is_for_rebuild || it == _metrics_rebuild.end()) {
-          // Write metrics RRD.
-          try {
-            _backend.open(metric_path);
-          } catch (exceptions::open const& b) {
-            time_t interval(e->interval ? e->interval : 60);
-            assert(e->rrd_len);
-            _backend.open(metric_path, e->rrd_len, e->time - 1, interval,
-                          e->value_type);
-          }
           std::string v;
           switch (e->value_type) {
             case misc::perfdata::gauge:
@@ -319,7 +448,11 @@ int output<T>::write(std::shared_ptr<io::data> const& d) {
                                   e->metric_id, e->value_type, v);
               break;
           }
-          _backend.update(e->time, v);
+          // Write metrics RRD.
+          _update(e->metric_id, metric_path,
+                  {static_cast<uint32_t>(e->rrd_len), e->time - 1,
+                   e->interval ? e->interval : 60, e->value_type},
+                  e->time, v);
         } else
           // Cache value.
           it->second.push_back(d);
@@ -342,14 +475,6 @@ int output<T>::write(std::shared_ptr<io::data> const& d) {
         // Check that status is not begin rebuild.
         rebuild_cache::iterator it(_status_rebuild.find(status_path));
         if (it == _status_rebuild.end()) {
-          // Write status RRD.
-          try {
-            _backend.open(status_path);
-          } catch (exceptions::open const& b) {
-            time_t interval(s.interval() ? s.interval() : 60);
-            assert(s.rrd_len());
-            _backend.open(status_path, s.rrd_len(), s.time() - 1, interval);
-          }
           std::string value;
           if (s.state() == 0)
             value = "100";
@@ -359,7 +484,11 @@ int output<T>::write(std::shared_ptr<io::data> const& d) {
             value = "0";
           else
             value = "";
-          _backend.update(s.time(), value);
+          // Write status RRD.
+          _update(s.index_id(), status_path,
+                  {s.rrd_len(), static_cast<time_t>(s.time() - 1),
+                   s.interval() ? s.interval() : 60, 0},
+                  s.time(), value);
         } else
           // Cache value.
           it->second.push_back(d);
@@ -381,14 +510,6 @@ int output<T>::write(std::shared_ptr<io::data> const& d) {
         // Check that status is not begin rebuild.
         rebuild_cache::iterator it(_status_rebuild.find(status_path));
         if (e->is_for_rebuild || it == _status_rebuild.end()) {
-          // Write status RRD.
-          try {
-            _backend.open(status_path);
-          } catch (exceptions::open const& b) {
-            time_t interval(e->interval ? e->interval : 60);
-            assert(e->rrd_len);
-            _backend.open(status_path, e->rrd_len, e->time - 1, interval);
-          }
           std::string value;
           if (e->state == 0)
             value = "100";
@@ -398,7 +519,11 @@ int output<T>::write(std::shared_ptr<io::data> const& d) {
             value = "0";
           else
             value = "";
-          _backend.update(e->time, value);
+          // Write status RRD.
+          _update(e->index_id, status_path,
+                  {static_cast<uint32_t>(e->rrd_len), e->time - 1,
+                   e->interval ? e->interval : 60, 0},
+                  e->time, value);
         } else
           // Cache value.
           it->second.push_back(d);
@@ -408,12 +533,14 @@ int output<T>::write(std::shared_ptr<io::data> const& d) {
       SPDLOG_LOGGER_DEBUG(log_v2::rrd(), "RRD: RebuildMessage received");
       std::shared_ptr<storage::pb_rebuild_message> e{
           std::static_pointer_cast<storage::pb_rebuild_message>(d)};
+      // Rebuilt files are written from here.
+      _wait_idle();
       switch (e->obj().state()) {
         case RebuildMessage_State_START:
           if (e->obj().metric_to_index_id().empty()) {
             SPDLOG_LOGGER_ERROR(log_v2::rrd(),
                                 "RRD: rebuild empty metric list");
-            return 1;
+            return;
           }
           SPDLOG_LOGGER_INFO(
               log_v2::rrd(),
@@ -443,7 +570,7 @@ int output<T>::write(std::shared_ptr<io::data> const& d) {
           if (_metrics_rebuild.empty()) {
             SPDLOG_LOGGER_ERROR(log_v2::rrd(),
                                 "RRD: rebuild empty metric list");
-            return 1;
+            return;
           }
           SPDLOG_LOGGER_DEBUG(log_v2::rrd(), "RRD: Data to rebuild metrics");
           _rebuild_data(e->obj());
@@ -452,7 +579,7 @@ int output<T>::write(std::shared_ptr<io::data> const& d) {
           if (e->obj().metric_to_index_id().empty()) {
             SPDLOG_LOGGER_ERROR(log_v2::rrd(),
                                 "RRD: rebuild empty metric list");
-            return 1;
+            return;
           }
           SPDLOG_LOGGER_INFO(
               log_v2::rrd(),
@@ -468,7 +595,7 @@ int output<T>::write(std::shared_ptr<io::data> const& d) {
               l = std::move(it->second);
               _metrics_rebuild.erase(it);
               while (!l.empty()) {
-                write(l.front());
+                _write(l.front());
                 l.pop_front();
               }
             }
@@ -478,7 +605,7 @@ int output<T>::write(std::shared_ptr<io::data> const& d) {
               l = std::move(it->second);
               _status_rebuild.erase(it);
               while (!l.empty()) {
-                write(l.front());
+                _write(l.front());
                 l.pop_front();
               }
             }
@@ -496,6 +623,7 @@ int output<T>::write(std::shared_ptr<io::data> const& d) {
       SPDLOG_LOGGER_DEBUG(log_v2::rrd(), "RRD: RemoveGraphsMessage received");
       std::shared_ptr<storage::pb_remove_graph_message> e{
           std::static_pointer_cast<storage::pb_remove_graph_message>(d)};
+      _wait_idle();
       for (auto& m : e->obj().metric_ids()) {
         std::string path{fmt::format("{}{}.rrd", _metrics_path, m)};
         /* File removed */
@@ -514,6 +642,7 @@ int output<T>::write(std::shared_ptr<io::data> const& d) {
       // Debug message.
       std::shared_ptr<storage::remove_graph> e(
           std::static_pointer_cast<storage::remove_graph>(d));
+      _wait_idle();
       SPDLOG_LOGGER_DEBUG(log_v2::rrd(), "RRD: remove graph request for {} {}",
                           e->is_index ? "index" : "metric", e->id);
 
@@ -534,8 +663,6 @@ int output<T>::write(std::shared_ptr<io::data> const& d) {
       log_v2::rrd()->warn("RRD: unknown BBDO message received of type {}",
                           d->type());
   }
-
-  return 1;
 }
 
 /**
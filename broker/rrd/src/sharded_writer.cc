@@ -0,0 +1,241 @@
+/**
+ * Copyright 2023 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include "com/centreon/broker/rrd/sharded_writer.hh"
+
+#include <absl/strings/str_cat.h>
+
+#include "com/centreon/broker/log_v2.hh"
+#include "com/centreon/broker/rrd/exceptions/open.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::rrd;
+
+/**
+ *  Constructor.
+ *
+ *  @param[in] threads Number of threads writing files.
+ *  @param[in] builder Function creating the backend of each thread.
+ */
+sharded_writer::sharded_writer(uint32_t threads, const backend_builder& builder)
+    : _next_event(0),
+      _acknowledged(0),
+      _pending_points(0),
+      _updates(0),
+      _points(0),
+      _stats_time(std::chrono::steady_clock::now()),
+      _stats_updates(0) {
+  if (threads == 0)
+    threads = 1;
+  _shards.reserve(threads);
+  for (uint32_t i = 0; i < threads; ++i) {
+    _shards.emplace_back(std::make_unique<shard>());
+    _shards.back()->file_backend = builder();
+  }
+  for (auto& s : _shards)
+    s->thread = std::thread(&sharded_writer::_run, this, std::ref(*s));
+  SPDLOG_LOGGER_INFO(log_v2::rrd(), "RRD: {} threads started to write files",
+                     threads);
+}
+
+/**
+ *  Destructor. Buffered points are written before threads exit.
+ */
+sharded_writer::~sharded_writer() noexcept {
+  for (auto& s : _shards) {
+    std::lock_guard<std::mutex> lck(s->m);
+    s->exit = true;
+    s->cv.notify_all();
+  }
+  for (auto& s : _shards)
+    s->thread.join();
+}
+
+/**
+ *  Declare a new event. The following calls to update() are points of this
+ *  event.
+ */
+void sharded_writer::next_event() {
+  ++_next_event;
+}
+
+/**
+ *  Add a point to a file. If the thread in charge of the file has too many
+ *  points waiting, this call waits for it to write them.
+ *
+ *  @param[in] id    Id of the metric or of the index of the file.
+ *  @param[in] path  Path of the file.
+ *  @param[in] def   Parameters to create the file if it does not exist.
+ *  @param[in] t     Timestamp of the point.
+ *  @param[in] value Value of the point.
+ */
+void sharded_writer::update(uint64_t id,
+                            const std::string& path,
+                            const file_def& def,
+                            time_t t,
+                            const std::string& value) {
+  if (value.empty()) {
+    log_v2::rrd()->error(
+        "RRD: ignored update non-float value '{}' in file '{}'", value, path);
+    return;
+  }
+
+  shard& s = *_shards[id % _shards.size()];
+  std::unique_lock<std::mutex> lck(s.m);
+  s.done_cv.wait(lck, [&s] { return s.buffer_points < max_pending_points; });
+  auto found = s.buffer.find(path);
+  if (found == s.buffer.end())
+    found = s.buffer.emplace(path, file_points{def, {}}).first;
+  found->second.pts.emplace_back(absl::StrCat(t, ":", value));
+  ++s.buffer_points;
+  ++_pending_points;
+  if (s.buffer_first_event == no_event)
+    s.buffer_first_event = _next_event - 1;
+  s.cv.notify_one();
+}
+
+/**
+ *  Get the number of events whose points are all written since the previous
+ *  call. An event is only counted when all the previous ones are.
+ *
+ *  @return The number of events to acknowledge.
+ */
+uint32_t sharded_writer::acknowledge() {
+  uint64_t oldest = _next_event;
+  for (auto& s : _shards) {
+    std::lock_guard<std::mutex> lck(s->m);
+    oldest = std::min({oldest, s->buffer_first_event, s->written_first_event});
+  }
+  uint32_t retval = oldest - _acknowledged;
+  _acknowledged = oldest;
+  return retval;
+}
+
+/**
+ *  Wait for all the points to be written. It is needed before touching
+ *  files outside of the threads, during rebuilds or removals for example.
+ */
+void sharded_writer::wait_idle() {
+  for (auto& s : _shards) {
+    std::unique_lock<std::mutex> lck(s->m);
+    s->done_cv.wait(lck, [&s] {
+      return s->buffer.empty() && s->written_first_event == no_event;
+    });
+  }
+}
+
+/**
+ *  Clean the template cache of each backend.
+ */
+void sharded_writer::clean() {
+  for (auto& s : _shards) {
+    std::lock_guard<std::mutex> lck(s->backend_m);
+    s->file_backend->clean();
+  }
+}
+
+/**
+ *  Get the number of points not written yet.
+ *
+ *  @return A number of points.
+ */
+uint64_t sharded_writer::pending_points() const {
+  return _pending_points;
+}
+
+/**
+ *  Fill the statistics tree with pending points and updates per second since
+ *  the previous call.
+ *
+ *  @param[out] tree Output tree.
+ */
+void sharded_writer::statistics(nlohmann::json& tree) const {
+  std::lock_guard<std::mutex> lck(_stats_m);
+  auto now = std::chrono::steady_clock::now();
+  uint64_t updates = _updates;
+  double elapsed = std::chrono::duration<double>(now - _stats_time).count();
+  tree["rrd_pending_points"] = _pending_points.load();
+  if (elapsed > 0)
+    tree["rrd_updates_per_second"] = (updates - _stats_updates) / elapsed;
+  if (updates)
+    tree["rrd_points_per_update"] = static_cast<double>(_points) / updates;
+  _stats_time = now;
+  _stats_updates = updates;
+}
+
+/**
+ *  Thread main loop: write all the buffered points, one update per file.
+ *
+ *  @param[in] s The shard of the thread.
+ */
+void sharded_writer::_run(shard& s) {
+  std::unique_lock<std::mutex> lck(s.m);
+  for (;;) {
+    s.cv.wait(lck, [&s] { return s.exit || !s.buffer.empty(); });
+    if (s.buffer.empty())
+      break;
+
+    file_buffer to_write;
+    to_write.swap(s.buffer);
+    size_t points = s.buffer_points;
+    s.buffer_points = 0;
+    s.written_first_event = s.buffer_first_event;
+    s.buffer_first_event = no_event;
+    s.done_cv.notify_all();
+    lck.unlock();
+
+    {
+      std::lock_guard<std::mutex> lb(s.backend_m);
+      for (auto& f : to_write)
+        _write(*s.file_backend, f.first, f.second);
+    }
+    _pending_points -= points;
+    _points += points;
+    _updates += to_write.size();
+
+    lck.lock();
+    s.written_first_event = no_event;
+    s.done_cv.notify_all();
+  }
+}
+
+/**
+ *  Write the points of a file, creating it if needed.
+ *
+ *  @param[in] b    The backend to use.
+ *  @param[in] path Path of the file.
+ *  @param[in] f    The points and the parameters of the file.
+ */
+void sharded_writer::_write(backend& b,
+                            const std::string& path,
+                            const file_points& f) {
+  try {
+    try {
+      b.open(path);
+    } catch (const exceptions::open& e) {
+      b.open(path, f.def.length, f.def.from, f.def.step, f.def.value_type);
+    }
+    SPDLOG_LOGGER_TRACE(log_v2::rrd(), "RRD: {} points added to file '{}'",
+                        f.pts.size(), path);
+    b.update(f.pts);
+  } catch (const std::exception& e) {
+    log_v2::rrd()->error("RRD: {} points lost for file '{}': {}",
+                         f.pts.size(), path, e.what());
+  }
+}
@@ -0,0 +1,170 @@
+/**
+ * Copyright 2023 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include "com/centreon/broker/rrd/creation_queue.hh"
+
+#include <gtest/gtest.h>
+#include <rrd.h>
+
+#include "com/centreon/broker/misc/filesystem.hh"
+#include "com/centreon/broker/rrd/lib.hh"
+#include "com/centreon/exceptions/msg_fmt.hh"
+
+using namespace com::centreon::exceptions;
+using namespace com::centreon::broker;
+
+#define RRD_DIR "/tmp/rrd_creation_test/"
+
+class RrdCreationQueue : public ::testing::Test {
+ public:
+  void SetUp() override {
+    _remove_files();
+    misc::filesystem::mkpath(RRD_DIR);
+  }
+
+  void TearDown() override { _remove_files(); }
+
+ protected:
+  void _remove_files() {
+    for (const std::string& f :
+         misc::filesystem::dir_content_with_filter(RRD_DIR, "*"))
+      std::remove(f.c_str());
+  }
+
+  static time_t _last_update(const std::string& filename) {
+    time_t last_update = 0;
+    unsigned long ds_count;
+    char** ds_names;
+    char** last_ds;
+    if (rrd_lastupdate_r(filename.c_str(), &last_update, &ds_count, &ds_names,
+                         &last_ds))
+      return 0;
+    for (unsigned long i = 0; i < ds_count; ++i) {
+      rrd_freemem(ds_names[i]);
+      rrd_freemem(last_ds[i]);
+    }
+    rrd_freemem(ds_names);
+    rrd_freemem(last_ds);
+    return last_update;
+  }
+};
+
+// Given a lib backend with a creation queue
+// When points are written to files that do not exist
+// Then files are created in background
+// And the points written meanwhile are in the files once the queue is idle
+TEST_F(RrdCreationQueue, HeldPoints) {
+  auto creation = std::make_shared<rrd::creation_queue>(RRD_DIR, 16, 4);
+  rrd::lib lib{RRD_DIR, 16, creation};
+
+  for (int i = 0; i < 50; ++i) {
+    std::string path{fmt::format(RRD_DIR "{}.rrd", i)};
+    ASSERT_THROW(lib.open(path), msg_fmt);
+    lib.open(path, 3600 * 24, 1000, 60, 0);
+    for (time_t t = 1060; t <= 1600; t += 60)
+      lib.update(t, std::to_string(i));
+    lib.open(path);
+    lib.update(std::deque<std::string>{"1660:1", "1720:2"});
+  }
+  creation->wait_idle();
+  ASSERT_EQ(creation->pending_files(), 0u);
+  for (int i = 0; i < 50; ++i) {
+    std::string path{fmt::format(RRD_DIR "{}.rrd", i)};
+    ASSERT_NO_THROW(lib.open(path));
+    ASSERT_EQ(_last_update(path), 1720);
+  }
+}
+
+// Given a lib backend with a creation queue
+// When each event writes a point to a file not created yet
+// Then an event is only acknowledged once its point is in the file
+TEST_F(RrdCreationQueue, HeldPointsNotAcknowledged) {
+  auto creation = std::make_shared<rrd::creation_queue>(RRD_DIR, 16, 1);
+  rrd::lib lib{RRD_DIR, 16, creation};
+  constexpr uint64_t events = 50;
+
+  /* The event i writes the point of the file i. */
+  uint64_t checked = 0;
+  for (uint64_t i = 0; i < events; ++i) {
+    std::string path{fmt::format(RRD_DIR "{}.rrd", i)};
+    lib.open(path, 3600 * 24, 1000, 60, 0);
+    lib.update(1060, "1");
+    uint64_t acknowledged = creation->acknowledge(i + 1);
+    ASSERT_LE(acknowledged, i + 1);
+    for (; checked < acknowledged; ++checked)
+      ASSERT_EQ(_last_update(fmt::format(RRD_DIR "{}.rrd", checked)), 1060);
+  }
+  creation->wait_idle();
+  ASSERT_EQ(creation->acknowledge(events), events);
+}
+
+// Given a creator that created a template
+// When it is destroyed and another creator is constructed on the same path
+// Then the template is reused
+// And it is removed when the cache is cleared
+TEST_F(RrdCreationQueue, PersistentTemplates) {
+  {
+    rrd::creator c{RRD_DIR, 16};
+    c.create(RRD_DIR "1.rrd", 3600 * 24, 1000, 60, 0);
+  }
+  ASSERT_EQ(
+      misc::filesystem::dir_content_with_filter(RRD_DIR, "tmpl_*.rrd").size(),
+      1u);
+
+  rrd::creator c{RRD_DIR, 16};
+  c.create(RRD_DIR "2.rrd", 3600 * 24, 2000, 60, 0);
+  ASSERT_EQ(
+      misc::filesystem::dir_content_with_filter(RRD_DIR, "tmpl_*.rrd").size(),
+      1u);
+  ASSERT_EQ(_last_update(RRD_DIR "2.rrd"), 1000);
+
+  c.clear();
+  ASSERT_TRUE(
+      misc::filesystem::dir_content_with_filter(RRD_DIR, "tmpl_*.rrd").empty());
+}
+
+// Given several creators on the same template path
+// When they create files needing the same new template at the same time
+// Then all the files are created
+// And no temporary template is left
+TEST_F(RrdCreationQueue, ConcurrentCreators) {
+  std::vector<std::unique_ptr<rrd::creator>> creators;
+  for (int i = 0; i < 8; ++i)
+    creators.push_back(std::make_unique<rrd::creator>(RRD_DIR, 16));
+
+  std::vector<std::thread> threads;
+  std::atomic_int errors{0};
+  for (int i = 0; i < 8; ++i)
+    threads.emplace_back([&creators, &errors, i] {
+      try {
+        creators[i]->create(fmt::format(RRD_DIR "{}.rrd", i), 3600 * 24, 1000,
+                            60, 0);
+      } catch (const std::exception&) {
+        ++errors;
+      }
+    });
+  for (auto& t : threads)
+    t.join();
+
+  ASSERT_EQ(errors, 0);
+  for (int i = 0; i < 8; ++i)
+    ASSERT_EQ(_last_update(fmt::format(RRD_DIR "{}.rrd", i)), 1000);
+  ASSERT_TRUE(
+      misc::filesystem::dir_content_with_filter(RRD_DIR, "*.tmp").empty());
+}
@@ -99,3 +99,43 @@ TEST(RRDFactory, Output) {
 
   delete con;
 }
+
+TEST(RRDFactory, WriterThreads) {
+  rrd::factory fact;
+  config::endpoint cfg(config::endpoint::io_type::output);
+  bool is_acceptor;
+  std::shared_ptr<persistent_cache> cache;
+
+  cfg.params["metrics_path"] = "toto";
+  cfg.params["status_path"] = "toto";
+  cfg.params["writer_threads"] = "many";
+  ASSERT_THROW(fact.new_endpoint(cfg, is_acceptor, cache), msg_fmt);
+  cfg.params["writer_threads"] = "4";
+  rrd::connector* con{
+      static_cast<rrd::connector*>(fact.new_endpoint(cfg, is_acceptor, cache))};
+  auto out = con->open();
+  ASSERT_EQ(out->flush(), 0);
+  ASSERT_EQ(out->stop(), 0);
+  delete con;
+}
+
+TEST(RRDFactory, CreationThreads) {
+  rrd::factory fact;
+  config::endpoint cfg(config::endpoint::io_type::output);
+  bool is_acceptor;
+  std::shared_ptr<persistent_cache> cache;
+
+  cfg.params["metrics_path"] = "/tmp/";
+  cfg.params["status_path"] = "/tmp/";
+  cfg.params["creation_threads"] = "-1";
+  ASSERT_THROW(fact.new_endpoint(cfg, is_acceptor, cache), msg_fmt);
+  cfg.params["creation_threads"] = "2";
+  rrd::connector* con{
+      static_cast<rrd::connector*>(fact.new_endpoint(cfg, is_acceptor, cache))};
+  auto out = con->open();
+  nlohmann::json tree;
+  out->statistics(tree);
+  ASSERT_EQ(tree["rrd_files_being_created"].get<size_t>(), 0u);
+  ASSERT_EQ(out->stop(), 0);
+  delete con;
+}
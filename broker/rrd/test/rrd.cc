@@ -18,6 +18,7 @@
  */
 
 #include <gtest/gtest.h>
+#include <rrd.h>
 #include <unistd.h>
 
 #include <cstdlib>
@@ -137,3 +138,35 @@ TEST_F(Rrd, UpdateNOK) {
 
   ASSERT_TRUE(file_exists);
 }
+
+// Given a RRD file
+// When points are written in one update whose third point is rejected
+// Then the points after the rejected one are written too
+TEST_F(Rrd, WritePointsAfterRejectedOne) {
+  std::string file_path("/tmp/broker_rrd_lib_write_points");
+  ::remove(file_path.c_str());
+
+  time_t now{std::time(nullptr)};
+  rrd::lib lib("/tmp", 16);
+  lib.open(file_path, 90 * 24 * 60 * 60, now - 7 * 24 * 60 * 60, 60, 0, true);
+
+  std::deque<std::string> pts{
+      fmt::format("{}:1", now - 300), fmt::format("{}:2", now - 240),
+      fmt::format("{}:3", now - 600), fmt::format("{}:4", now - 180),
+      fmt::format("{}:5", now - 120)};
+  rrd::lib::write_points(file_path, pts);
+  time_t last = rrd_last_r(file_path.c_str());
+
+  ::remove(file_path.c_str());
+
+  ASSERT_EQ(last, now - 120);
+}
+
+// Given a librrd backend
+// When another backend is built from its creator
+// Then both share the same template cache
+TEST_F(Rrd, SharedCreator) {
+  rrd::lib lib("/tmp", 16);
+  rrd::lib other(lib.get_creator());
+  ASSERT_EQ(lib.get_creator(), other.get_creator());
+}
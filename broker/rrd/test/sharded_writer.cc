@@ -0,0 +1,160 @@
+/**
+ * Copyright 2023 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include "com/centreon/broker/rrd/exceptions/open.hh"
+#include "com/centreon/broker/rrd/sharded_writer.hh"
+
+using namespace com::centreon::broker;
+
+namespace {
+/* Backend keeping in memory the updates it receives. */
+class fake_backend : public rrd::backend {
+ public:
+  struct files {
+    std::mutex m;
+    std::map<std::string, std::vector<std::string>> points;
+    std::set<std::string> created;
+    uint32_t updates = 0;
+    /* While set, updates wait. */
+    bool hold = false;
+    std::condition_variable cv;
+  };
+
+ private:
+  files& _files;
+  std::string _filename;
+
+ public:
+  fake_backend(files& f) : _files(f) {}
+  void begin() override {}
+  void clean() override {}
+  void close() override {}
+  void commit() override {}
+  void open(std::string const& filename) override {
+    std::lock_guard<std::mutex> lck(_files.m);
+    if (!_files.created.count(filename))
+      throw rrd::exceptions::open("RRD: file '{}' does not exist", filename);
+    _filename = filename;
+  }
+  void open(std::string const& filename,
+            uint32_t,
+            time_t,
+            uint32_t,
+            short,
+            bool) override {
+    std::lock_guard<std::mutex> lck(_files.m);
+    _files.created.insert(filename);
+    _filename = filename;
+  }
+  void remove(std::string const& filename) override {}
+  void update(time_t t, std::string const& value) override {
+    update(std::deque<std::string>{fmt::format("{}:{}", t, value)});
+  }
+  void update(const std::deque<std::string>& pts) override {
+    std::unique_lock<std::mutex> lck(_files.m);
+    _files.cv.wait(lck, [this] { return !_files.hold; });
+    auto& v = _files.points[_filename];
+    v.insert(v.end(), pts.begin(), pts.end());
+    ++_files.updates;
+  }
+};
+}  // namespace
+
+class RrdShardedWriter : public ::testing::Test {
+ protected:
+  fake_backend::files _files;
+  std::unique_ptr<rrd::sharded_writer> _writer;
+
+ public:
+  void SetUp() override {
+    _writer = std::make_unique<rrd::sharded_writer>(
+        4, [this]() -> std::unique_ptr<rrd::backend> {
+          return std::make_unique<fake_backend>(_files);
+        });
+  }
+
+  void hold(bool h) {
+    std::lock_guard<std::mutex> lck(_files.m);
+    _files.hold = h;
+    _files.cv.notify_all();
+  }
+};
+
+// Given a sharded_writer with 4 threads
+// When 10 points are written to 100 files
+// Then each file is created and contains its points in order
+TEST_F(RrdShardedWriter, PointsInOrder) {
+  for (int t = 0; t < 10; ++t)
+    for (uint64_t id = 0; id < 100; ++id) {
+      _writer->next_event();
+      _writer->update(id, fmt::format("/tmp/{}.rrd", id), {100, 0, 60, 0},
+                      t + 1, std::to_string(id * 100 + t));
+    }
+  _writer->wait_idle();
+  ASSERT_EQ(_writer->acknowledge(), 1000u);
+  ASSERT_EQ(_writer->pending_points(), 0u);
+  ASSERT_EQ(_files.created.size(), 100u);
+  for (uint64_t id = 0; id < 100; ++id) {
+    const auto& pts = _files.points[fmt::format("/tmp/{}.rrd", id)];
+    ASSERT_EQ(pts.size(), 10u);
+    for (int t = 0; t < 10; ++t)
+      ASSERT_EQ(pts[t], fmt::format("{}:{}", t + 1, id * 100 + t));
+  }
+}
+
+// Given a sharded_writer whose threads are blocked
+// When points are written to a file
+// Then they are written with one update once the threads are released
+// And events are acknowledged only when written
+TEST_F(RrdShardedWriter, Coalescing) {
+  hold(true);
+  /* The thread takes the first points and waits in update(), the others
+   * are buffered meanwhile. */
+  for (int t = 1; t <= 50; ++t) {
+    _writer->next_event();
+    _writer->update(1, "/tmp/1.rrd", {100, 0, 60, 0}, t, std::to_string(t));
+  }
+  /* An event without point is not acknowledged before the previous ones. */
+  _writer->next_event();
+  ASSERT_EQ(_writer->acknowledge(), 0u);
+  ASSERT_EQ(_writer->pending_points(), 50u);
+
+  hold(false);
+  _writer->wait_idle();
+  ASSERT_EQ(_writer->acknowledge(), 51u);
+  ASSERT_EQ(_files.points["/tmp/1.rrd"].size(), 50u);
+  ASSERT_LE(_files.updates, 2u);
+
+  nlohmann::json tree;
+  _writer->statistics(tree);
+  ASSERT_EQ(tree["rrd_pending_points"].get<uint64_t>(), 0u);
+  ASSERT_GE(tree["rrd_points_per_update"].get<double>(), 25.0);
+}
+
+// Given a sharded_writer
+// When a point with an empty value is written
+// Then it is ignored and the event is acknowledged at once
+TEST_F(RrdShardedWriter, EmptyValue) {
+  _writer->next_event();
+  _writer->update(1, "/tmp/1.rrd", {100, 0, 60, 0}, 1, "");
+  ASSERT_EQ(_writer->acknowledge(), 1u);
+  ASSERT_EQ(_writer->pending_points(), 0u);
+}
@@ -258,11 +258,14 @@ void conflict_manager::_storage_process_service_status(
 
       /* Parse perfdata. */
       _finish_action(-1, actions::metrics);
-      std::list<misc::perfdata> pds{misc::parse_perfdata(
-          ss.host_id, ss.service_id, ss.perf_data.c_str())};
+      auto pds =
+          ss.parsed_perf_data.get(ss.host_id, ss.service_id, ss.perf_data);
 
       std::deque<std::shared_ptr<io::data>> to_publish;
-      for (auto& pd : pds) {
+      for (const auto& pd : *pds) {
+        /* pd is shared with the other streams, the type found in the cache
+         * is kept here. */
+        int16_t value_type = pd.value_type();
         auto it_index_cache = _metric_cache.find({index_id, pd.name()});
 
         /* The cache does not contain this metric */
@@ -287,7 +290,7 @@ void conflict_manager::_storage_process_service_status(
           _metrics_insert.bind_value_as_f32(10, pd.max());
           _metrics_insert.bind_value_as_f32(11, pd.value());
 
-          int16_t type = pd.value_type();
+          int16_t type = value_type;
           char t[2];
           t[0] = '0' + type;
           t[1] = 0;
@@ -347,7 +350,7 @@ void conflict_manager::_storage_process_service_status(
           else
             need_metric_mapping = false;
 
-          pd.value_type(it_index_cache->second.type);
+          value_type = it_index_cache->second.type;
 
           log_v2::perfdata()->debug(
               "conflict_manager: metric {} concerning index {}, perfdata "
@@ -410,7 +413,7 @@ void conflict_manager::_storage_process_service_status(
               ss.host_id, ss.service_id, pd.name(), ss.last_check,
               static_cast<uint32_t>(ss.check_interval * _interval_length),
               false, metric_id, rrd_len, pd.value(),
-              static_cast<misc::perfdata::data_type>(pd.value_type()))};
+              static_cast<misc::perfdata::data_type>(value_type))};
           log_v2::perfdata()->debug(
               "conflict_manager: generating perfdata event for metric {} "
               "(name '{}', time {}, value {}, rrd_len {}, data_type {})",
@@ -210,12 +210,12 @@ class StorageParserParsePerfdata : public testing::Test {
 // Then perfdata are returned in a list
 TEST_F(StorageParserParsePerfdata, Simple1) {
   // Parse perfdata.
-  std::list<misc::perfdata> lst{misc::parse_perfdata(
+  std::vector<misc::perfdata> lst{misc::parse_perfdata(
       0, 0, "time=2.45698s;2.000000;5.000000;0.000000;10.000000")};
 
   // Assertions.
   ASSERT_EQ(lst.size(), 1u);
-  std::list<misc::perfdata>::const_iterator it(lst.begin());
+  std::vector<misc::perfdata>::const_iterator it(lst.begin());
   misc::perfdata expected;
   expected.name("time");
   expected.value_type(misc::perfdata::gauge);
@@ -232,12 +232,12 @@ TEST_F(StorageParserParsePerfdata, Simple1) {
 
 TEST_F(StorageParserParsePerfdata, Simple2) {
   // Parse perfdata.
-  std::list<misc::perfdata> list{
+  std::vector<misc::perfdata> list{
       misc::parse_perfdata(0, 0, "'ABCD12E'=18.00%;15:;10:;0;100")};
 
   // Assertions.
   ASSERT_EQ(list.size(), 1u);
-  std::list<misc::perfdata>::const_iterator it(list.begin());
+  std::vector<misc::perfdata>::const_iterator it(list.begin());
   misc::perfdata expected;
   expected.name("ABCD12E");
   expected.value_type(misc::perfdata::gauge);
@@ -254,7 +254,7 @@ TEST_F(StorageParserParsePerfdata, Simple2) {
 
 TEST_F(StorageParserParsePerfdata, Complex1) {
   // Parse perfdata.
-  std::list<misc::perfdata> list{misc::parse_perfdata(
+  std::vector<misc::perfdata> list{misc::parse_perfdata(
       0, 0,
       "time=2.45698s;;nan;;inf d[metric]=239765B/s;5;;-inf; "
       "infotraffic=18x;;;; a[foo]=1234;10;11: c[bar]=1234;~:10;20:30 "
@@ -262,7 +262,7 @@ TEST_F(StorageParserParsePerfdata, Complex1) {
 
   // Assertions.
   ASSERT_EQ(list.size(), 7u);
-  std::list<misc::perfdata>::const_iterator it(list.begin());
+  std::vector<misc::perfdata>::const_iterator it(list.begin());
   misc::perfdata expected;
 
   // #1.
@@ -352,7 +352,7 @@ TEST_F(StorageParserParsePerfdata, Complex1) {
 // Then the corresponding perfdata list is returned
 TEST_F(StorageParserParsePerfdata, Loop) {
   // Objects.
-  std::list<misc::perfdata> list;
+  std::vector<misc::perfdata> list;
 
   // Loop.
   for (uint32_t i(0); i < 10000; ++i) {
@@ -362,7 +362,7 @@ TEST_F(StorageParserParsePerfdata, Loop) {
 
     // Assertions.
     ASSERT_EQ(list.size(), 1u);
-    std::list<misc::perfdata>::const_iterator it(list.begin());
+    std::vector<misc::perfdata>::const_iterator it(list.begin());
     misc::perfdata expected;
     expected.name("time");
     expected.value_type(misc::perfdata::counter);
@@ -403,7 +403,7 @@ TEST_F(StorageParserParsePerfdata, LabelWithSpaces) {
 
   // Assertions.
   ASSERT_EQ(lst.size(), 1u);
-  std::list<misc::perfdata>::const_iterator it(lst.begin());
+  std::vector<misc::perfdata>::const_iterator it(lst.begin());
   misc::perfdata expected;
   expected.name("foo  bar");
   expected.value_type(misc::perfdata::gauge);
@@ -422,7 +422,7 @@ TEST_F(StorageParserParsePerfdata, LabelWithSpacesMultiline) {
 
   // Assertions.
   ASSERT_EQ(lst.size(), 1u);
-  std::list<misc::perfdata>::const_iterator it(lst.begin());
+  std::vector<misc::perfdata>::const_iterator it(lst.begin());
   misc::perfdata expected;
   expected.name("foo  bar");
   expected.value_type(misc::perfdata::gauge);
@@ -446,7 +446,7 @@ TEST_F(StorageParserParsePerfdata, Complex2) {
 
   // Assertions.
   ASSERT_EQ(list.size(), 6u);
-  std::list<misc::perfdata>::const_iterator it(list.begin());
+  std::vector<misc::perfdata>::const_iterator it(list.begin());
   misc::perfdata expected;
 
   // #1.
@@ -527,7 +527,7 @@ TEST_F(StorageParserParsePerfdata, SimpleWithR) {
 
   // Assertions.
   ASSERT_EQ(lst.size(), 1u);
-  std::list<misc::perfdata>::const_iterator it(lst.begin());
+  std::vector<misc::perfdata>::const_iterator it(lst.begin());
   misc::perfdata expected;
   expected.name("total");
   expected.value_type(misc::perfdata::gauge);
@@ -28,6 +28,8 @@ class tcp_config {
   int32_t _read_timeout;
   int _second_keepalive_interval;
   int _keepalive_count;
+  int _send_buffer_size;
+  int _receive_buffer_size;
 
  public:
   using pointer = std::shared_ptr<tcp_config>;
@@ -36,12 +38,16 @@ class tcp_config {
              uint16_t port,
              int32_t read_timeout = -1,
              int second_keepalive_interval = 30,
-             int keepalive_count = 2)
+             int keepalive_count = 2,
+             int send_buffer_size = 0,
+             int receive_buffer_size = 0)
       : _host(host),
         _port(port),
         _read_timeout(read_timeout),
         _second_keepalive_interval(second_keepalive_interval),
-        _keepalive_count(keepalive_count) {}
+        _keepalive_count(keepalive_count),
+        _send_buffer_size(send_buffer_size),
+        _receive_buffer_size(receive_buffer_size) {}
 
   const std::string& get_host() const { return _host; }
   uint16_t get_port() const { return _port; }
@@ -50,6 +56,9 @@ class tcp_config {
     return _second_keepalive_interval;
   }
   int get_keepalive_count() const { return _keepalive_count; }
+  /* 0 means the system default. */
+  int get_send_buffer_size() const { return _send_buffer_size; }
+  int get_receive_buffer_size() const { return _receive_buffer_size; }
 };
 
 }  // namespace tcp
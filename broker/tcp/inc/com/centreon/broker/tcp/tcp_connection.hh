@@ -18,6 +18,8 @@
 #ifndef CENTREON_BROKER_TCP_CONNECTION_HH
 #define CENTREON_BROKER_TCP_CONNECTION_HH
 
+#include <deque>
+#include <nlohmann/json.hpp>
 
 namespace com::centreon::broker {
 
@@ -25,6 +27,8 @@ namespace tcp {
 
 class tcp_connection : public std::enable_shared_from_this<tcp_connection> {
   constexpr static std::size_t async_buf_size = 16384;
+  /* Maximum number of queued vectors sent by one async_write(). */
+  constexpr static std::size_t max_write_buffers = 64;
   asio::ip::tcp::socket _socket;
   asio::io_context::strand _strand;
 
@@ -32,8 +36,11 @@ class tcp_connection : public std::enable_shared_from_this<tcp_connection> {
   boost::system::error_code _current_error;
 
   std::mutex _exposed_write_queue_m;
-  std::queue<std::vector<char>> _exposed_write_queue;
-  std::queue<std::vector<char>> _write_queue;
+  std::deque<std::vector<char>> _exposed_write_queue;
+  std::deque<std::vector<char>> _write_queue;
+  /* The buffers of the running async_write(), the first ones of
+   * _write_queue. */
+  std::vector<asio::const_buffer> _write_buffers;
   std::atomic_bool _write_queue_has_events;
   std::atomic_bool _writing;
   std::condition_variable _writing_cv;
@@ -41,7 +48,8 @@ class tcp_connection : public std::enable_shared_from_this<tcp_connection> {
   std::atomic<int32_t> _acks;
   std::atomic_bool _reading;
   std::atomic_bool _closing;
-  std::array<char, async_buf_size> _read_buffer;
+  /* Given to the reader when it is filled enough, so not copied. */
+  std::vector<char> _read_buffer;
   std::queue<std::vector<char>> _exposed_read_queue;
   std::mutex _read_queue_m;
   std::condition_variable _read_queue_cv;
@@ -51,6 +59,16 @@ class tcp_connection : public std::enable_shared_from_this<tcp_connection> {
   std::string _address;
   uint16_t _port;
 
+  /* Statistics */
+  std::atomic<uint64_t> _write_calls;
+  std::atomic<uint64_t> _written_bytes;
+  std::atomic<uint64_t> _read_calls;
+  std::atomic<uint64_t> _read_bytes;
+  std::atomic<uint32_t> _write_queue_depth;
+  std::atomic<uint32_t> _max_write_queue_depth;
+
+  void _async_write();
+
  public:
   typedef std::shared_ptr<tcp_connection> pointer;
   tcp_connection(asio::io_context& io_context,
@@ -65,7 +83,7 @@ class tcp_connection : public std::enable_shared_from_this<tcp_connection> {
   int32_t flush();
 
   void writing();
-  void handle_write(const boost::system::error_code& ec);
+  void handle_write(const boost::system::error_code& ec, size_t written_bytes);
   int32_t write(const std::vector<char>& v);
 
   void start_reading();
@@ -81,6 +99,7 @@ class tcp_connection : public std::enable_shared_from_this<tcp_connection> {
   uint16_t port() const;
 
   bool wait_for_all_events_written(unsigned ms_timeout);
+  void statistics(nlohmann::json& tree) const;
 };
 
 }  // namespace tcp
@@ -32,6 +32,30 @@ using namespace com::centreon::broker;
 using namespace com::centreon::broker::tcp;
 using namespace com::centreon::exceptions;
 
+/**
+ *  Read a socket buffer size from the endpoint configuration.
+ *
+ *  @param[in] cfg  Endpoint configuration.
+ *  @param[in] key  The parameter name.
+ *
+ *  @return The size in bytes, 0 if not configured.
+ */
+static int socket_buffer_size(const com::centreon::broker::config::endpoint& cfg,
+                              const std::string& key) {
+  int retval = 0;
+  auto it = cfg.params.find(key);
+  if (it != cfg.params.end()) {
+    if (!absl::SimpleAtoi(it->second, &retval) || retval < 0) {
+      log_v2::tcp()->error(
+          "TCP: '{}' field should be a positive integer and not '{}'", key,
+          it->second);
+      throw msg_fmt("TCP: '{}' field should be a positive integer and not '{}'",
+                    key, it->second);
+    }
+  }
+  return retval;
+}
+
 /**
  *  Check if a configuration supports this protocol.
  *  Possible endpoints are:
@@ -161,7 +185,9 @@ io::endpoint* factory::new_endpoint(
   }
 
   tcp_config::pointer conf(std::make_shared<tcp_config>(
-      host, port, read_timeout, keepalive_interval, keepalive_count));
+      host, port, read_timeout, keepalive_interval, keepalive_count,
+      socket_buffer_size(cfg, "socket_send_buffer_size"),
+      socket_buffer_size(cfg, "socket_receive_buffer_size")));
 
   // Acceptor.
   std::unique_ptr<io::endpoint> endp;
@@ -303,7 +329,9 @@ io::endpoint* factory::_new_endpoint_bbdo_cs(
   }
 
   tcp_config::pointer conf(std::make_shared<tcp_config>(
-      host, port, read_timeout, keepalive_interval, keepalive_count));
+      host, port, read_timeout, keepalive_interval, keepalive_count,
+      socket_buffer_size(cfg, "socket_send_buffer_size"),
+      socket_buffer_size(cfg, "socket_receive_buffer_size")));
 
   if (is_acceptor)
     endp = std::make_unique<tcp::acceptor>(conf);
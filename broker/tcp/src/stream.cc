@@ -190,6 +190,15 @@ int32_t stream::write(std::shared_ptr<io::data> const& d) {
   return 1;
 }
 
+/**
+ *  Get statistics of the connection.
+ *
+ *  @param[out] tree  Statistics tree.
+ */
+void stream::statistics(nlohmann::json& tree) const {
+  _connection->statistics(tree);
+}
+
 /**
  * @brief wait for connection write queue empty
  *
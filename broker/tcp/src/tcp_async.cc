@@ -189,6 +189,18 @@ std::shared_ptr<asio::ip::tcp::acceptor> tcp_async::create_acceptor(
 
   asio::ip::tcp::acceptor::reuse_address option(true);
   retval->set_option(option);
+  /* Accepted sockets inherit it, it must be set before the connection to be
+   * taken into account in the TCP window. */
+  if (conf->get_receive_buffer_size() > 0) {
+    boost::system::error_code err;
+    retval->set_option(asio::socket_base::receive_buffer_size(
+                           conf->get_receive_buffer_size()),
+                       err);
+    if (err)
+      SPDLOG_LOGGER_ERROR(log_v2::tcp(),
+                          "fail to set receive buffer size on acceptor {}",
+                          err.message());
+  }
   return retval;
 }
 
@@ -396,4 +408,19 @@ void tcp_async::_set_sock_opt(asio::ip::tcp::socket& sock,
   if (err) {
     SPDLOG_LOGGER_ERROR(log_v2::tcp(), "fail to set keepalive option");
   }
+  if (conf->get_send_buffer_size() > 0) {
+    sock.set_option(
+        asio::socket_base::send_buffer_size(conf->get_send_buffer_size()), err);
+    if (err)
+      SPDLOG_LOGGER_ERROR(log_v2::tcp(), "fail to set send buffer size {}",
+                          err.message());
+  }
+  if (conf->get_receive_buffer_size() > 0) {
+    sock.set_option(asio::socket_base::receive_buffer_size(
+                        conf->get_receive_buffer_size()),
+                    err);
+    if (err)
+      SPDLOG_LOGGER_ERROR(log_v2::tcp(), "fail to set receive buffer size {}",
+                          err.message());
+  }
 }
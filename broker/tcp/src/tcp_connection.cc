@@ -51,7 +51,13 @@ tcp_connection::tcp_connection(asio::io_context& io_context,
       _closing(false),
       _closed(false),
       _address(host),
-      _port(port) {}
+      _port(port),
+      _write_calls{0u},
+      _written_bytes{0u},
+      _read_calls{0u},
+      _read_bytes{0u},
+      _write_queue_depth{0u},
+      _max_write_queue_depth{0u} {}
 
 /**
  * @brief Destructor
@@ -134,9 +140,16 @@ int32_t tcp_connection::write(const std::vector<char>& v) {
     }
   }
 
+  /* The depth is incremented before the push, otherwise the writing thread
+   * could decrement it first and make it wrap around. */
+  uint32_t depth = ++_write_queue_depth;
+  uint32_t max_depth = _max_write_queue_depth;
+  while (depth > max_depth &&
+         !_max_write_queue_depth.compare_exchange_weak(max_depth, depth))
+    ;
   {
     std::lock_guard<std::mutex> lck(_exposed_write_queue_m);
-    _exposed_write_queue.push(v);
+    _exposed_write_queue.push_back(v);
   }
 
   // If the queue is not empty and the writing work is not started, we start
@@ -177,7 +190,7 @@ bool tcp_connection::wait_for_all_events_written(unsigned ms_timeout) {
  *    executed from the internal function tcp_connection::write(), then we are
  *    not already writing. And otherwise, writing() is called from the
  *    tcp_connection::handle_write() function, cadenced by _strand.
- *  * Launches the async_write.
+ *  * Launches the async_write on the first vectors of the queue.
  */
 void tcp_connection::writing() {
   if (!_write_queue_has_events) {
@@ -191,9 +204,25 @@ void tcp_connection::writing() {
     return;
   }
 
-  asio::async_write(_socket, asio::buffer(_write_queue.front()),
-                    _strand.wrap(std::bind(&tcp_connection::handle_write, ptr(),
-                                           std::placeholders::_1)));
+  _async_write();
+}
+
+/**
+ * @brief Gather the first vectors of _write_queue, up to max_write_buffers,
+ * and write them with one async_write. The vectors stay in the queue until
+ * they are written. This call must be cadenced by _strand.
+ */
+void tcp_connection::_async_write() {
+  _write_buffers.clear();
+  for (auto it = _write_queue.begin();
+       it != _write_queue.end() && _write_buffers.size() < max_write_buffers;
+       ++it)
+    _write_buffers.emplace_back(asio::buffer(*it));
+
+  asio::async_write(
+      _socket, _write_buffers,
+      _strand.wrap(std::bind(&tcp_connection::handle_write, ptr(),
+                             std::placeholders::_1, std::placeholders::_2)));
 }
 
 /**
@@ -201,8 +230,10 @@ void tcp_connection::writing() {
  * vectors to write, this handler continues to call async_write.
  *
  * @param ec
+ * @param written_bytes The number of bytes written.
  */
-void tcp_connection::handle_write(const boost::system::error_code& ec) {
+void tcp_connection::handle_write(const boost::system::error_code& ec,
+                                  size_t written_bytes) {
   if (ec) {
     if (ec == _eof_error)
       log_v2::tcp()->debug("write: socket closed: {}", _address);
@@ -214,14 +245,16 @@ void tcp_connection::handle_write(const boost::system::error_code& ec) {
     _writing = false;
     _closed = true;
   } else {
-    ++_acks;
-    _write_queue.pop();
+    size_t count = _write_buffers.size();
+    _acks += static_cast<int32_t>(count);
+    _write_queue.erase(_write_queue.begin(), _write_queue.begin() + count);
+    _write_queue_depth -= static_cast<uint32_t>(count);
+    ++_write_calls;
+    _written_bytes += written_bytes;
     _write_queue_has_events = !_write_queue.empty();
     if (_write_queue_has_events) {
       // The strand is useful because of the flush() method.
-      asio::async_write(_socket, asio::buffer(_write_queue.front()),
-                        _strand.wrap(std::bind(&tcp_connection::handle_write,
-                                               ptr(), std::placeholders::_1)));
+      _async_write();
     } else
       writing();
   }
@@ -239,6 +272,7 @@ void tcp_connection::start_reading() {
   if (!_reading) {
     _reading = true;
   }
+  _read_buffer.resize(async_buf_size);
   _socket.async_read_some(
       asio::buffer(_read_buffer),
       _strand.wrap(std::bind(&tcp_connection::handle_read, ptr(),
@@ -250,10 +284,24 @@ void tcp_connection::handle_read(const boost::system::error_code& ec,
   log_v2::tcp()->trace("Incoming data: {} bytes: {}", read_bytes,
                        debug_buf(&_read_buffer[0], read_bytes));
   if (read_bytes > 0) {
+    ++_read_calls;
+    _read_bytes += read_bytes;
+    /* A buffer filled enough is given as is, otherwise its content is copied
+     * to avoid queuing mostly empty buffers. */
+    std::vector<char> data;
+    if (read_bytes >= async_buf_size / 4) {
+      _read_buffer.resize(read_bytes);
+      data = std::move(_read_buffer);
+      _read_buffer = std::vector<char>();
+    } else
+      data.assign(_read_buffer.begin(), _read_buffer.begin() + read_bytes);
+
     std::lock_guard<std::mutex> lock(_read_queue_m);
-    _read_queue.emplace(_read_buffer.begin(),
-                        _read_buffer.begin() + read_bytes);
-    _read_queue_cv.notify_one();
+    /* The reader only waits on an empty queue. */
+    bool notify = _read_queue.empty();
+    _read_queue.push(std::move(data));
+    if (notify)
+      _read_queue_cv.notify_one();
   }
   if (ec) {
     if (ec == _eof_error)
@@ -379,6 +427,24 @@ std::vector<char> tcp_connection::read(time_t timeout_time, bool* timeout) {
   return retval;
 }
 
+/**
+ * @brief Fill the given json tree with the connection statistics.
+ *
+ * @param tree The tree to fill.
+ */
+void tcp_connection::statistics(nlohmann::json& tree) const {
+  uint64_t write_calls = _write_calls;
+  uint64_t read_calls = _read_calls;
+  tree["tcp_written_bytes"] = static_cast<double>(_written_bytes);
+  tree["tcp_bytes_per_write"] =
+      write_calls ? static_cast<double>(_written_bytes) / write_calls : 0.0;
+  tree["tcp_read_bytes"] = static_cast<double>(_read_bytes);
+  tree["tcp_bytes_per_read"] =
+      read_calls ? static_cast<double>(_read_bytes) / read_calls : 0.0;
+  tree["tcp_write_queue_depth"] = _write_queue_depth.load();
+  tree["tcp_max_write_queue_depth"] = _max_write_queue_depth.load();
+}
+
 /**
  * @brief Is this socket is closed?
  *
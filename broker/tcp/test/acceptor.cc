@@ -903,6 +903,60 @@ TEST_F(TcpAcceptor, BigSend) {
   t.join();
 }
 
+// Given a connector writing many small buffers at once
+// When the acceptor reads them
+// Then all the data are received in order
+// And the connector statistics show several buffers sent by write.
+TEST_F(TcpAcceptor, GatheredWrites) {
+  tcp::acceptor acc(test_conf);
+  constexpr int count = 1000;
+
+  std::thread t{[] {
+    tcp::connector con(test_conf);
+    std::shared_ptr<io::stream> str{try_connect(con)};
+    for (int i = 0; i < count; i++) {
+      std::shared_ptr<io::raw> data{new io::raw()};
+      data->append(fmt::format("{:04}", i));
+      str->write(data);
+    }
+    str->wait_for_all_events_written(5000);
+    nlohmann::json tree;
+    str->statistics(tree);
+    ASSERT_EQ(tree["tcp_written_bytes"].get<double>(), 4 * count);
+    ASSERT_GE(tree["tcp_bytes_per_write"].get<double>(), 4.0);
+    ASSERT_EQ(tree["tcp_write_queue_depth"].get<uint32_t>(), 0u);
+    std::shared_ptr<io::data> data_read;
+    str->read(data_read, -1);
+  }};
+  std::shared_ptr<io::stream> io;
+  for (;;) {
+    io = acc.open();
+    if (io)
+      break;
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  }
+  std::string str;
+  while (str.size() < 4 * count) {
+    std::shared_ptr<io::data> data_read;
+    io->read(data_read, time(nullptr) + 5);
+    if (data_read) {
+      const std::vector<char>& vec{
+          std::static_pointer_cast<io::raw>(data_read)->get_buffer()};
+      str.append(vec.begin(), vec.end());
+    }
+  }
+  std::string expected;
+  for (int i = 0; i < count; i++)
+    expected += fmt::format("{:04}", i);
+  ASSERT_EQ(str, expected);
+
+  std::shared_ptr<io::raw> data{new io::raw()};
+  data->append(std::string("END\n"));
+  io->write(data);
+
+  t.join();
+}
+
 TEST_F(TcpAcceptor, CloseRead) {
   tcp::acceptor acc(test_conf);
 
@@ -109,3 +109,23 @@ TEST(TcpFactory, Connector) {
   ASSERT_FALSE(is_acceptor);
   ASSERT_TRUE(endp->is_connector());
 }
+
+TEST(TcpFactory, BadSocketBufferSize) {
+  tcp::factory fact;
+  config::endpoint cfg(config::endpoint::io_type::output);
+  bool is_acceptor;
+  std::shared_ptr<persistent_cache> cache;
+
+  cfg.params["port"] = "4343";
+  cfg.params["socket_send_buffer_size"] = "-1";
+  ASSERT_THROW(fact.new_endpoint(cfg, is_acceptor, cache), msg_fmt);
+
+  cfg.params["socket_send_buffer_size"] = "1048576";
+  cfg.params["socket_receive_buffer_size"] = "big";
+  ASSERT_THROW(fact.new_endpoint(cfg, is_acceptor, cache), msg_fmt);
+
+  cfg.params["socket_receive_buffer_size"] = "1048576";
+  std::unique_ptr<io::endpoint> endp{
+      fact.new_endpoint(cfg, is_acceptor, cache)};
+  ASSERT_TRUE(is_acceptor);
+}
@@ -0,0 +1,117 @@
+/**
+ * Copyright 2023 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+#include <iostream>
+#include <random>
+
+#include "com/centreon/broker/config/applier/init.hh"
+#include "com/centreon/broker/config/applier/state.hh"
+#include "com/centreon/broker/log_v2.hh"
+#include "misc/legacy_perfdata.hh"
+
+using namespace com::centreon::broker;
+
+std::shared_ptr<asio::io_context> g_io_context =
+    std::make_shared<asio::io_context>();
+bool g_io_context_started = false;
+
+/**
+ * @brief Check that the current parser returns exactly what the legacy one
+ * returns, the string is displayed otherwise.
+ */
+static bool same_as_legacy(const std::string& str) {
+  auto expected = legacy::parse_perfdata(str.c_str());
+  auto result = misc::parse_perfdata(0, 0, str.c_str());
+  bool retval = expected.size() == result.size();
+  for (size_t i = 0; retval && i < expected.size(); ++i)
+    retval = legacy::same(expected[i], result[i]);
+  if (!retval)
+    std::cerr << "perfdata differ for '" << str << "'" << std::endl;
+  return retval;
+}
+
+/**
+ *  Compares the perfdata parser with the legacy one on random strings built
+ *  with perfdata pieces and on random mutations of the samples.
+ *
+ *  Usage: fuzz_parse_perfdata [iterations [seed]]
+ *
+ *  @return 0 if both parsers always agree, 1 otherwise.
+ */
+int main(int argc, char* argv[]) {
+  int iterations = argc > 1 ? std::atoi(argv[1]) : 100000;
+  uint32_t seed = argc > 2 ? std::strtoul(argv[2], nullptr, 10)
+                           : std::random_device()();
+  std::cout << "fuzz_parse_perfdata: " << iterations
+            << " iterations with seed " << seed << std::endl;
+
+  config::applier::state::load();
+  log_v2::load(g_io_context);
+  config::applier::init(0, "broker_fuzz", 0);
+
+  static const std::vector<std::string> pieces{
+      "metric", "'a b'", "=",    ";",     ":",      "@",
+      "~",      ",",     ".",    "-",     "+",      "e",
+      "E",      "e-",    "x",    "0x",    "0X1",    "1",
+      "12",     "3.5",   "1e3",  "inf",   "nan",    "NaN",
+      " ",      "\t",    "\n",   "\r",    "\v",     "'",
+      "a[",     "c[",    "d[",   "g[",    "]",      "%",
+      "B/s",    "é",     "\xff", "0,5",   "1,5e2",  "123456789012345678",
+      "9007199254740993", "0.00000000000000000000000012"};
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<size_t> piece(0, pieces.size() - 1);
+  std::uniform_int_distribution<int> length(1, 30);
+  std::uniform_int_distribution<int> byte(1, 255);
+
+  int retval = 0;
+  for (int i = 0; !retval && i < iterations; ++i) {
+    std::string str;
+    for (int j = length(gen); j > 0; --j)
+      str += pieces[piece(gen)];
+    if (!same_as_legacy(str))
+      retval = 1;
+  }
+
+  auto real = legacy::samples();
+  std::uniform_int_distribution<size_t> sample(0, real.size() - 2);
+  for (int i = 0; !retval && i < iterations; ++i) {
+    std::string str = real[sample(gen)];
+    for (int j = length(gen) / 5; j >= 0; --j) {
+      size_t pos = std::uniform_int_distribution<size_t>(0, str.size())(gen);
+      switch (gen() % 3) {
+        case 0:
+          str.insert(pos, 1, static_cast<char>(byte(gen)));
+          break;
+        case 1:
+          if (pos < str.size())
+            str.erase(pos, 1);
+          break;
+        default:
+          str.insert(pos, pieces[piece(gen)]);
+          break;
+      }
+    }
+    if (!same_as_legacy(str))
+      retval = 1;
+  }
+
+  config::applier::deinit();
+  config::applier::state::unload();
+  spdlog::shutdown();
+  return retval;
+}
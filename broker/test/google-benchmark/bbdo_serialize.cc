@@ -0,0 +1,139 @@
+/**
+ * Copyright 2023 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "com/centreon/broker/bbdo/stream.hh"
+#include "com/centreon/broker/config/applier/init.hh"
+#include "com/centreon/broker/config/applier/modules.hh"
+#include "com/centreon/broker/io/raw.hh"
+#include "com/centreon/broker/neb/internal.hh"
+#include "com/centreon/broker/neb/service.hh"
+
+using namespace com::centreon::broker;
+
+/* Allocations counter, this binary only contains serialization benchmarks. */
+static std::atomic<uint64_t> allocations{0};
+
+void* operator new(size_t size) {
+  ++allocations;
+  void* retval = malloc(size ? size : 1);
+  if (!retval)
+    throw std::bad_alloc();
+  return retval;
+}
+
+void operator delete(void* p) noexcept {
+  free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+  free(p);
+}
+
+/**
+ * @brief A substream forgetting what is written to it.
+ */
+class null_stream : public io::stream {
+ public:
+  null_stream() : io::stream("null_stream") {}
+  bool read(std::shared_ptr<io::data>&, time_t) override { return false; }
+  int write(std::shared_ptr<io::data> const&) override { return 1; }
+  int32_t stop() override { return 0; }
+};
+
+static void init_broker() {
+  static bool initialized = false;
+  if (!initialized) {
+    io::data::broker_id = 0;
+    config::applier::init(0, "broker_bench", 0);
+    config::applier::modules modules;
+    modules.load_file("./lib/10-neb.so");
+    initialized = true;
+  }
+}
+
+static std::unique_ptr<bbdo::stream> make_stream() {
+  auto retval = std::make_unique<bbdo::stream>(true);
+  retval->set_substream(std::make_shared<null_stream>());
+  retval->set_coarse(false);
+  retval->set_negotiate(false);
+  retval->negotiate(bbdo::stream::negotiate_first);
+  return retval;
+}
+
+/**
+ * @brief The events are written one by one, or all at once when the second
+ * argument is set.
+ */
+static void serialize(benchmark::State& state,
+                      const std::vector<std::shared_ptr<io::data>>& events) {
+  auto stream = make_stream();
+  uint64_t count = 0;
+  uint64_t allocs = allocations;
+  for (auto _ : state) {
+    if (state.range(1))
+      stream->write(events);
+    else
+      for (auto& e : events)
+        stream->write(e);
+    count += events.size();
+  }
+  state.counters["allocs_per_event"] = benchmark::Counter(
+      static_cast<double>(allocations - allocs) / (count ? count : 1));
+  state.SetItemsProcessed(count);
+}
+
+static void BM_serialize_legacy_service(benchmark::State& state) {
+  init_broker();
+  std::vector<std::shared_ptr<io::data>> events;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    auto svc = std::make_shared<neb::service>();
+    svc->host_id = 1 + i / 10;
+    svc->service_id = i;
+    svc->output = fmt::format("OK - service {} is fine", i);
+    svc->perf_data = fmt::format("metric={};80;90;0;100", i % 100);
+    events.push_back(std::move(svc));
+  }
+  serialize(state, events);
+}
+
+static void BM_serialize_pb_service(benchmark::State& state) {
+  init_broker();
+  std::vector<std::shared_ptr<io::data>> events;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    auto svc = std::make_shared<neb::pb_service>();
+    svc->mut_obj().set_host_id(1 + i / 10);
+    svc->mut_obj().set_service_id(i);
+    svc->mut_obj().set_output(fmt::format("OK - service {} is fine", i));
+    svc->mut_obj().set_perfdata(fmt::format("metric={};80;90;0;100", i % 100));
+    events.push_back(std::move(svc));
+  }
+  serialize(state, events);
+}
+
+BENCHMARK(BM_serialize_legacy_service)
+    ->ArgNames({"events", "batch"})
+    ->ArgsProduct({{1000, 100000}, {0, 1}});
+BENCHMARK(BM_serialize_pb_service)
+    ->ArgNames({"events", "batch"})
+    ->ArgsProduct({{1000, 100000}, {0, 1}});
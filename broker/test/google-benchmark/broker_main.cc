@@ -0,0 +1,43 @@
+/**
+ * Copyright 2023 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+#include <benchmark/benchmark.h>
+#include "com/centreon/broker/config/applier/state.hh"
+#include "com/centreon/broker/log_v2.hh"
+
+std::shared_ptr<asio::io_context> g_io_context =
+    std::make_shared<asio::io_context>();
+bool g_io_context_started = false;
+
+/**
+ *  Entry point of the benchmarks linked with the broker libraries. It sets
+ *  the same environment as ut_broker.
+ */
+int main(int argc, char* argv[]) {
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    return 1;
+
+  com::centreon::broker::config::applier::state::load();
+  com::centreon::broker::log_v2::load(g_io_context);
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  com::centreon::broker::config::applier::state::unload();
+  spdlog::shutdown();
+  return 0;
+}
@@ -0,0 +1,65 @@
+/**
+ * Copyright 2023 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+#include <benchmark/benchmark.h>
+
+#include "com/centreon/broker/misc/misc.hh"
+
+using namespace com::centreon::broker;
+
+/* BBDO headers are 16 bytes long, the checksum covers the last 14 ones. */
+static const char header[14] = {0x00, 0x2a, 0x00, 0x01, 0x00, 0x02,
+                                0x00, 0x00, 0x00, 0x07, 0x00, 0x00,
+                                0x00, 0x00};
+
+static const uint16_t crc_nibble_tbl[16] = {
+    0x0000, 0x1081, 0x2102, 0x3183, 0x4204, 0x5285, 0x6306, 0x7387,
+    0x8408, 0x9489, 0xa50a, 0xb58b, 0xc60c, 0xd68d, 0xe70e, 0xf78f};
+
+/**
+ *  The nibble based checksum used before misc::crc16_ccitt() was table
+ *  driven, kept as the reference.
+ */
+static uint16_t crc16_nibbles(char const* data, uint32_t data_len) {
+  uint16_t crc = 0xffff;
+  const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
+  while (data_len--) {
+    uint8_t c = *p++;
+    crc = ((crc >> 4) & 0x0fff) ^ crc_nibble_tbl[((crc ^ c) & 15)];
+    c >>= 4;
+    crc = ((crc >> 4) & 0x0fff) ^ crc_nibble_tbl[((crc ^ c) & 15)];
+  }
+  return ~crc & 0xffff;
+}
+
+static void BM_crc16_nibbles(benchmark::State& state) {
+  for (auto _ : state)
+    benchmark::DoNotOptimize(crc16_nibbles(header, sizeof(header)));
+}
+BENCHMARK(BM_crc16_nibbles);
+
+static void BM_crc16_ccitt(benchmark::State& state) {
+  if (misc::crc16_ccitt(header, sizeof(header)) !=
+      crc16_nibbles(header, sizeof(header))) {
+    state.SkipWithError("crc16_ccitt() differs from the nibble checksum");
+    return;
+  }
+  for (auto _ : state)
+    benchmark::DoNotOptimize(misc::crc16_ccitt(header, sizeof(header)));
+}
+BENCHMARK(BM_crc16_ccitt);
@@ -0,0 +1,106 @@
+/**
+ * Copyright 2023 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+#include <benchmark/benchmark.h>
+
+#include <thread>
+
+#include "grpc_stream.pb.h"
+
+#include "com/centreon/broker/config/applier/init.hh"
+#include "com/centreon/broker/grpc/acceptor.hh"
+#include "com/centreon/broker/grpc/stream.hh"
+#include "com/centreon/broker/io/raw.hh"
+#include "com/centreon/broker/pool.hh"
+
+using namespace com::centreon::broker;
+using com::centreon::broker::grpc::grpc_config;
+
+static void init_broker() {
+  static bool initialized = false;
+  if (!initialized) {
+    config::applier::init(0, "broker_bench", 0);
+    pool::load(std::make_shared<asio::io_context>(), 1);
+    initialized = true;
+  }
+}
+
+static grpc_config::pointer batch_conf(uint32_t batch_size) {
+  return std::make_shared<grpc_config>("127.0.0.1:4448", false, "", "", "",
+                                       "", "", grpc_config::NO, 30, false,
+                                       batch_size);
+}
+
+/**
+ *  A client sends events to a server. The first argument is the batch size
+ *  of the server, the second one the batch size of the client, 0 to send
+ *  events one by one.
+ */
+static void BM_grpc_client_to_server(benchmark::State& state) {
+  constexpr unsigned count = 10000;
+  init_broker();
+  auto s = std::make_unique<com::centreon::broker::grpc::acceptor>(
+      batch_conf(state.range(0)));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  com::centreon::broker::grpc::stream client(batch_conf(state.range(1)));
+  std::shared_ptr<io::stream> accepted =
+      s->open(std::chrono::milliseconds(1000));
+  if (!accepted) {
+    state.SkipWithError("no connection accepted");
+    return;
+  }
+
+  std::vector<std::shared_ptr<io::raw>> events;
+  events.reserve(count);
+  for (unsigned ii = 0; ii < count; ++ii) {
+    auto evt = std::make_shared<io::raw>();
+    std::string buffer(std::to_string(ii));
+    evt->_buffer.assign(buffer.begin(), buffer.end());
+    events.push_back(evt);
+  }
+
+  for (auto _ : state) {
+    std::thread writer([&client, &events]() {
+      for (auto& evt : events)
+        client.write(evt);
+    });
+    unsigned received = 0;
+    while (received < count) {
+      std::shared_ptr<io::data> receive;
+      if (!accepted->read(receive, time(nullptr) + 5))
+        break;
+      ++received;
+    }
+    writer.join();
+    if (received < count) {
+      state.SkipWithError("events lost");
+      break;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+  accepted.reset();
+  s.reset();
+}
+
+BENCHMARK(BM_grpc_client_to_server)
+    ->ArgNames({"server_batch", "client_batch"})
+    ->Args({0, 0})
+    ->Args({grpc_config::default_batch_size, 0})
+    ->Args({grpc_config::default_batch_size, grpc_config::default_batch_size})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
@@ -0,0 +1,84 @@
+/**
+ * Copyright 2023 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+#include <benchmark/benchmark.h>
+
+#include "com/centreon/broker/config/applier/init.hh"
+#include "stand_in_server.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::http_tsdb::test;
+
+static void init_broker() {
+  static bool initialized = false;
+  if (!initialized) {
+    config::applier::init(0, "broker_bench", 0);
+    initialized = true;
+  }
+}
+
+/**
+ *  Metrics are sent to a server behind a link limited to 20MB/s. The
+ *  argument is the compression of the request bodies.
+ */
+static void BM_http_tsdb_send(benchmark::State& state) {
+  constexpr unsigned nb_events = 100000;
+  init_broker();
+  auto compression =
+      static_cast<http_tsdb::http_tsdb_config::compression>(state.range(0));
+  stand_in_server server(20000, 100000);
+  http_client::http_config conf(
+      server.endpoint(), "localhost", false, std::chrono::seconds(10),
+      std::chrono::seconds(10), std::chrono::seconds(10), 30,
+      std::chrono::seconds(1), 100, std::chrono::seconds(1), 2);
+  auto str = std::make_shared<line_stream>(
+      std::make_shared<http_tsdb::http_tsdb_config>(conf, 10000, compression));
+
+  std::vector<std::shared_ptr<storage::pb_metric>> events;
+  events.reserve(nb_events);
+  for (unsigned i = 0; i < nb_events; ++i)
+    events.push_back(create_metric(i));
+
+  for (auto _ : state) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+    unsigned acknowledged = 0;
+    for (auto& evt : events)
+      acknowledged += str->write(evt);
+    while (acknowledged < nb_events &&
+           std::chrono::steady_clock::now() < deadline) {
+      acknowledged += str->flush();
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    if (acknowledged < nb_events) {
+      state.SkipWithError("events not acknowledged");
+      break;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * nb_events);
+  state.counters["bytes_sent"] = benchmark::Counter(
+      server.received_bytes, benchmark::Counter::kAvgIterations);
+  str->stop();
+}
+
+BENCHMARK(BM_http_tsdb_send)
+    ->ArgName("compression")
+    ->Arg(static_cast<int>(http_tsdb::http_tsdb_config::compression::none))
+    ->Arg(static_cast<int>(http_tsdb::http_tsdb_config::compression::gzip))
+    ->Arg(static_cast<int>(http_tsdb::http_tsdb_config::compression::zstd))
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
@@ -0,0 +1,99 @@
+/**
+ * Copyright 2023 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+#include <benchmark/benchmark.h>
+
+#include "com/centreon/broker/config/applier/init.hh"
+#include "com/centreon/broker/sql/mysql.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::database;
+
+static constexpr uint32_t services = 20000;
+
+static void init_broker() {
+  static bool initialized = false;
+  if (!initialized) {
+    config::applier::init(0, "broker_bench", 0);
+    initialized = true;
+  }
+}
+
+/**
+ *  The status of 20000 services is updated with the same statement, as the
+ *  unified_sql stream does it. The argument is the max_batch_rows of the
+ *  connection, 1 to execute the rows one by one. A MariaDB server must be
+ *  reachable as for the sql tests of ut_broker.
+ */
+static void BM_mysql_service_updates(benchmark::State& state) {
+  init_broker();
+  database_config db_cfg("MySQL", "127.0.0.1", MYSQL_SOCKET, 3306, "root",
+                         "centreon", "centreon_storage", 5, true, 5);
+  db_cfg.set_max_batch_rows(state.range(0));
+  mysql ms(db_cfg);
+  ms.run_query("DROP TABLE IF EXISTS ut_bench_services");
+  ms.commit();
+  ms.run_query(
+      "CREATE TABLE ut_bench_services (host_id INT UNSIGNED NOT NULL, "
+      "service_id INT UNSIGNED NOT NULL, state TINYINT, output VARCHAR(255), "
+      "perfdata VARCHAR(255) DEFAULT NULL, last_check BIGINT, PRIMARY KEY "
+      "(host_id, service_id))");
+  ms.commit();
+
+  mysql_stmt insert(ms.prepare_query(
+      "INSERT INTO ut_bench_services (host_id, service_id) VALUES (?,?)"));
+  for (uint32_t i = 0; i < services; i++) {
+    insert.bind_value_as_u32(0, 1 + i / 20);
+    insert.bind_value_as_u32(1, i);
+    ms.run_statement(insert);
+  }
+  ms.commit();
+
+  mysql_stmt update(ms.prepare_query(
+      "UPDATE ut_bench_services SET state=?, output=?, perfdata=?, "
+      "last_check=? WHERE host_id=? AND service_id=?"));
+  int64_t last_check = 0;
+  for (auto _ : state) {
+    ++last_check;
+    for (uint32_t i = 0; i < services; i++) {
+      update.bind_value_as_tiny(0, i % 4);
+      update.bind_value_as_str(1, fmt::format("service {} is fine", i));
+      if (i % 3)
+        update.bind_value_as_str(2, fmt::format("metric={};80;90", i % 100));
+      else
+        update.bind_null_str(2);
+      update.bind_value_as_i64(3, last_check);
+      update.bind_value_as_u32(4, 1 + i / 20);
+      update.bind_value_as_u32(5, i);
+      ms.run_statement(update);
+    }
+    ms.commit();
+  }
+  state.SetItemsProcessed(state.iterations() * services);
+
+  ms.run_query("DROP TABLE ut_bench_services");
+  ms.commit();
+}
+
+BENCHMARK(BM_mysql_service_updates)
+    ->ArgName("max_batch_rows")
+    ->Arg(1)
+    ->Arg(128)
+    ->Arg(4096)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
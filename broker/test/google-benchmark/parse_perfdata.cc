@@ -0,0 +1,56 @@
+/**
+ * Copyright 2023 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+#include <benchmark/benchmark.h>
+
+#include "com/centreon/broker/config/applier/init.hh"
+#include "misc/legacy_perfdata.hh"
+
+using namespace com::centreon::broker;
+
+static void init_broker() {
+  static bool initialized = false;
+  if (!initialized) {
+    config::applier::init(0, "broker_bench", 0);
+    initialized = true;
+  }
+}
+
+static void parse_samples(benchmark::State& state,
+                          std::vector<misc::perfdata> (*parse)(const char*)) {
+  init_broker();
+  auto real = legacy::samples();
+  size_t metrics = 0;
+  for (auto _ : state)
+    for (auto& s : real)
+      metrics += parse(s.c_str()).size();
+  state.SetItemsProcessed(metrics);
+}
+
+static void BM_parse_perfdata_legacy(benchmark::State& state) {
+  parse_samples(state, legacy::parse_perfdata);
+}
+
+static void BM_parse_perfdata(benchmark::State& state) {
+  parse_samples(state, [](const char* str) {
+    return misc::parse_perfdata(0, 0, str);
+  });
+}
+
+BENCHMARK(BM_parse_perfdata_legacy);
+BENCHMARK(BM_parse_perfdata);
@@ -0,0 +1,56 @@
+/**
+ * Copyright 2023 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+#include <benchmark/benchmark.h>
+
+#include "com/centreon/broker/config/applier/init.hh"
+#include "com/centreon/broker/time/timeperiod.hh"
+
+using namespace com::centreon::broker;
+
+static constexpr time_t day = 24 * 60 * 60;
+
+static void init_broker() {
+  static bool initialized = false;
+  if (!initialized) {
+    config::applier::init(0, "broker_bench", 0);
+    initialized = true;
+  }
+}
+
+/**
+ *  A week is checked minute by minute against a timeperiod. The argument is
+ *  the first day of the week relative to today: lookups before today are
+ *  computed, the following ones use the compiled segments.
+ */
+static void BM_timeperiod_is_valid(benchmark::State& state) {
+  init_broker();
+  std::string ranges{"00:00-03:00,08:00-12:00,13:30-18:00,22:00-24:00"};
+  time::timeperiod tp(1, "test", "alias", ranges, ranges, ranges, ranges,
+                      ranges, ranges, "");
+  tp.set_timezone("Europe/Paris");
+
+  time_t start = ::time(nullptr) + state.range(0) * day;
+  uint64_t lookups = 0;
+  for (auto _ : state)
+    for (time_t t = start; t < start + 7 * day; t += 60, ++lookups)
+      benchmark::DoNotOptimize(tp.is_valid(t));
+  state.SetItemsProcessed(lookups);
+}
+
+BENCHMARK(BM_timeperiod_is_valid)->ArgName("first_day")->Arg(-7)->Arg(0);
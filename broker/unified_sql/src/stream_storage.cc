@@ -150,11 +150,14 @@ void stream::_unified_sql_process_pb_service_status(
 
       /* Parse perfdata. */
       _finish_action(-1, actions::metrics);
-      std::list<misc::perfdata> pds{misc::parse_perfdata(
-          ss.host_id(), ss.service_id(), ss.perfdata().c_str())};
+      auto pds = s->parsed_perfdata().get(ss.host_id(), ss.service_id(),
+                                          ss.perfdata());
 
       std::deque<std::shared_ptr<io::data>> to_publish;
-      for (auto& pd : pds) {
+      for (const auto& pd : *pds) {
+        /* pd is shared with the other streams, the type found in the cache
+         * is kept here. */
+        int16_t value_type = pd.value_type();
         misc::read_lock rlck(_metric_cache_m);
         auto it_index_cache = _metric_cache.find({index_id, pd.name()});
 
@@ -182,7 +185,7 @@ void stream::_unified_sql_process_pb_service_status(
           _metrics_insert.bind_value_as_f32(10, pd.max());
           _metrics_insert.bind_value_as_f32(11, pd.value());
 
-          uint32_t type = pd.value_type();
+          uint32_t type = value_type;
           char t[2];
           t[0] = '0' + type;
           t[1] = 0;
@@ -243,8 +246,7 @@ void stream::_unified_sql_process_pb_service_status(
           else
             need_metric_mapping = false;
 
-          pd.value_type(static_cast<misc::perfdata::data_type>(
-              it_index_cache->second.type));
+          value_type = it_index_cache->second.type;
 
           SPDLOG_LOGGER_DEBUG(
               log_v2::perfdata(),
@@ -352,7 +354,7 @@ void stream::_unified_sql_process_pb_service_status(
           m.set_metric_id(metric_id);
           m.set_rrd_len(rrd_len);
           m.set_value(pd.value());
-          m.set_value_type(static_cast<Metric_ValueType>(pd.value_type()));
+          m.set_value_type(static_cast<Metric_ValueType>(value_type));
           m.set_name(pd.name());
           m.set_host_id(ss.host_id());
           m.set_service_id(ss.service_id());
@@ -520,11 +522,14 @@ void stream::_unified_sql_process_service_status(
 
       /* Parse perfdata. */
       _finish_action(-1, actions::metrics);
-      std::list<misc::perfdata> pds{misc::parse_perfdata(
-          ss.host_id, ss.service_id, ss.perf_data.c_str())};
+      auto pds =
+          ss.parsed_perf_data.get(ss.host_id, ss.service_id, ss.perf_data);
 
       std::deque<std::shared_ptr<io::data>> to_publish;
-      for (auto& pd : pds) {
+      for (const auto& pd : *pds) {
+        /* pd is shared with the other streams, the type found in the cache
+         * is kept here. */
+        int16_t value_type = pd.value_type();
         misc::read_lock rlck(_metric_cache_m);
         auto it_index_cache = _metric_cache.find({index_id, pd.name()});
 
@@ -552,7 +557,7 @@ void stream::_unified_sql_process_service_status(
           _metrics_insert.bind_value_as_f32(10, pd.max());
           _metrics_insert.bind_value_as_f32(11, pd.value());
 
-          uint32_t type = pd.value_type();
+          uint32_t type = value_type;
           char t[2];
           t[0] = '0' + type;
           t[1] = 0;
@@ -613,8 +618,7 @@ void stream::_unified_sql_process_service_status(
           else
             need_metric_mapping = false;
 
-          pd.value_type(static_cast<misc::perfdata::data_type>(
-              it_index_cache->second.type));
+          value_type = it_index_cache->second.type;
 
           SPDLOG_LOGGER_DEBUG(
               log_v2::perfdata(),
@@ -713,7 +717,7 @@ void stream::_unified_sql_process_service_status(
               ss.host_id, ss.service_id, pd.name(), ss.last_check,
               static_cast<uint32_t>(ss.check_interval * _interval_length),
               false, metric_id, rrd_len, pd.value(),
-              static_cast<misc::perfdata::data_type>(pd.value_type()))};
+              static_cast<misc::perfdata::data_type>(value_type))};
           SPDLOG_LOGGER_DEBUG(
               log_v2::perfdata(),
               "unified sql: generating perfdata event for metric {} "
@@ -214,7 +214,7 @@ TEST_F(UnifiedSqlParserParsePerfdata, Simple1) {
 
   // Assertions.
   ASSERT_EQ(lst.size(), 1u);
-  std::list<misc::perfdata>::const_iterator it(lst.begin());
+  std::vector<misc::perfdata>::const_iterator it(lst.begin());
   misc::perfdata expected;
   expected.name("time");
   expected.value_type(misc::perfdata::gauge);
@@ -234,7 +234,7 @@ TEST_F(UnifiedSqlParserParsePerfdata, Simple2) {
 
   // Assertions.
   ASSERT_EQ(list.size(), 1u);
-  std::list<misc::perfdata>::const_iterator it(list.begin());
+  std::vector<misc::perfdata>::const_iterator it(list.begin());
   misc::perfdata expected;
   expected.name("ABCD12E");
   expected.value_type(misc::perfdata::gauge);
@@ -258,7 +258,7 @@ TEST_F(UnifiedSqlParserParsePerfdata, Complex1) {
 
   // Assertions.
   ASSERT_EQ(list.size(), 7u);
-  std::list<misc::perfdata>::const_iterator it(list.begin());
+  std::vector<misc::perfdata>::const_iterator it(list.begin());
   misc::perfdata expected;
 
   // #1.
@@ -347,7 +347,7 @@ TEST_F(UnifiedSqlParserParsePerfdata, Complex1) {
 // When parse_perfdata() is called multiple time with valid strings
 // Then the corresponding perfdata list is returned
 TEST_F(UnifiedSqlParserParsePerfdata, Loop) {
-  std::list<misc::perfdata> list;
+  std::vector<misc::perfdata> list;
 
   // Loop.
   for (uint32_t i(0); i < 10000; ++i) {
@@ -357,7 +357,7 @@ TEST_F(UnifiedSqlParserParsePerfdata, Loop) {
 
     // Assertions.
     ASSERT_EQ(list.size(), 1u);
-    std::list<misc::perfdata>::const_iterator it(list.begin());
+    std::vector<misc::perfdata>::const_iterator it(list.begin());
     misc::perfdata expected;
     expected.name("time");
     expected.value_type(misc::perfdata::counter);
@@ -398,7 +398,7 @@ TEST_F(UnifiedSqlParserParsePerfdata, LabelWithSpaces) {
 
   // Assertions.
   ASSERT_EQ(lst.size(), 1u);
-  std::list<misc::perfdata>::const_iterator it(lst.begin());
+  std::vector<misc::perfdata>::const_iterator it(lst.begin());
   misc::perfdata expected;
   expected.name("foo  bar");
   expected.value_type(misc::perfdata::gauge);
@@ -416,7 +416,7 @@ TEST_F(UnifiedSqlParserParsePerfdata, LabelWithSpacesMultiline) {
 
   // Assertions.
   ASSERT_EQ(lst.size(), 1u);
-  std::list<misc::perfdata>::const_iterator it(lst.begin());
+  std::vector<misc::perfdata>::const_iterator it(lst.begin());
   misc::perfdata expected;
   expected.name("foo  bar");
   expected.value_type(misc::perfdata::gauge);
@@ -439,7 +439,7 @@ TEST_F(UnifiedSqlParserParsePerfdata, Complex2) {
 
   // Assertions.
   ASSERT_EQ(list.size(), 6u);
-  std::list<misc::perfdata>::const_iterator it(list.begin());
+  std::vector<misc::perfdata>::const_iterator it(list.begin());
   misc::perfdata expected;
 
   // #1.
@@ -520,7 +520,7 @@ TEST_F(UnifiedSqlParserParsePerfdata, SimpleWithR) {
 
   // Assertions.
   ASSERT_EQ(lst.size(), 1u);
-  std::list<misc::perfdata>::const_iterator it(lst.begin());
+  std::vector<misc::perfdata>::const_iterator it(lst.begin());
   misc::perfdata expected;
   expected.name("total");
   expected.value_type(misc::perfdata::gauge);
@@ -30,8 +30,6 @@ class database_config;
 namespace victoria_metrics {
 
 class stream : public http_tsdb::stream {
-  unsigned _body_size_to_reserve;
-
   http_tsdb::line_protocol_query _metric_formatter;
   http_tsdb::line_protocol_query _status_formatter;
 
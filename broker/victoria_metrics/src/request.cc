@@ -28,28 +28,26 @@ using namespace com::centreon::broker::victoria_metrics;
 /**
  * @brief a little filter use for string labels
  * it escape , ", space and \
+ * the result is appended to the body in order to avoid a temporary string
  *
  * @param to_filter
- * @return std::string result
+ * @param out string where to append the result
  */
 template <class string_class>
-static std::string string_filter(const string_class& to_filter) {
-  std::string ret;
-  ret.reserve(to_filter.length());
+static void append_filtered(const string_class& to_filter, std::string& out) {
   for (char c : to_filter) {
     if (c == ',') {
-      ret += "\\,";
+      out.append("\\,");
     } else if (c == '"') {
-      ret += "\\\"";
+      out.append("\\\"");
     } else if (c == ' ') {
-      ret += "\\ ";
+      out.append("\\ ");
     } else if (c == '\\') {
-      ret += "\\\\";
+      out.append("\\\\");
     } else {
-      ret.push_back(c);
+      out.push_back(c);
     }
   }
-  return ret;
 }
 
 request::request(boost::beast::http::verb method,
@@ -78,7 +76,8 @@ static constexpr std::string_view _sz_val = " val=";
 
 void request::add_metric(const storage::pb_metric& metric) {
   absl::StrAppend(&body(), _sz_metric, metric.obj().metric_id());
-  absl::StrAppend(&body(), _sz_name, string_filter(metric.obj().name()));
+  absl::StrAppend(&body(), _sz_name);
+  append_filtered(metric.obj().name(), body());
   absl::StrAppend(&body(), _sz_host_id, metric.obj().host_id(), _sz_serv_id,
                   metric.obj().service_id());
 
@@ -128,7 +127,8 @@ void request::append_metric_info(const Metric& metric) {
   const cache::metric_info* metric_inf =
       cache::global_cache::instance_ptr()->get_metric_info(metric.metric_id());
   if (metric_inf) {
-    absl::StrAppend(&body(), _sz_unit, string_filter(metric_inf->unit));
+    absl::StrAppend(&body(), _sz_unit);
+    append_filtered(metric_inf->unit, body());
     const cache::resource_info* res_info =
         cache::global_cache::instance_ptr()->get_service(metric.host_id(),
                                                          metric.service_id());
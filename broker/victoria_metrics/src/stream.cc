@@ -73,10 +73,11 @@ std::shared_ptr<stream> stream::load(
 }
 
 http_tsdb::request::pointer stream::create_request() const {
+  // body is reserved by new_request() if no buffer can be reused
   auto ret = std::make_shared<request>(
       boost::beast::http::verb::post, _conf->get_server_name(),
-      _conf->get_http_target(), _body_size_to_reserve, _metric_formatter,
-      _status_formatter, _authorization);
+      _conf->get_http_target(), 0, _metric_formatter, _status_formatter,
+      _authorization);
 
   ret->set(boost::beast::http::field::content_type, "text/plain");
   ret->set(boost::beast::http::field::accept, "application/json");
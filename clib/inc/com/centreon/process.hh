@@ -57,8 +57,9 @@ class process {
   pid_t _process;
 
   /* Almost never changed, we have two such functions, one with pgid and the
-   * other without. */
-  pid_t (*_create_process)(char* const*, char**);
+   * other without. The last argument gives the file descriptors to use as
+   * stdin, stdout and stderr of the child, -1 meaning /dev/null. */
+  pid_t (*_create_process)(char* const*, char**, const int*);
 
  public:
   enum status { normal = 0, crash = 1, timeout = 2 };
@@ -88,17 +89,17 @@ class process {
   timestamp _start_time;
 
   static void _close(int& fd) noexcept;
-  static pid_t _create_process_with_setpgid(char* const* args, char** env);
-  static pid_t _create_process_without_setpgid(char* const* args, char** env);
-  static void _dev_null(int fd, int flags);
-  static int _dup(int oldfd);
-  static void _dup2(int oldfd, int newfd);
+  static pid_t _create_process_with_setpgid(char* const* args,
+                                            char** env,
+                                            const int* fds);
+  static pid_t _create_process_without_setpgid(char* const* args,
+                                               char** env,
+                                               const int* fds);
   bool _is_running() const noexcept;
   void _kill(int sig);
   static void _pipe(int fds[2]);
   ssize_t do_read(int fd);
   void do_close(int fd);
-  static void _set_cloexec(int fd);
 
  public:
   process(process_listener* l = nullptr,
@@ -23,10 +23,10 @@
 #include <atomic>
 #include <condition_variable>
 #include <deque>
-#include <map>
 #include <mutex>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace com::centreon {
@@ -92,8 +92,26 @@ class process_listener;
  *  * _finished is a boolean telling when the destructor has been called. All
  *    the stuff needed to stop the loop are done in it, this is because the
  *    destructor may be called from another thread and we want to avoid mutexes.
+ *
+ *  Two backends are available for the main loop, chosen with set_backend()
+ *  before the first use of the manager:
+ *  * poll_backend, the historical one described above.
+ *  * epoll_backend, where streams are registered once in an epoll instance,
+ *    in edge-triggered mode. Each process is also watched through a pidfd,
+ *    so it is reaped as soon as it exits without any waitpid(-1) loop (if
+ *    pidfds are not available, we fall back to waitpid(-1) as in the poll
+ *    backend). add() wakes the loop with an eventfd and timeouts are checked
+ *    each second by a timerfd.
+ *
+ *  In both backends, timeouts are stored in a timing wheel of one second
+ *  slots, so adding, removing or expiring a timeout does not depend on the
+ *  number of running processes.
  */
 class process_manager {
+ public:
+  enum backend { poll_backend, epoll_backend };
+
+ private:
   struct orphan {
     orphan(pid_t _pid = 0, int _status = 0) : pid(_pid), status(_status) {}
     pid_t pid;
@@ -115,12 +133,28 @@ class process_manager {
 
   std::deque<orphan> _orphans_pid;
   std::unordered_map<pid_t, process*> _processes_pid;
+
+  /* Timing wheel of the processes timeouts, a process is in the slot
+   * _timeout % size(). Slots until _timeout_wheel_time are checked. */
   mutable std::mutex _timeout_m;
-  std::multimap<uint32_t, process*> _processes_timeout;
+  std::vector<std::unordered_set<process*>> _timeout_wheel;
+  std::time_t _timeout_wheel_time;
+  size_t _timeouts_count;
 
   mutable std::mutex _add_m;
   std::deque<std::pair<pid_t, process*>> _processes;
 
+  /* epoll backend. */
+  static backend _next_backend;
+  const backend _backend;
+  int _epoll_fd;
+  int _wake_fd;
+  int _timer_fd;
+  bool _timer_armed;
+  bool _use_pidfd;
+  std::unordered_map<int, pid_t> _pidfds;
+  std::deque<int> _ready_fds;
+
   process_manager();
   ~process_manager() noexcept;
   void _close_stream(int fd) noexcept;
@@ -128,6 +162,15 @@ class process_manager {
   void _kill_processes_timeout() noexcept;
   uint32_t _read_stream(int fd) noexcept;
   void _run();
+  void _run_poll();
+  void _run_epoll();
+  void _epoll_init();
+  void _epoll_register(int fd, uint32_t events) noexcept;
+  void _epoll_unregister(int fd) noexcept;
+  bool _epoll_read_stream(int fd) noexcept;
+  void _epoll_wait_process(int pidfd) noexcept;
+  void _arm_timer() noexcept;
+  void _wake() noexcept;
   void _update_ending_process(process* p, int status) noexcept;
   void _update_list();
   void _wait_orphans_pid() noexcept;
@@ -137,6 +180,8 @@ class process_manager {
  public:
   void add(process* p);
   static process_manager& instance();
+  static void set_backend(backend b) noexcept;
+  backend get_backend() const noexcept;
   process_manager& operator=(process_manager const& p) = delete;
   process_manager(process_manager const& p) = delete;
   void wait_for_update() const noexcept;
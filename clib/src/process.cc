@@ -41,9 +41,6 @@ using namespace com::centreon;
 // environ is not declared on *BSD.
 extern char** environ;
 
-// Global process lock.
-static std::mutex gl_process_lock;
-
 /**
  *  Default constructor.
  */
@@ -120,94 +117,43 @@ void process::exec(char const* cmd, char** env, uint32_t timeout) {
   for (int32_t i = 0; i < 3; ++i)
     _close(_stream[i]);
 
-  // Init file desciptor.
-  int std[3] = {-1, -1, -1};
+  /* Pipes are created with the close-on-exec flag, so processes spawned at
+   * the same time by other threads do not inherit them. Their child ends are
+   * only duplicated on the standard streams of the new process, the ones of
+   * this process are never touched, so several threads can exec() at the
+   * same time. */
   int pipe_stream[3][2] = {{-1, -1}, {-1, -1}, {-1, -1}};
 
-  // volatile prevent compiler optimization that might clobber variable.
-  volatile bool restore_std(false);
-
-  std::lock_guard<std::mutex> gl_lock(gl_process_lock);
   try {
-    // Create backup FDs.
-    std[0] = _dup(STDIN_FILENO);
-    std[1] = _dup(STDOUT_FILENO);
-    std[2] = _dup(STDERR_FILENO);
-
-    // Backup FDs do not need to be inherited.
     for (int32_t i = 0; i < 3; ++i)
-      _set_cloexec(std[i]);
-
-    restore_std = true;
-
-    // Create pipes if necessary and duplicate FDs.
-    if (!_enable_stream[in])
-      _dev_null(STDIN_FILENO, O_RDONLY);
-    else {
-      _pipe(pipe_stream[in]);
-      _dup2(pipe_stream[in][0], STDIN_FILENO);
-      _close(pipe_stream[in][0]);
-      _set_cloexec(pipe_stream[in][1]);
-    }
-
-    if (!_enable_stream[out])
-      _dev_null(STDOUT_FILENO, O_WRONLY);
-    else {
-      _pipe(pipe_stream[out]);
-      _dup2(pipe_stream[out][1], STDOUT_FILENO);
-      _close(pipe_stream[out][1]);
-      _set_cloexec(pipe_stream[out][0]);
-    }
-
-    if (!_enable_stream[err])
-      _dev_null(STDERR_FILENO, O_WRONLY);
-    else {
-      _pipe(pipe_stream[err]);
-      _dup2(pipe_stream[err][1], STDERR_FILENO);
-      _close(pipe_stream[err][1]);
-      _set_cloexec(pipe_stream[err][0]);
-    }
+      if (_enable_stream[i])
+        _pipe(pipe_stream[i]);
+    const int child_fds[3] = {pipe_stream[in][0], pipe_stream[out][1],
+                              pipe_stream[err][1]};
 
     // Parse and get command line arguments.
     misc::command_line cmdline(cmd);
     char* const* args = cmdline.get_argv();
 
-    // volatile prevent compiler optimization
-    // that might clobber variable.
-    char** volatile my_env(env ? env : environ);
-
     // Create new process.
-    _process = _create_process(args, my_env);
+    _process = _create_process(args, env ? env : environ, child_fds);
     assert(_process != -1);
 
     // Parent execution.
     _start_time = timestamp::now();
     _timeout = (timeout ? time(nullptr) + timeout : 0);
 
-    // Restore original FDs.
-    _dup2(std[0], STDIN_FILENO);
-    _dup2(std[1], STDOUT_FILENO);
-    _dup2(std[2], STDERR_FILENO);
     for (int32_t i = 0; i < 3; ++i) {
-      _close(std[i]);
-      //_close(pipe_stream[i][i == in ? 0 : 1]);
-      _stream[i] = pipe_stream[i][i == in ? 1 : 0];
+      _close(pipe_stream[i][i == in ? 0 : 1]);
+      std::swap(_stream[i], pipe_stream[i][i == in ? 1 : 0]);
     }
 
     // Add process to the process manager.
     lock.unlock();
     process_manager::instance().add(this);
   } catch (...) {
-    // Restore original FDs.
-    if (restore_std) {
-      _dup2(std[0], STDIN_FILENO);
-      _dup2(std[1], STDOUT_FILENO);
-      _dup2(std[2], STDERR_FILENO);
-    }
-
     // Close all file descriptor.
     for (uint32_t i = 0; i < 3; ++i) {
-      _close(std[i]);
       _close(_stream[i]);
       for (unsigned int j(0); j < 2; ++j)
         _close(pipe_stream[i][j]);
@@ -494,7 +440,57 @@ void process::_close(int& fd) noexcept {
   fd = -1;
 }
 
-pid_t process::_create_process_with_setpgid(char* const* args, char** env) {
+#ifdef HAVE_SPAWN_H
+/**
+ *  Initialize the spawn file actions giving to the child its standard
+ *  streams.
+ *
+ *  @param[out] actions The file actions to initialize.
+ *  @param[in]  fds     The stdin, stdout and stderr of the child, -1 to use
+ *                      /dev/null.
+ */
+static void init_stdio_actions(posix_spawn_file_actions_t* actions,
+                               const int* fds) {
+  int ret = posix_spawn_file_actions_init(actions);
+  if (ret)
+    throw basic_error() << "cannot initialize spawn file actions: "
+                        << strerror(ret);
+  for (int i = 0; i < 3; ++i) {
+    if (fds[i] >= 0)
+      ret = posix_spawn_file_actions_adddup2(actions, fds[i], i);
+    else
+      ret = posix_spawn_file_actions_addopen(
+          actions, i, "/dev/null", i == STDIN_FILENO ? O_RDONLY : O_WRONLY, 0);
+    if (ret) {
+      posix_spawn_file_actions_destroy(actions);
+      throw basic_error() << "cannot set spawn file actions: "
+                          << strerror(ret);
+    }
+  }
+}
+#else
+/**
+ *  Set the standard streams of the child, to call after the fork.
+ *
+ *  @param[in] fds  The stdin, stdout and stderr of the child, -1 to use
+ *                  /dev/null.
+ */
+static void set_child_stdio(const int* fds) {
+  for (int i = 0; i < 3; ++i) {
+    int fd = fds[i];
+    if (fd < 0)
+      fd = ::open("/dev/null", i == STDIN_FILENO ? O_RDONLY : O_WRONLY);
+    if (fd < 0 || ::dup2(fd, i) < 0)
+      ::_exit(EXIT_FAILURE);
+    if (fds[i] < 0 && fd != i)
+      ::close(fd);
+  }
+}
+#endif  // HAVE_SPAWN_H
+
+pid_t process::_create_process_with_setpgid(char* const* args,
+                                            char** env,
+                                            const int* fds) {
   pid_t pid(static_cast<pid_t>(-1));
 #ifdef HAVE_SPAWN_H
   posix_spawnattr_t attr;
@@ -514,13 +510,19 @@ pid_t process::_create_process_with_setpgid(char* const* args, char** env) {
         << "cannot set process group ID of to-be-spawned process: "
         << strerror(ret);
   }
-  if (posix_spawnp(&pid, args[0], NULL, &attr, args, env)) {
-    char const* msg(strerror(errno));
+  posix_spawn_file_actions_t actions;
+  try {
+    init_stdio_actions(&actions, fds);
+  } catch (...) {
     posix_spawnattr_destroy(&attr);
-    throw basic_error() << "could not create process '" << args[0]
-                        << "': " << msg;
+    throw;
   }
+  ret = posix_spawnp(&pid, args[0], &actions, &attr, args, env);
+  posix_spawn_file_actions_destroy(&actions);
   posix_spawnattr_destroy(&attr);
+  if (ret)
+    throw basic_error() << "could not create process '" << args[0]
+                        << "': " << strerror(ret);
 #else
   pid = fork();
   if (pid == static_cast<pid_t>(-1)) {
@@ -533,6 +535,7 @@ pid_t process::_create_process_with_setpgid(char* const* args, char** env) {
   if (!pid) {
     // Set process to its own group.
     ::setpgid(0, 0);
+    set_child_stdio(fds);
 
     ::execve(args[0], args, env);
     ::_exit(EXIT_FAILURE);
@@ -541,14 +544,18 @@ pid_t process::_create_process_with_setpgid(char* const* args, char** env) {
   return pid;
 }
 
-pid_t process::_create_process_without_setpgid(char* const* args, char** env) {
+pid_t process::_create_process_without_setpgid(char* const* args,
+                                               char** env,
+                                               const int* fds) {
   pid_t pid(static_cast<pid_t>(-1));
 #ifdef HAVE_SPAWN_H
-  if (posix_spawnp(&pid, args[0], NULL, NULL, args, env)) {
-    char const* msg(strerror(errno));
+  posix_spawn_file_actions_t actions;
+  init_stdio_actions(&actions, fds);
+  int ret = posix_spawnp(&pid, args[0], &actions, NULL, args, env);
+  posix_spawn_file_actions_destroy(&actions);
+  if (ret)
     throw basic_error() << "could not create process '" << args[0]
-                        << "': " << msg;
-  }
+                        << "': " << strerror(ret);
 #else
   pid = vfork();
   if (pid == static_cast<pid_t>(-1)) {
@@ -559,6 +566,7 @@ pid_t process::_create_process_without_setpgid(char* const* args, char** env) {
 
   // Child execution.
   if (!pid) {
+    set_child_stdio(fds);
     ::execve(args[0], args, env);
     ::_exit(EXIT_FAILURE);
   }
@@ -566,60 +574,6 @@ pid_t process::_create_process_without_setpgid(char* const* args, char** env) {
   return pid;
 }
 
-/**
- *  Open /dev/null and duplicate file descriptor.
- *
- *  @param[in] fd    Target FD.
- *  @param[in] flags Flags for open().
- */
-void process::_dev_null(int fd, int flags) {
-  int newfd(::open("/dev/null", flags));
-  if (newfd < 0) {
-    char const* msg(strerror(errno));
-    throw basic_error() << "could not open /dev/null: " << msg;
-  }
-  try {
-    _dup2(newfd, fd);
-  } catch (...) {
-    _close(newfd);
-    throw;
-  }
-  _close(newfd);
-}
-
-/**
- *  dup syscall wrapper.
- *
- *  @param[in] oldfd Old FD.
- *
- *  @return The new descriptor.
- */
-int process::_dup(int oldfd) {
-  int newfd;
-  while ((newfd = dup(oldfd)) < 0) {
-    if (errno == EINTR)
-      continue;
-    char const* msg(strerror(errno));
-    throw basic_error() << "could not duplicate FD: " << msg;
-  }
-  return newfd;
-}
-
-/**
- *  dup2 syscall wrapper.
- *
- *  @param[in] oldfd Old FD.
- *  @param[in] newfd New FD.
- */
-void process::_dup2(int oldfd, int newfd) {
-  while (dup2(oldfd, newfd) < 0) {
-    if (errno == EINTR)
-      continue;
-    char const* msg(strerror(errno));
-    throw basic_error() << "could not duplicate FD: " << msg;
-  }
-}
-
 /**
  *  kill syscall wrapper.
  *
@@ -636,23 +590,34 @@ void process::_kill(int sig) {
 }
 
 /**
- *  Open a pipe.
+ *  Open a pipe, both its ends are closed on exec.
  *
  *  @param[in] fds FD array.
  */
 void process::_pipe(int fds[2]) {
-  if (pipe(fds) != 0) {
+  if (pipe2(fds, O_CLOEXEC) != 0) {
     char const* msg(strerror(errno));
     throw basic_error() << "pipe creation failed: " << msg;
   }
 }
 
+/**
+ *  Read the given stream of the process and append its content to the
+ *  corresponding buffer. Called by the process manager.
+ *
+ *  @param[in] fd  The stream to read.
+ *
+ *  @return The number of bytes read, 0 if the stream is closed or -1 if it
+ *  is non blocking and empty.
+ */
 ssize_t process::do_read(int fd) {
   // Read content of the stream and push it.
   char buffer[4096];
   ssize_t size = ::read(fd, buffer, sizeof(buffer));
 
   if (size == -1) {
+    if (errno == EAGAIN || errno == EWOULDBLOCK)
+      return -1;
     char const* msg(strerror(errno));
     if (errno == EINTR)
       throw interruption_error() << msg;
@@ -687,27 +652,6 @@ ssize_t process::do_read(int fd) {
   return size;
 }
 
-/**
- *  Set the close-on-exec flag on the file descriptor.
- *
- *  @param[in] fd The file descriptor to set close on exec.
- */
-void process::_set_cloexec(int fd) {
-  int flags(0);
-  while ((flags = fcntl(fd, F_GETFD)) < 0) {
-    if (errno == EINTR)
-      continue;
-    char const* msg(strerror(errno));
-    throw basic_error() << "Could not get file descriptor flags: " << msg;
-  }
-  while (fcntl(fd, F_SETFD, flags | FD_CLOEXEC) < 0) {
-    if (errno == EINTR)
-      continue;
-    throw basic_error() << "Could not set close-on-exec flag: "
-                        << strerror(errno);
-  }
-}
-
 void process::set_timeout(bool timeout) {
   _is_timeout = timeout;
 }
@@ -17,8 +17,14 @@
 */
 
 #include "com/centreon/process_manager.hh"
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#include <sys/timerfd.h>
 #include <sys/wait.h>
 #include <unistd.h>
+#include <array>
 #include <algorithm>
 #include <cassert>
 #include <cerrno>
@@ -32,13 +38,50 @@ using namespace com::centreon;
 
 // Default varibale.
 static int const DEFAULT_TIMEOUT = 200;
+// Number of one second slots of the timeouts wheel.
+static size_t const TIMEOUT_WHEEL_SIZE = 512;
+// Maximum number of reads on a stream before giving the hand to others.
+static int const MAX_READS = 16;
+
+process_manager::backend process_manager::_next_backend =
+    process_manager::poll_backend;
+
+/**
+ *  pidfd_open syscall wrapper, the returned fd is closed on exec.
+ *
+ *  @param[in] pid  The pid of the process to watch.
+ *
+ *  @return The pidfd or -1 on error.
+ */
+static int open_pidfd(pid_t pid) {
+#ifdef SYS_pidfd_open
+  return syscall(SYS_pidfd_open, pid, 0);
+#else
+  (void)pid;
+  errno = ENOSYS;
+  return -1;
+#endif
+}
 
 /**
  *  Default constructor. It is private. No need to call, we just use the static
  *  internal function instance().
  */
 process_manager::process_manager()
-    : _update{true}, _running{false}, _finished{false} {
+    : _update{true},
+      _running{false},
+      _finished{false},
+      _timeout_wheel(TIMEOUT_WHEEL_SIZE),
+      _timeout_wheel_time{time(nullptr)},
+      _timeouts_count{0},
+      _backend{_next_backend},
+      _epoll_fd{-1},
+      _wake_fd{-1},
+      _timer_fd{-1},
+      _timer_armed{false},
+      _use_pidfd{false} {
+  if (_backend == epoll_backend)
+    _epoll_init();
   std::unique_lock<std::mutex> lck(_running_m);
   _thread = std::thread(&process_manager::_run, this);
   pthread_setname_np(_thread.native_handle(), "clib_prc_mgr");
@@ -69,8 +112,15 @@ process_manager::~process_manager() noexcept {
   _running = false;
   _finished = true;
   std::time(&_finished_time);
+  _wake();
   _thread.join();
 
+  for (auto& p : _pidfds)
+    ::close(p.first);
+  for (int fd : {_timer_fd, _wake_fd, _epoll_fd})
+    if (fd >= 0)
+      ::close(fd);
+
   // Waiting all process.
   int status = 0;
   auto time_limit = std::chrono::system_clock::now() + std::chrono::seconds(10);
@@ -96,6 +146,26 @@ void process_manager::add(process* p) {
     _processes.emplace_back(p->_process, p);
     _update = true;
   }
+  _wake();
+}
+
+/**
+ * @brief Choose the backend of the process manager. It must be called before
+ * the first use of the manager, it has no effect after.
+ *
+ * @param b The backend.
+ */
+void process_manager::set_backend(backend b) noexcept {
+  _next_backend = b;
+}
+
+/**
+ * @brief Accessor to the backend used by the process manager.
+ *
+ * @return poll_backend or epoll_backend.
+ */
+process_manager::backend process_manager::get_backend() const noexcept {
+  return _backend;
 }
 
 /**
@@ -127,14 +197,21 @@ void process_manager::_update_list() {
   {
     for (auto& p : my_processes) {
       // Monitor err/out output if necessary.
-      if (p.second->_enable_stream[process::out]) {
-        _processes_fd[p.second->_stream[process::out]] = p.second;
-      }
-      if (p.second->_enable_stream[process::err]) {
-        _processes_fd[p.second->_stream[process::err]] = p.second;
+      for (int s : {process::out, process::err}) {
+        if (p.second->_enable_stream[s]) {
+          int fd = p.second->_stream[s];
+          _processes_fd[fd] = p.second;
+          if (_backend == epoll_backend) {
+            /* Edge triggered, so fds are read until EAGAIN. */
+            fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+            _epoll_register(fd, EPOLLIN | EPOLLRDHUP | EPOLLET);
+          }
+        }
       }
     }
+  }
 
+  if (_backend == poll_backend) {
     if (_processes_fd.size() != _fds.size())
       _fds.resize(_processes_fd.size());
 
@@ -152,14 +229,34 @@ void process_manager::_update_list() {
     std::lock_guard<std::mutex> lock(_timeout_m);
     for (auto& p : my_processes) {
       // Add timeout to kill process if necessary.
-      if (p.second->_timeout)
-        _processes_timeout.insert({p.second->_timeout, p.second});
+      if (p.second->_timeout) {
+        /* An already expired timeout goes in the next checked slot. */
+        if (static_cast<std::time_t>(p.second->_timeout) <=
+            _timeout_wheel_time)
+          p.second->_timeout = _timeout_wheel_time + 1;
+        _timeout_wheel[p.second->_timeout % _timeout_wheel.size()].insert(
+            p.second);
+        ++_timeouts_count;
+      }
     }
   }
 
   // Add pid process to use waitpid.
-  for (auto& p : my_processes)
+  for (auto& p : my_processes) {
     _processes_pid[p.first] = p.second;
+    if (_use_pidfd) {
+      int pidfd = open_pidfd(p.first);
+      if (pidfd >= 0) {
+        _pidfds[pidfd] = p.first;
+        _epoll_register(pidfd, EPOLLIN);
+      } else {
+        log_error(logging::high)
+            << "cannot watch process " << p.first << " with a pidfd ("
+            << strerror(errno) << "), falling back to waitpid";
+        _use_pidfd = false;
+      }
+    }
+  }
 
   {
     // Notification for process::wait()
@@ -194,6 +291,8 @@ void process_manager::_close_stream(int fd) noexcept {
 
     process* p = it->second;
     _processes_fd.erase(it);
+    if (_backend == epoll_backend)
+      _epoll_unregister(fd);
 
     // Update process informations.
     p->do_close(fd);
@@ -212,13 +311,8 @@ void process_manager::_erase_timeout(process* p) {
   if (!p || !p->_timeout)
     return;
   std::lock_guard<std::mutex> lock(_timeout_m);
-  auto range = _processes_timeout.equal_range(p->_timeout);
-  for (auto it = range.first; it != range.second; ++it) {
-    if (it->second == p) {
-      _processes_timeout.erase(it);
-      break;
-    }
-  }
+  if (_timeout_wheel[p->_timeout % _timeout_wheel.size()].erase(p))
+    --_timeouts_count;
 }
 
 /**
@@ -228,18 +322,31 @@ void process_manager::_kill_processes_timeout() noexcept {
   std::lock_guard<std::mutex> lock(_timeout_m);
   // Get the current time.
   std::time_t now(time(nullptr));
+  if (now <= _timeout_wheel_time)
+    return;
 
-  // Kill process who timeout and remove it from timeout list.
-  for (auto it = _processes_timeout.begin(), end = _processes_timeout.end();
-       it != end && it->first <= now;) {
-    process* p = it->second;
-    try {
-      p->kill();
-    } catch (const std::exception& e) {
-      log_error(logging::high) << e.what();
+  // Check the slots of the elapsed seconds, at most one wheel turn.
+  std::time_t size = _timeout_wheel.size();
+  for (std::time_t t = std::max(_timeout_wheel_time + 1, now - size + 1);
+       t <= now && _timeouts_count; ++t) {
+    auto& slot = _timeout_wheel[t % size];
+    // Kill process who timeout and remove it from timeout list.
+    for (auto it = slot.begin(); it != slot.end();) {
+      process* p = *it;
+      if (static_cast<std::time_t>(p->_timeout) > now) {
+        ++it;
+        continue;
+      }
+      try {
+        p->kill();
+      } catch (const std::exception& e) {
+        log_error(logging::high) << e.what();
+      }
+      it = slot.erase(it);
+      --_timeouts_count;
     }
-    it = _processes_timeout.erase(it);
   }
+  _timeout_wheel_time = now;
 }
 
 /**
@@ -281,67 +388,298 @@ void process_manager::_run() {
     _running_cv.notify_all();
   }
   try {
-    for (;;) {
-      // Update the file descriptor list.
-      if (_update)
-        _update_list();
-      if (_finished)
-        _stop_processes();
-
-      if (!_running && _fds.size() == 0 && _processes_pid.size() == 0) {
-        if (_orphans_pid.size() == 0)
+    if (_backend == epoll_backend)
+      _run_epoll();
+    else
+      _run_poll();
+  } catch (const std::exception& e) {
+    log_error(logging::high) << e.what();
+  }
+}
+
+/**
+ *  Main loop of the poll backend.
+ */
+void process_manager::_run_poll() {
+  for (;;) {
+    // Update the file descriptor list.
+    if (_update)
+      _update_list();
+    if (_finished)
+      _stop_processes();
+
+    if (!_running && _fds.size() == 0 && _processes_pid.size() == 0) {
+      if (_orphans_pid.size() == 0)
+        break;
+      else {
+        /* After 20s with only orphans pid, we quit if asked. */
+        std::time_t now;
+        std::time(&now);
+        if (now - _finished_time > 20)
           break;
-        else {
-          /* After 20s with only orphans pid, we quit if asked. */
-          std::time_t now;
-          std::time(&now);
-          if (now - _finished_time > 20)
-            break;
-        }
       }
+    }
 
-      assert(_processes_fd.size() == _fds.size());
-      int ret = poll(_fds.data(), _fds.size(), DEFAULT_TIMEOUT);
-      if (ret < 0) {
-        if (errno == EINTR)
-          ret = 0;
-        else {
-          const char* msg = strerror(errno);
-          throw basic_error() << "poll failed: " << msg;
-        }
+    assert(_processes_fd.size() == _fds.size());
+    int ret = poll(_fds.data(), _fds.size(), DEFAULT_TIMEOUT);
+    if (ret < 0) {
+      if (errno == EINTR)
+        ret = 0;
+      else {
+        const char* msg = strerror(errno);
+        throw basic_error() << "poll failed: " << msg;
       }
-      for (uint32_t i = 0, checked = 0;
-           checked < static_cast<uint32_t>(ret) && i < _fds.size(); ++i) {
-        // No event.
-        if (!_fds[i].revents)
-          continue;
-
-        ++checked;
-
-        // Data are available.
-        uint32_t size = 0;
-        if (_fds[i].revents & (POLLIN | POLLPRI))
-          size = _read_stream(_fds[i].fd);
-        // File descriptor was close.
-        if ((_fds[i].revents & POLLHUP) && !size)
-          _close_stream(_fds[i].fd);
-
-        //  Error!
-        else if (_fds[i].revents & (POLLERR | POLLNVAL)) {
-          _update = true;
-          log_error(logging::high)
-              << "invalid fd " << _fds[i].fd << " from process manager";
-        }
+    }
+    for (uint32_t i = 0, checked = 0;
+         checked < static_cast<uint32_t>(ret) && i < _fds.size(); ++i) {
+      // No event.
+      if (!_fds[i].revents)
+        continue;
+
+      ++checked;
+
+      // Data are available.
+      uint32_t size = 0;
+      if (_fds[i].revents & (POLLIN | POLLPRI))
+        size = _read_stream(_fds[i].fd);
+      // File descriptor was close.
+      if ((_fds[i].revents & POLLHUP) && !size)
+        _close_stream(_fds[i].fd);
+
+      //  Error!
+      else if (_fds[i].revents & (POLLERR | POLLNVAL)) {
+        _update = true;
+        log_error(logging::high)
+            << "invalid fd " << _fds[i].fd << " from process manager";
+      }
+    }
+    // Release finished process.
+    _wait_processes();
+    _wait_orphans_pid();
+    // Kill process in timeout.
+    _kill_processes_timeout();
+  }
+}
+
+/**
+ *  Main loop of the epoll backend.
+ */
+void process_manager::_run_epoll() {
+  std::array<epoll_event, 64> events;
+  for (;;) {
+    // Update the file descriptor list.
+    if (_update)
+      _update_list();
+    if (_finished)
+      _stop_processes();
+
+    if (!_running && _processes_fd.empty() && _processes_pid.empty()) {
+      if (_orphans_pid.empty())
+        break;
+      else {
+        /* After 20s with only orphans pid, we quit if asked. */
+        std::time_t now;
+        std::time(&now);
+        if (now - _finished_time > 20)
+          break;
       }
-      // Release finished process.
+    }
+
+    _arm_timer();
+
+    /* Without pidfds, we have to call waitpid() regularly. */
+    int timeout = -1;
+    if (!_ready_fds.empty())
+      timeout = 0;
+    else if (!_use_pidfd || _finished)
+      timeout = DEFAULT_TIMEOUT;
+    int ret = epoll_wait(_epoll_fd, events.data(), events.size(), timeout);
+    if (ret < 0) {
+      if (errno == EINTR)
+        ret = 0;
+      else {
+        const char* msg = strerror(errno);
+        throw basic_error() << "epoll_wait failed: " << msg;
+      }
+    }
+    for (int i = 0; i < ret; ++i) {
+      int fd = events[i].data.fd;
+      uint64_t value;
+      if (fd == _wake_fd) {
+        while (::read(_wake_fd, &value, sizeof(value)) > 0)
+          ;
+      } else if (fd == _timer_fd) {
+        while (::read(_timer_fd, &value, sizeof(value)) > 0)
+          ;
+        _kill_processes_timeout();
+      } else if (_pidfds.find(fd) != _pidfds.end())
+        _epoll_wait_process(fd);
+      else
+        _ready_fds.push_back(fd);
+    }
+
+    /* Streams still having data after MAX_READS reads are put back at the
+     * end of the queue, so that a verbose process does not starve others. */
+    for (size_t i = _ready_fds.size(); i > 0; --i) {
+      int fd = _ready_fds.front();
+      _ready_fds.pop_front();
+      if (_epoll_read_stream(fd))
+        _ready_fds.push_back(fd);
+    }
+
+    // Release finished process.
+    if (!_use_pidfd) {
       _wait_processes();
       _wait_orphans_pid();
-      // Kill process in timeout.
-      _kill_processes_timeout();
     }
+  }
+}
+
+/**
+ *  Create the epoll instance, the eventfd used to wake up the loop and the
+ *  timerfd used for timeouts. Called from the constructor.
+ */
+void process_manager::_epoll_init() {
+  _epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+  if (_epoll_fd < 0) {
+    const char* msg = strerror(errno);
+    throw basic_error() << "could not create epoll instance: " << msg;
+  }
+  _wake_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  if (_wake_fd < 0) {
+    const char* msg = strerror(errno);
+    throw basic_error() << "could not create eventfd: " << msg;
+  }
+  _timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+  if (_timer_fd < 0) {
+    const char* msg = strerror(errno);
+    throw basic_error() << "could not create timerfd: " << msg;
+  }
+  _epoll_register(_wake_fd, EPOLLIN);
+  _epoll_register(_timer_fd, EPOLLIN);
+
+  /* pidfds are available since Linux 5.3. */
+  int pidfd = open_pidfd(getpid());
+  if (pidfd >= 0) {
+    _use_pidfd = true;
+    ::close(pidfd);
+  }
+}
+
+/**
+ *  Add a file descriptor to the epoll instance.
+ *
+ *  @param[in] fd      The file descriptor.
+ *  @param[in] events  The events to watch.
+ */
+void process_manager::_epoll_register(int fd, uint32_t events) noexcept {
+  epoll_event ev{};
+  ev.events = events;
+  ev.data.fd = fd;
+  if (epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, fd, &ev) < 0)
+    log_error(logging::high) << "could not add fd " << fd
+                             << " to the process manager: " << strerror(errno);
+}
+
+/**
+ *  Remove a file descriptor from the epoll instance.
+ *
+ *  @param[in] fd  The file descriptor.
+ */
+void process_manager::_epoll_unregister(int fd) noexcept {
+  epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+}
+
+/**
+ *  Read a stream until it is empty or closed, or until MAX_READS reads have
+ *  been done. Called from _run_epoll().
+ *
+ *  @param[in] fd  The file descriptor to read.
+ *
+ *  @return true if the stream may still contain data.
+ */
+bool process_manager::_epoll_read_stream(int fd) noexcept {
+  try {
+    /* The stream may have been closed since it was ready. */
+    auto it = _processes_fd.find(fd);
+    if (it == _processes_fd.end())
+      return false;
+    process* p = it->second;
+    for (int i = 0; i < MAX_READS; ++i) {
+      ssize_t size = p->do_read(fd);
+      // Nothing more to read.
+      if (size < 0)
+        return false;
+      // File descriptor was close.
+      if (size == 0) {
+        _close_stream(fd);
+        return false;
+      }
+    }
+    return true;
   } catch (const std::exception& e) {
     log_error(logging::high) << e.what();
   }
+  return false;
+}
+
+/**
+ *  Reap the process whose pidfd is readable. Called from _run_epoll().
+ *
+ *  @param[in] pidfd  The pidfd of the finished process.
+ */
+void process_manager::_epoll_wait_process(int pidfd) noexcept {
+  auto it = _pidfds.find(pidfd);
+  pid_t pid = it->second;
+  _pidfds.erase(it);
+  _epoll_unregister(pidfd);
+  ::close(pidfd);
+
+  int status = 0;
+  pid_t ret;
+  while ((ret = ::waitpid(pid, &status, WNOHANG)) < 0 && errno == EINTR)
+    ;
+  if (ret != pid)
+    return;
+
+  auto it_p = _processes_pid.find(pid);
+  if (it_p == _processes_pid.end())
+    return;
+  process* p = it_p->second;
+  _processes_pid.erase(it_p);
+
+  // Update process.
+  if (WIFSIGNALED(status) && WTERMSIG(status) == SIGKILL)
+    p->set_timeout(true);
+  _update_ending_process(p, status);
+}
+
+/**
+ *  Start the timeouts timer if there are timeouts, stop it otherwise.
+ */
+void process_manager::_arm_timer() noexcept {
+  bool armed = _timeouts_count > 0;
+  if (armed == _timer_armed)
+    return;
+  itimerspec spec{};
+  if (armed) {
+    /* Timeouts are in seconds, we check them four times per second. */
+    spec.it_value.tv_nsec = 250000000;
+    spec.it_interval.tv_nsec = 250000000;
+  }
+  if (timerfd_settime(_timer_fd, 0, &spec, nullptr) == 0)
+    _timer_armed = armed;
+}
+
+/**
+ *  Wake up the epoll loop. Does nothing with the poll backend.
+ */
+void process_manager::_wake() noexcept {
+  if (_wake_fd >= 0) {
+    uint64_t value = 1;
+    ssize_t ret = ::write(_wake_fd, &value, sizeof(value));
+    (void)ret;
+  }
 }
 
 /**
@@ -356,8 +694,10 @@ void process_manager::_update_ending_process(process* p, int status) noexcept {
   if (!p)
     return;
 
-  p->update_ending_process(status);
+  /* The timeout is removed first, the process may be destroyed as soon as
+   * it is notified. */
   _erase_timeout(p);
+  p->update_ending_process(status);
 }
 
 /**
@@ -398,7 +738,9 @@ void process_manager::_wait_processes() noexcept {
   try {
     for (;;) {
       int status = 0;
-      assert(_processes_fd.size() <= _fds.size());
+      // With the epoll backend, _fds is not used.
+      assert(_backend == epoll_backend ||
+             _processes_fd.size() <= _fds.size());
       pid_t pid(::waitpid(-1, &status, WNOHANG));
       // No process are finished.
       if (pid <= 0)
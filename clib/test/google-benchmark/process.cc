@@ -0,0 +1,63 @@
+/**
+ * Copyright 2023 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include "com/centreon/process.hh"
+#include "com/centreon/process_manager.hh"
+
+using namespace com::centreon;
+
+/**
+ * @brief Measures the spawns/s of threads launching processes at the same
+ * time. Only exec() calls are measured, processes are waited after.
+ */
+static void BM_spawn(benchmark::State& state) {
+  for (auto _ : state) {
+    process p(nullptr, false, true, false);
+    p.exec("./tests/bin_test_process_output check_stdout 0");
+    state.PauseTiming();
+    std::string output;
+    p.read(output);
+    if (!p.wait(5000) || output != "check_stdout\n")
+      state.SkipWithError("unexpected process output");
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_spawn)->Threads(1)->Threads(4)->Threads(16)->UseRealTime();
+
+int main(int argc, char* argv[]) {
+  // The benchmark can be run with the epoll backend of the process manager.
+  int j = 1;
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "--epoll"))
+      process_manager::set_backend(process_manager::epoll_backend);
+    else
+      argv[j++] = argv[i];
+  }
+  argc = j;
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    return 1;
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
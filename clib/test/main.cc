@@ -17,10 +17,19 @@
  *
  */
 #include <gtest/gtest.h>
+#include <cstring>
+#include "com/centreon/process_manager.hh"
+
+using namespace com::centreon;
 
 int main(int argc, char* argv[], char** env) {
   // GTest initialization.
   testing::InitGoogleTest(&argc, argv);
 
+  // Tests can be run with the epoll backend of the process manager.
+  for (int i = 1; i < argc; ++i)
+    if (!strcmp(argv[i], "--epoll"))
+      process_manager::set_backend(process_manager::epoll_backend);
+
   return RUN_ALL_TESTS();
 }
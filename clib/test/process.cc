@@ -362,3 +362,74 @@ TEST(ClibProcess, ProcessWaitTimeout) {
   ASSERT_FALSE(p.wait(500) == true);
   ASSERT_FALSE(p.wait(1500) == false);
 }
+
+/**
+ * @brief Processes launched at the same time by several threads each get
+ * their own output.
+ *
+ * @param ClibProcess
+ * @param ProcessStdoutMT
+ */
+TEST(ClibProcess, ProcessStdoutMT) {
+  constexpr int count = 16;
+  std::atomic_int sum{0};
+  std::vector<std::thread> v;
+  for (int i = 0; i < count; i++) {
+    v.emplace_back([&sum, i] {
+      for (int j = 0; j < 10; j++) {
+        process p(nullptr, false, true, false);
+        p.exec("./tests/bin_test_process_output check_return " +
+               std::to_string(i));
+        p.wait();
+        sum += p.exit_code() != i;
+
+        process q(nullptr, false, true, false);
+        q.exec("./tests/bin_test_process_output check_stdout 0");
+        std::string output;
+        q.read(output);
+        q.wait();
+        sum += output != "check_stdout\n";
+      }
+    });
+  }
+
+  for (auto& t : v)
+    t.join();
+
+  ASSERT_EQ(sum, 0);
+}
+
+/**
+ * @brief 1, 4 and 16 threads launch processes at the same time. Processes
+ * are waited after all of them are launched and all must give the expected
+ * output.
+ *
+ * @param ClibProcess
+ * @param ConcurrentSpawn
+ */
+TEST(ClibProcess, ConcurrentSpawn) {
+  constexpr int count = 48;
+  for (int launchers : {1, 4, 16}) {
+    std::vector<std::unique_ptr<process>> processes;
+    for (int i = 0; i < count; i++)
+      processes.emplace_back(
+          std::make_unique<process>(nullptr, false, true, false));
+    std::vector<std::thread> v;
+    for (int i = 0; i < launchers; i++) {
+      v.emplace_back([&processes, launchers, i] {
+        for (int j = i; j < count; j += launchers)
+          processes[j]->exec("./tests/bin_test_process_output check_stdout 0");
+      });
+    }
+    for (auto& t : v)
+      t.join();
+
+    int sum = 0;
+    for (auto& p : processes) {
+      std::string output;
+      p->read(output);
+      sum += !p->wait(5000) || output != "check_stdout\n";
+    }
+    ASSERT_EQ(sum, 0);
+  }
+}
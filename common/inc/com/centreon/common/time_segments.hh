@@ -0,0 +1,155 @@
+/**
+ * Copyright 2023 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CCCM_TIME_SEGMENTS_HH
+#define CCCM_TIME_SEGMENTS_HH
+
+#include <algorithm>
+#include <ctime>
+#include <functional>
+#include <iterator>
+#include <vector>
+
+namespace com::centreon::common {
+
+/**
+ * @brief Compiled form of a timeperiod lookup function (next valid time,
+ * next invalid time...) over a window of time.
+ *
+ * Timeperiod lookups only change of behaviour at some boundaries: midnights
+ * and time range limits. Between two boundaries, the result is either the
+ * looked up time itself (it is valid when looking for a valid time) or a
+ * constant (the start of the next valid range). compile() evaluates the
+ * lookup once per segment between boundaries, then lookup() is a binary
+ * search among the segments. Consecutive segments with the same result are
+ * merged, so for a next valid time lookup, the segments returning the time
+ * itself are the valid [start, end) intervals of the timeperiod.
+ */
+class time_segments {
+ public:
+  /* Value of a segment whose result is the looked up time itself. */
+  static constexpr time_t same_time = -2;
+  /* Returned by lookup() when the result is not known, the lookup must be
+   * computed directly. */
+  static constexpr time_t not_compiled = -3;
+
+ private:
+  struct segment {
+    time_t start;
+    time_t value;
+  };
+
+  time_t _start = not_compiled;
+  time_t _end = not_compiled;
+  std::vector<segment> _segments;
+
+  void _push(time_t start, time_t value) {
+    if (_segments.empty() || _segments.back().value != value)
+      _segments.push_back({start, value});
+  }
+
+ public:
+  /**
+   * @brief Compile a lookup function over the window [start, end).
+   *
+   * @param start Start of the window.
+   * @param end End of the window.
+   * @param boundaries Times where the result of the lookup may change
+   * behaviour, in any order. Those outside the window are ignored.
+   * @param lookup The function to compile, it returns not_compiled if its
+   * result on a segment is not known.
+   * @param monotonic True if the lookup returns the first time not before
+   * its argument matching a condition (a next valid time lookup for
+   * example), boundaries before a result are then not evaluated since they
+   * get the same result.
+   */
+  void compile(time_t start,
+               time_t end,
+               std::vector<time_t> boundaries,
+               const std::function<time_t(time_t)>& lookup,
+               bool monotonic) {
+    _start = start;
+    _end = end;
+    _segments.clear();
+    boundaries.push_back(start);
+    std::sort(boundaries.begin(), boundaries.end());
+    auto it = std::lower_bound(boundaries.begin(), boundaries.end(), start);
+    auto last = std::lower_bound(it, boundaries.end(), end);
+    while (it != last) {
+      time_t b = *it;
+      time_t r = lookup(b);
+      if (r == b)
+        _push(b, same_time);
+      else {
+        _push(b, r);
+        if (monotonic && r > b) {
+          it = std::lower_bound(it, last, r);
+          continue;
+        }
+      }
+      it = std::upper_bound(it, last, b);
+    }
+  }
+
+  /**
+   * @brief Reset the compiled segments.
+   */
+  void clear() {
+    _start = not_compiled;
+    _end = not_compiled;
+    _segments.clear();
+  }
+
+  /**
+   * @brief Check if the window of compiled segments contains a time.
+   *
+   * @param t A time.
+   *
+   * @return True if t is in [start, end).
+   */
+  bool contains(time_t t) const { return t >= _start && t < _end; }
+
+  /**
+   * @brief Start of the window of compiled segments.
+   *
+   * @return A time or not_compiled if nothing has been compiled.
+   */
+  time_t start() const { return _start; }
+
+  /**
+   * @brief Get the compiled result of a lookup.
+   *
+   * @param t The looked up time.
+   *
+   * @return The result or not_compiled if t is outside the window or the
+   * result is not known.
+   */
+  time_t lookup(time_t t) const {
+    if (!contains(t))
+      return not_compiled;
+    auto it = std::upper_bound(
+        _segments.begin(), _segments.end(), t,
+        [](time_t t, const segment& s) { return t < s.start; });
+    time_t value = std::prev(it)->value;
+    return value == same_time ? t : value;
+  }
+};
+
+}  // namespace com::centreon::common
+
+#endif  // !CCCM_TIME_SEGMENTS_HH
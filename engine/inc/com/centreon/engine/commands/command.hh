@@ -28,6 +28,9 @@ namespace com::centreon::engine {
 namespace commands {
 class command;
 }
+namespace macros {
+class command_template;
+}
 }
 
 typedef std::unordered_map<
@@ -54,6 +57,10 @@ class command {
   command_listener* _listener;
   std::string _name;
 
+  /* The command line parsed by process_cmd(). */
+  mutable std::mutex _template_m;
+  mutable std::shared_ptr<const macros::command_template> _template;
+
   /**
    * @brief the goal of this structure is to ensure that checks shared by
    * anomalydetection and service are not called to often
@@ -92,6 +92,7 @@ class object {
     }
   };
 
+  static void _add_warning();
   bool _set_name(std::string const& value);
   bool _set_should_register(bool value);
   bool _set_templates(std::string const& value);
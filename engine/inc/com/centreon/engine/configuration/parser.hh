@@ -62,13 +62,24 @@ class parser {
     read_all = (~0)
   };
 
-  parser(unsigned int read_options = read_all);
+  parser(unsigned int read_options = read_all, unsigned int threads = 0);
   ~parser() throw();
   void parse(std::string const& path, state& config);
 
  private:
   typedef void (parser::*store)(object_ptr obj);
 
+  /**
+   *  Objects read from an object definitions file, with the line where each
+   *  one is defined. If the file is invalid, error is the exception to throw
+   *  once the objects defined before the invalid line are merged.
+   */
+  struct file_objects {
+    std::string path;
+    std::list<std::pair<object_ptr, unsigned int>> objects;
+    std::exception_ptr error;
+  };
+
   parser(parser const& right);
   parser& operator=(parser const& right);
   void _add_object(object_ptr obj);
@@ -91,9 +102,12 @@ class parser {
   template <typename T>
   static void _insert(map_object const& from, std::set<T>& to);
   std::string const& _map_object_type(map_object const& objects) const throw();
-  void _parse_directory_configuration(std::string const& path);
+  void _list_directory_configuration(std::string const& path,
+                                     std::list<std::string>& files) const;
+  void _merge_object_definitions(file_objects& file);
   void _parse_global_configuration(std::string const& path);
-  void _parse_object_definitions(std::string const& path);
+  void _parse_object_definitions(file_objects& file) const;
+  void _parse_object_files(std::vector<file_objects>& files) const;
   void _parse_resource_file(std::string const& path);
   void _resolve_template();
   void _store_into_list(object_ptr obj);
@@ -109,6 +123,7 @@ class parser {
   unsigned int _read_options;
   static store _store[];
   std::array<map_object, 19> _templates;
+  unsigned int _threads;
 };
 }  // namespace configuration
 
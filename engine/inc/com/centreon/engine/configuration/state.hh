@@ -432,6 +432,10 @@ class state {
   void log_level_process(std::string const& value);
   std::string const& log_level_runtime() const noexcept;
   void log_level_runtime(std::string const& value);
+  bool use_binary_retention_format() const noexcept;
+  void use_binary_retention_format(bool value);
+  bool use_epoll_process_manager() const noexcept;
+  void use_epoll_process_manager(bool value);
   std::string const& use_timezone() const noexcept;
   void use_timezone(std::string const& value);
   bool use_true_regexp_matching() const noexcept;
@@ -660,6 +664,8 @@ class state {
   std::string _log_level_macros;
   std::string _log_level_process;
   std::string _log_level_runtime;
+  bool _use_binary_retention_format;
+  bool _use_epoll_process_manager;
   std::string _use_timezone;
   bool _use_true_regexp_matching;
 
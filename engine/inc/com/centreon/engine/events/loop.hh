@@ -22,10 +22,7 @@
 #ifndef CCE_EVENTS_LOOP_HH
 #define CCE_EVENTS_LOOP_HH
 
-#include "com/centreon/engine/events/timed_event.hh"
-
-using timed_event_list =
-    std::deque<std::unique_ptr<com::centreon::engine::timed_event>>;
+#include "com/centreon/engine/events/timed_event_queue.hh"
 
 namespace com::centreon::engine {
 
@@ -45,8 +42,8 @@ class loop {
   bool _reload_running;
   timed_event _sleep_event;
 
-  timed_event_list _event_list_high;
-  timed_event_list _event_list_low;
+  timed_event_queue _event_list_high;
+  timed_event_queue _event_list_low;
 
   loop();
   loop(const loop&) = delete;
@@ -65,19 +62,9 @@ class loop {
   void compensate_for_system_time_change(unsigned long last_time,
                                          unsigned long current_time);
   void remove_downtime(uint64_t downtime_id);
-  void remove_event(timed_event_list::iterator& it, priority priority);
   void remove_event(timed_event* evt, loop::priority priority);
   void remove_events(priority, uint32_t event_type, void* data) noexcept;
-  timed_event_list::iterator find_event(priority priority,
-                                        uint32_t event_type,
-                                        void* data);
-  const timed_event_list::const_iterator list_end(
-      priority priority) const noexcept {
-    if (priority == low)
-      return _event_list_low.end();
-    else
-      return _event_list_high.end();
-  }
+  timed_event* find_event(priority priority, uint32_t event_type, void* data);
 
   void reschedule_event(std::unique_ptr<timed_event>&& event,
                         priority priority);
@@ -28,10 +28,17 @@
 
 namespace com::centreon::engine {
 class timed_event;
+namespace events {
+class timed_event_queue;
+}
 }
 
 namespace com::centreon::engine {
 class timed_event {
+  /* Position and insertion number of the event in its timed_event_queue. */
+  size_t _queue_pos;
+  uint64_t _queue_seq;
+
   void _exec_event_service_check();
   void _exec_event_command_check();
   void _exec_event_log_rotation();
@@ -103,6 +110,8 @@ class timed_event {
   int handle_timed_event();
 
   std::string const& name() const noexcept;
+
+  friend class events::timed_event_queue;
 };
 }
 
@@ -0,0 +1,91 @@
+/**
+ * Copyright 2023 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+#ifndef CCE_EVENTS_TIMED_EVENT_QUEUE_HH
+#define CCE_EVENTS_TIMED_EVENT_QUEUE_HH
+
+#include <absl/container/flat_hash_map.h>
+#include <absl/container/inlined_vector.h>
+
+#include "com/centreon/engine/events/timed_event.hh"
+
+namespace com::centreon::engine::events {
+/**
+ *  @class timed_event_queue timed_event_queue.hh
+ *  @brief Priority queue of timed events ordered by their run time.
+ *
+ *  It is a binary min-heap, each event knows its position in it, so that it
+ *  can be removed or rescheduled in O(log n). Events with the same run time
+ *  are returned in their insertion order. Events are also indexed by their
+ *  type and data to find them in O(1).
+ *
+ *  The run_time of a queued event must not be modified without calling
+ *  update() or rebuild() just after.
+ */
+class timed_event_queue {
+  using key = std::pair<uint32_t, const void*>;
+
+  std::vector<std::unique_ptr<timed_event>> _heap;
+  absl::flat_hash_map<key, absl::InlinedVector<timed_event*, 1>> _index;
+  uint64_t _next_seq;
+
+  void _place(size_t pos, std::unique_ptr<timed_event>&& evt) noexcept;
+  void _sift_up(size_t pos) noexcept;
+  void _sift_down(size_t pos) noexcept;
+  bool _contains(const timed_event* evt) const noexcept;
+  void _unindex(const timed_event* evt);
+
+ public:
+  using const_iterator =
+      std::vector<std::unique_ptr<timed_event>>::const_iterator;
+
+  /**
+   *  Order of the events in the queue: by run time and then by insertion.
+   */
+  static bool before(const timed_event& a, const timed_event& b) noexcept {
+    return a.run_time < b.run_time ||
+           (a.run_time == b.run_time && a._queue_seq < b._queue_seq);
+  }
+
+  timed_event_queue() : _next_seq{0} {}
+  timed_event_queue(const timed_event_queue&) = delete;
+  timed_event_queue& operator=(const timed_event_queue&) = delete;
+
+  bool empty() const noexcept { return _heap.empty(); }
+  size_t size() const noexcept { return _heap.size(); }
+  /**
+   *  The next event to run. The queue must not be empty.
+   */
+  timed_event* front() const noexcept { return _heap.front().get(); }
+  /**
+   *  Iterators on all the events, they are not ordered.
+   */
+  const_iterator begin() const noexcept { return _heap.begin(); }
+  const_iterator end() const noexcept { return _heap.end(); }
+
+  void clear();
+  void push(std::unique_ptr<timed_event>&& evt);
+  std::unique_ptr<timed_event> pop();
+  std::unique_ptr<timed_event> remove(timed_event* evt);
+  void remove(uint32_t event_type, const void* data);
+  timed_event* find(uint32_t event_type, const void* data) const;
+  void update(timed_event* evt);
+  void rebuild();
+};
+}  // namespace com::centreon::engine::events
+
+#endif  // !CCE_EVENTS_TIMED_EVENT_QUEUE_HH
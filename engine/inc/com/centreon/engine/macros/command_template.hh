@@ -0,0 +1,99 @@
+/**
+ * Copyright 2023 Centreon
+ *
+ * This file is part of Centreon Engine.
+ *
+ * Centreon Engine is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * Centreon Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Centreon Engine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CCE_MACROS_COMMAND_TEMPLATE_HH
+#define CCE_MACROS_COMMAND_TEMPLATE_HH
+
+#include "com/centreon/engine/macros/defines.hh"
+
+namespace com::centreon::engine {
+
+namespace macros {
+/**
+ *  @class command_template command_template.hh
+ *  @brief Command line parsed once for macro processing.
+ *
+ *  process_macros_r() looks for the '$' of the command line and searches
+ *  each macro by name among all the known macros, at each call. A
+ *  command_template does this work once: the command line is split into
+ *  literal segments and macros, X macros are resolved to their id, $ARGn$
+ *  and $USERn$ to their index, user macros to their value and on-demand
+ *  host and service macros to their object. expand() then gives the same
+ *  result as process_macros_r() without any name lookup.
+ *
+ *  Resolved values and objects may change at reload, so every template is
+ *  obsoleted by invalidate().
+ */
+class command_template {
+  enum class segment_type {
+    literal,
+    macrox,
+    host_macrox,
+    service_macrox,
+    argv,
+    user,
+    value,
+    custom,
+    generic
+  };
+
+  struct segment {
+    segment_type type;
+    /* X macro id, $ARGn$ or $USERn$ index. */
+    unsigned int index = 0;
+    /* Literal text, value or name of the macro. */
+    std::string text;
+    std::string arg1;
+    std::string arg2;
+    host* hst = nullptr;
+    service* svc = nullptr;
+  };
+
+  static std::atomic<uint32_t> _current_generation;
+
+  const std::string _command_line;
+  const uint32_t _generation;
+  std::vector<segment> _segments;
+  mutable std::atomic<size_t> _size_hint;
+
+  void _add_literal(std::string& literal);
+  void _add_macro(const std::string& token);
+
+ public:
+  explicit command_template(const std::string& command_line);
+  ~command_template() noexcept = default;
+  command_template(const command_template&) = delete;
+  command_template& operator=(const command_template&) = delete;
+  const std::string& get_command_line() const noexcept {
+    return _command_line;
+  }
+  bool is_obsolete() const noexcept {
+    return _generation != _current_generation;
+  }
+  void expand(nagios_macros* mac, std::string& output, int options) const;
+
+  static std::shared_ptr<const command_template> get(
+      const std::string& command_line);
+  static void invalidate();
+};
+}  // namespace macros
+
+}  // namespace com::centreon::engine
+
+#endif  // !CCE_MACROS_COMMAND_TEMPLATE_HH
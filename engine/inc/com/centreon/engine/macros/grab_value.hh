@@ -38,6 +38,9 @@ int grab_macrox_value_r(nagios_macros* mac,
                         std::string const& arg2,
                         std::string& output,
                         int* free_macro);
+int grab_macrox_clean_options(int macro_type);
+bool grab_macrox_is_host(int macro_type);
+bool grab_macrox_is_service(int macro_type);
 
 #ifdef __cplusplus
 }
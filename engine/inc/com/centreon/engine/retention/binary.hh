@@ -0,0 +1,101 @@
+/**
+ * Copyright 2023 Centreon
+ *
+ * This file is part of Centreon Engine.
+ *
+ * Centreon Engine is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * Centreon Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Centreon Engine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CCE_RETENTION_BINARY_HH
+#define CCE_RETENTION_BINARY_HH
+
+#include "com/centreon/engine/retention/object.hh"
+
+namespace com::centreon::engine {
+
+namespace retention {
+/**
+ *  Binary retention file format.
+ *
+ *  The file contains the records of the text format, split into sections
+ *  of at most records_per_section records, so that sections are decoded in
+ *  parallel. Keys are replaced by indexes in a per section dictionary and
+ *  values are kept NUL terminated, so that they are given to the retention
+ *  objects setters without any copy.
+ *
+ *    file       := magic version:u32 section* table trailer
+ *    section    := dictionary record*
+ *    dictionary := count:varint string*
+ *    record     := type:varint count:varint (key:varint value:string)*
+ *    string     := size:varint bytes '\0'
+ *    table      := (offset:u64 size:u64 records:u32)*
+ *    trailer    := table_offset:u64 count:u32
+ *
+ *  Integers are little endian, varints are LEB128 encoded. type and key are
+ *  indexes in the dictionary of the section.
+ */
+namespace binary {
+constexpr char magic[8] = {'C', 'C', 'E', 'R', 'E', 'T', 'B', '\n'};
+constexpr uint32_t version = 1;
+constexpr uint32_t records_per_section = 4096;
+
+/**
+ *  @class encoder binary.hh
+ *  @brief Encode text retention records in the binary format.
+ */
+class encoder {
+  struct section {
+    uint64_t offset;
+    uint64_t size;
+    uint32_t records;
+  };
+
+  std::ostream& _os;
+  uint64_t _offset;
+  std::vector<section> _sections;
+
+  /* Current section. */
+  std::unordered_map<std::string, uint32_t> _keys;
+  std::string _dictionary;
+  std::string _records;
+  uint32_t _records_count;
+
+  /* Current record. */
+  bool _in_record;
+  uint32_t _type;
+  uint32_t _fields_count;
+  std::string _fields;
+
+  uint32_t _key(std::string const& key);
+  void _end_record();
+  void _end_section();
+  void _write(std::string const& data);
+
+ public:
+  explicit encoder(std::ostream& os);
+  ~encoder() noexcept = default;
+  encoder(encoder const&) = delete;
+  encoder& operator=(encoder const&) = delete;
+  void add(std::string const& text);
+  uint64_t finish();
+};
+
+bool is_binary(std::string const& content) noexcept;
+std::vector<std::vector<object_ptr>> decode(std::string const& content);
+}  // namespace binary
+}  // namespace retention
+
+}  // namespace com::centreon::engine
+
+#endif  // !CCE_RETENTION_BINARY_HH
@@ -22,6 +22,7 @@
 
 #include "com/centreon/engine/customvariable.hh"
 #include "com/centreon/engine/notification.hh"
+#include "com/centreon/engine/retention/snapshot.hh"
 
 // Forward declaration.
 
@@ -41,9 +42,13 @@ namespace dump {
 std::ostream& comment(std::ostream& os, comment const& obj);
 std::ostream& comments(std::ostream& os);
 std::ostream& contact(std::ostream& os, contact const& obj);
+std::ostream& contact(std::ostream& os, snapshot::contact_data const& obj);
 std::ostream& contacts(std::ostream& os);
 std::ostream& customvariables(std::ostream& os,
                               com::centreon::engine::map_customvar const& obj);
+std::ostream& customvariables(
+    std::ostream& os,
+    std::vector<snapshot::customvariable_data> const& obj);
 std::ostream& notifications(
     std::ostream& os,
     std::array<std::unique_ptr<com::centreon::engine::notification>, 6> const&
@@ -53,20 +58,25 @@ std::ostream& scheduled_downtime(std::ostream& os,
 std::ostream& downtimes(std::ostream& os);
 std::ostream& header(std::ostream& os);
 std::ostream& host(std::ostream& os, com::centreon::engine::host const& obj);
+std::ostream& host(std::ostream& os, snapshot::host_data const& obj);
 std::ostream& hosts(std::ostream& os);
 std::ostream& info(std::ostream& os);
 std::ostream& program(std::ostream& os);
 bool save(std::string const& path);
+bool write(std::string const& path, snapshot const& snap, size_t& size);
 std::ostream& service(std::ostream& os,
                       const std::string_view& class_name,
-                      com::centreon::engine::service const& obj);
+                      snapshot::service_data const& obj);
 
 std::ostream& service(std::ostream& os,
                       com::centreon::engine::service const& obj);
+std::ostream& service(std::ostream& os, snapshot::service_data const& obj);
 
 std::ostream& anomalydetection(
     std::ostream& os,
     com::centreon::engine::anomalydetection const& obj);
+std::ostream& anomalydetection(std::ostream& os,
+                               snapshot::service_data const& obj);
 std::ostream& services(std::ostream& os);
 }  // namespace dump
 }  // namespace retention
@@ -0,0 +1,81 @@
+/**
+ * Copyright 2023 Centreon
+ *
+ * This file is part of Centreon Engine.
+ *
+ * Centreon Engine is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * Centreon Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Centreon Engine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CCE_RETENTION_DUMPER_HH
+#define CCE_RETENTION_DUMPER_HH
+
+#include "com/centreon/engine/retention/snapshot.hh"
+
+namespace com::centreon::engine {
+
+namespace retention {
+/**
+ *  @class dumper dumper.hh
+ *  @brief Write retention snapshots from a background thread.
+ *
+ *  The event loop only takes the snapshot, the dumper thread formats it and
+ *  writes it. If a new snapshot is saved while the previous one is still
+ *  waiting to be written, only the new one is written.
+ *
+ *  When the dumper is not initialized (tests, verify config), snapshots are
+ *  written synchronously by save().
+ */
+class dumper {
+  static dumper* _instance;
+
+  /* Durations in milliseconds of the last dump, and size in bytes of the
+   * last written file. */
+  static std::atomic<uint64_t> _snapshot_duration;
+  static std::atomic<uint64_t> _write_duration;
+  static std::atomic<uint64_t> _size;
+
+  std::mutex _m;
+  std::condition_variable _cv;
+  std::string _path;
+  std::unique_ptr<snapshot> _pending;
+  bool _writing;
+  bool _exit;
+  std::thread _thread;
+
+  dumper();
+  ~dumper() noexcept;
+  void _run();
+  static bool _write(std::string const& path, snapshot const& snap);
+
+ public:
+  dumper(dumper const&) = delete;
+  dumper& operator=(dumper const&) = delete;
+
+  static void init();
+  static void deinit();
+  static bool save(std::string const& path, std::unique_ptr<snapshot> snap);
+  static void wait();
+
+  static void set_snapshot_duration(uint64_t duration) noexcept {
+    _snapshot_duration = duration;
+  }
+  static uint64_t snapshot_duration() noexcept { return _snapshot_duration; }
+  static uint64_t write_duration() noexcept { return _write_duration; }
+  static uint64_t size() noexcept { return _size; }
+};
+}  // namespace retention
+
+}  // namespace com::centreon::engine
+
+#endif  // !CCE_RETENTION_DUMPER_HH
@@ -36,6 +36,8 @@ class parser {
  private:
   typedef void (parser::*store)(state&, object_ptr obj);
 
+  void _parse_binary(std::istream& stream, state& retention);
+
   template <typename T, typename T2, T& (state::*ptr)() noexcept>
   void _store_into_list(state& retention, object_ptr obj) noexcept;
   template <typename T, T& (state::*ptr)() noexcept>
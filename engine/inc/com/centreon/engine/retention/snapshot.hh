@@ -0,0 +1,187 @@
+/**
+ * Copyright 2023 Centreon
+ *
+ * This file is part of Centreon Engine.
+ *
+ * Centreon Engine is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * Centreon Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Centreon Engine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CCE_RETENTION_SNAPSHOT_HH
+#define CCE_RETENTION_SNAPSHOT_HH
+
+#include "com/centreon/engine/common.hh"
+
+namespace com::centreon::engine {
+class anomalydetection;
+class contact;
+class host;
+class notifier;
+class service;
+
+namespace retention {
+namespace binary {
+class encoder;
+}
+
+/**
+ *  @class snapshot snapshot.hh
+ *  @brief Copy of the retained fields of the engine objects.
+ *
+ *  A snapshot is taken on the event loop thread and does not reference any
+ *  engine object, so the retention file can be formatted and written from
+ *  another thread while checks go on. Fields keep the values returned by the
+ *  engine getters, enumerations being stored as the integers they are
+ *  dumped as, so that a snapshot is dumped exactly as its object would be.
+ *
+ *  Comments, downtimes, notifications and the program section are small
+ *  and directly copied as text.
+ *
+ *  The output format, text or binary, is chosen when the snapshot is taken.
+ */
+class snapshot {
+ public:
+  struct customvariable_data {
+    std::string name;
+    bool modified;
+    std::string value;
+  };
+
+  /* Fields shared by hosts and services. */
+  struct notifier_data {
+    int acknowledgement;
+    bool active_checks_enabled;
+    std::string check_command;
+    double execution_time;
+    double latency;
+    int check_options;
+    std::string check_period;
+    int check_type;
+    int current_attempt;
+    unsigned long current_event_id;
+    uint64_t current_notification_id;
+    int notification_number;
+    unsigned long current_problem_id;
+    int current_state;
+    std::string event_handler;
+    bool event_handler_enabled;
+    bool flap_detection_enabled;
+    bool has_been_checked;
+    bool is_flapping;
+    time_t last_acknowledgement;
+    time_t last_check;
+    unsigned long last_event_id;
+    int last_hard_state;
+    time_t last_hard_state_change;
+    time_t last_notification;
+    unsigned long last_problem_id;
+    int last_state;
+    time_t last_state_change;
+    std::string long_plugin_output;
+    int max_attempts;
+    unsigned long modified_attributes;
+    time_t next_check;
+    uint32_t check_interval;
+    std::string notification_period;
+    bool notifications_enabled;
+    bool obsess_over;
+    bool passive_checks_enabled;
+    double percent_state_change;
+    std::string perf_data;
+    std::string plugin_output;
+    bool problem_has_been_acknowledged;
+    double retry_interval;
+    int state_type;
+    /* Oldest entry first. */
+    std::array<int, MAX_STATE_HISTORY_ENTRIES> state_history;
+    std::string notifications;
+    std::vector<customvariable_data> custom_variables;
+
+    explicit notifier_data(notifier const& obj);
+  };
+
+  struct host_data : notifier_data {
+    std::string name;
+    uint64_t host_id;
+    time_t last_time_down;
+    time_t last_time_unreachable;
+    time_t last_time_up;
+    bool notified_on_down;
+    bool notified_on_unreachable;
+    bool process_performance_data;
+
+    explicit host_data(com::centreon::engine::host const& obj);
+  };
+
+  struct service_data : notifier_data {
+    std::string host_name;
+    std::string description;
+    uint64_t host_id;
+    uint64_t service_id;
+    bool check_flapping_recovery_notification;
+    time_t last_time_critical;
+    time_t last_time_ok;
+    time_t last_time_unknown;
+    time_t last_time_warning;
+    bool notified_on_critical;
+    bool notified_on_unknown;
+    bool notified_on_warning;
+    int process_performance_data;
+    bool is_anomalydetection;
+    double sensitivity;
+
+    explicit service_data(com::centreon::engine::service const& obj);
+  };
+
+  struct contact_data {
+    std::string name;
+    std::string host_notification_period;
+    bool host_notifications_enabled;
+    time_t last_host_notification;
+    time_t last_service_notification;
+    unsigned long modified_attributes;
+    unsigned long modified_host_attributes;
+    unsigned long modified_service_attributes;
+    std::string service_notification_period;
+    bool service_notifications_enabled;
+    std::vector<customvariable_data> custom_variables;
+
+    explicit contact_data(com::centreon::engine::contact const& obj);
+  };
+
+ private:
+  bool _binary;
+  std::string _info;
+  std::string _program;
+  std::vector<host_data> _hosts;
+  std::vector<service_data> _services;
+  std::vector<contact_data> _contacts;
+  std::string _comments;
+  std::string _downtimes;
+
+ public:
+  snapshot();
+  ~snapshot() noexcept = default;
+  snapshot(snapshot const&) = delete;
+  snapshot& operator=(snapshot const&) = delete;
+  bool binary() const noexcept { return _binary; }
+  std::ostream& write(std::ostream& os) const;
+  void write(binary::encoder& enc) const;
+  size_t hosts_count() const noexcept { return _hosts.size(); }
+  size_t services_count() const noexcept { return _services.size(); }
+};
+}  // namespace retention
+
+}  // namespace com::centreon::engine
+
+#endif  // !CCE_RETENTION_SNAPSHOT_HH
@@ -20,6 +20,7 @@
 #ifndef CCE_OBJECTS_TIMEPERIOD_HH
 #define CCE_OBJECTS_TIMEPERIOD_HH
 
+#include "com/centreon/common/time_segments.hh"
 #include "com/centreon/engine/daterange.hh"
 
 /* Forward declaration. */
@@ -53,6 +54,7 @@ class timeperiod {
                                             bool notif_timeperiod);
 
   void resolve(int& w, int& e);
+  static void invalidate_compiled();
 
   bool operator==(timeperiod const& obj) throw();
   bool operator!=(timeperiod const& obj) throw();
@@ -62,10 +64,38 @@ class timeperiod {
 
   static timeperiod_map timeperiods;
 
+  /* Lookups use the compiled segments, they can be disabled to compare them
+   * with the direct computation. */
+  static bool use_compiled;
+
  private:
+  /* Lookups compiled for a timezone over the days [start, start + 8). */
+  struct compiled {
+    uint64_t generation = 0;
+    time_t start = -1;
+    time_t next_day = -1;
+    com::centreon::common::time_segments valid;
+    com::centreon::common::time_segments invalid;
+  };
+
   std::string _name;
   std::string _alias;
   timeperiodexclusion _exclusions;
+
+  /* Compiled lookups per timezone, indexed by notif_timeperiod. */
+  std::array<std::unordered_map<std::string, compiled>, 2> _compiled;
+
+  /* Incremented each time the timeperiods are resolved, compiled lookups of
+   * older generations are recompiled. */
+  static uint64_t _generation;
+
+  time_t _next_valid_time(time_t preferred_time, bool notif_timeperiod);
+  time_t _next_invalid_time(time_t preferred_time, bool notif_timeperiod);
+  compiled* _get_compiled(bool notif_timeperiod);
+  bool _add_boundaries(time_t start,
+                       time_t end,
+                       std::vector<time_t>& boundaries,
+                       std::unordered_set<const timeperiod*>& path) const;
 };
 
 }
@@ -190,6 +190,10 @@ int external_commands_last_1min = 0;
 int external_commands_last_5min = 0;
 int external_commands_last_15min = 0;
 
+unsigned long retention_snapshot_duration = 0;
+unsigned long retention_write_duration = 0;
+unsigned long retention_dump_size = 0;
+
 int total_external_command_buffer_slots = 0;
 int used_external_command_buffer_slots = 0;
 int high_external_command_buffer_slots = 0;
@@ -515,6 +519,12 @@ int display_stats() {
          external_commands_last_1min, external_commands_last_5min,
          external_commands_last_15min);
   printf("\n");
+  printf("Retention Snapshot/Write Time:          %.3f / %.3f sec\n",
+         retention_snapshot_duration / 1000.0,
+         retention_write_duration / 1000.0);
+  printf("Retention File Size:                    %lu bytes\n",
+         retention_dump_size);
+  printf("\n");
   printf("\n");
 
   /*
@@ -1046,6 +1056,13 @@ int read_status_file() {
               serial_host_checks_last_5min = atoi(temp_ptr);
             if ((temp_ptr = strtok(NULL, ",")))
               serial_host_checks_last_15min = atoi(temp_ptr);
+          } else if (!strcmp(var, "retention_dump_stats")) {
+            if ((temp_ptr = strtok(val, ",")))
+              retention_snapshot_duration = strtoul(temp_ptr, NULL, 10);
+            if ((temp_ptr = strtok(NULL, ",")))
+              retention_write_duration = strtoul(temp_ptr, NULL, 10);
+            if ((temp_ptr = strtok(NULL, ",")))
+              retention_dump_size = strtoul(temp_ptr, NULL, 10);
           }
           break;
 
@@ -1226,6 +1243,13 @@ int read_stats_file() {
         serial_host_checks_last_5min = atoi(temp_ptr);
       if ((temp_ptr = strtok(NULL, ",")))
         serial_host_checks_last_15min = atoi(temp_ptr);
+    } else if (!strcmp(var, "retention_dump_stats")) {
+      if ((temp_ptr = strtok(val, ",")))
+        retention_snapshot_duration = strtoul(temp_ptr, NULL, 10);
+      if ((temp_ptr = strtok(NULL, ",")))
+        retention_write_duration = strtoul(temp_ptr, NULL, 10);
+      if ((temp_ptr = strtok(NULL, ",")))
+        retention_dump_size = strtoul(temp_ptr, NULL, 10);
     }
 
     /***** HOST INFO *****/
@@ -24,6 +24,7 @@
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/log_v2.hh"
 #include "com/centreon/engine/logging/logger.hh"
+#include "com/centreon/engine/macros/command_template.hh"
 #include "com/centreon/engine/macros/grab.hh"
 
 using namespace com::centreon;
@@ -134,8 +135,19 @@ void commands::command::set_listener(
  *  @return The processed command line.
  */
 std::string commands::command::process_cmd(nagios_macros* macros) const {
+  std::shared_ptr<const macros::command_template> tmpl;
+  {
+    std::lock_guard<std::mutex> lck(_template_m);
+    const std::string& command_line = this->get_command_line();
+    if (!_template || _template->is_obsolete() ||
+        _template->get_command_line() != command_line)
+      _template =
+          std::make_shared<const macros::command_template>(command_line);
+    tmpl = _template;
+  }
+
   std::string command_line;
-  process_macros_r(macros, this->get_command_line(), command_line, 0);
+  tmpl->expand(macros, command_line, 0);
   return command_line;
 }
 
@@ -26,6 +26,7 @@
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/retention/applier/state.hh"
 #include "com/centreon/engine/retention/dump.hh"
+#include "com/centreon/engine/retention/dumper.hh"
 #include "com/centreon/engine/retention/parser.hh"
 #include "com/centreon/engine/retention/state.hh"
 
@@ -904,6 +905,8 @@ bool processing::is_thread_safe(char const* cmd) {
 
 void processing::_wrapper_read_state_information() {
   try {
+    // A retention dump may still be written.
+    retention::dumper::wait();
     retention::state state;
     retention::parser p;
     p.parse(config->state_retention_file(), state);
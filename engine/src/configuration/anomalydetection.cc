@@ -29,7 +29,6 @@
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/string.hh"
 
-extern int config_warnings;
 extern int config_errors;
 
 using namespace com::centreon;
@@ -1772,7 +1771,7 @@ bool anomalydetection::_set_failure_prediction_enabled(bool value) {
   log_v2::config()->warn(
       "Warning: anomalydetection failure_prediction_enabled is deprecated. "
       "This option will not be supported in 20.04.");
-  ++config_warnings;
+  _add_warning();
   return true;
 }
 
@@ -1792,7 +1791,7 @@ bool anomalydetection::_set_failure_prediction_options(
   log_v2::config()->warn(
       "Warning: anomalydetection failure_prediction_options is deprecated. "
       "This option will not be supported in 20.04.");
-  ++config_warnings;
+  _add_warning();
   return true;
 }
 
@@ -2098,7 +2097,7 @@ bool anomalydetection::_set_parallelize_check(bool value) {
   log_v2::config()->warn(
       "Warning: anomalydetection parallelize_check is deprecated This option "
       "will not be supported in 20.04.");
-  ++config_warnings;
+  _add_warning();
   return true;
 }
 
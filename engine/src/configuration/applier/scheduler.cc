@@ -78,9 +78,7 @@ void applier::scheduler::apply(
     host_map::const_iterator hst(hosts.find(it->host_name().c_str()));
     if (hst != hosts.end()) {
       bool has_event(events::loop::instance().find_event(
-                         events::loop::low, timed_event::EVENT_HOST_CHECK,
-                         hst->second.get()) !=
-                     events::loop::instance().list_end(events::loop::low));
+          events::loop::low, timed_event::EVENT_HOST_CHECK, hst->second.get()));
       bool should_schedule(it->checks_active() && it->check_interval() > 0);
       if (has_event && should_schedule) {
         hst_to_unschedule.insert(*it);
@@ -100,9 +98,8 @@ void applier::scheduler::apply(
         {it->host_id(), it->service_id()}));
     if (svc != services.end()) {
       bool has_event(events::loop::instance().find_event(
-                         events::loop::low, timed_event::EVENT_SERVICE_CHECK,
-                         svc->second.get()) !=
-                     events::loop::instance().list_end(events::loop::low));
+          events::loop::low, timed_event::EVENT_SERVICE_CHECK,
+          svc->second.get()));
       bool should_schedule(it->checks_active() && (it->check_interval() > 0));
       if (has_event && should_schedule) {
         svc_to_unschedule.insert(*it);
@@ -124,9 +121,8 @@ void applier::scheduler::apply(
         {it->host_id(), it->service_id()}));
     if (svc != services.end()) {
       bool has_event(events::loop::instance().find_event(
-                         events::loop::low, timed_event::EVENT_SERVICE_CHECK,
-                         svc->second.get()) !=
-                     events::loop::instance().list_end(events::loop::low));
+          events::loop::low, timed_event::EVENT_SERVICE_CHECK,
+          svc->second.get()));
       bool should_schedule(it->checks_active() && (it->check_interval() > 0));
       if (has_event && should_schedule) {
         ad_to_unschedule.insert(*it);
@@ -50,12 +50,14 @@
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/logging.hh"
 #include "com/centreon/engine/logging/logger.hh"
+#include "com/centreon/engine/macros/command_template.hh"
 #include "com/centreon/engine/objects.hh"
 #include "com/centreon/engine/retention/applier/state.hh"
 #include "com/centreon/engine/retention/state.hh"
 #include "com/centreon/engine/version.hh"
 #include "com/centreon/engine/xpddefault.hh"
 #include "com/centreon/engine/xsddefault.hh"
+#include "com/centreon/process_manager.hh"
 
 using namespace com::centreon;
 using namespace com::centreon::engine;
@@ -167,6 +169,7 @@ void applier::state::clear() {
   applier::macros::instance().clear();
   applier::globals::instance().clear();
   applier::logging::instance().clear();
+  engine::macros::command_template::invalidate();
 
   _processing_state = state_ready;
   _config = nullptr;
@@ -282,6 +285,14 @@ void applier::state::_apply(configuration::state const& new_cfg) {
       log_v2::config()->warn("Warning: Timezone can not be changed");
       ++config_warnings;
     }
+    if (config->use_epoll_process_manager() !=
+        new_cfg.use_epoll_process_manager()) {
+      engine_logger(log_config_warning, basic)
+          << "Warning: Process manager backend cannot be changed";
+      log_v2::config()->warn(
+          "Warning: Process manager backend cannot be changed");
+      ++config_warnings;
+    }
   }
 
   // Initialize perfdata if necessary.
@@ -458,6 +469,7 @@ void applier::state::_apply(configuration::state const& new_cfg) {
   config->log_level_downtimes(new_cfg.log_level_downtimes());
   config->log_level_comments(new_cfg.log_level_comments());
   config->log_level_macros(new_cfg.log_level_macros());
+  config->use_binary_retention_format(new_cfg.use_binary_retention_format());
   config->use_true_regexp_matching(new_cfg.use_true_regexp_matching());
   config->user(new_cfg.user());
 
@@ -469,6 +481,11 @@ void applier::state::_apply(configuration::state const& new_cfg) {
     config->external_command_buffer_slots(
         new_cfg.external_command_buffer_slots());
     config->use_timezone(new_cfg.use_timezone());
+    config->use_epoll_process_manager(new_cfg.use_epoll_process_manager());
+    /* Must be done before the first process is executed. */
+    process_manager::set_backend(config->use_epoll_process_manager()
+                                     ? process_manager::epoll_backend
+                                     : process_manager::poll_backend);
   }
 
   // Initialize.
@@ -1331,6 +1348,10 @@ void applier::state::_processing(configuration::state& new_cfg,
     // Apply macros configurations.
     applier::macros::instance().apply(new_cfg);
 
+    // Parsed command lines point to user macros and objects that are
+    // reloaded.
+    engine::macros::command_template::invalidate();
+
     // Timing.
     gettimeofday(tv + 2, nullptr);
 
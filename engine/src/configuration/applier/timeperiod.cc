@@ -155,6 +155,9 @@ void applier::timeperiod::modify_object(configuration::timeperiod const& obj) {
     _add_exclusions(obj.exclude(), tp);
   }
 
+  // Compiled lookups are obsolete.
+  engine::timeperiod::invalidate_compiled();
+
   // Notify event broker.
   timeval tv(get_broker_timestamp(nullptr));
   broker_adaptive_timeperiod_data(NEBTYPE_TIMEPERIOD_UPDATE, NEBFLAG_NONE,
@@ -28,7 +28,6 @@
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/string.hh"
 
-extern int config_warnings;
 extern int config_errors;
 
 using namespace com::centreon;
@@ -1294,7 +1293,7 @@ bool host::_set_failure_prediction_enabled(bool value) {
   log_v2::config()->warn(
       "Warning: host failure_prediction_enabled is deprecated This option will "
       "not be supported in 20.04.");
-  ++config_warnings;
+  _add_warning();
   return true;
 }
 
@@ -1313,7 +1312,7 @@ bool host::_set_failure_prediction_options(std::string const& value) {
   log_v2::config()->warn(
       "Warning: service failure_prediction_options is deprecated This option "
       "will not be supported in 20.04.");
-  ++config_warnings;
+  _add_warning();
   return (true);
 }
 
@@ -39,6 +39,8 @@
 #include "com/centreon/engine/exceptions/error.hh"
 #include "com/centreon/engine/string.hh"
 
+extern int config_warnings;
+
 using namespace com::centreon;
 using namespace com::centreon::engine::configuration;
 
@@ -272,6 +274,16 @@ std::string const& object::type_name() const noexcept {
   return tab[_type];
 }
 
+/**
+ *  Count a configuration warning. Objects may be parsed from several
+ *  threads, so the global counter is protected.
+ */
+void object::_add_warning() {
+  static std::mutex m;
+  std::lock_guard<std::mutex> lck(m);
+  ++config_warnings;
+}
+
 /**
  *  Set name value.
  *
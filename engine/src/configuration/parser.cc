@@ -18,6 +18,8 @@
 */
 
 #include "com/centreon/engine/configuration/parser.hh"
+#include <future>
+#include <thread>
 #include "com/centreon/engine/exceptions/error.hh"
 #include "com/centreon/engine/log_v2.hh"
 #include "com/centreon/engine/string.hh"
@@ -52,9 +54,14 @@ parser::store parser::_store[] = {
  *
  *  @param[in] read_options Configuration file reading options
  *             (use to skip some object type).
+ *  @param[in] threads      Maximum number of threads used to parse object
+ *             definitions files, 0 to use one thread per core.
  */
-parser::parser(unsigned int read_options)
-    : _config(NULL), _read_options(read_options) {}
+parser::parser(unsigned int read_options, unsigned int threads)
+    : _config(NULL),
+      _read_options(read_options),
+      _threads(threads ? threads
+                       : std::max(1u, std::thread::hardware_concurrency())) {}
 
 /**
  *  Destructor.
@@ -73,12 +80,35 @@ void parser::parse(std::string const& path, state& config) {
   // parse the global configuration file.
   _parse_global_configuration(path);
 
-  // parse configuration files.
-  _apply(config.cfg_file(), &parser::_parse_object_definitions);
+  // Object definition files are parsed in parallel. They are then merged
+  // in the order of a sequential parsing: configuration files, resource
+  // files and configuration directories, so that the result and the
+  // reported error are the same.
+  std::list<std::string> paths(config.cfg_file());
+  std::exception_ptr dir_error;
+  try {
+    for (std::string const& dir : config.cfg_dir())
+      _list_directory_configuration(dir, paths);
+  } catch (...) {
+    dir_error = std::current_exception();
+  }
+  std::vector<file_objects> files(paths.size());
+  std::list<std::string>::const_iterator it_path(paths.begin());
+  for (file_objects& file : files)
+    file.path = *it_path++;
+  _parse_object_files(files);
+
+  // merge configuration files.
+  size_t cfg_files(config.cfg_file().size());
+  for (size_t i = 0; i < cfg_files; ++i)
+    _merge_object_definitions(files[i]);
   // parse resource files.
   _apply(config.resource_file(), &parser::_parse_resource_file);
-  // parse configuration directories.
-  _apply(config.cfg_dir(), &parser::_parse_directory_configuration);
+  // merge configuration directories.
+  for (size_t i = cfg_files; i < files.size(); ++i)
+    _merge_object_definitions(files[i]);
+  if (dir_error)
+    std::rethrow_exception(dir_error);
 
   // Apply template.
   _resolve_template();
@@ -346,16 +376,39 @@ std::string const& parser::_map_object_type(map_object const& objects) const
 }
 
 /**
- *  Parse the directory configuration.
+ *  List the object definitions files of a directory configuration.
  *
- *  @param[in] path The directory path.
+ *  @param[in]     path  The directory path.
+ *  @param[in,out] files The list to fill.
  */
-void parser::_parse_directory_configuration(std::string const& path) {
+void parser::_list_directory_configuration(
+    std::string const& path,
+    std::list<std::string>& files) const {
   directory_entry dir(path);
   std::list<file_entry> const& lst(dir.entry_list("*.cfg"));
   for (std::list<file_entry>::const_iterator it(lst.begin()), end(lst.end());
        it != end; ++it)
-    _parse_object_definitions(it->path());
+    files.push_back(it->path());
+}
+
+/**
+ *  Merge the objects of an object definitions file, as if they were parsed
+ *  now, and throw its parsing error if any.
+ *
+ *  @param[in,out] file The parsed file.
+ */
+void parser::_merge_object_definitions(file_objects& file) {
+  for (std::pair<object_ptr, unsigned int> const& p : file.objects) {
+    object_ptr const& obj(p.first);
+    _objects_info[obj.get()] = file_info(file.path, p.second);
+    if (!obj->name().empty())
+      _add_template(obj);
+    if (obj->should_register())
+      _add_object(obj);
+  }
+  file.objects.clear();
+  if (file.error)
+    std::rethrow_exception(file.error);
 }
 
 /**
@@ -392,32 +445,32 @@ void parser::_parse_global_configuration(std::string const& path) {
 }
 
 /**
- *  Parse the object definition file.
+ *  Parse the object definition file. Only the file is read, so that several
+ *  files can be parsed at the same time.
  *
- *  @param[in] path The object definitions path.
+ *  @param[in,out] file The file to parse, its objects are filled.
  */
-void parser::_parse_object_definitions(std::string const& path) {
+void parser::_parse_object_definitions(file_objects& file) const {
   engine_logger(logging::log_info_message, logging::basic)
-      << "Processing object config file '" << path << "'";
-  log_v2::config()->info("Processing object config file '{}'", path);
+      << "Processing object config file '" << file.path << "'";
+  log_v2::config()->info("Processing object config file '{}'", file.path);
 
-  std::ifstream stream(path, std::ios::binary);
+  std::ifstream stream(file.path, std::ios::binary);
   if (!stream.is_open())
     throw engine_error() << "Parsing of object definition failed: "
-                         << "Can't open file '" << path << "'";
-
-  _current_line = 0;
-  _current_path = path;
+                         << "Can't open file '" << file.path << "'";
 
+  unsigned int current_line = 0;
+  unsigned int object_line = 0;
   bool parse_object = false;
   object_ptr obj;
   std::string input;
-  while (string::get_next_line(stream, input, _current_line)) {
+  while (string::get_next_line(stream, input, current_line)) {
     // Multi-line.
     while ('\\' == input[input.size() - 1]) {
       input.resize(input.size() - 1);
       std::string addendum;
-      if (!string::get_next_line(stream, addendum, _current_line))
+      if (!string::get_next_line(stream, addendum, current_line))
         break;
       input.append(addendum);
     }
@@ -427,24 +480,24 @@ void parser::_parse_object_definitions(std::string const& path) {
       if (input.find("define") || !std::isspace(input[6]))
         throw engine_error()
             << "Parsing of object definition failed "
-            << "in file '" << _current_path << "' on line " << _current_line
+            << "in file '" << file.path << "' on line " << current_line
             << ": Unexpected start definition";
       string::trim_left(input.erase(0, 6));
       std::size_t last(input.size() - 1);
       if (input.empty() || input[last] != '{')
         throw engine_error()
             << "Parsing of object definition failed "
-            << "in file '" << _current_path << "' on line " << _current_line
+            << "in file '" << file.path << "' on line " << current_line
             << ": Unexpected start definition";
       std::string const& type(string::trim_right(input.erase(last)));
       obj = object::create(type);
       if (obj == nullptr)
         throw engine_error()
             << "Parsing of object definition failed "
-            << "in file '" << _current_path << "' on line " << _current_line
+            << "in file '" << file.path << "' on line " << current_line
             << ": Unknown object type name '" << type << "'";
       parse_object = (_read_options & (1 << obj->type()));
-      _objects_info[obj.get()] = file_info(path, _current_line);
+      object_line = current_line;
     }
     // Check if is the not the end of the current object.
     else if (input != "}") {
@@ -452,23 +505,46 @@ void parser::_parse_object_definitions(std::string const& path) {
         if (!obj->parse(input))
           throw engine_error()
               << "Parsing of object definition "
-              << "failed in file '" << _current_path << "' on line "
-              << _current_line << ": Invalid line '" << input << "'";
+              << "failed in file '" << file.path << "' on line "
+              << current_line << ": Invalid line '" << input << "'";
       }
     }
     // End of the current object.
     else {
-      if (parse_object) {
-        if (!obj->name().empty())
-          _add_template(obj);
-        if (obj->should_register())
-          _add_object(obj);
-      }
+      if (parse_object)
+        file.objects.emplace_back(std::move(obj), object_line);
       obj.reset();
     }
   }
 }
 
+/**
+ *  Parse object definitions files on a pool of threads. A file parsing
+ *  error is kept in the file, to be thrown when it is merged.
+ *
+ *  @param[in,out] files The files to parse.
+ */
+void parser::_parse_object_files(std::vector<file_objects>& files) const {
+  std::atomic<size_t> next{0};
+  auto worker = [this, &files, &next] {
+    for (size_t i = next++; i < files.size(); i = next++) {
+      try {
+        _parse_object_definitions(files[i]);
+      } catch (...) {
+        files[i].error = std::current_exception();
+      }
+    }
+  };
+
+  size_t threads(std::min<size_t>(_threads, files.size()));
+  std::vector<std::future<void>> futures;
+  for (size_t i = 1; i < threads; ++i)
+    futures.push_back(std::async(std::launch::async, worker));
+  worker();
+  for (std::future<void>& f : futures)
+    f.get();
+}
+
 /**
  *  Parse the resource file.
  *
@@ -29,7 +29,6 @@
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/string.hh"
 
-extern int config_warnings;
 extern int config_errors;
 
 using namespace com::centreon;
@@ -1666,7 +1665,7 @@ bool service::_set_failure_prediction_enabled(bool value) {
   log_v2::config()->warn(
       "Warning: service failure_prediction_enabled is deprecated. This option "
       "will not be supported in 20.04.");
-  ++config_warnings;
+  _add_warning();
   return true;
 }
 
@@ -1685,7 +1684,7 @@ bool service::_set_failure_prediction_options(std::string const& value) {
   log_v2::config()->warn(
       "Warning: service failure_prediction_options is deprecated. This option "
       "will not be supported in 20.04.");
-  ++config_warnings;
+  _add_warning();
   return true;
 }
 
@@ -2003,7 +2002,7 @@ bool service::_set_parallelize_check(bool value) {
   log_v2::config()->warn(
       "Warning: service parallelize_check is deprecated This option will not "
       "be supported in 20.04.");
-  ++config_warnings;
+  _add_warning();
   return true;
 }
 
@@ -254,6 +254,8 @@ std::unordered_map<std::string, state::setter_func> const state::_setters{
     {"log_level_macros", SETTER(std::string const&, log_level_macros)},
     {"log_level_process", SETTER(std::string const&, log_level_process)},
     {"log_level_runtime", SETTER(std::string const&, log_level_runtime)},
+    {"use_binary_retention_format", SETTER(bool, use_binary_retention_format)},
+    {"use_epoll_process_manager", SETTER(bool, use_epoll_process_manager)},
     {"use_timezone", SETTER(std::string const&, use_timezone)},
     {"use_true_regexp_matching", SETTER(bool, use_true_regexp_matching)},
     {"xcddefault_comment_file", SETTER(std::string const&, _set_comment_file)},
@@ -390,6 +392,8 @@ static std::string const default_log_level_comments("error");
 static std::string const default_log_level_macros("error");
 static std::string const default_log_level_process("info");
 static std::string const default_log_level_runtime("error");
+static bool const default_use_binary_retention_format(false);
+static bool const default_use_epoll_process_manager(false);
 static std::string const default_use_timezone("");
 static bool const default_use_true_regexp_matching(false);
 static const std::string default_rpc_listen_address("localhost");
@@ -532,6 +536,8 @@ state::state()
       _log_level_macros(default_log_level_macros),
       _log_level_process(default_log_level_process),
       _log_level_runtime(default_log_level_runtime),
+      _use_binary_retention_format(default_use_binary_retention_format),
+      _use_epoll_process_manager(default_use_epoll_process_manager),
       _use_timezone(default_use_timezone),
       _use_true_regexp_matching(default_use_true_regexp_matching) {}
 
@@ -711,6 +717,8 @@ state& state::operator=(state const& right) {
     _log_level_macros = right._log_level_macros;
     _log_level_process = right._log_level_process;
     _log_level_runtime = right._log_level_runtime;
+    _use_binary_retention_format = right._use_binary_retention_format;
+    _use_epoll_process_manager = right._use_epoll_process_manager;
     _use_timezone = right._use_timezone;
     _use_true_regexp_matching = right._use_true_regexp_matching;
   }
@@ -876,6 +884,8 @@ bool state::operator==(state const& right) const noexcept {
       _log_level_macros == right._log_level_macros &&
       _log_level_process == right._log_level_process &&
       _log_level_runtime == right._log_level_runtime &&
+      _use_binary_retention_format == right._use_binary_retention_format &&
+      _use_epoll_process_manager == right._use_epoll_process_manager &&
       _use_timezone == right._use_timezone &&
       _use_true_regexp_matching == right._use_true_regexp_matching);
 }
@@ -4183,6 +4193,42 @@ void state::use_timezone(std::string const& value) {
   _use_timezone = value;
 }
 
+/**
+ *  Get use_binary_retention_format value.
+ *
+ *  @return The use_binary_retention_format value.
+ */
+bool state::use_binary_retention_format() const noexcept {
+  return _use_binary_retention_format;
+}
+
+/**
+ *  Set use_binary_retention_format value.
+ *
+ *  @param[in] value The new use_binary_retention_format value.
+ */
+void state::use_binary_retention_format(bool value) {
+  _use_binary_retention_format = value;
+}
+
+/**
+ *  Get use_epoll_process_manager value.
+ *
+ *  @return The use_epoll_process_manager value.
+ */
+bool state::use_epoll_process_manager() const noexcept {
+  return _use_epoll_process_manager;
+}
+
+/**
+ *  Set use_epoll_process_manager value.
+ *
+ *  @param[in] value The new use_epoll_process_manager value.
+ */
+void state::use_epoll_process_manager(bool value) {
+  _use_epoll_process_manager = value;
+}
+
 /**
  *  Get use_true_regexp_matching value.
  *
@@ -184,9 +184,9 @@ void loop::_dispatching() {
     if (!_event_list_high.empty()) {
       engine_logger(dbg_events, more)
           << "Next High Priority Event Time: "
-          << my_ctime(&(*_event_list_high.begin())->run_time);
+          << my_ctime(&_event_list_high.front()->run_time);
       log_v2::events()->debug("Next High Priority Event Time: {}",
-                              my_ctime(&(*_event_list_high.begin())->run_time));
+                              my_ctime(&_event_list_high.front()->run_time));
     } else {
       engine_logger(dbg_events, more)
           << "No high priority events are scheduled...";
@@ -195,9 +195,9 @@ void loop::_dispatching() {
     if (!_event_list_low.empty()) {
       engine_logger(dbg_events, more)
           << "Next Low Priority Event Time:  "
-          << my_ctime(&(*_event_list_low.begin())->run_time);
+          << my_ctime(&_event_list_low.front()->run_time);
       log_v2::events()->debug("Next Low Priority Event Time:  {}",
-                              my_ctime(&(*_event_list_low.begin())->run_time));
+                              my_ctime(&_event_list_low.front()->run_time));
     } else {
       engine_logger(dbg_events, more)
           << "No low priority events are scheduled...";
@@ -222,10 +222,7 @@ void loop::_dispatching() {
     if (!_event_list_high.empty() &&
         current_time >= _event_list_high.front()->run_time) {
       // Remove the first event from the timing loop.
-      auto temp_event = std::move(_event_list_high.front());
-
-      _event_list_high.pop_front();
-      // We may have just removed the only item from the list.
+      auto temp_event = _event_list_high.pop();
 
       // Handle the event.
       temp_event->handle_timed_event();
@@ -308,8 +305,7 @@ void loop::_dispatching() {
           // reschedule it for a later time. Since event was not
           // executed, it needs to be remove()'ed to maintain sync with
           // event broker modules.
-          auto temp_event = std::move(_event_list_low.front());
-          _event_list_low.pop_front();
+          auto temp_event = _event_list_low.pop();
 
           // We nudge the next check time when it is
           // due to too many concurrent service checks.
@@ -366,8 +362,7 @@ void loop::_dispatching() {
           // it for a later time. Since event was not executed, it needs
           // to be remove()'ed to maintain sync with event broker
           // modules.
-          auto temp_event = std::move(_event_list_low.front());
-          _event_list_low.pop_front();
+          auto temp_event = _event_list_low.pop();
 
           // Reschedule.
           if ((notifier::soft == temp_host->get_state_type()) &&
@@ -389,9 +384,7 @@ void loop::_dispatching() {
       // Run the event.
       if (run_event) {
         // Remove the first event from the timing loop.
-        auto temp_event = std::move(_event_list_low.front());
-        _event_list_low.pop_front();
-        // We may have just removed the only item from the list.
+        auto temp_event = _event_list_low.pop();
 
         // Handle the event.
         engine_logger(dbg_events, more) << "Running event...";
@@ -414,9 +407,9 @@ void loop::_dispatching() {
     }
     // We don't have anything to do at this moment in time...
     else if ((_event_list_high.empty() ||
-              current_time < (*_event_list_high.begin())->run_time) &&
+              current_time < _event_list_high.front()->run_time) &&
              (_event_list_low.empty() ||
-              current_time < (*_event_list_low.begin())->run_time)) {
+              current_time < _event_list_low.front()->run_time)) {
       engine_logger(dbg_events, most)
           << "No events to execute at the moment. Idling for a bit...";
       log_v2::events()->debug(
@@ -493,18 +486,20 @@ void loop::adjust_check_scheduling() {
   time_t last_window_time(first_window_time +
                           config->auto_rescheduling_window());
 
-  // get current scheduling data.
-  for (timed_event_list::iterator it{_event_list_low.begin()},
-       end{_event_list_low.end()};
-       it != end; ++it) {
-    // skip events outside of our current window.
-    if ((*it)->run_time <= first_window_time)
-      continue;
-    if ((*it)->run_time > last_window_time)
-      break;
+  // get the events of our current window, in their execution order.
+  std::vector<timed_event*> window;
+  for (auto& evt : _event_list_low)
+    if (evt->run_time > first_window_time && evt->run_time <= last_window_time)
+      window.push_back(evt.get());
+  std::sort(window.begin(), window.end(),
+            [](const timed_event* a, const timed_event* b) {
+              return timed_event_queue::before(*a, *b);
+            });
 
-    if ((*it)->event_type == timed_event::EVENT_HOST_CHECK) {
-      if (!(hst = (host*)(*it)->event_data))
+  // get current scheduling data.
+  for (timed_event* evt : window) {
+    if (evt->event_type == timed_event::EVENT_HOST_CHECK) {
+      if (!(hst = (host*)evt->event_data))
         continue;
 
       // ignore forced checks.
@@ -512,18 +507,18 @@ void loop::adjust_check_scheduling() {
         continue;
 
       // does the last check "bump" into this one?
-      if ((last_check_time + last_check_exec_time) > (*it)->run_time)
+      if ((last_check_time + last_check_exec_time) > evt->run_time)
         adjust_scheduling = true;
 
-      last_check_time = (*it)->run_time;
+      last_check_time = evt->run_time;
 
       // calculate time needed to perform check.
       // NOTE: host check execution time is not taken into account,
       // as scheduled host checks are run in parallel.
       last_check_exec_time = projected_host_check_overhead;
       total_check_exec_time += last_check_exec_time;
-    } else if ((*it)->event_type == timed_event::EVENT_SERVICE_CHECK) {
-      if (!(svc = (com::centreon::engine::service*)(*it)->event_data))
+    } else if (evt->event_type == timed_event::EVENT_SERVICE_CHECK) {
+      if (!(svc = (com::centreon::engine::service*)evt->event_data))
         continue;
 
       // ignore forced checks.
@@ -531,10 +526,10 @@ void loop::adjust_check_scheduling() {
         continue;
 
       // does the last check "bump" into this one?
-      if ((last_check_time + last_check_exec_time) > (*it)->run_time)
+      if ((last_check_time + last_check_exec_time) > evt->run_time)
         adjust_scheduling = true;
 
-      last_check_time = (*it)->run_time;
+      last_check_time = evt->run_time;
 
       // calculate time needed to perform check.
       // NOTE: service check execution time is not taken into
@@ -572,17 +567,9 @@ void loop::adjust_check_scheduling() {
   };
   // adjust check scheduling.
   double current_icd_offset(inter_check_delay / 2.0);
-  for (timed_event_list::iterator it = _event_list_low.begin(),
-                                  end = _event_list_low.end();
-       it != end; ++it) {
-    // skip events outside of our current window.
-    if ((*it)->run_time <= first_window_time)
-      continue;
-    if ((*it)->run_time > last_window_time)
-      break;
-
-    if ((*it)->event_type == timed_event::EVENT_HOST_CHECK) {
-      if (!(hst = (host*)(*it)->event_data))
+  for (timed_event* evt : window) {
+    if (evt->event_type == timed_event::EVENT_HOST_CHECK) {
+      if (!(hst = (host*)evt->event_data))
         continue;
 
       // ignore forced checks.
@@ -594,11 +581,12 @@ void loop::adjust_check_scheduling() {
           exec_time_factor;
       time_t new_run_time = compute_new_run_time(
           current_exec_time_offset, current_icd_offset, first_window_time);
-      (*it)->run_time = new_run_time;
+      evt->run_time = new_run_time;
+      _event_list_low.update(evt);
       hst->set_next_check(new_run_time);
       hst->update_status();
-    } else if ((*it)->event_type == timed_event::EVENT_SERVICE_CHECK) {
-      if (!(svc = (com::centreon::engine::service*)(*it)->event_data))
+    } else if (evt->event_type == timed_event::EVENT_SERVICE_CHECK) {
+      if (!(svc = (com::centreon::engine::service*)evt->event_data))
         continue;
 
       // ignore forced checks.
@@ -610,7 +598,8 @@ void loop::adjust_check_scheduling() {
       current_exec_time = projected_service_check_overhead * exec_time_factor;
       time_t new_run_time = compute_new_run_time(
           current_exec_time_offset, current_icd_offset, first_window_time);
-      (*it)->run_time = new_run_time;
+      evt->run_time = new_run_time;
+      _event_list_low.update(evt);
       svc->set_next_check(new_run_time);
       svc->update_status();
     } else
@@ -619,10 +608,6 @@ void loop::adjust_check_scheduling() {
     current_icd_offset += inter_check_delay;
     current_exec_time_offset += current_exec_time;
   }
-
-  // resort event list (some events may be out of order at
-  // this point).
-  resort_event_list(events::loop::low);
 }
 
 /**
@@ -798,47 +783,20 @@ void loop::compensate_for_system_time_change(unsigned long last_time,
 }
 
 /**
- *  Add an event to list ordered by execution time.
+ *  Add an event to the queue ordered by execution time.
  *
- *  @param[in] event           The new event to add.
- *  @param[in] event_list      The head of the event list.
- *  @param[in] event_list_tail The tail of the event list.
+ *  @param[in] event     The new event to add.
+ *  @param[in] priority  This is to know which queue to work with.
  */
 void loop::add_event(std::unique_ptr<timed_event>&& event,
                      loop::priority priority) {
   engine_logger(dbg_functions, basic) << "add_event()";
   log_v2::functions()->trace("add_event()");
 
-  timed_event_list* list;
-
-  if (priority == loop::low) {
-    list = &_event_list_low;
-  } else {
-    list = &_event_list_high;
-  }
-
-  // add the event to the head of the list if there are
-  // no other events.
-  if (list->empty())
-    list->push_front(std::move(event));
-
-  // add event to head of the list if it should be executed first.
-  else if (event->run_time < (*list->begin())->run_time)
-    list->push_front(std::move(event));
-
-  // else place the event according to next execution time.
-  else {
-    // start from the end of the list, as new events are likely to
-    // be executed in the future, rather than now...
-    for (timed_event_list::reverse_iterator it = list->rbegin(),
-                                            end = list->rend();
-         it != end; ++it) {
-      if (event->run_time >= (*it)->run_time) {
-        list->insert(it.base(), std::move(event));
-        break;
-      }
-    }
-  }
+  if (priority == loop::low)
+    _event_list_low.push(std::move(event));
+  else
+    _event_list_high.push(std::move(event));
 }
 
 void loop::remove_downtime(uint64_t downtime_id) {
@@ -853,29 +811,12 @@ void loop::remove_downtime(uint64_t downtime_id) {
       // send event data to broker.
       broker_timed_event(NEBTYPE_TIMEDEVENT_REMOVE, NEBFLAG_NONE, NEBATTR_NONE,
                          it->get(), nullptr);
-      _event_list_high.erase(it);
+      _event_list_high.remove(it->get());
       break;
     }
   }
 }
 
-/**
- *  Remove an event given by its iterator from the queue.
- *
- *  @param[in]     it              The iterator to the event to remove.
- *  @param[in]     priority        This to now which list to work with.
- */
-void loop::remove_event(timed_event_list::iterator& it,
-                        loop::priority priority) {
-  engine_logger(dbg_functions, basic) << "loop::remove_event()";
-  log_v2::functions()->trace("loop::remove_event()");
-
-  if (priority == loop::low)
-    _event_list_low.erase(it);
-  else
-    _event_list_high.erase(it);
-}
-
 /**
  *  Remove an event given from the queue.
  *
@@ -885,55 +826,40 @@ void loop::remove_event(timed_event_list::iterator& it,
 void loop::remove_event(timed_event* evt, loop::priority priority) {
   engine_logger(dbg_functions, basic) << "loop::remove_event()";
   log_v2::functions()->trace("loop::remove_event()");
-  timed_event_list* list;
   if (priority == loop::low)
-    list = &_event_list_low;
+    _event_list_low.remove(evt);
   else
-    list = &_event_list_high;
-
-  list->erase(std::remove_if(list->begin(), list->end(),
-                             [evt](const std::unique_ptr<timed_event>& e) {
-                               return evt == e.get();
-                             }),
-              list->end());
+    _event_list_high.remove(evt);
 }
 
 void loop::remove_events(loop::priority priority,
                          uint32_t event_type,
                          void* data) noexcept {
-  timed_event_list* list;
   if (priority == loop::low)
-    list = &_event_list_low;
+    _event_list_low.remove(event_type, data);
   else
-    list = &_event_list_high;
-
-  list->erase(std::remove_if(
-                  list->begin(), list->end(),
-                  [event_type, data](const std::unique_ptr<timed_event>& e) {
-                    return e->event_type == event_type && e->event_data == data;
-                  }),
-              list->end());
+    _event_list_high.remove(event_type, data);
 }
 
-timed_event_list::iterator loop::find_event(loop::priority priority,
-                                            uint32_t event_type,
-                                            void* data) {
-  timed_event_list* list;
-
-  engine_logger(dbg_functions, basic) << "resort_event_list()";
-  log_v2::functions()->trace("resort_event_list()");
+/**
+ *  Find the next event of the given type and data.
+ *
+ *  @param[in] priority    This is to know which list to work with.
+ *  @param[in] event_type  The event type.
+ *  @param[in] data        The event data.
+ *
+ *  @return The event or nullptr if there is no such event.
+ */
+timed_event* loop::find_event(loop::priority priority,
+                              uint32_t event_type,
+                              void* data) {
+  engine_logger(dbg_functions, basic) << "find_event()";
+  log_v2::functions()->trace("find_event()");
 
-  // move current event list to temp list.
   if (priority == loop::low)
-    list = &_event_list_low;
+    return _event_list_low.find(event_type, data);
   else
-    list = &_event_list_high;
-
-  for (auto it = list->begin(), end = list->end(); it != end; ++it)
-    if ((*it)->event_type == event_type && (*it)->event_data == data)
-      return it;
-
-  return list->end();
+    return _event_list_high.find(event_type, data);
 }
 
 /**
@@ -978,26 +904,20 @@ void loop::reschedule_event(std::unique_ptr<timed_event>&& event,
  *  Resorts an event list by event execution time - needed when
  *  compensating for system time changes.
  *
- *  @param[in,out] event_list      The head of the event list.
- *  @param[in,out] event_list_tail The tail of the event list.
+ *  @param[in] priority  This is to know which list to work with.
  */
 void loop::resort_event_list(loop::priority priority) {
-  timed_event_list* list;
+  timed_event_queue* list;
 
   engine_logger(dbg_functions, basic) << "resort_event_list()";
   log_v2::functions()->trace("resort_event_list()");
 
-  // move current event list to temp list.
   if (priority == loop::low)
     list = &_event_list_low;
   else
     list = &_event_list_high;
 
-  std::sort(list->begin(), list->end(),
-            [](const std::unique_ptr<timed_event>& first,
-               const std::unique_ptr<timed_event>& second) {
-              return first->run_time < second->run_time;
-            });
+  list->rebuild();
 
   // send event data to broker.
   for (auto& evt : *list)
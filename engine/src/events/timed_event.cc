@@ -42,7 +42,9 @@ using namespace com::centreon::engine;
  * Defaut constructor
  */
 timed_event::timed_event()
-    : event_type{0},
+    : _queue_pos{0},
+      _queue_seq{0},
+      event_type{0},
       run_time{0},
       recurring{0},
       event_interval{0},
@@ -74,7 +76,9 @@ timed_event::timed_event(uint32_t event_type,
                          void* event_data,
                          void* event_args,
                          int32_t event_options)
-    : event_type{event_type},
+    : _queue_pos{0},
+      _queue_seq{0},
+      event_type{event_type},
       run_time{run_time},
       recurring{recurring},
       event_interval{event_interval},
@@ -0,0 +1,221 @@
+/**
+ * Copyright 2023 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/engine/events/timed_event_queue.hh"
+
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::events;
+
+/**
+ *  Put an event at the given position of the heap.
+ *
+ *  @param[in] pos  The position.
+ *  @param[in] evt  The event.
+ */
+void timed_event_queue::_place(size_t pos,
+                               std::unique_ptr<timed_event>&& evt) noexcept {
+  evt->_queue_pos = pos;
+  _heap[pos] = std::move(evt);
+}
+
+/**
+ *  Move up the event at the given position while it runs before its parent.
+ *
+ *  @param[in] pos  The position of the event.
+ */
+void timed_event_queue::_sift_up(size_t pos) noexcept {
+  std::unique_ptr<timed_event> evt = std::move(_heap[pos]);
+  while (pos > 0) {
+    size_t parent = (pos - 1) / 2;
+    if (!before(*evt, *_heap[parent]))
+      break;
+    _place(pos, std::move(_heap[parent]));
+    pos = parent;
+  }
+  _place(pos, std::move(evt));
+}
+
+/**
+ *  Move down the event at the given position while one of its children runs
+ *  before it.
+ *
+ *  @param[in] pos  The position of the event.
+ */
+void timed_event_queue::_sift_down(size_t pos) noexcept {
+  const size_t size = _heap.size();
+  std::unique_ptr<timed_event> evt = std::move(_heap[pos]);
+  for (;;) {
+    size_t child = 2 * pos + 1;
+    if (child >= size)
+      break;
+    if (child + 1 < size && before(*_heap[child + 1], *_heap[child]))
+      ++child;
+    if (!before(*_heap[child], *evt))
+      break;
+    _place(pos, std::move(_heap[child]));
+    pos = child;
+  }
+  _place(pos, std::move(evt));
+}
+
+/**
+ *  Check if an event is in this queue.
+ *
+ *  @param[in] evt  The event.
+ *
+ *  @return true if it is in the queue.
+ */
+bool timed_event_queue::_contains(const timed_event* evt) const noexcept {
+  return evt->_queue_pos < _heap.size() &&
+         _heap[evt->_queue_pos].get() == evt;
+}
+
+/**
+ *  Remove an event from the index.
+ *
+ *  @param[in] evt  The event.
+ */
+void timed_event_queue::_unindex(const timed_event* evt) {
+  auto found = _index.find(key{evt->event_type, evt->event_data});
+  if (found != _index.end()) {
+    auto& v = found->second;
+    for (auto it = v.begin(); it != v.end(); ++it)
+      if (*it == evt) {
+        v.erase(it);
+        break;
+      }
+    if (v.empty())
+      _index.erase(found);
+  }
+}
+
+/**
+ *  Remove all the events.
+ */
+void timed_event_queue::clear() {
+  _heap.clear();
+  _index.clear();
+}
+
+/**
+ *  Add an event to the queue.
+ *
+ *  @param[in] evt  The event to add.
+ */
+void timed_event_queue::push(std::unique_ptr<timed_event>&& evt) {
+  evt->_queue_seq = _next_seq++;
+  _index[key{evt->event_type, evt->event_data}].push_back(evt.get());
+  _heap.emplace_back();
+  _place(_heap.size() - 1, std::move(evt));
+  _sift_up(_heap.size() - 1);
+}
+
+/**
+ *  Remove the next event to run. The queue must not be empty.
+ *
+ *  @return The removed event.
+ */
+std::unique_ptr<timed_event> timed_event_queue::pop() {
+  return remove(front());
+}
+
+/**
+ *  Remove an event from the queue.
+ *
+ *  @param[in] evt  The event to remove.
+ *
+ *  @return The removed event or nullptr if it was not in the queue.
+ */
+std::unique_ptr<timed_event> timed_event_queue::remove(timed_event* evt) {
+  if (!evt || !_contains(evt))
+    return nullptr;
+  _unindex(evt);
+  size_t pos = evt->_queue_pos;
+  std::unique_ptr<timed_event> retval = std::move(_heap[pos]);
+  std::unique_ptr<timed_event> last = std::move(_heap.back());
+  _heap.pop_back();
+  if (pos < _heap.size()) {
+    _place(pos, std::move(last));
+    if (pos > 0 && before(*_heap[pos], *_heap[(pos - 1) / 2]))
+      _sift_up(pos);
+    else
+      _sift_down(pos);
+  }
+  return retval;
+}
+
+/**
+ *  Remove all the events of the given type and data.
+ *
+ *  @param[in] event_type  The type of events to remove.
+ *  @param[in] data        Their data.
+ */
+void timed_event_queue::remove(uint32_t event_type, const void* data) {
+  auto found = _index.find(key{event_type, data});
+  if (found != _index.end()) {
+    /* remove() modifies the index, so we work on a copy. */
+    auto to_remove = found->second;
+    for (timed_event* evt : to_remove)
+      remove(evt);
+  }
+}
+
+/**
+ *  Find the next event to run of the given type and data.
+ *
+ *  @param[in] event_type  The type of the event.
+ *  @param[in] data        Its data.
+ *
+ *  @return The event or nullptr if none is found.
+ */
+timed_event* timed_event_queue::find(uint32_t event_type,
+                                     const void* data) const {
+  timed_event* retval = nullptr;
+  auto found = _index.find(key{event_type, data});
+  if (found != _index.end())
+    for (timed_event* evt : found->second)
+      if (!retval || before(*evt, *retval))
+        retval = evt;
+  return retval;
+}
+
+/**
+ *  Move an event to its new place after its run time has been changed.
+ *
+ *  @param[in] evt  The event.
+ */
+void timed_event_queue::update(timed_event* evt) {
+  if (!_contains(evt))
+    return;
+  size_t pos = evt->_queue_pos;
+  if (pos > 0 && before(*evt, *_heap[(pos - 1) / 2]))
+    _sift_up(pos);
+  else
+    _sift_down(pos);
+}
+
+/**
+ *  Reorder the whole queue, needed when run times of many events have been
+ *  changed.
+ */
+void timed_event_queue::rebuild() {
+  if (_heap.size() < 2)
+    return;
+  for (size_t pos = _heap.size() / 2; pos-- > 0;)
+    _sift_down(pos);
+}
@@ -1905,13 +1905,13 @@ bool host::schedule_check(time_t check_time,
 #endif
 
   /* see if there are any other scheduled checks of this host in the queue */
-  timed_event_list::iterator found = events::loop::instance().find_event(
+  timed_event* found = events::loop::instance().find_event(
       events::loop::low, timed_event::EVENT_HOST_CHECK, this);
 
   /* we found another host check event for this host in the queue - what should
    * we do? */
-  if (found != events::loop::instance().list_end(events::loop::low)) {
-    auto& temp_event = *found;
+  if (found) {
+    timed_event* temp_event = found;
     engine_logger(dbg_checks, most)
         << "Found another host check event for this host @ "
         << my_ctime(&temp_event->run_time);
@@ -0,0 +1,288 @@
+/**
+ * Copyright 2023 Centreon
+ *
+ * This file is part of Centreon Engine.
+ *
+ * Centreon Engine is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * Centreon Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Centreon Engine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "com/centreon/engine/macros/command_template.hh"
+#include "com/centreon/engine/configuration/applier/state.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/log_v2.hh"
+#include "com/centreon/engine/macros.hh"
+
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::macros;
+
+std::atomic<uint32_t> command_template::_current_generation{0};
+
+/* Templates of the command arguments, they are numerous but mostly the same
+ * ones ($HOSTADDRESS$, thresholds...). */
+static constexpr size_t max_cached_templates = 100000;
+static std::mutex _cache_m;
+static std::unordered_map<std::string,
+                          std::shared_ptr<const command_template>>
+    _cache;
+
+/**
+ *  Parse a command line.
+ *
+ *  @param[in] command_line The command line with its macros.
+ */
+command_template::command_template(const std::string& command_line)
+    : _command_line(command_line),
+      _generation(_current_generation),
+      _size_hint(command_line.size()) {
+  std::string literal;
+  for (size_t i = 0; i < command_line.size(); ++i) {
+    if (command_line[i] != '$')
+      literal.push_back(command_line[i]);
+    // A dollar as last character is ignored.
+    else if (i + 1 == command_line.size())
+      ;
+    // $$ => $ escape.
+    else if (command_line[i + 1] == '$') {
+      literal.push_back('$');
+      ++i;
+    } else {
+      size_t pos = command_line.find('$', i + 1);
+      // An unterminated macro loses its dollar.
+      if (pos != std::string::npos) {
+        _add_literal(literal);
+        _add_macro(command_line.substr(i + 1, pos - i - 1));
+        i = pos;
+      }
+    }
+  }
+  _add_literal(literal);
+  log_v2::macros()->trace("Command line '{}' parsed into {} segments",
+                          command_line, _segments.size());
+}
+
+/**
+ *  Add a literal segment.
+ *
+ *  @param[in,out] literal The text to add, cleared once added.
+ */
+void command_template::_add_literal(std::string& literal) {
+  if (!literal.empty()) {
+    segment s{segment_type::literal};
+    s.text = std::move(literal);
+    _segments.push_back(std::move(s));
+    literal.clear();
+  }
+}
+
+/**
+ *  Resolve a macro and add it as a segment. Macros are resolved in the
+ *  order used by grab_macro_value_r(), those that cannot be resolved here
+ *  are left to it.
+ *
+ *  @param[in] token The macro without its dollars.
+ */
+void command_template::_add_macro(const std::string& token) {
+  segment s{segment_type::generic};
+  s.text = token;
+
+  /* see if there's an argument - if so, this is most likely an on-demand
+   * macro */
+  size_t colon = token.find(':');
+  std::string name(token, 0, colon);
+  if (colon != std::string::npos) {
+    size_t colon2 = token.find(':', colon + 1);
+    if (colon2 == std::string::npos)
+      s.arg1 = token.substr(colon + 1);
+    else {
+      s.arg1 = token.substr(colon + 1, colon2 - colon - 1);
+      s.arg2 = token.substr(colon2 + 1);
+    }
+  }
+
+  unsigned int x;
+  for (x = 0; x < MACRO_X_COUNT; ++x)
+    if (!macro_x_names[x].empty() && macro_x_names[x] == name)
+      break;
+
+  /***** X MACROS *****/
+  if (x < MACRO_X_COUNT) {
+    s.type = segment_type::macrox;
+    s.index = x;
+    if (!s.arg1.empty() && s.arg2.empty() && grab_macrox_is_host(x)) {
+      host_map::const_iterator it(host::hosts.find(s.arg1));
+      if (it != host::hosts.end() && it->second) {
+        s.type = segment_type::host_macrox;
+        s.hst = it->second.get();
+      }
+    } else if (!s.arg1.empty() && !s.arg2.empty() &&
+               grab_macrox_is_service(x)) {
+      service_map::const_iterator it(service::services.find({s.arg1, s.arg2}));
+      if (it != service::services.end() && it->second) {
+        s.type = segment_type::service_macrox;
+        s.svc = it->second.get();
+      }
+    }
+  }
+  /***** ARGV MACROS *****/
+  else if (token.size() > 3 && token.compare(0, 3, "ARG") == 0) {
+    if (absl::SimpleAtoi(token.c_str() + 3, &x) && x &&
+        x <= MAX_COMMAND_ARGUMENTS) {
+      s.type = segment_type::argv;
+      s.index = x - 1;
+    }
+  }
+  /***** USER MACROS *****/
+  else if (token.size() > 4 && token.compare(0, 4, "USER") == 0) {
+    if (absl::SimpleAtoi(token.c_str() + 4, &x) && x && x <= MAX_USER_MACROS) {
+      s.type = segment_type::user;
+      s.index = x - 1;
+    }
+  }
+  /***** CONTACT ADDRESS MACROS *****/
+  else if (token.size() > 14 && token.compare(0, 14, "CONTACTADDRESS") == 0)
+    ;
+  /***** CUSTOM VARIABLE MACROS *****/
+  else if (token[0] == '_')
+    s.type = segment_type::custom;
+  /***** NEW STYLE USER MACROS *****/
+  else {
+    auto it = configuration::applier::state::instance().user_macros_find(token);
+    if (it != configuration::applier::state::instance().user_macros().end()) {
+      s.type = segment_type::value;
+      s.text = it->second;
+    }
+  }
+
+  _segments.push_back(std::move(s));
+}
+
+/**
+ *  Expand the command line, it is the same as process_macros_r().
+ *
+ *  @param[in]  mac     The macros.
+ *  @param[out] output  The expanded command line, its memory is reused.
+ *  @param[in]  options Cleaning options of the macros values.
+ */
+void command_template::expand(nagios_macros* mac,
+                              std::string& output,
+                              int options) const {
+  output.clear();
+  output.reserve(_size_hint.load(std::memory_order_relaxed));
+
+  std::string buffer;
+  for (const segment& s : _segments) {
+    const std::string* value = &buffer;
+    int clean_options = 0;
+    int free_macro = false;
+    int result = OK;
+    buffer.clear();
+
+    switch (s.type) {
+      case segment_type::literal:
+        output.append(s.text);
+        continue;
+      case segment_type::macrox:
+        result = grab_macrox_value_r(mac, s.index, s.arg1, s.arg2, buffer,
+                                     &free_macro);
+        clean_options = grab_macrox_clean_options(s.index);
+        break;
+      case segment_type::host_macrox:
+        if (mac)
+          result = grab_standard_host_macro_r(mac, s.index, s.hst, buffer,
+                                              &free_macro);
+        else
+          result = ERROR;
+        clean_options = grab_macrox_clean_options(s.index);
+        break;
+      case segment_type::service_macrox:
+        if (mac)
+          result = grab_standard_service_macro_r(mac, s.index, s.svc, buffer,
+                                                 &free_macro);
+        else
+          result = ERROR;
+        clean_options = grab_macrox_clean_options(s.index);
+        break;
+      case segment_type::argv:
+        if (mac)
+          value = &mac->argv[s.index];
+        else
+          result = ERROR;
+        break;
+      case segment_type::user:
+        value = &macro_user[s.index];
+        break;
+      case segment_type::value:
+        value = &s.text;
+        break;
+      case segment_type::custom:
+        result =
+            grab_custom_macro_value_r(mac, s.text, s.arg1, s.arg2, buffer);
+        break;
+      case segment_type::generic:
+        result = grab_macro_value_r(mac, s.text, buffer, &clean_options,
+                                    &free_macro);
+        break;
+    }
+
+    /* an error occurred - we couldn't parse the macro, so continue on */
+    if (result == ERROR)
+      log_v2::macros()->trace(
+          " WARNING: An error occurred processing macro '{}'!", s.text);
+
+    /* insert macro, some macros are cleaned */
+    if (!value->empty()) {
+      int macro_options = options | clean_options;
+      if (macro_options & (STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS))
+        output.append(clean_macro_chars(*value, macro_options));
+      else
+        output.append(*value);
+    }
+  }
+
+  _size_hint.store(output.size(), std::memory_order_relaxed);
+  log_v2::macros()->trace("Command line '{}' expanded to '{}'", _command_line,
+                          output);
+}
+
+/**
+ *  Get the template of a command line from the templates cache, parsing it
+ *  if needed.
+ *
+ *  @param[in] command_line The command line.
+ *
+ *  @return The template.
+ */
+std::shared_ptr<const command_template> command_template::get(
+    const std::string& command_line) {
+  std::lock_guard<std::mutex> lck(_cache_m);
+  auto found = _cache.find(command_line);
+  if (found != _cache.end() && !found->second->is_obsolete())
+    return found->second;
+
+  if (_cache.size() >= max_cached_templates)
+    _cache.clear();
+  auto retval = std::make_shared<const command_template>(command_line);
+  _cache[command_line] = retval;
+  return retval;
+}
+
+/**
+ *  Make all the templates obsolete, they must be parsed again. It is needed
+ *  when the objects and the user macros they point to are reloaded.
+ */
+void command_template::invalidate() {
+  ++_current_generation;
+  std::lock_guard<std::mutex> lck(_cache_m);
+  _cache.clear();
+}
@@ -960,11 +960,8 @@ int grab_macro_value_r(nagios_macros* mac,
                                    arg[1] ? arg[1] : "", output, free_macro);
 
       /* post-processing */
-      /* host/service output/perfdata and author/comment macros should get
-       * cleaned */
-      if ((x >= 16 && x <= 19) || (x >= 49 && x <= 52) ||
-          (x >= 99 && x <= 100) || (x >= 124 && x <= 127)) {
-        *clean_options |= (STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS);
+      if (int options = grab_macrox_clean_options(x)) {
+        *clean_options |= options;
         engine_logger(dbg_macros, most)
             << "  New clean options: " << *clean_options;
         log_v2::macros()->trace("  New clean options: {}", *clean_options);
@@ -1117,6 +1114,54 @@ int grab_macro_value_r(nagios_macros* mac,
   return result;
 }
 
+/**
+ *  Get the cleaning options of an X macro.
+ *
+ *  @param[in] macro_type Macro to check.
+ *
+ *  @return STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS for the macros
+ *          that must be cleaned, 0 otherwise.
+ */
+int grab_macrox_clean_options(int macro_type) {
+  /* host/service output/perfdata and author/comment macros should get
+   * cleaned */
+  if ((macro_type >= 16 && macro_type <= 19) ||
+      (macro_type >= 49 && macro_type <= 52) ||
+      (macro_type >= 99 && macro_type <= 100) ||
+      (macro_type >= 124 && macro_type <= 127))
+    return STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS;
+  return 0;
+}
+
+/**
+ *  Check if an X macro is a host macro, whose value is computed by
+ *  grab_standard_host_macro_r().
+ *
+ *  @param[in] macro_type Macro to check.
+ *
+ *  @return true if it is a host macro.
+ */
+bool grab_macrox_is_host(int macro_type) {
+  grab_value_redirection::entry::const_iterator it(
+      redirector.routines.find(macro_type));
+  return it != redirector.routines.end() && it->second == &handle_host_macro;
+}
+
+/**
+ *  Check if an X macro is a service macro, whose value is computed by
+ *  grab_standard_service_macro_r().
+ *
+ *  @param[in] macro_type Macro to check.
+ *
+ *  @return true if it is a service macro.
+ */
+bool grab_macrox_is_service(int macro_type) {
+  grab_value_redirection::entry::const_iterator it(
+      redirector.routines.find(macro_type));
+  return it != redirector.routines.end() &&
+         it->second == &handle_service_macro;
+}
+
 /**
  *  Grab a macro value.
  *
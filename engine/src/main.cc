@@ -57,6 +57,7 @@ namespace asio = boost::asio;
 #include "com/centreon/engine/macros/misc.hh"
 #include "com/centreon/engine/nebmods.hh"
 #include "com/centreon/engine/retention/dump.hh"
+#include "com/centreon/engine/retention/dumper.hh"
 #include "com/centreon/engine/retention/parser.hh"
 #include "com/centreon/engine/retention/state.hh"
 #include "com/centreon/engine/statusdata.hh"
@@ -422,6 +423,9 @@ int main(int argc, char* argv[]) {
         // Initialize check statistics.
         init_check_stats();
 
+        // Start the retention writer.
+        retention::dumper::init();
+
         // Update all status data (with retained information).
         update_all_status_data();
 
@@ -0,0 +1,385 @@
+/**
+ * Copyright 2023 Centreon
+ *
+ * This file is part of Centreon Engine.
+ *
+ * Centreon Engine is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * Centreon Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Centreon Engine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "com/centreon/engine/retention/binary.hh"
+#include <future>
+#include <thread>
+#include "com/centreon/engine/exceptions/error.hh"
+#include "com/centreon/engine/string.hh"
+
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::retention;
+
+static constexpr size_t table_entry_size = 8 + 8 + 4;
+static constexpr size_t trailer_size = 8 + 4;
+
+static void put_u32(std::string& buffer, uint32_t value) {
+  for (int i = 0; i < 4; ++i, value >>= 8)
+    buffer.push_back(static_cast<char>(value & 0xff));
+}
+
+static void put_u64(std::string& buffer, uint64_t value) {
+  for (int i = 0; i < 8; ++i, value >>= 8)
+    buffer.push_back(static_cast<char>(value & 0xff));
+}
+
+static void put_varint(std::string& buffer, uint64_t value) {
+  while (value >= 0x80) {
+    buffer.push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  buffer.push_back(static_cast<char>(value));
+}
+
+static void put_string(std::string& buffer, char const* str, size_t size) {
+  put_varint(buffer, size);
+  buffer.append(str, size);
+  buffer.push_back('\0');
+}
+
+/**
+ *  Constructor. The file header is written.
+ *
+ *  @param[out] os The output stream.
+ */
+binary::encoder::encoder(std::ostream& os)
+    : _os(os),
+      _offset{0},
+      _records_count{0},
+      _in_record{false},
+      _type{0},
+      _fields_count{0} {
+  std::string header(magic, sizeof(magic));
+  put_u32(header, version);
+  _write(header);
+}
+
+/**
+ *  Add text records. They are read exactly as retention::parser reads the
+ *  text format, so both formats give the same objects.
+ *
+ *  @param[in] text Complete records in the text format.
+ */
+void binary::encoder::add(std::string const& text) {
+  std::string line;
+  size_t pos = 0;
+  while (pos < text.size()) {
+    size_t end = text.find('\n', pos);
+    if (end == std::string::npos)
+      end = text.size();
+    size_t first = text.find_first_not_of(" \t", pos);
+    size_t last = text.find_last_not_of(" \t", end - 1);
+    bool empty = first >= end || last == std::string::npos || last < pos;
+    if (!empty)
+      line.assign(text, first, last - first + 1);
+    pos = end + 1;
+    if (empty || line[0] == '#' || line[0] == 0)
+      continue;
+
+    if (!_in_record) {
+      size_t sep = line.find_first_of(" \t");
+      if (sep == std::string::npos)
+        continue;
+      _type = _key(line.substr(0, sep));
+      _in_record = true;
+    } else if (line != "}") {
+      char const* key;
+      char const* value;
+      if (string::split(line, &key, &value, '=') && key) {
+        put_varint(_fields, _key(key));
+        put_string(_fields, value, strlen(value));
+        ++_fields_count;
+      }
+    } else
+      _end_record();
+  }
+}
+
+/**
+ *  Write the last section and the sections table.
+ *
+ *  @return The size of the written data.
+ */
+uint64_t binary::encoder::finish() {
+  if (_in_record)
+    _end_record();
+  if (_records_count)
+    _end_section();
+
+  std::string table;
+  uint64_t table_offset = _offset;
+  for (section const& s : _sections) {
+    put_u64(table, s.offset);
+    put_u64(table, s.size);
+    put_u32(table, s.records);
+  }
+  put_u64(table, table_offset);
+  put_u32(table, _sections.size());
+  _write(table);
+  return _offset;
+}
+
+/**
+ *  Get the index of a key in the dictionary of the current section.
+ *
+ *  @param[in] key The key.
+ *
+ *  @return Its index.
+ */
+uint32_t binary::encoder::_key(std::string const& key) {
+  auto it = _keys.find(key);
+  if (it != _keys.end())
+    return it->second;
+  uint32_t id = _keys.size();
+  _keys.emplace(key, id);
+  put_string(_dictionary, key.data(), key.size());
+  return id;
+}
+
+void binary::encoder::_end_record() {
+  put_varint(_records, _type);
+  put_varint(_records, _fields_count);
+  _records.append(_fields);
+  _fields.clear();
+  _fields_count = 0;
+  _in_record = false;
+  if (++_records_count == records_per_section)
+    _end_section();
+}
+
+void binary::encoder::_end_section() {
+  std::string dictionary_size;
+  put_varint(dictionary_size, _keys.size());
+  section s{_offset,
+            dictionary_size.size() + _dictionary.size() + _records.size(),
+            _records_count};
+  _write(dictionary_size);
+  _write(_dictionary);
+  _write(_records);
+  _sections.push_back(s);
+  _keys.clear();
+  _dictionary.clear();
+  _records.clear();
+  _records_count = 0;
+}
+
+void binary::encoder::_write(std::string const& data) {
+  _os.write(data.data(), data.size());
+  _offset += data.size();
+}
+
+/**
+ *  Check if a retention file content is in the binary format.
+ *
+ *  @param[in] content The beginning of the file.
+ *
+ *  @return True if it starts with the binary magic.
+ */
+bool binary::is_binary(std::string const& content) noexcept {
+  return content.size() >= sizeof(magic) &&
+         !memcmp(content.data(), magic, sizeof(magic));
+}
+
+namespace {
+/**
+ *  Bounds checked reader over a part of the file content.
+ */
+class reader {
+  char const* _pos;
+  char const* const _end;
+
+ public:
+  reader(char const* begin, char const* end) : _pos(begin), _end(end) {}
+
+  void need(size_t size) const {
+    if (static_cast<size_t>(_end - _pos) < size)
+      throw engine_error() << "Parsing of binary retention file failed: "
+                              "truncated data";
+  }
+
+  uint64_t fixed(int size) {
+    need(size);
+    uint64_t retval = 0;
+    for (int i = 0; i < size; ++i)
+      retval |= static_cast<uint64_t>(static_cast<uint8_t>(_pos[i])) << (8 * i);
+    _pos += size;
+    return retval;
+  }
+
+  uint64_t varint() {
+    uint64_t retval = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      need(1);
+      uint8_t byte = *_pos++;
+      retval |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if (!(byte & 0x80))
+        return retval;
+    }
+    throw engine_error() << "Parsing of binary retention file failed: "
+                            "bad varint";
+  }
+
+  char const* string() {
+    uint64_t size = varint();
+    need(size + 1);
+    char const* retval = _pos;
+    if (_pos[size])
+      throw engine_error() << "Parsing of binary retention file failed: "
+                              "unterminated string";
+    _pos += size + 1;
+    return retval;
+  }
+
+  bool at_end() const noexcept { return _pos == _end; }
+};
+
+/**
+ *  Decode one section into retention objects.
+ *
+ *  @param[in]  content The file content.
+ *  @param[in]  offset  The section offset.
+ *  @param[in]  size    The section size.
+ *  @param[in]  records The number of records in the section.
+ *  @param[out] objects The decoded objects, in the file order.
+ */
+void decode_section(std::string const& content,
+                    uint64_t offset,
+                    uint64_t size,
+                    uint32_t records,
+                    std::vector<object_ptr>& objects) {
+  if (offset > content.size() || size > content.size() - offset)
+    throw engine_error() << "Parsing of binary retention file failed: "
+                            "section out of file";
+  reader r(content.data() + offset, content.data() + offset + size);
+
+  // Every key and every record takes at least one byte of the section, so
+  // counts the section cannot hold are rejected before allocating.
+  uint64_t keys = r.varint();
+  r.need(keys);
+  std::vector<char const*> dictionary(keys);
+  for (char const*& key : dictionary)
+    key = r.string();
+  auto lookup = [&dictionary](uint64_t id) {
+    if (id >= dictionary.size())
+      throw engine_error() << "Parsing of binary retention file failed: "
+                              "unknown key "
+                           << id;
+    return dictionary[id];
+  };
+
+  r.need(records);
+  objects.reserve(records);
+  for (uint32_t i = 0; i < records; ++i) {
+    object_ptr obj = object::create(lookup(r.varint()));
+    uint64_t fields = r.varint();
+    for (uint64_t j = 0; j < fields; ++j) {
+      char const* key = lookup(r.varint());
+      char const* value = r.string();
+      if (obj)
+        obj->set(key, value);
+    }
+    if (obj)
+      objects.push_back(std::move(obj));
+  }
+  if (!r.at_end())
+    throw engine_error() << "Parsing of binary retention file failed: "
+                            "bad section size";
+}
+}  // namespace
+
+/**
+ *  Decode a binary retention file. Sections are decoded in parallel.
+ *
+ *  @param[in] content The whole file content.
+ *
+ *  @return The retention objects of each section, in the file order.
+ */
+std::vector<std::vector<object_ptr>> binary::decode(
+    std::string const& content) {
+  if (!is_binary(content))
+    throw engine_error() << "Parsing of binary retention file failed: "
+                            "bad magic";
+  reader header(content.data() + sizeof(magic), content.data() + content.size());
+  uint32_t file_version = header.fixed(4);
+  if (file_version != version)
+    throw engine_error() << "Parsing of binary retention file failed: "
+                            "unsupported version "
+                         << file_version;
+
+  if (content.size() < sizeof(magic) + 4 + trailer_size)
+    throw engine_error() << "Parsing of binary retention file failed: "
+                            "truncated data";
+  reader trailer(content.data() + content.size() - trailer_size,
+                 content.data() + content.size());
+  uint64_t table_offset = trailer.fixed(8);
+  uint32_t count = trailer.fixed(4);
+  if (table_offset > content.size() - trailer_size ||
+      (content.size() - trailer_size - table_offset) / table_entry_size <
+          count)
+    throw engine_error() << "Parsing of binary retention file failed: "
+                            "bad sections table";
+
+  struct entry {
+    uint64_t offset;
+    uint64_t size;
+    uint32_t records;
+  };
+  std::vector<entry> table(count);
+  reader t(content.data() + table_offset,
+           content.data() + content.size() - trailer_size);
+  for (entry& e : table) {
+    e.offset = t.fixed(8);
+    e.size = t.fixed(8);
+    e.records = t.fixed(4);
+  }
+
+  std::vector<std::vector<object_ptr>> retval(count);
+  std::atomic<uint32_t> next{0};
+  auto worker = [&] {
+    for (uint32_t i = next++; i < count; i = next++)
+      decode_section(content, table[i].offset, table[i].size,
+                     table[i].records, retval[i]);
+  };
+
+  uint32_t threads =
+      std::min<uint32_t>(std::max(1u, std::thread::hardware_concurrency()),
+                         count);
+  std::vector<std::future<void>> futures;
+  for (uint32_t i = 1; i < threads; ++i)
+    futures.push_back(std::async(std::launch::async, worker));
+  std::exception_ptr error;
+  try {
+    worker();
+  } catch (...) {
+    error = std::current_exception();
+    next = count;
+  }
+  for (auto& f : futures) {
+    try {
+      f.get();
+    } catch (...) {
+      if (!error)
+        error = std::current_exception();
+      next = count;
+    }
+  }
+  if (error)
+    std::rethrow_exception(error);
+  return retval;
+}
@@ -18,6 +18,8 @@
 */
 
 #include "com/centreon/engine/retention/dump.hh"
+#include <fcntl.h>
+#include <unistd.h>
 #include <fstream>
 #include "com/centreon/engine/anomalydetection.hh"
 #include "com/centreon/engine/broker.hh"
@@ -30,6 +32,8 @@
 #include "com/centreon/engine/exceptions/error.hh"
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/log_v2.hh"
+#include "com/centreon/engine/retention/binary.hh"
+#include "com/centreon/engine/retention/dumper.hh"
 
 using namespace com::centreon::engine;
 using namespace com::centreon::engine::configuration::applier;
@@ -127,39 +131,50 @@ std::ostream& dump::comments(std::ostream& os) {
  */
 std::ostream& dump::contact(std::ostream& os,
                             com::centreon::engine::contact const& obj) {
+  return dump::contact(os, snapshot::contact_data(obj));
+}
+
+/**
+ *  Dump retention of contact snapshot.
+ *
+ *  @param[out] os  The output stream.
+ *  @param[in]  obj The contact snapshot to dump.
+ *
+ *  @return The output stream.
+ */
+std::ostream& dump::contact(std::ostream& os,
+                            snapshot::contact_data const& obj) {
   os << "contact {\n"
         "contact_name="
-     << obj.get_name()
+     << obj.name
      << "\n"
         "host_notification_period="
-     << obj.get_host_notification_period()
+     << obj.host_notification_period
      << "\n"
         "host_notifications_enabled="
-     << obj.get_host_notifications_enabled()
+     << obj.host_notifications_enabled
      << "\n"
         "last_host_notification="
-     << static_cast<unsigned long>(obj.get_last_host_notification())
+     << static_cast<unsigned long>(obj.last_host_notification)
      << "\n"
         "last_service_notification="
-     << static_cast<unsigned long>(obj.get_last_service_notification())
+     << static_cast<unsigned long>(obj.last_service_notification)
      << "\n"
         "modified_attributes="
-     << (obj.get_modified_attributes() & ~0L)
+     << obj.modified_attributes
      << "\n"
         "modified_host_attributes="
-     << (obj.get_modified_host_attributes() &
-         ~config->retained_contact_host_attribute_mask())
+     << obj.modified_host_attributes
      << "\n"
         "modified_service_attributes="
-     << (obj.get_modified_service_attributes() &
-         ~config->retained_contact_service_attribute_mask())
+     << obj.modified_service_attributes
      << "\n"
         "service_notification_period="
-     << obj.get_service_notification_period()
+     << obj.service_notification_period
      << "\n"
         "service_notifications_enabled="
-     << obj.get_service_notifications_enabled() << "\n";
-  dump::customvariables(os, obj.get_custom_variables());
+     << obj.service_notifications_enabled << "\n";
+  dump::customvariables(os, obj.custom_variables);
   os << "}\n";
   return os;
 }
@@ -196,6 +211,22 @@ std::ostream& dump::customvariables(std::ostream& os,
   return os;
 }
 
+/**
+ *  Dump retention of custom variables snapshot.
+ *
+ *  @param[out] os  The output stream.
+ *  @param[in]  obj The custom variables to dump.
+ *
+ *  @return The output stream.
+ */
+std::ostream& dump::customvariables(
+    std::ostream& os,
+    std::vector<snapshot::customvariable_data> const& obj) {
+  for (auto const& cv : obj)
+    os << "_" << cv.name << "=" << cv.modified << "," << cv.value << "\n";
+  return os;
+}
+
 std::ostream& dump::notifications(
     std::ostream& os,
     std::array<std::unique_ptr<notification>, 6> const& obj) {
@@ -267,169 +298,178 @@ std::ostream& dump::header(std::ostream& os) {
  */
 std::ostream& dump::host(std::ostream& os,
                          com::centreon::engine::host const& obj) {
+  return dump::host(os, snapshot::host_data(obj));
+}
+
+/**
+ *  Dump retention of host snapshot.
+ *
+ *  @param[out] os  The output stream.
+ *  @param[in]  obj The host snapshot to dump.
+ *
+ *  @return The output stream.
+ */
+std::ostream& dump::host(std::ostream& os, snapshot::host_data const& obj) {
   os << "host {\n"
         "host_name="
-     << obj.name()
+     << obj.name
      << "\n"
         "host_id="
-     << obj.host_id()
+     << obj.host_id
      << "\n"
         "acknowledgement_type="
-     << obj.get_acknowledgement()
+     << obj.acknowledgement
      << "\n"
         "active_checks_enabled="
-     << obj.active_checks_enabled()
+     << obj.active_checks_enabled
      << "\n"
         "check_command="
-     << obj.check_command()
+     << obj.check_command
      << "\n"
         "check_execution_time="
-     << std::setprecision(3) << std::fixed << obj.get_execution_time()
+     << std::setprecision(3) << std::fixed << obj.execution_time
      << "\n"
         "check_latency="
-     << std::setprecision(3) << std::fixed << obj.get_latency()
+     << std::setprecision(3) << std::fixed << obj.latency
      << "\n"
         "check_options="
-     << obj.get_check_options()
+     << obj.check_options
      << "\n"
         "check_period="
-     << obj.check_period()
+     << obj.check_period
      << "\n"
         "check_type="
-     << obj.get_check_type()
+     << obj.check_type
      << "\n"
         "current_attempt="
-     << obj.get_current_attempt()
+     << obj.current_attempt
      << "\n"
         "current_event_id="
-     << obj.get_current_event_id()
+     << obj.current_event_id
      << "\n"
         "current_notification_id="
-     << obj.get_current_notification_id()
+     << obj.current_notification_id
      << "\n"
         "current_notification_number="
-     << obj.get_notification_number()
+     << obj.notification_number
      << "\n"
         "current_problem_id="
-     << obj.get_current_problem_id()
+     << obj.current_problem_id
      << "\n"
         "current_state="
-     << obj.get_current_state()
+     << obj.current_state
      << "\n"
         "event_handler="
-     << obj.event_handler()
+     << obj.event_handler
      << "\n"
         "event_handler_enabled="
-     << obj.event_handler_enabled()
+     << obj.event_handler_enabled
      << "\n"
         "flap_detection_enabled="
-     << obj.flap_detection_enabled()
+     << obj.flap_detection_enabled
      << "\n"
         "has_been_checked="
-     << obj.has_been_checked()
+     << obj.has_been_checked
      << "\n"
         "is_flapping="
-     << obj.get_is_flapping()
+     << obj.is_flapping
      << "\n"
         "last_acknowledgement="
-     << obj.last_acknowledgement()
+     << obj.last_acknowledgement
      << "\n"
         "last_check="
-     << static_cast<unsigned long>(obj.get_last_check())
+     << static_cast<unsigned long>(obj.last_check)
      << "\n"
         "last_event_id="
-     << obj.get_last_event_id()
+     << obj.last_event_id
      << "\n"
         "last_hard_state="
-     << obj.get_last_hard_state()
+     << obj.last_hard_state
      << "\n"
         "last_hard_state_change="
-     << static_cast<unsigned long>(obj.get_last_hard_state_change())
+     << static_cast<unsigned long>(obj.last_hard_state_change)
      << "\n"
         "last_notification="
-     << static_cast<unsigned long>(obj.get_last_notification())
+     << static_cast<unsigned long>(obj.last_notification)
      << "\n"
         "last_problem_id="
-     << obj.get_last_problem_id()
+     << obj.last_problem_id
      << "\n"
         "last_state="
-     << obj.get_last_state()
+     << obj.last_state
      << "\n"
         "last_state_change="
-     << static_cast<unsigned long>(obj.get_last_state_change())
+     << static_cast<unsigned long>(obj.last_state_change)
      << "\n"
         "last_time_down="
-     << static_cast<unsigned long>(obj.get_last_time_down())
+     << static_cast<unsigned long>(obj.last_time_down)
      << "\n"
         "last_time_unreachable="
-     << static_cast<unsigned long>(obj.get_last_time_unreachable())
+     << static_cast<unsigned long>(obj.last_time_unreachable)
      << "\n"
         "last_time_up="
-     << static_cast<unsigned long>(obj.get_last_time_up())
+     << static_cast<unsigned long>(obj.last_time_up)
      << "\n"
         "long_plugin_output="
-     << obj.get_long_plugin_output()
+     << obj.long_plugin_output
      << "\n"
         "max_attempts="
-     << obj.max_check_attempts()
+     << obj.max_attempts
      << "\n"
         "modified_attributes="
-     << (obj.get_modified_attributes() &
-         ~config->retained_host_attribute_mask())
+     << obj.modified_attributes
      << "\n"
         "next_check="
-     << static_cast<unsigned long>(obj.get_next_check())
+     << static_cast<unsigned long>(obj.next_check)
      << "\n"
         "normal_check_interval="
-     << obj.check_interval()
+     << obj.check_interval
      << "\n"
         "notification_period="
-     << obj.notification_period()
+     << obj.notification_period
      << "\n"
         "notifications_enabled="
-     << obj.get_notifications_enabled()
+     << obj.notifications_enabled
      << "\n"
         "notified_on_down="
-     << obj.get_notified_on(notifier::down)
+     << obj.notified_on_down
      << "\n"
         "notified_on_unreachable="
-     << obj.get_notified_on(notifier::unreachable)
+     << obj.notified_on_unreachable
      << "\n"
         "obsess_over_host="
-     << obj.obsess_over()
+     << obj.obsess_over
      << "\n"
         "passive_checks_enabled="
-     << obj.passive_checks_enabled()
+     << obj.passive_checks_enabled
      << "\n"
         "percent_state_change="
-     << std::setprecision(2) << std::fixed << obj.get_percent_state_change()
+     << std::setprecision(2) << std::fixed << obj.percent_state_change
      << "\n"
         "performance_data="
-     << obj.get_perf_data()
+     << obj.perf_data
      << "\n"
         "plugin_output="
-     << obj.get_plugin_output()
+     << obj.plugin_output
      << "\n"
         "problem_has_been_acknowledged="
-     << obj.problem_has_been_acknowledged()
+     << obj.problem_has_been_acknowledged
      << "\n"
         "process_performance_data="
-     << obj.get_process_performance_data()
+     << obj.process_performance_data
      << "\n"
         "retry_check_interval="
-     << obj.retry_interval()
+     << obj.retry_interval
      << "\n"
         "state_type="
-     << obj.get_state_type() << "\n";
+     << obj.state_type << "\n";
 
   os << "state_history=";
-  for (unsigned int x(0); x < obj.get_state_history().size(); ++x)
-    os << (x > 0 ? "," : "")
-       << obj.get_state_history()[(x + obj.get_state_history_index()) %
-                                  MAX_STATE_HISTORY_ENTRIES];
+  for (unsigned int x(0); x < obj.state_history.size(); ++x)
+    os << (x > 0 ? "," : "") << obj.state_history[x];
   os << "\n";
 
-  dump::notifications(os, obj.get_current_notifications());
+  os << obj.notifications;
   dump::customvariables(os, obj.custom_variables);
   os << "}\n";
   return os;
@@ -544,6 +584,9 @@ std::ostream& dump::program(std::ostream& os) {
 /**
  *  Save all data.
  *
+ *  Only the snapshot of the retained data is taken here, the retention file
+ *  is written by the dumper.
+ *
  *  @param[in] path The file path to use to save.
  *
  *  @return True on success, otherwise false.
@@ -556,30 +599,78 @@ bool dump::save(std::string const& path) {
   broker_retention_data(NEBTYPE_RETENTIONDATA_STARTSAVE, NEBFLAG_NONE,
                         NEBATTR_NONE, NULL);
 
+  auto start = std::chrono::steady_clock::now();
+  auto snap = std::make_unique<snapshot>();
+  dumper::set_snapshot_duration(
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::steady_clock::now() - start)
+          .count());
+
+  // send data to event broker.
+  broker_retention_data(NEBTYPE_RETENTIONDATA_ENDSAVE, NEBFLAG_NONE,
+                        NEBATTR_NONE, NULL);
+  return dumper::save(path, std::move(snap));
+}
+
+/**
+ *  Write a snapshot in a retention file.
+ *
+ *  The snapshot is written in a temporary file, synced and then renamed, so
+ *  that the retention file is never left partially written. The snapshot
+ *  tells if the text or the binary format is used.
+ *
+ *  @param[in]  path The file path to use to save.
+ *  @param[in]  snap The snapshot to write.
+ *  @param[out] size The size of the written file.
+ *
+ *  @return True on success, otherwise false.
+ */
+bool dump::write(std::string const& path, snapshot const& snap, size_t& size) {
+  static constexpr size_t buffer_size = 1 << 20;
+  std::string tmp_path{path + ".tmp"};
   bool ret(false);
   try {
-    std::ofstream stream(path.c_str(), std::ios::binary | std::ios::trunc);
-    if (!stream.is_open())
-      throw(engine_error() << "Cannot open retention file '"
-                           << config->state_retention_file() << "'");
-    dump::header(stream);
-    dump::info(stream);
-    dump::program(stream);
-    dump::hosts(stream);
-    dump::services(stream);
-    dump::contacts(stream);
-    dump::comments(stream);
-    dump::downtimes(stream);
+    {
+      std::unique_ptr<char[]> buffer{new char[buffer_size]};
+      std::ofstream stream;
+      stream.rdbuf()->pubsetbuf(buffer.get(), buffer_size);
+      stream.open(tmp_path, std::ios::binary | std::ios::trunc);
+      if (!stream.is_open())
+        throw engine_error() << "Cannot open retention file '" << tmp_path
+                             << "'";
+      if (snap.binary()) {
+        binary::encoder enc(stream);
+        snap.write(enc);
+        enc.finish();
+      } else
+        snap.write(stream);
+      size = stream.tellp();
+      stream.close();
+      if (stream.fail())
+        throw engine_error() << "Cannot write retention file '" << tmp_path
+                             << "'";
+    }
+
+    int fd = ::open(tmp_path.c_str(), O_RDONLY);
+    if (fd < 0 || ::fsync(fd) < 0) {
+      char const* msg = strerror(errno);
+      if (fd >= 0)
+        ::close(fd);
+      throw engine_error() << "Cannot sync retention file '" << tmp_path
+                           << "': " << msg;
+    }
+    ::close(fd);
+
+    if (::rename(tmp_path.c_str(), path.c_str()) < 0)
+      throw engine_error() << "Cannot rename retention file '" << tmp_path
+                           << "' to '" << path << "': " << strerror(errno);
 
     ret = true;
   } catch (std::exception const& e) {
+    ::unlink(tmp_path.c_str());
     engine_logger(log_runtime_error, basic) << e.what();
     log_v2::runtime()->error(e.what());
   }
-
-  // send data to event broker.
-  broker_retention_data(NEBTYPE_RETENTIONDATA_ENDSAVE, NEBFLAG_NONE,
-                        NEBATTR_NONE, NULL);
   return ret;
 }
 
@@ -594,196 +685,194 @@ bool dump::save(std::string const& path) {
  */
 std::ostream& dump::service(std::ostream& os,
                             const std::string_view& class_name,
-                            class service const& obj) {
-  std::string hostname;
-  if (obj.get_host_ptr())
-    hostname = obj.get_host_ptr()->name();
-
+                            snapshot::service_data const& obj) {
   os << class_name
      << " {\n"
         "host_name="
-     << obj.get_hostname()
+     << obj.host_name
      << "\n"
         "service_description="
-     << obj.description()
+     << obj.description
      << "\n"
         "host_id="
-     << service::services[{hostname, obj.description()}]->host_id()
+     << obj.host_id
      << "\n"
         "service_id="
-     << service::services[{hostname, obj.description()}]->service_id()
+     << obj.service_id
      << "\n"
         "acknowledgement_type="
-     << obj.get_acknowledgement()
+     << obj.acknowledgement
      << "\n"
         "active_checks_enabled="
-     << obj.active_checks_enabled()
+     << obj.active_checks_enabled
      << "\n"
         "check_command="
-     << obj.check_command()
+     << obj.check_command
      << "\n"
         "check_execution_time="
-     << std::setprecision(3) << std::fixed << obj.get_execution_time()
+     << std::setprecision(3) << std::fixed << obj.execution_time
      << "\n"
         "check_flapping_recovery_notification="
-     << obj.get_check_flapping_recovery_notification()
+     << obj.check_flapping_recovery_notification
      << "\n"
         "check_latency="
-     << std::setprecision(3) << std::fixed << obj.get_latency()
+     << std::setprecision(3) << std::fixed << obj.latency
      << "\n"
         "check_options="
-     << obj.get_check_options()
+     << obj.check_options
      << "\n"
         "check_period="
-     << obj.check_period()
+     << obj.check_period
      << "\n"
         "check_type="
-     << obj.get_check_type()
+     << obj.check_type
      << "\n"
         "current_attempt="
-     << obj.get_current_attempt()
+     << obj.current_attempt
      << "\n"
         "current_event_id="
-     << obj.get_current_event_id()
+     << obj.current_event_id
      << "\n"
         "current_notification_id="
-     << obj.get_current_notification_id()
+     << obj.current_notification_id
      << "\n"
         "current_notification_number="
-     << obj.get_notification_number()
+     << obj.notification_number
      << "\n"
         "current_problem_id="
-     << obj.get_current_problem_id()
+     << obj.current_problem_id
      << "\n"
         "current_state="
-     << obj.get_current_state()
+     << obj.current_state
      << "\n"
         "event_handler="
-     << obj.event_handler()
+     << obj.event_handler
      << "\n"
         "event_handler_enabled="
-     << obj.event_handler_enabled()
+     << obj.event_handler_enabled
      << "\n"
         "flap_detection_enabled="
-     << obj.flap_detection_enabled()
+     << obj.flap_detection_enabled
      << "\n"
         "has_been_checked="
-     << obj.has_been_checked()
+     << obj.has_been_checked
      << "\n"
         "is_flapping="
-     << obj.get_is_flapping()
+     << obj.is_flapping
      << "\n"
         "last_acknowledgement="
-     << obj.last_acknowledgement()
+     << obj.last_acknowledgement
      << "\n"
         "last_check="
-     << static_cast<unsigned long>(obj.get_last_check())
+     << static_cast<unsigned long>(obj.last_check)
      << "\n"
         "last_event_id="
-     << obj.get_last_event_id()
+     << obj.last_event_id
      << "\n"
         "last_hard_state="
-     << obj.get_last_hard_state()
+     << obj.last_hard_state
      << "\n"
         "last_hard_state_change="
-     << static_cast<unsigned long>(obj.get_last_hard_state_change())
+     << static_cast<unsigned long>(obj.last_hard_state_change)
      << "\n"
         "last_notification="
-     << static_cast<unsigned long>(obj.get_last_notification())
+     << static_cast<unsigned long>(obj.last_notification)
      << "\n"
         "last_problem_id="
-     << obj.get_last_problem_id()
+     << obj.last_problem_id
      << "\n"
         "last_state="
-     << obj.get_last_state()
+     << obj.last_state
      << "\n"
         "last_state_change="
-     << static_cast<unsigned long>(obj.get_last_state_change())
+     << static_cast<unsigned long>(obj.last_state_change)
      << "\n"
         "last_time_critical="
-     << static_cast<unsigned long>(obj.get_last_time_critical())
+     << static_cast<unsigned long>(obj.last_time_critical)
      << "\n"
         "last_time_ok="
-     << static_cast<unsigned long>(obj.get_last_time_ok())
+     << static_cast<unsigned long>(obj.last_time_ok)
      << "\n"
         "last_time_unknown="
-     << static_cast<unsigned long>(obj.get_last_time_unknown())
+     << static_cast<unsigned long>(obj.last_time_unknown)
      << "\n"
         "last_time_warning="
-     << static_cast<unsigned long>(obj.get_last_time_warning())
+     << static_cast<unsigned long>(obj.last_time_warning)
      << "\n"
         "long_plugin_output="
-     << obj.get_long_plugin_output()
+     << obj.long_plugin_output
      << "\n"
         "max_attempts="
-     << obj.max_check_attempts()
+     << obj.max_attempts
      << "\n"
         "modified_attributes="
-     << (obj.get_modified_attributes() &
-         ~config->retained_host_attribute_mask())
+     << obj.modified_attributes
      << "\n"
         "next_check="
-     << static_cast<unsigned long>(obj.get_next_check())
+     << static_cast<unsigned long>(obj.next_check)
      << "\n"
         "normal_check_interval="
-     << obj.check_interval()
+     << obj.check_interval
      << "\n"
         "notification_period="
-     << obj.notification_period()
+     << obj.notification_period
      << "\n"
         "notifications_enabled="
-     << obj.get_notifications_enabled()
+     << obj.notifications_enabled
      << "\n"
         "notified_on_critical="
-     << obj.get_notified_on(notifier::critical)
+     << obj.notified_on_critical
      << "\n"
         "notified_on_unknown="
-     << obj.get_notified_on(notifier::unknown)
+     << obj.notified_on_unknown
      << "\n"
         "notified_on_warning="
-     << obj.get_notified_on(notifier::warning)
+     << obj.notified_on_warning
      << "\n"
         "obsess_over_service="
-     << obj.obsess_over()
+     << obj.obsess_over
      << "\n"
         "passive_checks_enabled="
-     << obj.passive_checks_enabled()
+     << obj.passive_checks_enabled
      << "\n"
         "percent_state_change="
-     << std::setprecision(2) << std::fixed << obj.get_percent_state_change()
+     << std::setprecision(2) << std::fixed << obj.percent_state_change
      << "\n"
         "performance_data="
-     << obj.get_perf_data()
+     << obj.perf_data
      << "\n"
         "plugin_output="
-     << obj.get_plugin_output()
+     << obj.plugin_output
      << "\n"
         "problem_has_been_acknowledged="
-     << obj.problem_has_been_acknowledged()
+     << obj.problem_has_been_acknowledged
      << "\n"
         "process_performance_data="
-     << obj.get_process_performance_data()
+     << obj.process_performance_data
      << "\n"
         "retry_check_interval="
-     << obj.retry_interval()
+     << obj.retry_interval
      << "\n"
         "state_type="
-     << obj.get_state_type() << "\n";
+     << obj.state_type << "\n";
 
   os << "state_history=";
   for (unsigned int x(0); x < MAX_STATE_HISTORY_ENTRIES; ++x)
-    os << (x > 0 ? "," : "")
-       << obj.get_state_history()[(x + obj.get_state_history_index()) %
-                                  MAX_STATE_HISTORY_ENTRIES];
+    os << (x > 0 ? "," : "") << obj.state_history[x];
   os << "\n";
 
-  dump::notifications(os, obj.get_current_notifications());
+  os << obj.notifications;
   dump::customvariables(os, obj.custom_variables);
   return os;
 }
 
 std::ostream& dump::service(std::ostream& os,
                             com::centreon::engine::service const& obj) {
+  return dump::service(os, snapshot::service_data(obj));
+}
+
+std::ostream& dump::service(std::ostream& os,
+                            snapshot::service_data const& obj) {
   service(os, "service", obj);
   os << "}\n";
   return os;
@@ -792,8 +881,13 @@ std::ostream& dump::service(std::ostream& os,
 std::ostream& dump::anomalydetection(
     std::ostream& os,
     com::centreon::engine::anomalydetection const& obj) {
+  return dump::anomalydetection(os, snapshot::service_data(obj));
+}
+
+std::ostream& dump::anomalydetection(std::ostream& os,
+                                     snapshot::service_data const& obj) {
   service(os, "anomalydetection", obj);
-  os << "sensitivity=" << obj.get_sensitivity() << "\n"
+  os << "sensitivity=" << obj.sensitivity << "\n"
      << "}\n";
   return os;
 }
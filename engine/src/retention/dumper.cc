@@ -0,0 +1,148 @@
+/**
+ * Copyright 2023 Centreon
+ *
+ * This file is part of Centreon Engine.
+ *
+ * Centreon Engine is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * Centreon Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Centreon Engine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "com/centreon/engine/retention/dumper.hh"
+#include "com/centreon/engine/log_v2.hh"
+#include "com/centreon/engine/logging/logger.hh"
+#include "com/centreon/engine/retention/dump.hh"
+
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::logging;
+using namespace com::centreon::engine::retention;
+
+dumper* dumper::_instance = nullptr;
+std::atomic<uint64_t> dumper::_snapshot_duration{0};
+std::atomic<uint64_t> dumper::_write_duration{0};
+std::atomic<uint64_t> dumper::_size{0};
+
+/**
+ *  Constructor. The writer thread is started.
+ */
+dumper::dumper()
+    : _writing{false}, _exit{false}, _thread{&dumper::_run, this} {}
+
+/**
+ *  Destructor. A pending snapshot is written before the thread stops.
+ */
+dumper::~dumper() noexcept {
+  {
+    std::lock_guard<std::mutex> lck(_m);
+    _exit = true;
+  }
+  _cv.notify_all();
+  _thread.join();
+}
+
+void dumper::init() {
+  if (!_instance)
+    _instance = new dumper;
+}
+
+void dumper::deinit() {
+  if (_instance) {
+    delete _instance;
+    _instance = nullptr;
+  }
+}
+
+/**
+ *  Save a snapshot. It is given to the writer thread if the dumper is
+ *  initialized, otherwise it is written now.
+ *
+ *  @param[in] path The retention file path.
+ *  @param[in] snap The snapshot to write.
+ *
+ *  @return False if the synchronous write failed, true otherwise.
+ */
+bool dumper::save(std::string const& path, std::unique_ptr<snapshot> snap) {
+  if (!_instance)
+    return _write(path, *snap);
+
+  {
+    std::lock_guard<std::mutex> lck(_instance->_m);
+    if (_instance->_pending)
+      SPDLOG_LOGGER_WARN(log_v2::runtime(),
+                         "retention: previous dump not written yet, it is "
+                         "replaced by the new one");
+    _instance->_path = path;
+    _instance->_pending = std::move(snap);
+  }
+  _instance->_cv.notify_all();
+  return true;
+}
+
+/**
+ *  Wait for the pending snapshot to be written.
+ */
+void dumper::wait() {
+  if (!_instance)
+    return;
+  std::unique_lock<std::mutex> lck(_instance->_m);
+  _instance->_cv.wait(lck, [] {
+    return !_instance->_pending && !_instance->_writing;
+  });
+}
+
+/**
+ *  Writer thread main loop.
+ */
+void dumper::_run() {
+  std::unique_lock<std::mutex> lck(_m);
+  for (;;) {
+    _cv.wait(lck, [this] { return _pending || _exit; });
+    if (!_pending)
+      break;
+    std::unique_ptr<snapshot> snap{std::move(_pending)};
+    std::string path{_path};
+    _writing = true;
+    lck.unlock();
+    _write(path, *snap);
+    snap.reset();
+    lck.lock();
+    _writing = false;
+    _cv.notify_all();
+  }
+}
+
+/**
+ *  Write a snapshot and keep the statistics of the write.
+ *
+ *  @param[in] path The retention file path.
+ *  @param[in] snap The snapshot to write.
+ *
+ *  @return True on success.
+ */
+bool dumper::_write(std::string const& path, snapshot const& snap) {
+  auto start = std::chrono::steady_clock::now();
+  size_t size = 0;
+  bool retval = dump::write(path, snap, size);
+  uint64_t duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+                          std::chrono::steady_clock::now() - start)
+                          .count();
+  if (retval) {
+    _write_duration = duration;
+    _size = size;
+    SPDLOG_LOGGER_DEBUG(
+        log_v2::runtime(),
+        "retention: {} hosts and {} services written to '{}' in {}ms ({} "
+        "bytes)",
+        snap.hosts_count(), snap.services_count(), path, duration, size);
+  }
+  return retval;
+}
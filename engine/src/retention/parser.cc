@@ -22,6 +22,7 @@
 #include <fstream>
 
 #include "com/centreon/engine/exceptions/error.hh"
+#include "com/centreon/engine/retention/binary.hh"
 #include "com/centreon/engine/retention/state.hh"
 #include "com/centreon/engine/string.hh"
 
@@ -60,6 +61,17 @@ void parser::parse(std::string const& path, state& retention) {
     throw engine_error()
         << "Parsing of retention file failed: Can't open file '" << path << "'";
 
+  // Binary files start with a magic, other files use the legacy text format.
+  std::string magic(sizeof(binary::magic), '\0');
+  stream.read(&magic[0], magic.size());
+  magic.resize(stream.gcount());
+  if (binary::is_binary(magic)) {
+    _parse_binary(stream, retention);
+    return;
+  }
+  stream.clear();
+  stream.seekg(0);
+
   std::shared_ptr<object> obj;
   std::string input;
   unsigned int current_line(0);
@@ -100,6 +112,25 @@ void parser::parse(std::string const& path, state& retention) {
   }
 }
 
+/**
+ *  Parse a binary retention file. Its sections are decoded in parallel, then
+ *  objects are stored in the file order.
+ *
+ *  @param[in] stream    The retention file.
+ *  @param[in] retention The state to fill.
+ */
+void parser::_parse_binary(std::istream& stream, state& retention) {
+  stream.seekg(0, std::ios::end);
+  std::string content(stream.tellg(), '\0');
+  stream.seekg(0);
+  if (!stream.read(&content[0], content.size()))
+    throw engine_error() << "Parsing of retention file failed: Can't read file";
+
+  for (auto& section : binary::decode(content))
+    for (object_ptr& obj : section)
+      (this->*_store[obj->type()])(retention, std::move(obj));
+}
+
 /**
  *  Store object into the state list.
  *
@@ -0,0 +1,290 @@
+/**
+ * Copyright 2023 Centreon
+ *
+ * This file is part of Centreon Engine.
+ *
+ * Centreon Engine is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * Centreon Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Centreon Engine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "com/centreon/engine/retention/snapshot.hh"
+#include "com/centreon/engine/anomalydetection.hh"
+#include "com/centreon/engine/contact.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/host.hh"
+#include "com/centreon/engine/retention/binary.hh"
+#include "com/centreon/engine/retention/dump.hh"
+#include "com/centreon/engine/service.hh"
+
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::retention;
+
+/**
+ *  Copy custom variables in their iteration order.
+ *
+ *  @param[in] vars The custom variables to copy.
+ *
+ *  @return The copied custom variables.
+ */
+static std::vector<snapshot::customvariable_data> copy_customvariables(
+    map_customvar const& vars) {
+  std::vector<snapshot::customvariable_data> retval;
+  retval.reserve(vars.size());
+  for (auto const& cv : vars)
+    retval.push_back(
+        {cv.first, cv.second.has_been_modified(), cv.second.get_value()});
+  return retval;
+}
+
+/**
+ *  Copy the retained fields shared by hosts and services.
+ *
+ *  @param[in] obj The host or the service.
+ */
+snapshot::notifier_data::notifier_data(notifier const& obj)
+    : acknowledgement{obj.get_acknowledgement()},
+      active_checks_enabled{obj.active_checks_enabled()},
+      check_command{obj.check_command()},
+      execution_time{obj.get_execution_time()},
+      latency{obj.get_latency()},
+      check_options{obj.get_check_options()},
+      check_period{obj.check_period()},
+      check_type{obj.get_check_type()},
+      current_attempt{obj.get_current_attempt()},
+      current_event_id{obj.get_current_event_id()},
+      current_notification_id{obj.get_current_notification_id()},
+      notification_number{obj.get_notification_number()},
+      current_problem_id{obj.get_current_problem_id()},
+      current_state{0},
+      event_handler{obj.event_handler()},
+      event_handler_enabled{obj.event_handler_enabled()},
+      flap_detection_enabled{obj.flap_detection_enabled()},
+      has_been_checked{obj.has_been_checked()},
+      is_flapping{obj.get_is_flapping()},
+      last_acknowledgement{obj.last_acknowledgement()},
+      last_check{obj.get_last_check()},
+      last_event_id{obj.get_last_event_id()},
+      last_hard_state{0},
+      last_hard_state_change{obj.get_last_hard_state_change()},
+      last_notification{obj.get_last_notification()},
+      last_problem_id{obj.get_last_problem_id()},
+      last_state{0},
+      last_state_change{obj.get_last_state_change()},
+      long_plugin_output{obj.get_long_plugin_output()},
+      max_attempts{obj.max_check_attempts()},
+      modified_attributes{obj.get_modified_attributes() &
+                          ~config->retained_host_attribute_mask()},
+      next_check{obj.get_next_check()},
+      check_interval{obj.check_interval()},
+      notification_period{obj.notification_period()},
+      notifications_enabled{obj.get_notifications_enabled()},
+      obsess_over{obj.obsess_over()},
+      passive_checks_enabled{obj.passive_checks_enabled()},
+      percent_state_change{obj.get_percent_state_change()},
+      perf_data{obj.get_perf_data()},
+      plugin_output{obj.get_plugin_output()},
+      problem_has_been_acknowledged{obj.problem_has_been_acknowledged()},
+      retry_interval{obj.retry_interval()},
+      state_type{obj.get_state_type()},
+      custom_variables{copy_customvariables(obj.custom_variables)} {
+  for (unsigned int x = 0; x < MAX_STATE_HISTORY_ENTRIES; ++x)
+    state_history[x] =
+        obj.get_state_history()[(x + obj.get_state_history_index()) %
+                                MAX_STATE_HISTORY_ENTRIES];
+
+  // Notifications are rare, don't build a stream for nothing.
+  for (auto const& n : obj.get_current_notifications())
+    if (n) {
+      std::ostringstream oss;
+      dump::notifications(oss, obj.get_current_notifications());
+      notifications = oss.str();
+      break;
+    }
+}
+
+/**
+ *  Copy the retained fields of a host.
+ *
+ *  @param[in] obj The host.
+ */
+snapshot::host_data::host_data(com::centreon::engine::host const& obj)
+    : notifier_data(obj),
+      name{obj.name()},
+      host_id{obj.host_id()},
+      last_time_down{obj.get_last_time_down()},
+      last_time_unreachable{obj.get_last_time_unreachable()},
+      last_time_up{obj.get_last_time_up()},
+      notified_on_down{obj.get_notified_on(notifier::down)},
+      notified_on_unreachable{obj.get_notified_on(notifier::unreachable)},
+      process_performance_data{obj.get_process_performance_data()} {
+  current_state = obj.get_current_state();
+  last_hard_state = obj.get_last_hard_state();
+  last_state = obj.get_last_state();
+}
+
+/**
+ *  Copy the retained fields of a service or of an anomaly detection.
+ *
+ *  @param[in] obj The service.
+ */
+snapshot::service_data::service_data(com::centreon::engine::service const& obj)
+    : notifier_data(obj),
+      host_name{obj.get_hostname()},
+      description{obj.description()},
+      host_id{obj.host_id()},
+      service_id{obj.service_id()},
+      check_flapping_recovery_notification{
+          obj.get_check_flapping_recovery_notification()},
+      last_time_critical{obj.get_last_time_critical()},
+      last_time_ok{obj.get_last_time_ok()},
+      last_time_unknown{obj.get_last_time_unknown()},
+      last_time_warning{obj.get_last_time_warning()},
+      notified_on_critical{obj.get_notified_on(notifier::critical)},
+      notified_on_unknown{obj.get_notified_on(notifier::unknown)},
+      notified_on_warning{obj.get_notified_on(notifier::warning)},
+      process_performance_data{obj.get_process_performance_data()},
+      is_anomalydetection{obj.get_service_type() ==
+                          service_type::ANOMALY_DETECTION},
+      sensitivity{0.0} {
+  current_state = obj.get_current_state();
+  last_hard_state = obj.get_last_hard_state();
+  last_state = obj.get_last_state();
+  if (is_anomalydetection)
+    sensitivity =
+        static_cast<com::centreon::engine::anomalydetection const&>(obj)
+            .get_sensitivity();
+}
+
+/**
+ *  Copy the retained fields of a contact.
+ *
+ *  @param[in] obj The contact.
+ */
+snapshot::contact_data::contact_data(com::centreon::engine::contact const& obj)
+    : name{obj.get_name()},
+      host_notification_period{obj.get_host_notification_period()},
+      host_notifications_enabled{obj.get_host_notifications_enabled()},
+      last_host_notification{obj.get_last_host_notification()},
+      last_service_notification{obj.get_last_service_notification()},
+      modified_attributes{obj.get_modified_attributes() & ~0UL},
+      modified_host_attributes{
+          obj.get_modified_host_attributes() &
+          ~config->retained_contact_host_attribute_mask()},
+      modified_service_attributes{
+          obj.get_modified_service_attributes() &
+          ~config->retained_contact_service_attribute_mask()},
+      service_notification_period{obj.get_service_notification_period()},
+      service_notifications_enabled{obj.get_service_notifications_enabled()},
+      custom_variables{copy_customvariables(obj.get_custom_variables())} {}
+
+/**
+ *  Take a snapshot of the retained state of the engine.
+ */
+snapshot::snapshot() : _binary{config->use_binary_retention_format()} {
+  {
+    std::ostringstream oss;
+    dump::info(oss);
+    _info = oss.str();
+  }
+  {
+    std::ostringstream oss;
+    dump::program(oss);
+    _program = oss.str();
+  }
+
+  _hosts.reserve(com::centreon::engine::host::hosts.size());
+  for (auto const& p : com::centreon::engine::host::hosts)
+    _hosts.emplace_back(*p.second);
+
+  _services.reserve(com::centreon::engine::service::services.size());
+  for (auto const& p : com::centreon::engine::service::services)
+    _services.emplace_back(*p.second);
+
+  _contacts.reserve(com::centreon::engine::contact::contacts.size());
+  for (auto const& p : com::centreon::engine::contact::contacts)
+    _contacts.emplace_back(*p.second);
+
+  {
+    std::ostringstream oss;
+    dump::comments(oss);
+    _comments = oss.str();
+  }
+  {
+    std::ostringstream oss;
+    dump::downtimes(oss);
+    _downtimes = oss.str();
+  }
+}
+
+/**
+ *  Write the snapshot in the retention file format.
+ *
+ *  @param[out] os The output stream.
+ *
+ *  @return The output stream.
+ */
+std::ostream& snapshot::write(std::ostream& os) const {
+  dump::header(os);
+  os << _info << _program;
+  for (host_data const& h : _hosts)
+    dump::host(os, h);
+  for (service_data const& s : _services) {
+    if (s.is_anomalydetection)
+      dump::anomalydetection(os, s);
+    else
+      dump::service(os, s);
+  }
+  for (contact_data const& c : _contacts)
+    dump::contact(os, c);
+  os << _comments << _downtimes;
+  return os;
+}
+
+/**
+ *  Write the snapshot in the binary retention format.
+ *
+ *  Records are formatted as text by batches and then encoded, so that both
+ *  formats have exactly the same content.
+ *
+ *  @param[out] enc The binary encoder.
+ */
+void snapshot::write(binary::encoder& enc) const {
+  static constexpr std::streamoff batch_size = 1 << 20;
+  std::ostringstream oss;
+  auto flush = [&oss, &enc](bool force) {
+    if (force || oss.tellp() >= batch_size) {
+      enc.add(oss.str());
+      oss.str("");
+    }
+  };
+
+  oss << _info << _program;
+  flush(true);
+  for (host_data const& h : _hosts) {
+    dump::host(oss, h);
+    flush(false);
+  }
+  for (service_data const& s : _services) {
+    if (s.is_anomalydetection)
+      dump::anomalydetection(oss, s);
+    else
+      dump::service(oss, s);
+    flush(false);
+  }
+  for (contact_data const& c : _contacts) {
+    dump::contact(oss, c);
+    flush(false);
+  }
+  oss << _comments << _downtimes;
+  flush(true);
+}
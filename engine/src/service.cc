@@ -2748,13 +2748,13 @@ bool service::schedule_check(time_t check_time,
 
   // Default is to use the new event.
   bool use_original_event = false;
-  timed_event_list::iterator found = events::loop::instance().find_event(
+  timed_event* found = events::loop::instance().find_event(
       events::loop::low, timed_event::EVENT_SERVICE_CHECK, this);
 
   // We found another service check event for this service in
   // the queue - what should we do?
-  if (found != events::loop::instance().list_end(events::loop::low)) {
-    auto& temp_event = *found;
+  if (found) {
+    timed_event* temp_event = found;
     engine_logger(dbg_checks, most)
         << "Found another service check event for this service @ "
         << my_ctime(&temp_event->run_time);
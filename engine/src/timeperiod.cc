@@ -36,6 +36,8 @@ using namespace com::centreon::engine::logging;
 using namespace com::centreon::engine::string;
 
 timeperiod_map timeperiod::timeperiods;
+bool timeperiod::use_compiled = true;
+uint64_t timeperiod::_generation = 1;
 
 /**
  *  Create a new timeperiod in memory.
@@ -798,20 +800,15 @@ bool check_time_against_period_for_notif(time_t test_time,
 }
 
 /**
- *  Get the next invalid time within a time period (used to compute
- *  exclusions).
+ *  Compute the next invalid time within a time period.
  *
- *  @param[in]  preferred_time  The preferred time to check.
- *  @param[out] invalid_time    Variable to fill.
- *  @param[in]  notif_timeperiod    if called for the notification .
+ *  @param[in] preferred_time    The preferred time to check.
+ *  @param[in] notif_timeperiod  if called for the notification .
+ *
+ *  @return The next invalid time.
  */
-void timeperiod::get_next_invalid_time_per_timeperiod(time_t preferred_time,
-                                                      time_t* invalid_time,
-                                                      bool notif_timeperiod) {
-  engine_logger(dbg_functions, basic)
-      << "get_next_invalid_time_per_timeperiod()";
-  log_v2::functions()->trace("get_next_invalid_time_per_timeperiod()");
-
+time_t timeperiod::_next_invalid_time(time_t preferred_time,
+                                      bool notif_timeperiod) {
   // If no time can be found, the original preferred time will be set
   // in invalid_time at the end of the loop.
   time_t original_preferred_time(preferred_time);
@@ -943,10 +940,33 @@ void timeperiod::get_next_invalid_time_per_timeperiod(time_t preferred_time,
 
   // If we couldn't find a time period there must be none defined.
   if (earliest_time != (time_t)-1)
-    *invalid_time = original_preferred_time;
+    return original_preferred_time;
   // Else use the calculated time.
   else
-    *invalid_time = preferred_time;
+    return preferred_time;
+}
+
+/**
+ *  Get the next invalid time within a time period (used to compute
+ *  exclusions).
+ *
+ *  @param[in]  preferred_time  The preferred time to check.
+ *  @param[out] invalid_time    Variable to fill.
+ *  @param[in]  notif_timeperiod    if called for the notification .
+ */
+void timeperiod::get_next_invalid_time_per_timeperiod(time_t preferred_time,
+                                                      time_t* invalid_time,
+                                                      bool notif_timeperiod) {
+  engine_logger(dbg_functions, basic)
+      << "get_next_invalid_time_per_timeperiod()";
+  log_v2::functions()->trace("get_next_invalid_time_per_timeperiod()");
+
+  compiled* c = _get_compiled(notif_timeperiod);
+  time_t t = c ? c->invalid.lookup(preferred_time)
+               : common::time_segments::not_compiled;
+  if (t == common::time_segments::not_compiled)
+    t = _next_invalid_time(preferred_time, notif_timeperiod);
+  *invalid_time = t;
 }
 
 /**
@@ -985,22 +1005,15 @@ static time_t _get_next_valid_time_in_timeranges(time_t preferred_time,
 }
 
 /**
- *  Get the next valid time within a time period.
+ *  Compute the next valid time within a time period.
  *
- *  @param[in]  preferred_time      The preferred time to check.
- *  @param[out] valid_time          Variable to fill.
- *  @param[in]  notif_timeperiod    if called for the notification .
+ *  @param[in] preferred_time    The preferred time to check.
+ *  @param[in] notif_timeperiod  if called for the notification .
+ *
+ *  @return The next valid time or -1 if none is found in the upcoming year.
  */
-void timeperiod::get_next_valid_time_per_timeperiod(time_t preferred_time,
-                                                    time_t* valid_time,
-                                                    bool notif_timeperiod) {
-  engine_logger(dbg_functions, basic) << "get_next_valid_time_per_timeperiod()";
-  log_v2::functions()->trace("get_next_valid_time_per_timeperiod()");
-
-  // If no time can be found, the original preferred time will be set
-  // in valid_time at the end of the loop.
-  time_t original_preferred_time(preferred_time);
-
+time_t timeperiod::_next_valid_time(time_t preferred_time,
+                                    bool notif_timeperiod) {
   // Loop through the upcoming year a day at a time.
   time_t earliest_time((time_t)-1);
   time_info ti;
@@ -1100,17 +1113,155 @@ void timeperiod::get_next_valid_time_per_timeperiod(time_t preferred_time,
           _add_round_days_to_midnight(ti.midnight, 24 * 60 * 60);
   }
 
-  // If we couldn't find a time period there must be none defined.
-  if ((earliest_time == (time_t)-1) && !notif_timeperiod)
-    *valid_time = original_preferred_time;
-  // Else use the calculated time.
-  else
-    *valid_time = earliest_time;
+  return earliest_time;
+}
+
+/**
+ *  Get the next valid time within a time period.
+ *
+ *  @param[in]  preferred_time      The preferred time to check.
+ *  @param[out] valid_time          Variable to fill.
+ *  @param[in]  notif_timeperiod    if called for the notification .
+ */
+void timeperiod::get_next_valid_time_per_timeperiod(time_t preferred_time,
+                                                    time_t* valid_time,
+                                                    bool notif_timeperiod) {
+  engine_logger(dbg_functions, basic) << "get_next_valid_time_per_timeperiod()";
+  log_v2::functions()->trace("get_next_valid_time_per_timeperiod()");
+
+  compiled* c = _get_compiled(notif_timeperiod);
+  time_t t = c ? c->valid.lookup(preferred_time)
+               : common::time_segments::not_compiled;
+  if (t == common::time_segments::not_compiled) {
+    t = _next_valid_time(preferred_time, notif_timeperiod);
+    // If we couldn't find a time period there must be none defined.
+    if (t == (time_t)-1 && !notif_timeperiod)
+      t = preferred_time;
+  }
+  *valid_time = t;
   log_v2::functions()->trace(
       "get_next_valid_time_per_timeperiod {} valid_time={}", _name,
       *valid_time);
 }
 
+/**
+ *  Get the lookups of this time period compiled for the current timezone,
+ *  they are compiled again every day and when the time periods are resolved
+ *  again.
+ *
+ *  @param[in] notif_timeperiod  if called for the notification .
+ *
+ *  @return The compiled lookups or nullptr if they are disabled.
+ */
+timeperiod::compiled* timeperiod::_get_compiled(bool notif_timeperiod) {
+  if (!use_compiled)
+    return nullptr;
+
+  const char* tz = getenv("TZ");
+  compiled& c = _compiled[notif_timeperiod][tz ? tz : ""];
+  time_t now = time(nullptr);
+  if (c.generation == _generation && now >= c.start && now < c.next_day)
+    return &c;
+
+  struct tm midnight;
+  localtime_r(&now, &midnight);
+  midnight.tm_sec = 0;
+  midnight.tm_min = 0;
+  midnight.tm_hour = 0;
+  midnight.tm_isdst = -1;
+  c.generation = _generation;
+  c.start = mktime(&midnight);
+  c.next_day = _add_round_days_to_midnight(c.start, 24 * 60 * 60);
+  time_t end = _add_round_days_to_midnight(c.start, 8 * 24 * 60 * 60);
+
+  // Time periods in an exclusion loop are always computed directly, their
+  // lookups depend on the exclusions being computed.
+  std::vector<time_t> boundaries;
+  std::unordered_set<const timeperiod*> path;
+  if (!_add_boundaries(c.start, end, boundaries, path)) {
+    c.valid.clear();
+    c.invalid.clear();
+    return &c;
+  }
+
+  c.valid.compile(
+      c.start, end, boundaries,
+      [this, notif_timeperiod](time_t t) -> time_t {
+        time_t valid = _next_valid_time(t, notif_timeperiod);
+        if (valid != (time_t)-1)
+          return valid;
+        // Nothing in the upcoming year, it must also be the case a day later
+        // to be sure of the result until the next boundary.
+        if (_next_valid_time(t + 25 * 60 * 60, notif_timeperiod) !=
+            (time_t)-1)
+          return common::time_segments::not_compiled;
+        return notif_timeperiod ? (time_t)-1 : t;
+      },
+      true);
+  c.invalid.compile(
+      c.start, end, boundaries,
+      [this, notif_timeperiod](time_t t) {
+        return _next_invalid_time(t, notif_timeperiod);
+      },
+      false);
+  return &c;
+}
+
+/**
+ *  Add the times where the lookups of this time period may change to a
+ *  list, those of the excluded time periods are added too.
+ *
+ *  @param[in]     start       Midnight of the first day.
+ *  @param[in]     end         Midnight after the last day.
+ *  @param[in,out] boundaries  The list of times.
+ *  @param[in,out] path        Time periods whose exclusions are browsed.
+ *
+ *  @return False if the time period is in an exclusion loop.
+ */
+bool timeperiod::_add_boundaries(
+    time_t start,
+    time_t end,
+    std::vector<time_t>& boundaries,
+    std::unordered_set<const timeperiod*>& path) const {
+  if (!path.insert(this).second)
+    return false;
+
+  for (time_t day = start; day < end;
+       day = _add_round_days_to_midnight(day, 24 * 60 * 60)) {
+    boundaries.push_back(day);
+    struct tm midnight;
+    localtime_r(&day, &midnight);
+    auto add_timeranges = [&](const timerange_list& timeranges) {
+      for (const timerange& trange : timeranges) {
+        time_t range_start((time_t)-1);
+        time_t range_end((time_t)-1);
+        _timerange_to_time_t(trange, &midnight, range_start, range_end);
+        boundaries.push_back(range_start);
+        boundaries.push_back(range_end);
+      }
+    };
+    add_timeranges(days[midnight.tm_wday]);
+    for (const daterange_list& dateranges : exceptions)
+      for (const daterange& drange : dateranges)
+        add_timeranges(drange.get_timerange());
+  }
+
+  for (const auto& excluded : _exclusions)
+    if (excluded.second &&
+        !excluded.second->_add_boundaries(start, end, boundaries, path))
+      return false;
+  path.erase(this);
+  return true;
+}
+
+/**
+ *  Forget the compiled lookups of all the time periods, they are compiled
+ *  again on their next lookup.
+ */
+void timeperiod::invalidate_compiled() {
+  ++_generation;
+}
+
 /**
  *  Given a preferred time, get the next valid time within a time
  *  period.
@@ -1188,6 +1339,9 @@ void timeperiod::resolve(int& w __attribute__((unused)), int& e) {
     }
   }
 
+  // Exclusions may have changed.
+  invalidate_compiled();
+
   // Add errors.
   if (errors) {
     e += errors;
@@ -41,7 +41,9 @@
 #include "com/centreon/engine/log_v2.hh"
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/macros.hh"
+#include "com/centreon/engine/macros/command_template.hh"
 #include "com/centreon/engine/nebmods.hh"
+#include "com/centreon/engine/retention/dumper.hh"
 #include "com/centreon/engine/shared.hh"
 #include "com/centreon/engine/string.hh"
 
@@ -137,7 +139,6 @@ int get_raw_command_line_r(nagios_macros* mac,
                            std::string& full_command,
                            int macro_options) {
   char temp_arg[MAX_COMMAND_BUFFER] = "";
-  std::string arg_buffer;
   unsigned int x = 0;
   unsigned int y = 0;
   int arg_index = 0;
@@ -201,9 +202,8 @@ int get_raw_command_line_r(nagios_macros* mac,
 
       /* ADDED 01/29/04 EG */
       /* process any macros we find in the argument */
-      process_macros_r(mac, temp_arg, arg_buffer, macro_options);
-
-      mac->argv[x] = arg_buffer;
+      macros::command_template::get(temp_arg)->expand(mac, mac->argv[x],
+                                                      macro_options);
     }
   }
 
@@ -417,6 +417,9 @@ bool set_cloexec(int fd) {
  *  Do some cleanup before we exit.
  */
 void cleanup() {
+  // Wait for the last retention dump.
+  retention::dumper::deinit();
+
   // Unload modules.
   if (!test_scheduling && !verify_config) {
     checks::checker::deinit();
@@ -35,6 +35,7 @@
 #include "com/centreon/engine/log_v2.hh"
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/macros.hh"
+#include "com/centreon/engine/retention/dumper.hh"
 #include "com/centreon/engine/statusdata.hh"
 
 using namespace com::centreon;
@@ -283,6 +284,11 @@ int xsddefault_save_status_data() {
       << check_statistics[SERIAL_HOST_CHECK_STATS].minute_stats[0] << ","
       << check_statistics[SERIAL_HOST_CHECK_STATS].minute_stats[1] << ","
       << check_statistics[SERIAL_HOST_CHECK_STATS].minute_stats[2]
+      << "\n"
+         "\tretention_dump_stats="
+      << retention::dumper::snapshot_duration() << ","
+      << retention::dumper::write_duration() << ","
+      << retention::dumper::size()
       << "\n"
          "\t}\n\n";
 
@@ -20,6 +20,7 @@
 #include <gtest/gtest.h>
 
 #include <cstring>
+#include <fstream>
 
 #include "../test_engine.hh"
 #include "../timeperiod/utils.hh"
@@ -40,6 +41,7 @@
 #include "com/centreon/engine/configuration/state.hh"
 #include "com/centreon/engine/exceptions/error.hh"
 #include "com/centreon/engine/retention/dump.hh"
+#include "com/centreon/engine/retention/dumper.hh"
 #include "com/centreon/engine/serviceescalation.hh"
 #include "com/centreon/engine/timezone_manager.hh"
 #include "helper.hh"
@@ -564,3 +566,39 @@ TEST_F(ServiceRetention, RetentionWithMultilineOutput) {
   ASSERT_NE(str.find("host_name=test_host"), std::string::npos);
   ASSERT_NE(str.find("service_description=test_svc"), std::string::npos);
 }
+
+TEST_F(ServiceRetention, RetentionDumpedInBackground) {
+  set_time(55000);
+  std::string path{"/tmp/centengine_retention_dump.dat"};
+  ::unlink(path.c_str());
+  config->retain_state_information(true);
+  _svc->set_plugin_output("OK: dumped in background");
+
+  // The legacy dump, object by object on a single stream.
+  std::ostringstream oss;
+  retention::dump::header(oss);
+  retention::dump::info(oss);
+  retention::dump::program(oss);
+  retention::dump::hosts(oss);
+  retention::dump::services(oss);
+  retention::dump::contacts(oss);
+  retention::dump::comments(oss);
+  retention::dump::downtimes(oss);
+
+  retention::dumper::init();
+  ASSERT_TRUE(retention::dump::save(path));
+  // The snapshot is taken, later changes are not dumped.
+  _svc->set_plugin_output("OK: changed after the snapshot");
+  retention::dumper::wait();
+  retention::dumper::deinit();
+
+  std::ifstream ifs(path);
+  std::string content{std::istreambuf_iterator<char>(ifs),
+                      std::istreambuf_iterator<char>()};
+  ASSERT_EQ(content, oss.str());
+  ASSERT_EQ(retention::dumper::size(), content.size());
+  ASSERT_NE(content.find("plugin_output=OK: dumped in background\n"),
+            std::string::npos);
+  ASSERT_NE(::access((path + ".tmp").c_str(), F_OK), 0);
+  ::unlink(path.c_str());
+}
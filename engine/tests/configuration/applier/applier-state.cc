@@ -19,6 +19,7 @@
 
 #include <google/protobuf/util/message_differencer.h>
 #include <gtest/gtest.h>
+#include <filesystem>
 #include "com/centreon/engine/configuration/applier/state.hh"
 #include "com/centreon/engine/configuration/parser.hh"
 #include "com/centreon/engine/globals.hh"
@@ -1017,3 +1018,142 @@ TEST_F(ApplierState, StateLegacyParsingHostdependencyWithoutHost) {
   CreateBadConf(ConfigurationObject::HOSTDEPENDENCY);
   ASSERT_THROW(p.parse("/tmp/centengine.cfg", config), std::exception);
 }
+
+/**
+ * @brief Parse the configuration with a sequential parser and with a parallel
+ * one. Both results and both errors, if any, must be the same.
+ */
+static void ParseSequentialAndParallel(const std::string& path) {
+  configuration::state seq_config;
+  configuration::state par_config;
+  configuration::parser seq(configuration::parser::read_all, 1);
+  configuration::parser par(configuration::parser::read_all, 8);
+  std::string seq_error;
+  std::string par_error;
+  try {
+    seq.parse(path, seq_config);
+  } catch (const std::exception& e) {
+    seq_error = e.what();
+  }
+  try {
+    par.parse(path, par_config);
+  } catch (const std::exception& e) {
+    par_error = e.what();
+  }
+  ASSERT_EQ(seq_error, par_error);
+  ASSERT_TRUE(seq_config == par_config);
+}
+
+/**
+ * @brief Create a configuration made of a directory of many small files.
+ * Templates are defined in the last file, after the objects using them.
+ */
+static void CreateDirConf(size_t files) {
+  std::filesystem::create_directories("/tmp/parser_cfg_dir");
+  for (size_t i = 0; i < files; ++i) {
+    std::ostringstream oss;
+    for (size_t h = i * 20; h < (i + 1) * 20; ++h) {
+      oss << "define host {\n"
+             "    use                            generic-host\n"
+             "    host_name                      host_"
+          << h << "\n    address                        10.0.0." << h % 256
+          << "\n    _HOST_ID                       " << h + 1
+          << "\n}\n"
+             "define service {\n"
+             "    use                            generic-service\n"
+             "    host_name                      host_"
+          << h
+          << "\n    service_description            service_" << h
+          << "\n    _SERVICE_ID                    " << h + 1 << "\n}\n";
+    }
+    CreateFile(fmt::format("/tmp/parser_cfg_dir/hosts_{:03}.cfg", i),
+               oss.str());
+  }
+  CreateFile("/tmp/parser_cfg_dir/templates.cfg",
+             "define command {\n"
+             "    command_name                   check_ping\n"
+             "    command_line                   /bin/true\n"
+             "}\n"
+             "define host {\n"
+             "    name                           generic-host\n"
+             "    check_command                  check_ping\n"
+             "    max_check_attempts             3\n"
+             "    register                       0\n"
+             "}\n"
+             "define service {\n"
+             "    name                           generic-service\n"
+             "    check_command                  check_ping\n"
+             "    check_interval                 5\n"
+             "    register                       0\n"
+             "}\n");
+  CreateFile("/tmp/centengine.cfg",
+             "cfg_dir=/tmp/parser_cfg_dir\n"
+             "check_service_freshness=1\n");
+}
+
+TEST_F(ApplierState, StateLegacyParsingParallelSameAsSequential) {
+  CreateConf();
+  ParseSequentialAndParallel("/tmp/centengine.cfg");
+  for (ConfigurationObject obj :
+       {ConfigurationObject::ANOMALYDETECTION,
+        ConfigurationObject::CONTACTGROUP, ConfigurationObject::HOSTDEPENDENCY,
+        ConfigurationObject::HOSTESCALATION,
+        ConfigurationObject::SERVICEDEPENDENCY,
+        ConfigurationObject::SERVICEESCALATION,
+        ConfigurationObject::SERVICEGROUP, ConfigurationObject::SEVERITY,
+        ConfigurationObject::TAG}) {
+    CreateBadConf(obj);
+    ParseSequentialAndParallel("/tmp/centengine.cfg");
+  }
+  RmConf();
+}
+
+TEST_F(ApplierState, StateLegacyParsingParallelDirectory) {
+  CreateDirConf(50);
+  ParseSequentialAndParallel("/tmp/centengine.cfg");
+
+  configuration::state config;
+  configuration::parser p;
+  p.parse("/tmp/centengine.cfg", config);
+  ASSERT_EQ(config.hosts().size(), 1000u);
+  ASSERT_EQ(config.services().size(), 1000u);
+  ASSERT_EQ(config.hosts().begin()->check_command(), "check_ping");
+  ASSERT_EQ(config.services().rbegin()->check_interval(), 5u);
+
+  std::filesystem::remove_all("/tmp/parser_cfg_dir");
+  RmConf();
+}
+
+TEST_F(ApplierState, StateLegacyParsingParallelFirstErrorReported) {
+  CreateDirConf(10);
+  /* A duplicated host in an early file and an invalid line in a later one:
+   * the duplicated host must be reported as with a sequential parsing. */
+  CreateFile("/tmp/parser_cfg_dir/hosts_001.cfg",
+             "define host {\n"
+             "    use                            generic-host\n"
+             "    host_name                      host_0\n"
+             "    address                        10.0.0.1\n"
+             "    _HOST_ID                       1\n"
+             "}\n");
+  CreateFile("/tmp/parser_cfg_dir/hosts_005.cfg",
+             "define host {\n"
+             "    unknown_property               1\n"
+             "}\n");
+  ParseSequentialAndParallel("/tmp/centengine.cfg");
+
+  configuration::state config;
+  configuration::parser p;
+  try {
+    p.parse("/tmp/centengine.cfg", config);
+    FAIL() << "the configuration should be invalid";
+  } catch (const std::exception& e) {
+    std::string error(e.what());
+    ASSERT_NE(
+        error.find("in file '/tmp/parser_cfg_dir/hosts_001.cfg' on line 1"),
+        std::string::npos);
+    ASSERT_NE(error.find("alrealdy exists"), std::string::npos);
+  }
+
+  std::filesystem::remove_all("/tmp/parser_cfg_dir");
+  RmConf();
+}
@@ -0,0 +1,111 @@
+/**
+ * Copyright 2023 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "com/centreon/engine/configuration/applier/host.hh"
+#include "com/centreon/engine/configuration/applier/service.hh"
+#include "com/centreon/engine/configuration/applier/state.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/macros.hh"
+#include "com/centreon/engine/macros/command_template.hh"
+#include "tests/helper.hh"
+
+using namespace com::centreon::engine;
+
+static const char* const command_line =
+    "$CENTREONPLUGINS$/centreon_linux_snmp.pl --hostname=$HOSTADDRESS$ "
+    "--snmp-community='$_HOSTSNMPCOMMUNITY$' --storage='$_SERVICEDISK$' "
+    "--warning=$_HOSTWARNING$ --critical=$ARG2$";
+
+/**
+ * @brief A host and a service with custom variables are created and their
+ * macros are grabbed, as before a check is run.
+ *
+ * @return The macros to expand command lines with.
+ */
+static nagios_macros* init_macros_of_service() {
+  init_config_state();
+  init_macros();
+
+  configuration::applier::host hst_aply;
+  configuration::host hst;
+  hst.parse("host_name", "test_host");
+  hst.parse("address", "10.0.0.1");
+  hst.parse("_HOST_ID", "12");
+  hst.parse("_SNMPCOMMUNITY", "public");
+  hst.parse("_WARNING", "200,20%");
+  hst_aply.add_object(hst);
+
+  configuration::applier::service svc_aply;
+  configuration::service svc;
+  svc.parse("host_name", "test_host");
+  svc.parse("service_description", "test_svc");
+  svc.parse("_HOST_ID", "12");
+  svc.parse("_SERVICE_ID", "13");
+  svc.parse("_DISK", "/var");
+  svc_aply.add_object(svc);
+
+  configuration::applier::state::instance().user_macros()["CENTREONPLUGINS"] =
+      "/usr/lib/centreon/plugins";
+
+  nagios_macros* mac = get_global_macros();
+  grab_host_macros_r(mac, host::hosts.find("test_host")->second.get());
+  grab_service_macros_r(
+      mac, service::services.find({"test_host", "test_svc"})->second.get());
+  mac->argv[1] = "90";
+  return mac;
+}
+
+static void deinit_macros_of_service(nagios_macros* mac) {
+  clear_volatile_macros_r(mac);
+  deinit_config_state();
+}
+
+/**
+ * @brief A typical check command line is expanded by process_macros_r() as
+ * it is done without templates.
+ */
+static void BM_process_macros_r(benchmark::State& state) {
+  nagios_macros* mac = init_macros_of_service();
+  const std::string line(command_line);
+  std::string out;
+  for (auto _ : state) {
+    process_macros_r(mac, line, out, 0);
+    benchmark::DoNotOptimize(out.data());
+  }
+  deinit_macros_of_service(mac);
+}
+
+/**
+ * @brief The same command line is expanded from its parsed template.
+ */
+static void BM_command_template_expand(benchmark::State& state) {
+  nagios_macros* mac = init_macros_of_service();
+  macros::command_template tmpl(command_line);
+  std::string out;
+  for (auto _ : state) {
+    tmpl.expand(mac, out, 0);
+    benchmark::DoNotOptimize(out.data());
+  }
+  deinit_macros_of_service(mac);
+}
+
+BENCHMARK(BM_process_macros_r);
+BENCHMARK(BM_command_template_expand);
@@ -0,0 +1,59 @@
+/**
+ * Copyright 2023 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <fstream>
+
+#include "com/centreon/engine/retention/parser.hh"
+#include "com/centreon/engine/retention/state.hh"
+#include "tests/retention/utils.hh"
+
+using namespace com::centreon::engine::retention;
+
+/**
+ * @brief A retention file of 200000 services is loaded. The argument tells
+ * if the file is in the binary format or in the text one.
+ */
+static void BM_retention_load(benchmark::State& state) {
+  const std::string path(state.range(0) ? "/tmp/bench_retention.bin"
+                                        : "/tmp/bench_retention.dat");
+  std::string text(build_retention_file(200000));
+  if (state.range(0))
+    encode_retention_file(text, path);
+  else {
+    std::ofstream ofs(path, std::ios::binary | std::ios::trunc);
+    ofs << text;
+  }
+
+  for (auto _ : state) {
+    com::centreon::engine::retention::state loaded;
+    parser p;
+    p.parse(path, loaded);
+    benchmark::DoNotOptimize(loaded.services().size());
+  }
+  state.SetItemsProcessed(state.iterations() * 200000);
+  ::unlink(path.c_str());
+}
+
+BENCHMARK(BM_retention_load)
+    ->ArgName("binary")
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMillisecond);
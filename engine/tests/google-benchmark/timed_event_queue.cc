@@ -0,0 +1,60 @@
+/**
+ * Copyright 2023 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "com/centreon/engine/events/timed_event_queue.hh"
+
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::events;
+
+static std::unique_ptr<timed_event> check_event(time_t run_time,
+                                                void* data) {
+  return std::make_unique<timed_event>(timed_event::EVENT_SERVICE_CHECK,
+                                       run_time, false, 0, nullptr, false,
+                                       data, nullptr, 0);
+}
+
+/**
+ * @brief Schedules the given number of events, reschedules each of them once
+ * as a check result would do and then runs them all.
+ */
+static void BM_timed_event_queue(benchmark::State& state) {
+  const size_t count = state.range(0);
+  std::vector<int> data(count);
+  for (auto _ : state) {
+    timed_event_queue q;
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<time_t> dist(0, 300);
+    for (auto& d : data)
+      q.push(check_event(dist(gen), &d));
+    for (auto& d : data) {
+      timed_event* evt = q.find(timed_event::EVENT_SERVICE_CHECK, &d);
+      evt->run_time += dist(gen);
+      q.update(evt);
+    }
+    while (!q.empty())
+      benchmark::DoNotOptimize(q.pop());
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+BENCHMARK(BM_timed_event_queue)->Arg(10000)->Arg(500000);
@@ -0,0 +1,78 @@
+/**
+ * Copyright 2023 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "com/centreon/engine/timeperiod.hh"
+#include "tests/timeperiod/utils.hh"
+
+using namespace com::centreon::engine;
+
+/**
+ * @brief Random times of a week are checked against a time period of work
+ * hours with exceptions of every type and holidays excluded. The argument
+ * tells if the compiled lookups are used.
+ */
+static void BM_check_time_against_period(benchmark::State& state) {
+  timeperiod_creator creator;
+
+  timeperiod* holidays = creator.new_timeperiod();
+  daterange* dr =
+      creator.new_calendar_date(2016, 10, 28, 2016, 11, 2, holidays);
+  creator.new_timerange(0, 0, 24, 0, dr);
+  dr = creator.new_generic_month_date(15, 15, holidays);
+  creator.new_timerange(10, 0, 11, 0, dr);
+  std::shared_ptr<timeperiod> holidays_tp = creator.get_timeperiods_shared();
+
+  timeperiod* tp = creator.new_timeperiod();
+  for (int i = 1; i < 6; ++i) {
+    creator.new_timerange(8, 0, 12, 0, i);
+    creator.new_timerange(13, 30, 18, 0, i);
+  }
+  creator.new_timerange(1, 30, 3, 30, 0);
+  dr = creator.new_calendar_date(2016, 11, 5, 2016, 11, 6);
+  creator.new_timerange(9, 0, 10, 0, dr);
+  dr = creator.new_generic_month_date(1, 3);
+  dr->set_skip_interval(2);
+  creator.new_timerange(7, 0, 9, 0, dr);
+  dr = creator.new_offset_weekday_of_specific_month(10, 0, -1, 10, 0, -1);
+  creator.new_timerange(2, 0, 3, 0, dr);
+  dr = creator.new_offset_weekday_of_generic_month(3, 2, 3, 2);
+  creator.new_timerange(12, 0, 13, 0, dr);
+  creator.new_exclusion(holidays_tp, tp);
+
+  time_t now = strtotimet("2016-10-27 10:00:00");
+  set_time(now);
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<time_t> dist(now, now + 7 * 24 * 60 * 60);
+  std::vector<time_t> times(20000);
+  for (time_t& t : times)
+    t = dist(gen);
+
+  timeperiod::use_compiled = state.range(0);
+  for (auto _ : state)
+    for (time_t t : times)
+      benchmark::DoNotOptimize(check_time_against_period(t, tp));
+  timeperiod::use_compiled = true;
+  state.SetItemsProcessed(state.iterations() * times.size());
+}
+
+BENCHMARK(BM_check_time_against_period)->ArgName("compiled")->Arg(0)->Arg(1);
@@ -0,0 +1,169 @@
+/**
+ * Copyright 2023 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include "com/centreon/engine/events/timed_event_queue.hh"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::events;
+
+/**
+ * @brief Build a service check event on the given data.
+ */
+static std::unique_ptr<timed_event> check_event(time_t run_time,
+                                                void* data) {
+  return std::make_unique<timed_event>(timed_event::EVENT_SERVICE_CHECK,
+                                       run_time, false, 0, nullptr, false,
+                                       data, nullptr, 0);
+}
+
+/**
+ * @brief Events are popped in their run time order, those with the same run
+ * time in their insertion order.
+ */
+TEST(TimedEventQueue, Order) {
+  timed_event_queue q;
+  std::vector<int> data(1000);
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<time_t> dist(0, 100);
+  for (auto& d : data)
+    q.push(check_event(dist(gen), &d));
+  ASSERT_EQ(q.size(), data.size());
+
+  time_t last_time = 0;
+  int* last_data = nullptr;
+  while (!q.empty()) {
+    std::unique_ptr<timed_event> evt = q.pop();
+    ASSERT_GE(evt->run_time, last_time);
+    int* d = static_cast<int*>(evt->event_data);
+    if (evt->run_time == last_time)
+      ASSERT_LT(last_data, d);
+    last_time = evt->run_time;
+    last_data = d;
+  }
+}
+
+/**
+ * @brief Events are found and removed by their type and data.
+ */
+TEST(TimedEventQueue, FindAndRemove) {
+  timed_event_queue q;
+  int a, b;
+  q.push(check_event(30, &a));
+  q.push(check_event(10, &a));
+  q.push(check_event(20, &b));
+
+  timed_event* found = q.find(timed_event::EVENT_SERVICE_CHECK, &a);
+  ASSERT_TRUE(found);
+  ASSERT_EQ(found->run_time, 10);
+  ASSERT_FALSE(q.find(timed_event::EVENT_HOST_CHECK, &a));
+
+  std::unique_ptr<timed_event> removed = q.remove(found);
+  ASSERT_EQ(removed.get(), found);
+  ASSERT_FALSE(q.remove(found));
+  ASSERT_EQ(q.find(timed_event::EVENT_SERVICE_CHECK, &a)->run_time, 30);
+
+  q.remove(timed_event::EVENT_SERVICE_CHECK, &a);
+  ASSERT_FALSE(q.find(timed_event::EVENT_SERVICE_CHECK, &a));
+  ASSERT_EQ(q.size(), 1u);
+  ASSERT_EQ(q.front()->event_data, &b);
+}
+
+/**
+ * @brief An event whose run time is changed is moved to its new place.
+ */
+TEST(TimedEventQueue, Update) {
+  timed_event_queue q;
+  std::vector<int> data(100);
+  std::vector<timed_event*> events;
+  for (size_t i = 0; i < data.size(); ++i) {
+    q.push(check_event(i, &data[i]));
+    events.push_back(q.find(timed_event::EVENT_SERVICE_CHECK, &data[i]));
+  }
+
+  events[0]->run_time = 1000;
+  q.update(events[0]);
+  events[99]->run_time = -1;
+  q.update(events[99]);
+  events[50]->run_time = 60;
+  q.update(events[50]);
+
+  ASSERT_EQ(q.pop()->event_data, &data[99]);
+  for (size_t i = 1; i < 99; ++i) {
+    if (i == 50)
+      continue;
+    /* Same run time as data[60] but inserted before it. */
+    if (i == 60)
+      ASSERT_EQ(q.pop()->event_data, &data[50]);
+    ASSERT_EQ(q.pop()->event_data, &data[i]);
+  }
+  ASSERT_EQ(q.pop()->event_data, &data[0]);
+  ASSERT_TRUE(q.empty());
+}
+
+/**
+ * @brief After a global change of the run times, rebuild() restores the
+ * order.
+ */
+TEST(TimedEventQueue, Rebuild) {
+  timed_event_queue q;
+  std::vector<int> data(100);
+  for (size_t i = 0; i < data.size(); ++i)
+    q.push(check_event(i, &data[i]));
+  for (auto& evt : q)
+    evt->run_time = 1000 - evt->run_time;
+  q.rebuild();
+  for (size_t i = data.size(); i-- > 0;)
+    ASSERT_EQ(q.pop()->event_data, &data[i]);
+}
+
+/**
+ * @brief Every event is rescheduled once as a check result would do, the
+ * queue still pops them all in their run time order.
+ */
+TEST(TimedEventQueue, RescheduleAll) {
+  constexpr size_t count = 10000;
+  timed_event_queue q;
+  std::vector<int> data(count);
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<time_t> dist(0, 300);
+
+  for (auto& d : data)
+    q.push(check_event(dist(gen), &d));
+  for (auto& d : data) {
+    timed_event* evt = q.find(timed_event::EVENT_SERVICE_CHECK, &d);
+    ASSERT_TRUE(evt);
+    evt->run_time += dist(gen);
+    q.update(evt);
+  }
+  ASSERT_EQ(q.size(), count);
+
+  time_t last_time = 0;
+  size_t popped = 0;
+  while (!q.empty()) {
+    std::unique_ptr<timed_event> evt = q.pop();
+    ASSERT_GE(evt->run_time, last_time);
+    last_time = evt->run_time;
+    ++popped;
+  }
+  ASSERT_EQ(popped, count);
+}
@@ -0,0 +1,154 @@
+/**
+ * Copyright 2023 Centreon
+ *
+ * This file is part of Centreon Engine.
+ *
+ * Centreon Engine is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * Centreon Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Centreon Engine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "com/centreon/engine/globals.hh"
+
+#include "../helper.hh"
+#include "../test_engine.hh"
+#include "com/centreon/engine/configuration/applier/host.hh"
+#include "com/centreon/engine/configuration/applier/service.hh"
+#include "com/centreon/engine/configuration/applier/state.hh"
+#include "com/centreon/engine/macros.hh"
+#include "com/centreon/engine/macros/command_template.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+
+class CommandTemplate : public TestEngine {
+ public:
+  void SetUp() override {
+    init_config_state();
+    init_macros();
+
+    configuration::applier::host hst_aply;
+    configuration::host hst;
+    hst.parse("host_name", "test_host");
+    hst.parse("address", "10.0.0.1");
+    hst.parse("_HOST_ID", "12");
+    hst.parse("_SNMPCOMMUNITY", "public");
+    hst.parse("_WARNING", "200,20%");
+    hst_aply.add_object(hst);
+
+    configuration::applier::service svc_aply;
+    configuration::service svc;
+    svc.parse("host_name", "test_host");
+    svc.parse("service_description", "test_svc");
+    svc.parse("_HOST_ID", "12");
+    svc.parse("_SERVICE_ID", "13");
+    svc.parse("_DISK", "/var");
+    svc_aply.add_object(svc);
+
+    _host = host::hosts.find("test_host")->second;
+    _svc = service::services.find({"test_host", "test_svc"})->second;
+    _svc->set_plugin_output("Disk 'quoted' `ok`");
+
+    macro_user[0] = "/usr/lib/centreon/plugins";
+    configuration::applier::state::instance().user_macros()["CENTREONPLUGINS"] =
+        "/usr/lib/centreon/plugins";
+
+    _mac = get_global_macros();
+    grab_host_macros_r(_mac, _host.get());
+    grab_service_macros_r(_mac, _svc.get());
+    _mac->argv[0] = "80";
+    _mac->argv[1] = "90";
+  }
+
+  void TearDown() override {
+    clear_volatile_macros_r(_mac);
+    _host.reset();
+    _svc.reset();
+    deinit_config_state();
+  }
+
+ protected:
+  std::shared_ptr<engine::host> _host;
+  std::shared_ptr<engine::service> _svc;
+  nagios_macros* _mac;
+};
+
+static const char* const command_lines[] = {
+    "$USER1$/check_icmp -H $HOSTADDRESS$ -w $ARG1$ -c $ARG2$",
+    "$CENTREONPLUGINS$/centreon_linux_snmp.pl --hostname=$HOSTADDRESS$ "
+    "--snmp-community='$_HOSTSNMPCOMMUNITY$' --storage='$_SERVICEDISK$' "
+    "--warning=$_HOSTWARNING$ --critical=$ARG2$",
+    "echo '$SERVICEOUTPUT$' '$SERVICEDESC$' $SERVICESTATEID:test_host:test_svc$",
+    "$HOSTNAME:test_host$ $HOSTADDRESS:unknown_host$ $HOSTALIAS::$ $ARG33$",
+    "$ARG0$ $ARGX$ $USER0$ $USER257$ $UNKNOWN$ $ARG1:test_host$ $",
+    "price: 10$$ $ARG1",
+    "",
+};
+
+// Given command lines with all kinds of macros
+// When they are expanded from their templates
+// Then the result is the one of process_macros_r()
+TEST_F(CommandTemplate, SameAsProcessMacros) {
+  for (const char* command_line : command_lines) {
+    for (int options : {0, STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS}) {
+      std::string processed;
+      process_macros_r(_mac, command_line, processed, options);
+      std::string expanded("previous content");
+      macros::command_template(command_line).expand(_mac, expanded, options);
+      ASSERT_EQ(expanded, processed) << "command line: " << command_line;
+    }
+  }
+}
+
+// Given a cached template
+// When the configuration is reloaded
+// Then the template is obsolete and parsed again
+TEST_F(CommandTemplate, Invalidate) {
+  std::shared_ptr<const macros::command_template> tmpl =
+      macros::command_template::get("$CENTREONPLUGINS$/check_ping");
+  ASSERT_EQ(macros::command_template::get("$CENTREONPLUGINS$/check_ping"),
+            tmpl);
+  std::string out;
+  tmpl->expand(_mac, out, 0);
+  ASSERT_EQ(out, "/usr/lib/centreon/plugins/check_ping");
+
+  configuration::applier::state::instance().user_macros()["CENTREONPLUGINS"] =
+      "/opt/plugins";
+  macros::command_template::invalidate();
+  ASSERT_TRUE(tmpl->is_obsolete());
+  tmpl = macros::command_template::get("$CENTREONPLUGINS$/check_ping");
+  ASSERT_FALSE(tmpl->is_obsolete());
+  tmpl->expand(_mac, out, 0);
+  ASSERT_EQ(out, "/opt/plugins/check_ping");
+}
+
+// Given a typical check command line and its template
+// When it is expanded many times into the same output string
+// Then each expansion is the one of process_macros_r()
+TEST_F(CommandTemplate, RepeatedExpansion) {
+  const std::string command_line(command_lines[1]);
+  std::string processed;
+  process_macros_r(_mac, command_line, processed, 0);
+  ASSERT_EQ(processed,
+            "/usr/lib/centreon/plugins/centreon_linux_snmp.pl "
+            "--hostname=10.0.0.1 --snmp-community='public' --storage='/var' "
+            "--warning=200,20% --critical=90");
+
+  macros::command_template tmpl(command_line);
+  std::string out;
+  for (int i = 0; i < 1000; ++i) {
+    tmpl.expand(_mac, out, 0);
+    ASSERT_EQ(out, processed);
+  }
+}
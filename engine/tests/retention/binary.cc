@@ -0,0 +1,159 @@
+/**
+ * Copyright 2023 Centreon
+ *
+ * This file is part of Centreon Engine.
+ *
+ * Centreon Engine is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * Centreon Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Centreon Engine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "com/centreon/engine/retention/binary.hh"
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include "com/centreon/engine/exceptions/error.hh"
+#include "com/centreon/engine/retention/host.hh"
+#include "com/centreon/engine/retention/parser.hh"
+#include "com/centreon/engine/retention/service.hh"
+#include "com/centreon/engine/retention/state.hh"
+#include "tests/retention/utils.hh"
+
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::retention;
+
+class RetentionBinaryTest : public ::testing::Test {
+ protected:
+  static constexpr char const* _text_path = "/tmp/retention_binary_test.dat";
+  static constexpr char const* _binary_path =
+      "/tmp/retention_binary_test.bin";
+
+ public:
+  void TearDown() override {
+    ::unlink(_text_path);
+    ::unlink(_binary_path);
+  }
+
+  static void load(std::string const& path, state& retention) {
+    parser p;
+    p.parse(path, retention);
+  }
+
+  template <typename T>
+  static void expect_same(T const& left, T const& right) {
+    ASSERT_EQ(left.size(), right.size());
+    auto it = right.begin();
+    for (auto const& obj : left) {
+      ASSERT_TRUE(*obj == **it);
+      ++it;
+    }
+  }
+};
+
+TEST_F(RetentionBinaryTest, NotBinary) {
+  ASSERT_FALSE(binary::is_binary(""));
+  ASSERT_FALSE(binary::is_binary("info {\n"));
+  ASSERT_TRUE(binary::is_binary(std::string(binary::magic, 8)));
+}
+
+TEST_F(RetentionBinaryTest, BadFile) {
+  std::ostringstream oss;
+  binary::encoder enc(oss);
+  enc.add(build_retention_file(100));
+  enc.finish();
+  std::string content(oss.str());
+  ASSERT_EQ(binary::decode(content).size(), 1u);
+  content.resize(content.size() - 1);
+  ASSERT_THROW(binary::decode(content), std::exception);
+}
+
+// Given a section announcing more keys than its bytes can hold
+// When the file is decoded
+// Then an engine error is thrown before anything is allocated
+TEST_F(RetentionBinaryTest, HugeCountInSection) {
+  auto fixed = [](std::string& out, uint64_t value, int size) {
+    for (int i = 0; i < size; ++i)
+      out.push_back(static_cast<char>(value >> (8 * i)));
+  };
+  std::string content(binary::magic, sizeof(binary::magic));
+  fixed(content, binary::version, 4);
+  uint64_t section_offset = content.size();
+  // A dictionary of 2^63 - 1 keys.
+  content.append("\xff\xff\xff\xff\xff\xff\xff\xff\x7f");
+  uint64_t table_offset = content.size();
+  fixed(content, section_offset, 8);
+  fixed(content, table_offset - section_offset, 8);
+  fixed(content, 1, 4);
+  fixed(content, table_offset, 8);
+  fixed(content, 1, 4);
+  ASSERT_THROW(binary::decode(content), exceptions::error);
+}
+
+TEST_F(RetentionBinaryTest, SameStateAsText) {
+  std::string text(build_retention_file(10000));
+  {
+    std::ofstream ofs(_text_path, std::ios::binary | std::ios::trunc);
+    ofs << text;
+  }
+  encode_retention_file(text, _binary_path);
+
+  state from_text;
+  state from_binary;
+  load(_text_path, from_text);
+  load(_binary_path, from_binary);
+
+  ASSERT_EQ(from_binary.hosts().size(), 500u);
+  ASSERT_EQ(from_binary.services().size(), 10000u);
+  ASSERT_EQ(from_binary.contacts().size(), 1u);
+  ASSERT_TRUE(from_text.informations() == from_binary.informations());
+  ASSERT_TRUE(from_text.globals() == from_binary.globals());
+  expect_same(from_text.hosts(), from_binary.hosts());
+  expect_same(from_text.services(), from_binary.services());
+  expect_same(from_text.contacts(), from_binary.contacts());
+  ASSERT_EQ(from_binary.services().back()->service_description(),
+            "service_9999");
+  ASSERT_EQ(*from_binary.services().back()->long_plugin_output(),
+            "line1\\nline2");
+}
+
+// Given a retention file of more records than a section holds
+// When it is encoded and decoded
+// Then the sections are full except the last one and the records keep
+// their order
+TEST_F(RetentionBinaryTest, SplitIntoSections) {
+  // info, program, 1000 hosts, 20000 services and a contact.
+  constexpr uint32_t records = 2 + 1000 + 20000 + 1;
+  std::ostringstream oss;
+  binary::encoder enc(oss);
+  enc.add(build_retention_file(20000));
+  enc.finish();
+
+  std::vector<std::vector<object_ptr>> sections(binary::decode(oss.str()));
+  ASSERT_EQ(sections.size(),
+            (records + binary::records_per_section - 1) /
+                binary::records_per_section);
+  for (size_t i = 0; i + 1 < sections.size(); ++i)
+    ASSERT_EQ(sections[i].size(), binary::records_per_section);
+  ASSERT_EQ(sections.back().size(),
+            records % binary::records_per_section);
+
+  uint32_t s = 0;
+  for (auto const& section : sections)
+    for (object_ptr const& obj : section)
+      if (obj->type() == object::service) {
+        auto const& svc = static_cast<service const&>(*obj);
+        ASSERT_EQ(svc.service_description(), fmt::format("service_{}", s));
+        ++s;
+      }
+  ASSERT_EQ(s, 20000u);
+}
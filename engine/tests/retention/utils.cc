@@ -0,0 +1,109 @@
+/**
+ * Copyright 2023 Centreon
+ *
+ * This file is part of Centreon Engine.
+ *
+ * Centreon Engine is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * Centreon Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Centreon Engine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "tests/retention/utils.hh"
+
+#include <fstream>
+#include <sstream>
+
+#include "com/centreon/engine/retention/binary.hh"
+
+using namespace com::centreon::engine::retention;
+
+/**
+ *  Build a text retention file with the given number of services spread
+ *  over hosts of 20 services.
+ *
+ *  @param[in] services  The number of services.
+ *
+ *  @return The content of the retention file.
+ */
+std::string build_retention_file(uint32_t services) {
+  std::ostringstream oss;
+  oss << "# retention file\n"
+         "info {\n"
+         "created=1700000000\n"
+         "}\n"
+         "program {\n"
+         "enable_notifications=1\n"
+         "active_service_checks_enabled=1\n"
+         "next_comment_id=12\n"
+         "}\n";
+  for (uint32_t h = 0; h < services / 20; ++h)
+    oss << "host {\n"
+           "host_name=host_"
+        << h
+        << "\n"
+           "host_id="
+        << h + 1
+        << "\n"
+           "current_state=0\n"
+           "plugin_output=OK - host_"
+        << h
+        << " is up\n"
+           "last_check=1700000000\n"
+           "_SNMPCOMMUNITY=1;public\n"
+           "}\n";
+  for (uint32_t s = 0; s < services; ++s)
+    oss << "service {\n"
+           "host_name=host_"
+        << s / 20
+        << "\n"
+           "service_description=service_"
+        << s
+        << "\n"
+           "host_id="
+        << s / 20 + 1
+        << "\n"
+           "service_id="
+        << s + 1
+        << "\n"
+           "check_command=check_service!"
+        << s
+        << "\n"
+           "check_latency=0.123\n"
+           "current_state="
+        << s % 4
+        << "\n"
+           "  long_plugin_output = line1\\nline2  \n"
+           "perf_data=rta=0.5ms;100;200;0 pl=0%;20;50;0\n"
+           "plugin_output=Service "
+        << s
+        << " state\n"
+           "state_history=0,0,1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0\n"
+           "}\n";
+  oss << "contact {\n"
+         "contact_name=admin\n"
+         "host_notifications_enabled=1\n"
+         "}\n";
+  return oss.str();
+}
+
+/**
+ *  Write a text retention content in the binary format.
+ *
+ *  @param[in] text  The text retention content.
+ *  @param[in] path  The binary file to write.
+ */
+void encode_retention_file(std::string const& text, std::string const& path) {
+  std::ofstream ofs(path, std::ios::binary | std::ios::trunc);
+  binary::encoder enc(ofs);
+  enc.add(text);
+  enc.finish();
+}
@@ -0,0 +1,29 @@
+/**
+ * Copyright 2023 Centreon
+ *
+ * This file is part of Centreon Engine.
+ *
+ * Centreon Engine is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * Centreon Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Centreon Engine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TESTS_RETENTION_UTILS_HH
+#define TESTS_RETENTION_UTILS_HH
+
+#include <cstdint>
+#include <string>
+
+std::string build_retention_file(uint32_t services);
+void encode_retention_file(std::string const& text, std::string const& path);
+
+#endif  // !TESTS_RETENTION_UTILS_HH
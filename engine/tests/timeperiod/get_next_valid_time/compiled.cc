@@ -0,0 +1,158 @@
+/**
+ * Copyright 2023 Centreon
+ *
+ * This file is part of Centreon Engine.
+ *
+ * Centreon Engine is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * Centreon Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Centreon Engine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "com/centreon/engine/timeperiod.hh"
+#include "tests/timeperiod/utils.hh"
+
+using namespace com::centreon::engine;
+
+class GetNextValidTimeCompiledTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    _tz = getenv("TZ");
+    setenv("TZ", "Europe/Paris", 1);
+    tzset();
+
+    // Maintenance windows, excluded from the holidays.
+    timeperiod* maintenance = _creator.new_timeperiod();
+    _creator.new_timerange(22, 0, 23, 30, 2, maintenance);
+    daterange* dr = _creator.new_offset_weekday_of_generic_month(0, 1, 0, 1,
+                                                                 maintenance);
+    _creator.new_timerange(6, 0, 8, 0, dr);
+    std::shared_ptr<timeperiod> maintenance_tp =
+        _creator.get_timeperiods_shared();
+
+    // Holidays.
+    timeperiod* holidays = _creator.new_timeperiod();
+    dr = _creator.new_calendar_date(2016, 10, 28, 2016, 11, 2, holidays);
+    _creator.new_timerange(0, 0, 24, 0, dr);
+    dr = _creator.new_specific_month_date(3, 25, 3, 28, holidays);
+    _creator.new_timerange(0, 0, 12, 0, dr);
+    _creator.new_timerange(13, 0, 24, 0, dr);
+    dr = _creator.new_generic_month_date(15, 15, holidays);
+    _creator.new_timerange(10, 0, 11, 0, dr);
+    _creator.new_exclusion(maintenance_tp, holidays);
+    std::shared_ptr<timeperiod> holidays_tp = _creator.get_timeperiods_shared();
+
+    // Work hours, with exceptions of every type.
+    _tp = _creator.new_timeperiod();
+    for (int i = 1; i < 6; ++i) {
+      _creator.new_timerange(8, 0, 12, 0, i);
+      _creator.new_timerange(13, 30, 18, 0, i);
+    }
+    _creator.new_timerange(1, 30, 3, 30, 0);
+    dr = _creator.new_calendar_date(2016, 11, 5, 2016, 11, 6);
+    _creator.new_timerange(9, 0, 10, 0, dr);
+    dr = _creator.new_specific_month_date(3, 26, 3, 27);
+    _creator.new_timerange(1, 0, 4, 0, dr);
+    dr = _creator.new_generic_month_date(1, 3);
+    dr->set_skip_interval(2);
+    _creator.new_timerange(7, 0, 9, 0, dr);
+    dr = _creator.new_offset_weekday_of_specific_month(10, 0, -1, 10, 0, -1);
+    _creator.new_timerange(2, 0, 3, 0, dr);
+    dr = _creator.new_offset_weekday_of_generic_month(3, 2, 3, 2);
+    _creator.new_timerange(12, 0, 13, 0, dr);
+    _creator.new_exclusion(holidays_tp, _tp);
+
+    // A time period in an exclusion loop.
+    _loop = _creator.new_timeperiod();
+    for (int i = 0; i < 7; ++i)
+      _creator.new_timerange(6, 0, 20, 0, i, _loop);
+    _creator.new_exclusion(_creator.get_timeperiods_shared(), _loop);
+  }
+
+  void TearDown() override {
+    timeperiod::use_compiled = true;
+    if (_tz)
+      setenv("TZ", _tz, 1);
+    else
+      unsetenv("TZ");
+    tzset();
+  }
+
+  /**
+   *  Compare the compiled lookups of a time period with the computed ones
+   *  around now.
+   */
+  void compare(timeperiod* tp, time_t now, std::mt19937& gen) {
+    set_time(now);
+    std::uniform_int_distribution<time_t> dist(now - 24 * 60 * 60,
+                                               now + 9 * 24 * 60 * 60);
+    for (int i = 0; i < 200; ++i) {
+      time_t t = dist(gen);
+      if (i % 4 == 0)
+        t -= t % 1800;
+      for (bool notif : {false, true}) {
+        time_t valid[2];
+        time_t invalid[2];
+        for (int compiled = 0; compiled < 2; ++compiled) {
+          timeperiod::use_compiled = compiled;
+          tp->get_next_valid_time_per_timeperiod(t, &valid[compiled], notif);
+          tp->get_next_invalid_time_per_timeperiod(t, &invalid[compiled],
+                                                   notif);
+        }
+        ASSERT_EQ(valid[0], valid[1]) << "now=" << now << " t=" << t;
+        ASSERT_EQ(invalid[0], invalid[1]) << "now=" << now << " t=" << t;
+      }
+    }
+  }
+
+ protected:
+  timeperiod_creator _creator;
+  timeperiod* _tp;
+  timeperiod* _loop;
+  const char* _tz;
+};
+
+// Given exception-heavy time periods with exclusions
+// When their next valid and invalid times are looked up around DST changes
+// Then the compiled lookups return the computed times
+TEST_F(GetNextValidTimeCompiledTest, SameAsComputed) {
+  std::mt19937 gen(42);
+  for (const char* now :
+       {"2016-10-27 10:00:00", "2016-10-30 01:00:00", "2016-11-01 23:59:59",
+        "2017-03-24 08:00:00", "2017-03-26 03:30:00", "2017-06-15 12:00:00"}) {
+    compare(_tp, strtotimet(now), gen);
+    compare(_loop, strtotimet(now), gen);
+  }
+}
+
+// Given exception-heavy time periods with exclusions
+// When the compiled lookups are cached
+// Then they are recompiled once time periods are resolved again
+TEST_F(GetNextValidTimeCompiledTest, Invalidate) {
+  time_t now = strtotimet("2016-11-07 07:00:00");
+  set_time(now);
+  time_t valid;
+  _tp->get_next_valid_time_per_timeperiod(now, &valid, false);
+  ASSERT_EQ(valid, strtotimet("2016-11-07 08:00:00"));
+
+  _tp->days[1].clear();
+  timeperiod::invalidate_compiled();
+  _tp->get_next_valid_time_per_timeperiod(now, &valid, false);
+  ASSERT_NE(valid, strtotimet("2016-11-07 08:00:00"));
+  time_t computed;
+  timeperiod::use_compiled = false;
+  _tp->get_next_valid_time_per_timeperiod(now, &computed, false);
+  ASSERT_EQ(valid, computed);
+}